@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+//  pixconvbench.c
+//
+//  sokol_pixconv.h throughput benchmarks, measures how many megabytes of
+//  source pixel data per second the most common conversions process.
+//
+//  Built by the Makefile in this directory in several flavours which only
+//  differ in the compile options, so that the SIMD code paths can be
+//  compared with the plain C fallback:
+//
+//  - pixconvbench-c:       SOKOL_PIXCONV_NO_SIMD (plain C code)
+//  - pixconvbench-simd:    the compiler's default target instruction set
+//                          (SSE2 on x86-64, NEON on 64-bit ARM)
+//  - pixconvbench-avx2:    -mavx2 -mf16c (x86-64 only, SSSE3, AVX2 and F16C)
+//
+//  The source and destination buffers are small enough to stay in the CPU
+//  cache, so the results show the cost of the conversion code, not the
+//  memory bandwidth.
+//
+//  The results are printed as JSON to stdout, or written to the file given
+//  as first command line argument.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include "sokol_pixconv.h"
+#include "sokol_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_PIXELS (1<<16)
+#define MIN_PIXELS_PER_BENCH (256 * NUM_PIXELS)
+#define MAX_RESULTS (16)
+
+typedef struct {
+    const char* name;
+    double src_mb_per_sec;
+    double mpix_per_sec;
+} result_t;
+
+static struct {
+    const char* json_path;
+    int num_results;
+    result_t results[MAX_RESULTS];
+    void* src;
+    void* dst;
+    uint32_t checksum;
+} state;
+
+static void bench(const char* name, spc_format src_fmt, sg_pixel_format dst_fmt) {
+    if (!spc_can_convert(src_fmt, dst_fmt)) {
+        fprintf(stderr, "pixconvbench: unsupported conversion '%s'\n", name);
+        return;
+    }
+    // warm up the caches (and the lookup tables)
+    spc_convert(src_fmt, state.src, dst_fmt, state.dst, NUM_PIXELS);
+    const uint64_t start = stm_now();
+    int num_iters = 0;
+    for (; num_iters < (MIN_PIXELS_PER_BENCH / NUM_PIXELS); num_iters++) {
+        spc_convert(src_fmt, state.src, dst_fmt, state.dst, NUM_PIXELS);
+    }
+    const double secs = stm_sec(stm_since(start));
+    // consume the results so that the conversions can't be optimized away
+    const uint8_t* dst = (const uint8_t*) state.dst;
+    const size_t dst_size = spc_dst_size(dst_fmt, NUM_PIXELS);
+    for (size_t i = 0; i < dst_size; i += 61) {
+        state.checksum = (state.checksum * 31) + dst[i];
+    }
+    if (state.num_results < MAX_RESULTS) {
+        const double num_pixels = (double)num_iters * NUM_PIXELS;
+        result_t* res = &state.results[state.num_results++];
+        res->name = name;
+        res->src_mb_per_sec = (num_pixels * (double)spc_src_size(src_fmt, 1)) / (secs * 1024.0 * 1024.0);
+        res->mpix_per_sec = num_pixels / (secs * 1000000.0);
+    }
+}
+
+// fill the source buffer with random bytes, or with random floats
+// which are partially outside the 0..1 range to exercise clamping
+static void init_src(bool floats) {
+    uint32_t rnd = 0x12345678;
+    const size_t num_bytes = spc_src_size(SPC_FORMAT_RGBA32F, NUM_PIXELS);
+    for (size_t i = 0; i < (num_bytes / 4); i++) {
+        rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5;
+        if (floats) {
+            ((float*)state.src)[i] = ((float)(rnd & 0xFFFF) / 65535.0f) * 1.5f - 0.25f;
+        }
+        else {
+            ((uint32_t*)state.src)[i] = rnd;
+        }
+    }
+}
+
+static const char* simd_name(void) {
+    #if defined(_SPC_AVX2)
+    return "avx2";
+    #elif defined(_SPC_SSSE3)
+    return "ssse3";
+    #elif defined(_SPC_SSE2)
+    return "sse2";
+    #elif defined(_SPC_NEON)
+    return "neon";
+    #else
+    return "none";
+    #endif
+}
+
+static void write_json(void) {
+    FILE* fp = stdout;
+    if (state.json_path) {
+        fp = fopen(state.json_path, "w");
+        if (!fp) {
+            fprintf(stderr, "pixconvbench: failed to open '%s'\n", state.json_path);
+            return;
+        }
+    }
+    fprintf(fp, "{\n  \"simd\": \"%s\",\n  \"num_pixels\": %d,\n  \"checksum\": %u,\n  \"results\": [\n",
+        simd_name(), NUM_PIXELS, state.checksum);
+    for (int i = 0; i < state.num_results; i++) {
+        const result_t* res = &state.results[i];
+        fprintf(fp, "    { \"name\": \"%s\", \"src_mb_per_sec\": %.1f, \"mpix_per_sec\": %.1f }%s\n",
+            res->name, res->src_mb_per_sec, res->mpix_per_sec, (i < (state.num_results - 1)) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    state.json_path = (argc > 1) ? argv[1] : 0;
+    stm_setup();
+    spc_setup(&(spc_desc_t){0});
+    // big enough for the largest source and destination format (RGBA32F)
+    const size_t buf_size = spc_src_size(SPC_FORMAT_RGBA32F, NUM_PIXELS);
+    state.src = malloc(buf_size);
+    state.dst = malloc(buf_size);
+    if (!state.src || !state.dst) {
+        fprintf(stderr, "pixconvbench: out of memory\n");
+        return 10;
+    }
+
+    init_src(false);
+    bench("rgb8_to_rgba8", SPC_FORMAT_RGB8, SG_PIXELFORMAT_RGBA8);
+    bench("rgba8_to_bgra8", SPC_FORMAT_RGBA8, SG_PIXELFORMAT_BGRA8);
+    bench("rgba8_to_rgba32f", SPC_FORMAT_RGBA8, SG_PIXELFORMAT_RGBA32F);
+    bench("rgba8_to_rgba16f", SPC_FORMAT_RGBA8, SG_PIXELFORMAT_RGBA16F);
+    bench("srgb8_to_rgba8", SPC_FORMAT_SRGB8, SG_PIXELFORMAT_RGBA8);
+    bench("srgba8_to_rgba16f", SPC_FORMAT_SRGBA8, SG_PIXELFORMAT_RGBA16F);
+
+    init_src(true);
+    bench("rgba32f_to_rgba8", SPC_FORMAT_RGBA32F, SG_PIXELFORMAT_RGBA8);
+    bench("rgba32f_to_rgba16f", SPC_FORMAT_RGBA32F, SG_PIXELFORMAT_RGBA16F);
+    bench("rgb32f_to_rgba16f", SPC_FORMAT_RGB32F, SG_PIXELFORMAT_RGBA16F);
+
+    write_json();
+    free(state.src);
+    free(state.dst);
+    spc_shutdown();
+    return 0;
+}
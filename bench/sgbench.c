@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------------
+//  sgbench.c
+//
+//  sokol_gfx.h API overhead microbenchmarks, measures the CPU cost per call
+//  of resource creation/destruction and of the per-draw functions.
+//
+//  Built by the Makefile in this directory in four flavours:
+//
+//  - sgbench-dummy:        dummy backend, validation layer disabled (NDEBUG)
+//  - sgbench-dummy-debug:  dummy backend, validation layer enabled (SOKOL_DEBUG)
+//  - sgbench-dummy-debug-vcache: same as sgbench-dummy-debug, but with
+//                          sg_desc.validation_cache (SGBENCH_VALIDATION_CACHE)
+//  - sgbench-gl:           GL backend in a headless sokol_app.h application
+//                          (SOKOL_FORCE_EGL), runs on Mesa llvmpipe with
+//                          LIBGL_ALWAYS_SOFTWARE=1
+//
+//  The results are printed as JSON to stdout, or written to the file given
+//  as first command line argument.
+//
+//  The sokol implementations live in sokol.c so that the compiler can't
+//  inline (and optimize away) the measured API calls.
+//------------------------------------------------------------------------------
+#if defined(SGBENCH_GL)
+#include "sokol_app.h"
+#include "sokol_gfx.h"
+#include "sokol_glue.h"
+#else
+#include "sokol_gfx.h"
+#endif
+#include "sokol_time.h"
+#include <stdio.h>
+
+#define NUM_CHURN_ITERS (20000)
+#define NUM_DRAW_ITERS (200000)
+#define NUM_ITERS_PER_PASS (1000)
+#define MAX_RESULTS (32)
+#define NUM_LOOKUP_RESOURCES (16384)
+#define NUM_LOOKUP_BINDINGS (65536)
+#define POOL_SIZE (NUM_LOOKUP_RESOURCES + 64)
+#if defined(SGBENCH_VALIDATION_CACHE)
+#define VALIDATION_CACHE (true)
+#else
+#define VALIDATION_CACHE (false)
+#endif
+
+typedef struct {
+    const char* name;
+    int iterations;
+    double ns_per_op;
+} result_t;
+
+static struct {
+    const char* json_path;
+    int num_results;
+    result_t results[MAX_RESULTS];
+    sg_buffer vbuf[2];
+    sg_image img[2];
+    sg_shader shd;
+    sg_pipeline pip;
+    sg_buffer lookup_vbuf[NUM_LOOKUP_RESOURCES];
+    sg_image lookup_img[NUM_LOOKUP_RESOURCES];
+    sg_bindings lookup_bind[NUM_LOOKUP_BINDINGS];
+} state;
+
+static const char* vs_src =
+    "#version 330\n"
+    "uniform vec4 vs_params[4];\n"
+    "layout(location=0) in vec4 position;\n"
+    "void main() {\n"
+    "  gl_Position = position * vs_params[0].x;\n"
+    "}\n";
+static const char* fs_src =
+    "#version 330\n"
+    "uniform sampler2D tex;\n"
+    "out vec4 frag_color;\n"
+    "void main() {\n"
+    "  frag_color = texture(tex, vec2(0.5, 0.5));\n"
+    "}\n";
+
+static void add_result(const char* name, int iterations, uint64_t ticks) {
+    if (state.num_results < MAX_RESULTS) {
+        result_t* res = &state.results[state.num_results++];
+        res->name = name;
+        res->iterations = iterations;
+        res->ns_per_op = stm_ns(ticks) / (double)iterations;
+    }
+}
+
+static sg_shader_desc shader_desc(void) {
+    sg_shader_desc desc = {
+        .attrs[0].name = "position",
+        .vs = {
+            .source = vs_src,
+            .uniform_blocks[0] = {
+                .size = 4 * 16,
+                .uniforms[0] = { .name = "vs_params", .type = SG_UNIFORMTYPE_FLOAT4, .array_count = 4 },
+            },
+        },
+        .fs = {
+            .source = fs_src,
+            .images[0] = { .name = "tex", .image_type = SG_IMAGETYPE_2D },
+        },
+    };
+    return desc;
+}
+
+static sg_pipeline_desc pipeline_desc(sg_shader shd) {
+    sg_pipeline_desc desc = {
+        .shader = shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT4,
+    };
+    return desc;
+}
+
+static sg_buffer make_vertex_buffer(void) {
+    static const float vertices[12] = { 0.0f };
+    return sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+}
+
+static sg_image make_image(void) {
+    static const uint32_t pixels[4 * 4] = { 0 };
+    return sg_make_image(&(sg_image_desc){
+        .width = 4,
+        .height = 4,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.subimage[0][0] = SG_RANGE(pixels),
+    });
+}
+
+static void bench_churn(void) {
+    uint64_t start = stm_now();
+    for (int i = 0; i < NUM_CHURN_ITERS; i++) {
+        sg_destroy_buffer(make_vertex_buffer());
+    }
+    add_result("make_destroy_buffer", NUM_CHURN_ITERS, stm_since(start));
+
+    start = stm_now();
+    for (int i = 0; i < NUM_CHURN_ITERS; i++) {
+        sg_destroy_image(make_image());
+    }
+    add_result("make_destroy_image", NUM_CHURN_ITERS, stm_since(start));
+
+    const sg_shader_desc shd_desc = shader_desc();
+    start = stm_now();
+    for (int i = 0; i < NUM_CHURN_ITERS; i++) {
+        sg_destroy_shader(sg_make_shader(&shd_desc));
+    }
+    add_result("make_destroy_shader", NUM_CHURN_ITERS, stm_since(start));
+
+    const sg_pipeline_desc pip_desc = pipeline_desc(state.shd);
+    start = stm_now();
+    for (int i = 0; i < NUM_CHURN_ITERS; i++) {
+        sg_destroy_pipeline(sg_make_pipeline(&pip_desc));
+    }
+    add_result("make_destroy_pipeline", NUM_CHURN_ITERS, stm_since(start));
+}
+
+// setup a large number of bindings which reference resources in scattered
+// pool slots, this measures the cost of the resource lookups when the pool
+// memory isn't already in the CPU cache
+static void setup_lookup_bindings(void) {
+    for (int i = 0; i < NUM_LOOKUP_RESOURCES; i++) {
+        state.lookup_vbuf[i] = make_vertex_buffer();
+        state.lookup_img[i] = make_image();
+    }
+    uint32_t rnd = 0x12345678;
+    for (int i = 0; i < NUM_LOOKUP_BINDINGS; i++) {
+        rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5;
+        const uint32_t vb_index = rnd % NUM_LOOKUP_RESOURCES;
+        rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5;
+        const uint32_t img_index = rnd % NUM_LOOKUP_RESOURCES;
+        state.lookup_bind[i] = (sg_bindings){
+            .vertex_buffers[0] = state.lookup_vbuf[vb_index],
+            .fs_images[0] = state.lookup_img[img_index],
+        };
+    }
+}
+
+// runs 'num_iters' iterations of one of the per-draw benchmarks, split into
+// passes so that the per-frame state doesn't grow without bounds
+static uint64_t run_draw_loop(int mode, int num_iters) {
+    const sg_pass_action pass_action = { .colors[0].action = SG_ACTION_DONTCARE };
+    const float params[16] = { 1.0f };
+    const sg_range params_range = SG_RANGE(params);
+    sg_bindings bind[2];
+    for (int i = 0; i < 2; i++) {
+        bind[i] = (sg_bindings){ .vertex_buffers[0] = state.vbuf[i], .fs_images[0] = state.img[i] };
+    }
+    uint64_t ticks = 0;
+    for (int done = 0; done < num_iters; done += NUM_ITERS_PER_PASS) {
+        sg_begin_default_pass(&pass_action, 64, 64);
+        sg_apply_pipeline(state.pip);
+        sg_apply_bindings(&bind[0]);
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &params_range);
+        const uint64_t start = stm_now();
+        switch (mode) {
+            case 0:
+                for (int i = 0; i < NUM_ITERS_PER_PASS; i++) {
+                    sg_apply_bindings(&bind[i & 1]);
+                }
+                break;
+            case 1:
+                for (int i = 0; i < NUM_ITERS_PER_PASS; i++) {
+                    sg_apply_bindings(&state.lookup_bind[(done + i) % NUM_LOOKUP_BINDINGS]);
+                }
+                break;
+            case 2:
+                for (int i = 0; i < NUM_ITERS_PER_PASS; i++) {
+                    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &params_range);
+                }
+                break;
+            default:
+                for (int i = 0; i < NUM_ITERS_PER_PASS; i++) {
+                    sg_draw(0, 3, 1);
+                }
+                break;
+        }
+        ticks += stm_since(start);
+        sg_end_pass();
+        sg_commit();
+    }
+    return ticks;
+}
+
+static void bench_draw(void) {
+    add_result("apply_bindings", NUM_DRAW_ITERS, run_draw_loop(0, NUM_DRAW_ITERS));
+    add_result("apply_bindings_scattered", NUM_DRAW_ITERS, run_draw_loop(1, NUM_DRAW_ITERS));
+    add_result("apply_uniforms", NUM_DRAW_ITERS, run_draw_loop(2, NUM_DRAW_ITERS));
+    add_result("draw", NUM_DRAW_ITERS, run_draw_loop(3, NUM_DRAW_ITERS));
+}
+
+static void write_json(void) {
+    FILE* fp = stdout;
+    if (state.json_path) {
+        fp = fopen(state.json_path, "w");
+        if (!fp) {
+            fprintf(stderr, "sgbench: failed to open '%s'\n", state.json_path);
+            return;
+        }
+    }
+    const char* backend = "dummy";
+    #if defined(SGBENCH_GL)
+    backend = "glcore33";
+    #endif
+    #if defined(SOKOL_DEBUG)
+    const bool validation = true;
+    #else
+    const bool validation = false;
+    #endif
+    fprintf(fp, "{\n  \"backend\": \"%s\",\n  \"validation\": %s,\n  \"validation_cache\": %s,\n  \"results\": [\n",
+        backend, validation ? "true" : "false", VALIDATION_CACHE ? "true" : "false");
+    for (int i = 0; i < state.num_results; i++) {
+        const result_t* res = &state.results[i];
+        fprintf(fp, "    { \"name\": \"%s\", \"iterations\": %d, \"ns_per_op\": %.2f }%s\n",
+            res->name, res->iterations, res->ns_per_op, (i < (state.num_results - 1)) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+}
+
+// setup the shared resources, run all benchmarks and write the results,
+// expects that sg_setup() has been called
+static void run(void) {
+    stm_setup();
+    const sg_shader_desc shd_desc = shader_desc();
+    state.shd = sg_make_shader(&shd_desc);
+    const sg_pipeline_desc pip_desc = pipeline_desc(state.shd);
+    state.pip = sg_make_pipeline(&pip_desc);
+    for (int i = 0; i < 2; i++) {
+        state.vbuf[i] = make_vertex_buffer();
+        state.img[i] = make_image();
+    }
+    setup_lookup_bindings();
+    bench_churn();
+    bench_draw();
+    write_json();
+}
+
+#if defined(SGBENCH_GL)
+static void init(void) {
+    sg_setup(&(sg_desc){
+        .buffer_pool_size = POOL_SIZE,
+        .image_pool_size = POOL_SIZE,
+        .validation_cache = VALIDATION_CACHE,
+        .context = sapp_sgcontext()
+    });
+}
+
+static void frame(void) {
+    run();
+    sapp_quit();
+}
+
+static void cleanup(void) {
+    sg_shutdown();
+}
+
+sapp_desc sokol_main(int argc, char* argv[]) {
+    state.json_path = (argc > 1) ? argv[1] : 0;
+    return (sapp_desc){
+        .init_cb = init,
+        .frame_cb = frame,
+        .cleanup_cb = cleanup,
+        .width = 64,
+        .height = 64,
+        .headless = true,
+        .window_title = "sgbench",
+    };
+}
+#else
+int main(int argc, char* argv[]) {
+    state.json_path = (argc > 1) ? argv[1] : 0;
+    sg_setup(&(sg_desc){
+        .buffer_pool_size = POOL_SIZE,
+        .image_pool_size = POOL_SIZE,
+        .shader_pool_size = 8,
+        .pipeline_pool_size = 8,
+        .validation_cache = VALIDATION_CACHE,
+    });
+    run();
+    sg_shutdown();
+    return 0;
+}
+#endif
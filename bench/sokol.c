@@ -0,0 +1,17 @@
+//------------------------------------------------------------------------------
+//  sokol.c
+//
+//  The sokol header implementations for sgbench.c.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#if defined(SGBENCH_GL)
+#define SOKOL_GLCORE33
+#define SOKOL_FORCE_EGL
+#include "sokol_app.h"
+#include "sokol_gfx.h"
+#include "sokol_glue.h"
+#else
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#endif
+#include "sokol_time.h"
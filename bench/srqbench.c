@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+//  srqbench.c
+//
+//  sokol_renderqueue.h benchmark, renders a synthetic scene of 50k draws
+//  with random pipelines, materials and depth values on the dummy backend,
+//  and measures the number of state changes and the CPU time per draw:
+//
+//  - direct:               sg_apply_pipeline(), sg_apply_bindings(),
+//                          sg_apply_uniforms() and sg_draw() for each draw
+//                          in scene order, without sokol_renderqueue.h
+//  - queue_unsorted:       through sokol_renderqueue.h with identical sort
+//                          keys (scene order, only redundant state elimination)
+//  - queue_sorted:         sorted by pipeline, material and depth
+//  - queue_sorted_instanced: sorted, and with auto-instancing enabled for
+//                          all pipelines
+//
+//  The time per draw includes srq_push() and srq_submit() for the queue
+//  variants. The results are printed as JSON to stdout, or written to the
+//  file given as first command line argument.
+//------------------------------------------------------------------------------
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#define SOKOL_RENDERQUEUE_IMPL
+#include "sokol_renderqueue.h"
+#include <stdio.h>
+
+#define NUM_DRAWS (50000)
+#define NUM_FRAMES (20)
+#define NUM_PIPELINES (8)
+#define NUM_MATERIALS (64)
+#define MAX_RESULTS (8)
+
+typedef struct {
+    float model[16];
+} vs_params_t;
+
+typedef struct {
+    float color[4];
+} fs_params_t;
+
+typedef struct {
+    int pipeline;
+    int material;
+    float depth;
+    vs_params_t vs_params;
+} scene_item_t;
+
+typedef struct {
+    const char* name;
+    int iterations;
+    double ns_per_op;
+    uint32_t apply_pipeline;
+    uint32_t apply_bindings;
+    uint32_t apply_uniforms;
+    uint32_t draw;
+} result_t;
+
+static struct {
+    const char* json_path;
+    int num_results;
+    result_t results[MAX_RESULTS];
+    sg_pipeline pip[NUM_PIPELINES];
+    sg_pipeline inst_pip[NUM_PIPELINES];
+    sg_bindings bind[NUM_MATERIALS];
+    fs_params_t fs_params[NUM_MATERIALS];
+    scene_item_t scene[NUM_DRAWS];
+} state;
+
+static void add_result(const char* name, uint64_t ticks, const srq_stats_t* stats) {
+    if (state.num_results < MAX_RESULTS) {
+        result_t* res = &state.results[state.num_results++];
+        res->name = name;
+        res->iterations = NUM_DRAWS * NUM_FRAMES;
+        res->ns_per_op = stm_ns(ticks) / (double)res->iterations;
+        // state changes are reported per frame
+        res->apply_pipeline = stats->num_apply_pipeline / NUM_FRAMES;
+        res->apply_bindings = stats->num_apply_bindings / NUM_FRAMES;
+        res->apply_uniforms = stats->num_apply_uniforms / NUM_FRAMES;
+        res->draw = (stats->num_items - stats->num_instanced_items + stats->num_instanced_draws) / NUM_FRAMES;
+    }
+}
+
+static void setup_resources(void) {
+    sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .attrs[0].name = "position",
+        .vs.uniform_blocks[0].size = sizeof(vs_params_t),
+        .fs = {
+            .uniform_blocks[0].size = sizeof(fs_params_t),
+            .images[0] = { .name = "tex", .image_type = SG_IMAGETYPE_2D },
+        },
+    });
+    // the instanced shader reads the model matrix from per-instance vertex attributes
+    sg_shader inst_shd = sg_make_shader(&(sg_shader_desc){
+        .attrs = {
+            [0].name = "position",
+            [1].name = "model0", [2].name = "model1", [3].name = "model2", [4].name = "model3",
+        },
+        .fs = {
+            .uniform_blocks[0].size = sizeof(fs_params_t),
+            .images[0] = { .name = "tex", .image_type = SG_IMAGETYPE_2D },
+        },
+    });
+    for (int i = 0; i < NUM_PIPELINES; i++) {
+        // the pipelines only differ in render state
+        const sg_cull_mode cull_mode = (sg_cull_mode)(SG_CULLMODE_NONE + (i % 3));
+        const bool depth_write = (i & 4) != 0;
+        state.pip[i] = sg_make_pipeline(&(sg_pipeline_desc){
+            .shader = shd,
+            .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+            .cull_mode = cull_mode,
+            .depth.write_enabled = depth_write,
+        });
+        state.inst_pip[i] = sg_make_pipeline(&(sg_pipeline_desc){
+            .shader = inst_shd,
+            .layout = {
+                .buffers[1] = { .stride = sizeof(vs_params_t), .step_func = SG_VERTEXSTEP_PER_INSTANCE },
+                .attrs = {
+                    [0].format = SG_VERTEXFORMAT_FLOAT3,
+                    [1] = { .format = SG_VERTEXFORMAT_FLOAT4, .buffer_index = 1, .offset = 0 },
+                    [2] = { .format = SG_VERTEXFORMAT_FLOAT4, .buffer_index = 1, .offset = 16 },
+                    [3] = { .format = SG_VERTEXFORMAT_FLOAT4, .buffer_index = 1, .offset = 32 },
+                    [4] = { .format = SG_VERTEXFORMAT_FLOAT4, .buffer_index = 1, .offset = 48 },
+                },
+            },
+            .cull_mode = cull_mode,
+            .depth.write_enabled = depth_write,
+        });
+    }
+    static const float vertices[3 * 36] = { 0.0f };
+    static const uint32_t pixels[4 * 4] = { 0 };
+    for (int i = 0; i < NUM_MATERIALS; i++) {
+        state.bind[i] = (sg_bindings){
+            .vertex_buffers[0] = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) }),
+            .fs_images[0] = sg_make_image(&(sg_image_desc){
+                .width = 4,
+                .height = 4,
+                .pixel_format = SG_PIXELFORMAT_RGBA8,
+                .data.subimage[0][0] = SG_RANGE(pixels),
+            }),
+        };
+        state.fs_params[i] = (fs_params_t){ .color = { (float)i / NUM_MATERIALS, 0.5f, 0.5f, 1.0f } };
+    }
+}
+
+static void setup_scene(void) {
+    uint32_t rnd = 0x12345678;
+    for (int i = 0; i < NUM_DRAWS; i++) {
+        scene_item_t* item = &state.scene[i];
+        rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5;
+        item->pipeline = (int)(rnd % NUM_PIPELINES);
+        item->material = (int)((rnd >> 8) % NUM_MATERIALS);
+        item->depth = (float)((rnd >> 16) & 0xFFFF) / 65535.0f;
+        for (int k = 0; k < 16; k++) {
+            item->vs_params.model[k] = (k % 5) == 0 ? 1.0f : 0.0f;
+        }
+        item->vs_params.model[12] = (float)(i % 100);
+        item->vs_params.model[13] = (float)(i / 100);
+    }
+}
+
+static void begin_frame(void) {
+    sg_begin_default_pass(&(sg_pass_action){ .colors[0].action = SG_ACTION_DONTCARE }, 64, 64);
+}
+
+static void end_frame(void) {
+    sg_end_pass();
+    sg_commit();
+}
+
+// render the scene without sokol_renderqueue.h, one state change per draw
+static void bench_direct(void) {
+    uint64_t ticks = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        begin_frame();
+        const uint64_t start = stm_now();
+        for (int i = 0; i < NUM_DRAWS; i++) {
+            const scene_item_t* item = &state.scene[i];
+            sg_apply_pipeline(state.pip[item->pipeline]);
+            sg_apply_bindings(&state.bind[item->material]);
+            sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(item->vs_params));
+            sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &SG_RANGE(state.fs_params[item->material]));
+            sg_draw(0, 36, 1);
+        }
+        ticks += stm_since(start);
+        end_frame();
+    }
+    const srq_stats_t stats = {
+        .num_items = NUM_DRAWS * NUM_FRAMES,
+        .num_apply_pipeline = NUM_DRAWS * NUM_FRAMES,
+        .num_apply_bindings = NUM_DRAWS * NUM_FRAMES,
+        .num_apply_uniforms = 2 * NUM_DRAWS * NUM_FRAMES,
+    };
+    add_result("direct", ticks, &stats);
+}
+
+// render the scene through sokol_renderqueue.h
+static void bench_queue(const char* name, bool sorted, bool instanced) {
+    srq_setup(&(srq_desc_t){
+        .max_items = NUM_DRAWS,
+        .uniform_buffer_size = NUM_DRAWS * 128,
+        .instance_buffer_size = instanced ? (4 * NUM_DRAWS * (int)sizeof(vs_params_t)) : 0,
+    });
+    if (instanced) {
+        for (int i = 0; i < NUM_PIPELINES; i++) {
+            srq_add_instancing(&(srq_instancing_desc_t){
+                .pipeline = state.pip[i],
+                .instanced_pipeline = state.inst_pip[i],
+                .stage = SG_SHADERSTAGE_VS,
+                .ub_index = 0,
+                .buffer_index = 1,
+            });
+        }
+    }
+    uint64_t ticks = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        begin_frame();
+        const uint64_t start = stm_now();
+        for (int i = 0; i < NUM_DRAWS; i++) {
+            const scene_item_t* item = &state.scene[i];
+            const sg_pipeline pip = state.pip[item->pipeline];
+            srq_push(&(srq_draw_t){
+                .key = sorted ? srq_make_key(0, pip, (uint16_t)item->material, item->depth) : 0,
+                .pipeline = pip,
+                .bindings = state.bind[item->material],
+                .uniforms = {
+                    [0] = { .stage = SG_SHADERSTAGE_VS, .ub_index = 0, .data = SG_RANGE(item->vs_params) },
+                    [1] = { .stage = SG_SHADERSTAGE_FS, .ub_index = 0, .data = SG_RANGE(state.fs_params[item->material]) },
+                },
+                .num_elements = 36,
+                .num_instances = 1,
+            });
+        }
+        srq_submit();
+        ticks += stm_since(start);
+        end_frame();
+    }
+    const srq_stats_t stats = srq_stats();
+    if (stats.num_dropped > 0) {
+        fprintf(stderr, "srqbench: %u draws dropped in '%s'\n", stats.num_dropped, name);
+    }
+    add_result(name, ticks, &stats);
+    srq_shutdown();
+}
+
+static void write_json(void) {
+    FILE* fp = stdout;
+    if (state.json_path) {
+        fp = fopen(state.json_path, "w");
+        if (!fp) {
+            fprintf(stderr, "srqbench: failed to open '%s'\n", state.json_path);
+            return;
+        }
+    }
+    fprintf(fp, "{\n  \"backend\": \"dummy\",\n  \"validation\": false,\n  \"num_draws\": %d,\n  \"results\": [\n", NUM_DRAWS);
+    for (int i = 0; i < state.num_results; i++) {
+        const result_t* res = &state.results[i];
+        fprintf(fp, "    { \"name\": \"%s\", \"iterations\": %d, \"ns_per_op\": %.2f, "
+                    "\"apply_pipeline\": %u, \"apply_bindings\": %u, \"apply_uniforms\": %u, \"draw\": %u }%s\n",
+            res->name, res->iterations, res->ns_per_op,
+            res->apply_pipeline, res->apply_bindings, res->apply_uniforms, res->draw,
+            (i < (state.num_results - 1)) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    state.json_path = (argc > 1) ? argv[1] : 0;
+    sg_setup(&(sg_desc){
+        .buffer_pool_size = NUM_MATERIALS + 16,
+        .image_pool_size = NUM_MATERIALS + 16,
+        .pipeline_pool_size = 2 * NUM_PIPELINES + 16,
+    });
+    stm_setup();
+    setup_resources();
+    setup_scene();
+    bench_direct();
+    bench_queue("queue_unsorted", false, false);
+    bench_queue("queue_sorted", true, false);
+    bench_queue("queue_sorted_instanced", true, true);
+    write_json();
+    sg_shutdown();
+    return 0;
+}
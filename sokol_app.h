@@ -33,6 +33,7 @@
         SOKOL_ABORT()       - called after an unrecoverable error (default: abort())
         SOKOL_WIN32_FORCE_MAIN  - define this on Win32 to use a main() entry point instead of WinMain
         SOKOL_NO_ENTRY      - define this if sokol_app.h shouldn't "hijack" the main() function
+        SOKOL_FORCE_EGL     - define this on Linux to create the GL context with EGL instead of GLX
         SOKOL_APP_API_DECL  - public function declaration prefix (default: extern)
         SOKOL_API_DECL      - same as SOKOL_APP_API_DECL
         SOKOL_API_IMPL      - public function implementation prefix (default: -)
@@ -66,6 +67,7 @@
     - on iOS with Metal: Foundation, UIKit, Metal, MetalKit
     - on iOS with GL: Foundation, UIKit, OpenGLES, GLKit
     - on Linux: X11, Xi, Xcursor, GL, dl, pthread, m(?)
+    - on Linux with SOKOL_FORCE_EGL: X11, Xi, Xcursor, EGL, GL, dl, pthread, m(?)
     - on Android: GLESv3, EGL, log, android
     - on Windows with the MSVC or Clang toolchains: no action needed, libs are defined in-source via pragma-comment-lib
     - on Windows with MINGW/MSYS2 gcc: compile with '-mwin32' so that _WIN32 is defined
@@ -76,6 +78,14 @@
     On Linux, you also need to use the -pthread compiler and linker option, otherwise weird
     things will happen, see here for details: https://github.com/floooh/sokol/issues/376
 
+    The Linux implementation uses POSIX clock and timer functions (for the
+    frame pacing timer and the throttled headless frame loop) which are not
+    declared in strict ISO C modes (like -std=c99), for this reason
+    sokol_app.h defines _GNU_SOURCE when the implementation is included.
+    This only works if sokol_app.h is the first include in the
+    implementation source file, otherwise define _GNU_SOURCE on the
+    compiler command line (or use -std=gnu99).
+
     Building for UWP requires a recent Visual Studio toolchain and Windows SDK
     (at least VS2019 and Windows SDK 10.0.19041.0). When the UWP backend is
     selected, the sokol_app.h implementation must be compiled as C++17.
@@ -117,6 +127,7 @@
     TOUCHES_ENDED       | ---     | ---   | ---   | YES   | YES     | TODO | ---   | YES
     TOUCHES_CANCELLED   | ---     | ---   | ---   | YES   | YES     | TODO | ---   | YES
     RESIZED             | YES     | YES   | YES   | YES   | YES     | YES  | ---   | YES
+    RESIZE_SETTLED      | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | TODO
     ICONIFIED           | YES     | YES   | YES   | ---   | ---     | YES  | ---   | ---
     RESTORED            | YES     | YES   | YES   | ---   | ---     | YES  | ---   | ---
     FOCUSED             | YES     | YES   | YES   | ---   | ---     | ---  | ---   | YES
@@ -133,13 +144,28 @@
     mouse lock          | YES     | YES   | YES   | ---   | ---     | TODO | TODO  | YES
     screen keyboard     | ---     | ---   | ---   | YES   | TODO    | TODO | ---   | YES
     swap interval       | YES     | YES   | YES   | YES   | TODO    | ---  | TODO  | YES
+    runtime swap intv.  | YES     | TODO  | YES   | TODO  | TODO    | ---  | TODO  | TODO
+    adaptive vsync      | TODO    | TODO  | YES(4)| ---   | ---     | ---  | ---   | ---
+    fixed update        | YES     | YES   | YES   | YES   | YES     | YES  | YES   | YES
+    input record/replay | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
     high-dpi            | YES     | YES   | TODO  | YES   | YES     | YES  | TODO  | YES
     clipboard           | YES     | YES   | TODO  | ---   | ---     | TODO | ---   | YES
     MSAA                | YES     | YES   | YES   | YES   | YES     | TODO | TODO  | YES
     drag'n'drop         | YES     | YES   | YES   | ---   | ---     | TODO | TODO  | YES
     window icon         | YES     | YES(1)| YES   | ---   | ---     | TODO | TODO  | YES
+    multiple windows    | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
+    render on demand    | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
+    render thread       | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
+    mouse coalescing    | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
+    mouse history       | TODO    | TODO  | YES   | ---   | ---     | ---  | ---   | ---
+    present timing      | TODO    | TODO  | YES(3)| TODO  | TODO    | TODO | ---   | TODO
+    damage rects        | ---     | ---   | YES(2)| ---   | ---     | ---  | ---   | ---
+    headless            | ---     | ---   | YES(2)| ---   | ---     | ---  | ---   | ---
 
     (1) macOS has no regular window icons, instead the dock icon is changed
+    (2) only with SOKOL_FORCE_EGL (damage rects also need a driver which supports EGL_KHR_swap_buffers_with_damage)
+    (3) only with GLX and a driver which supports GLX_OML_sync_control or GLX_INTEL_swap_event
+    (4) only with GLX and a driver which supports GLX_EXT_swap_control_tear
 
     STEP BY STEP
     ============
@@ -202,6 +228,10 @@
             during start which doesn't allow the program to continue.
             Providing a callback here gives you a chance to show an error message
             to the user. The default behaviour is SOKOL_LOG(msg)
+        .fixed_update_cb (void (*)(void))
+            The optional fixed update callback is called at a fixed rate
+            (sapp_desc.fixed_update_rate, default: 60 times per second)
+            right before the frame callback, see FIXED-TIMESTEP UPDATES below.
 
         As you can see, those 'standard callbacks' don't have a user_data
         argument, so any data that needs to be preserved between callbacks
@@ -216,6 +246,7 @@
         .cleanup_userdata_cb (void (*)(void* user_data))
         .event_userdata_cb (void(*)(const sapp_event* event, void* user_data))
         .fail_userdata_cb (void(*)(const char* msg, void* user_data))
+        .fixed_update_userdata_cb (void (*)(void* user_data))
             These are the user-data versions of the callback functions. You
             can mix those with the standard callbacks that don't have the
             user_data argument.
@@ -801,6 +832,418 @@
     To check if the application window is currently in fullscreen mode,
     call sapp_is_fullscreen().
 
+    MULTIPLE WINDOWS
+    ================
+    On Linux, additional windows can be opened which share the GL context
+    (and thus all sokol-gfx resources) with the main window:
+
+        sapp_window win = sapp_open_window(&(sapp_window_desc){
+            .width = 640,
+            .height = 480,
+            .window_title = "View 2",
+        });
+
+    The function returns an invalid handle (with an id of 0) if the
+    platform doesn't support multiple windows, or if all SAPP_MAX_WINDOWS
+    window slots are in use (this includes the main window).
+
+    All windows use the same pixel formats and MSAA sample count as the main
+    window. At the start of each frame the main window is the active render
+    target. To render into a different window, call sapp_activate_window()
+    before starting the render pass, and use sg_begin_swapchain_pass()
+    instead of sg_begin_default_pass() (the helper function
+    sapp_sgswapchain() in sokol_glue.h creates a matching sg_swapchain
+    struct):
+
+        sapp_activate_window(win);
+        const sg_swapchain swapchain = sapp_sgswapchain(win);
+        sg_begin_swapchain_pass(&swapchain, &pass_action);
+        ...
+        sg_end_pass();
+        sapp_activate_window(sapp_main_window());
+        sg_begin_default_pass(&pass_action, sapp_width(), sapp_height());
+        ...
+        sg_end_pass();
+        sg_commit();
+
+    All windows are presented at the end of the frame. Only the main window
+    is synchronized with the display refresh rate (see sapp_desc.swap_interval),
+    additional windows are presented without waiting for vsync.
+
+    Events are sent for all windows to the same event callback, the window
+    which received the event is stored in sapp_event.window, and the
+    window_width/height and framebuffer_width/height event fields refer
+    to that window.
+
+    When the user tries to close an additional window, the event
+    SAPP_EVENTTYPE_WINDOW_CLOSE_REQUESTED will be sent, the window
+    is *not* closed automatically, instead call sapp_close_window() in
+    response. All remaining windows are closed automatically before
+    the application quits.
+
+    The window-state functions (fullscreen, mouse lock, window title,
+    window icon and drag'n'drop) only affect the main window.
+
+    RENDER ON DEMAND
+    ================
+    Applications which don't animate continuously (like tools or
+    dashboards) can set sapp_desc.render_on_demand to only render a
+    frame when something has changed, instead of rendering frames in
+    a busy loop:
+
+        sapp_desc sokol_main(int argc, char* argv[]) {
+            return (sapp_desc){
+                ...
+                .render_on_demand = true,
+                .render_on_demand_timer_ms = 1000,  // optional
+            };
+        }
+
+    In this mode, the run loop sleeps until one of the following happens,
+    and then renders a single frame:
+
+        - an input or window event arrives (this includes resizing and
+          the window being uncovered)
+        - sapp_request_frame() has been called
+        - the timer set with sapp_desc.render_on_demand_timer_ms has
+          expired (the timer is disabled by default)
+
+    sapp_request_frame() may be called from any thread (for instance
+    when a background thread has finished loading data), and also from
+    within the frame callback when the next frame needs to be rendered
+    too (for instance to finish an animation, or because a UI needs more
+    than one frame to settle after an input event).
+
+    Since the time between frames is arbitrary in on-demand mode, the
+    time spent waiting isn't included in sapp_frame_duration().
+
+    Render-on-demand is currently only implemented on Linux, on other
+    platforms the sapp_desc.render_on_demand flag is ignored and frames
+    are rendered continuously.
+
+    RENDER THREAD
+    =============
+    By default, window events are processed and frames are rendered on the
+    same thread, so a slow frame also delays input handling and the window
+    manager's resize requests. With sapp_desc.render_thread set to true, the
+    thread which called sapp_run() (or main()) only processes window system
+    events, and a separate render thread owns the GL context and calls all
+    application callbacks (init, frame, event and cleanup). Events are
+    handed over to the render thread through a lock-free queue, and are
+    dispatched on the render thread right before the frame callback.
+
+    Since all callbacks run on the render thread, application code doesn't
+    need any additional synchronization. Some things to keep in mind:
+
+        - sapp_width() and sapp_height() change when the render thread has
+          dequeued the window size change, not when the window was actually
+          resized
+        - if the render thread falls far behind, mouse move events are
+          merged into a single held back mouse move (with the summed
+          mouse_dx/dy deltas) until a slot in the queue is free, other
+          events wait for a free slot in the queue
+        - multiple windows (sapp_open_window()) are not supported in render
+          thread mode
+        - the window-state functions (fullscreen, mouse show and lock, window
+          title and icon) may be called from the callbacks as usual, but their
+          effect isn't synchronized with events already in the queue: fullscreen
+          and mouse show/lock changes are handed over to the event thread and
+          applied there, sapp_is_fullscreen(), sapp_mouse_shown() and
+          sapp_mouse_locked() return the requested state right away
+        - the dropped files can be queried in the SAPP_EVENTTYPE_FILES_DROPPED
+          event handler as usual, but files which are dropped before the render
+          thread has dispatched the previous SAPP_EVENTTYPE_FILES_DROPPED event
+          are ignored
+
+    Render thread mode can be combined with render-on-demand, but is ignored
+    in headless mode. It is currently only implemented on Linux, on other
+    platforms the sapp_desc.render_thread flag is ignored.
+
+    FRAME STATISTICS
+    ================
+    sapp_frame_duration() returns a filtered average which is useful for
+    animation, but hides dropped frames. To detect frame pacing problems
+    (for instance to adapt rendering quality at runtime), call:
+
+        sapp_frame_stats stats = sapp_query_frame_stats();
+
+    The returned struct contains statistics over the last
+    sapp_desc.frame_stats_window frames (default: 256): the min, max and
+    average frame duration, the 50th, 90th and 99th percentiles, the number
+    of spikes (frames which took longer than 1.5x the median), the number
+    of dropped frames, and a histogram of SAPP_FRAME_STATS_HISTOGRAM_BINS
+    bins with a width of sapp_desc.frame_stats_bin_width seconds (default:
+    0.001, the last bin also counts all longer frames). The percentiles
+    are computed with a sort, so don't call the function more often than
+    needed.
+
+    By default, frame durations are measured on the CPU between the starts
+    of two frames, and the number of dropped frames is estimated by comparing
+    each frame duration with the median. If sapp_desc.present_timing is
+    true, the frame durations are measured between the actual presents as
+    reported by the window system and the number of dropped frames is the
+    number of missed vblanks (stats.present_timing is true in this case).
+    This is currently only implemented on Linux with GLX, where the present
+    timestamps come from GLX_OML_sync_control (polled after each swap) or
+    GLX_INTEL_swap_event (not in render thread mode).
+
+    FIXED-TIMESTEP UPDATES
+    ======================
+    Simulations (physics, gameplay logic, networked state) are usually
+    advanced in fixed time steps, independent from the display refresh rate.
+    Instead of implementing the time accumulator yourself, you can provide
+    a fixed update callback in sapp_desc:
+
+        sapp_desc sokol_main(int argc, char* argv[]) {
+            return (sapp_desc){
+                ...
+                .fixed_update_cb = update,      // called 60 times per second
+                .frame_cb = frame,
+                .fixed_update_rate = 60,        // this is the default
+            };
+        }
+
+    Before each call to the frame callback, sokol_app.h adds the smoothed
+    frame duration (the same value as returned by sapp_frame_duration()) to
+    an accumulator and calls the fixed update callback once for each
+    complete step of 1 / sapp_desc.fixed_update_rate seconds in the
+    accumulator. Depending on the ratio of display refresh rate and fixed
+    update rate, this may be zero, one or several calls per frame. The
+    remaining time in the accumulator is available in the frame callback
+    as interpolation factor between 0.0 and 1.0, which can be used to blend
+    between the previous and current simulation state for smooth rendering:
+
+        static void frame(void) {
+            const float alpha = (float) sapp_fixed_update_alpha();
+            const vec3 pos = vec3_lerp(state.prev_pos, state.cur_pos, alpha);
+            ...
+        }
+
+    To prevent a 'spiral of death' where a slow fixed update causes even
+    more fixed updates in the next frame, the accumulator is clamped to
+    sapp_desc.fixed_update_max_ticks steps (default: 8), and any excess time
+    is dropped (which means that the simulation slows down instead).
+
+    Use sapp_fixed_update_duration() to get the time step in seconds, and
+    sapp_fixed_update_count() to get the number of fixed updates since the
+    application has started. Events are handled before the fixed update, so
+    input state set in the event callback is visible in the fixed update
+    callback.
+
+    Since the frame duration is a filtered average, the fixed update rate
+    isn't meaningful in render-on-demand mode (where frames are rendered
+    at irregular intervals).
+
+    LIVE WINDOW RESIZING
+    ====================
+    While the user drags a window border, the window system reports size
+    changes at a high rate. On Linux, sokol_app.h coalesces all size changes
+    of the main window between two frames into a single
+    SAPP_EVENTTYPE_RESIZED event, which is sent right before the frame
+    callback (after all other events). The event isn't sent at all if the
+    window ended up at its previous size. sapp_width() and sapp_height()
+    always return the latest size, even before the RESIZED event has been
+    sent.
+
+    This still means one RESIZED event per frame during a live resize. If
+    recreating size-dependent resources (render targets, G-buffers) is
+    expensive, set sapp_desc.resize_settle_ms to get an additional
+    SAPP_EVENTTYPE_RESIZE_SETTLED event once the size hasn't changed for
+    that many milliseconds:
+
+        static void event(const sapp_event* ev) {
+            switch (ev->type) {
+                case SAPP_EVENTTYPE_RESIZED:
+                    // cheap: adjust viewport and projection, keep using
+                    // (and stretching) the existing render targets
+                    break;
+                case SAPP_EVENTTYPE_RESIZE_SETTLED:
+                    // expensive: recreate the render targets with
+                    // ev->framebuffer_width x ev->framebuffer_height
+                    break;
+                default: break;
+            }
+        }
+
+    In render-on-demand mode, a frame is rendered when the RESIZE_SETTLED
+    event is due. Additional windows (see MULTIPLE WINDOWS) still get one
+    RESIZED event per size change and no RESIZE_SETTLED event.
+
+    INPUT RECORD AND REPLAY
+    =======================
+    For reproducible profiling and testing, sokol_app.h can record all
+    events passed to the event callback, together with the frame boundaries
+    and frame durations, into a compact binary log file:
+
+        .input_record_path = "session.inp",
+
+    ...and later replay the log instead of the live input:
+
+        .input_replay_path = "session.inp",
+        .input_replay_unthrottled = true,   // optional
+
+    During replay:
+
+        - all live input and window events are ignored, instead the
+          recorded events are passed to the event callback at the same
+          frame boundaries as during recording (with event.frame_count
+          set to the current frame counter)
+        - sapp_frame_duration() (and the fixed update accumulator, see
+          FIXED-TIMESTEP UPDATES) use the recorded frame durations, so an
+          application which only depends on those sees the same inputs
+          in the same frames
+        - render-on-demand mode is disabled, so that frames don't wait
+          for input which will never arrive
+        - with input_replay_unthrottled, vsync and the headless frame rate
+          are disabled and frames are rendered as fast as possible
+        - after the last recorded frame the application quits as if
+          sapp_quit() had been called
+
+    Combined with headless mode (see HEADLESS MODE), this allows identical,
+    repeatable benchmark runs of real application sessions. Note that the
+    replay only covers what goes through the event callback: mouse samples
+    (see HIGH-RATE MOUSE INPUT), clipboard content and dropped files are
+    not recorded, and the log file uses the native byte order. Input record
+    and replay is currently only implemented on Linux, on other platforms
+    those sapp_desc items are ignored.
+
+    SWAP INTERVAL AND ADAPTIVE VSYNC
+    ================================
+    The initial swap interval is taken from sapp_desc.swap_interval (default:
+    1, which means the frame rate is locked to the display refresh rate).
+    On Linux and with D3D11 on Windows the swap interval can be changed at
+    runtime, for instance from an options menu:
+
+        sapp_set_swap_interval(0);  // disable vsync
+        sapp_set_swap_interval(1);  // enable vsync
+
+    On other platforms the new swap interval is only stored and ignored.
+
+    With regular vsync, a frame which misses the vblank waits for the next
+    vblank, which halves the frame rate until the application catches up
+    again. With adaptive vsync, a late frame is presented immediately
+    instead (and may tear), while frames which are ready in time still wait
+    for the vblank. Adaptive vsync is enabled with sapp_desc.adaptive_vsync
+    or at runtime with sapp_set_adaptive_vsync(), and only has an effect for
+    swap intervals greater than zero. It is currently only implemented on
+    Linux with GLX and a driver which supports GLX_EXT_swap_control_tear,
+    use sapp_adaptive_vsync() to check whether adaptive vsync is actually
+    active (for instance to grey out the option in a settings menu).
+
+    HIGH-RATE MOUSE INPUT
+    =====================
+    Mice with a high polling rate (1000 Hz and more) may produce dozens of
+    SAPP_EVENTTYPE_MOUSE_MOVE events per frame. Applications which only
+    need the accumulated motion can set sapp_desc.coalesce_mouse_moves to
+    merge consecutive mouse move events into a single event:
+
+        - the merged event has the mouse position and modifiers of the
+          last move, and the sum of all mouse_dx/mouse_dy deltas
+        - a pending mouse move is sent before any other event (so the
+          event order is preserved) and before the frame callback, so
+          that there's at most one mouse move event between other events
+
+    Applications which need the motion at a finer granularity than once per
+    frame (for instance for drawing strokes, or for sub-frame latency
+    compensation) can enable a history buffer of mouse samples by setting
+    sapp_desc.mouse_history_size to the max number of samples per frame.
+    In the frame callback (and in event callbacks before it) the samples
+    recorded since the previous frame are available with:
+
+        const int num_samples = sapp_get_num_mouse_samples();
+        for (int i = 0; i < num_samples; i++) {
+            const sapp_mouse_sample smp = sapp_get_mouse_sample(i);
+            // smp.time (in seconds), smp.x, smp.y, smp.dx, smp.dy
+        }
+
+    Samples are returned oldest first. If more samples than
+    sapp_desc.mouse_history_size arrive in one frame, the oldest samples are
+    overwritten. Only the differences between sample timestamps are
+    meaningful, the timestamps come from the window system and don't
+    share an origin with sapp_frame_duration() or sokol_time.h.
+
+    Both features can be used independently of each other. In mouse lock
+    mode the samples contain the raw mouse deltas. Both are currently
+    only implemented on Linux; on other platforms every mouse move is
+    sent as its own event and sapp_get_num_mouse_samples() returns 0.
+
+    EGL AND DAMAGE RECTS ON LINUX
+    =============================
+    By default, the GL context on Linux is created with GLX. Define
+    SOKOL_FORCE_EGL before including the implementation to use EGL
+    instead (and link with libEGL), this has better swap behaviour
+    on recent Mesa drivers and allows to only present the parts of
+    the window which have changed:
+
+    Call sapp_add_damage_rect() in the frame callback with the areas
+    which have changed in this frame (in framebuffer pixels, with the
+    origin at the top-left corner):
+
+        sapp_add_damage_rect(x, y, width, height);
+
+    If the function is called several times in a frame, the union of all
+    rects is presented. If it isn't called, the whole framebuffer is
+    presented.
+
+    Outside the damage rect, the framebuffer must contain the same
+    content as in the previous frame. The number of frames since the
+    current back buffer was last presented is returned by:
+
+        int sapp_buffer_age(void)
+
+    A return value of 0 means that the buffer content is undefined and
+    everything needs to be rendered. A value of N means the buffer holds
+    the content of N frames ago, so the damage rects of the last N frames
+    need to be re-rendered (sokol_gfx.h applications must use SG_ACTION_LOAD
+    in the default pass action for this to be useful).
+
+    Without EGL, or if the driver doesn't support the required extensions
+    (EGL_KHR_swap_buffers_with_damage and EGL_EXT_buffer_age),
+    sapp_add_damage_rect() is ignored and sapp_buffer_age() returns 0.
+
+    HEADLESS MODE
+    =============
+    For automated tests, benchmarks on CI machines or server-side rendering,
+    a sokol_app.h application can run without a display by setting
+    sapp_desc.headless:
+
+        sapp_desc sokol_main(int argc, char* argv[]) {
+            return (sapp_desc){
+                ...
+                .headless = true,
+                .headless_max_frames = 1000,   // optional
+                .headless_frame_rate = 60,     // optional
+            };
+        }
+
+    In headless mode no window is created and no connection to an X server
+    is opened. Instead the GL context renders into an offscreen EGL pbuffer
+    surface of size sapp_desc.width/height (640x480 by default), so the
+    default framebuffer and sokol_glue.h work unchanged. The init-, frame-
+    and cleanup-callbacks are called as usual, but no input or window events
+    are sent.
+
+    By default, frames are rendered as fast as possible. With
+    sapp_desc.headless_frame_rate the frame loop is throttled to a fixed
+    frame rate instead. Set sapp_desc.headless_max_frames to quit the
+    application deterministically after the given number of frames,
+    otherwise the application runs until sapp_quit() or sapp_request_quit()
+    is called (a SAPP_EVENTTYPE_QUIT_REQUESTED event is sent in the latter
+    case).
+
+    The window-related functions (fullscreen, mouse show and lock, window
+    title and icon, and additional windows) do nothing in headless mode,
+    and render-on-demand is ignored.
+
+    Headless mode requires SOKOL_FORCE_EGL and an EGL implementation which
+    supports pbuffer surfaces for desktop GL. With Mesa, the
+    EGL_MESA_platform_surfaceless extension is used so that no X server is
+    needed (the GPU is selected through the DRI driver, for instance with
+    the environment variable MESA_LOADER_DRIVER_OVERRIDE, or with
+    LIBGL_ALWAYS_SOFTWARE=1 for the llvmpipe software rasterizer). On other
+    platforms, and on Linux without SOKOL_FORCE_EGL, the application fails
+    at startup when sapp_desc.headless is set.
+
     WINDOW ICON SUPPORT
     ===================
     Some sokol_app.h backends allow to change the window icon programmatically:
@@ -1022,6 +1465,14 @@
         distribution.
 */
 #define SOKOL_APP_INCLUDED (1)
+#if defined(SOKOL_APP_IMPL) && (defined(__linux__) || defined(__unix__)) && !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+    /* the Linux implementation needs POSIX.1-2008 declarations (timerfd, clock_nanosleep, CLOCK_MONOTONIC)
+       which are hidden in strict ISO C modes like -std=c99, this must happen before the first system include
+    */
+    #if !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+    #endif
+#endif
 #include <stddef.h> // size_t
 #include <stdint.h>
 #include <stdbool.h>
@@ -1049,6 +1500,7 @@ enum {
     SAPP_MAX_MOUSEBUTTONS = 3,
     SAPP_MAX_KEYCODES = 512,
     SAPP_MAX_ICONIMAGES = 8,
+    SAPP_MAX_WINDOWS = 8,
 };
 
 /*
@@ -1085,6 +1537,8 @@ typedef enum sapp_event_type {
     SAPP_EVENTTYPE_QUIT_REQUESTED,
     SAPP_EVENTTYPE_CLIPBOARD_PASTED,
     SAPP_EVENTTYPE_FILES_DROPPED,
+    SAPP_EVENTTYPE_WINDOW_CLOSE_REQUESTED,
+    SAPP_EVENTTYPE_RESIZE_SETTLED,
     _SAPP_EVENTTYPE_NUM,
     _SAPP_EVENTTYPE_FORCE_U32 = 0x7FFFFFFF
 } sapp_event_type;
@@ -1237,6 +1691,67 @@ typedef struct sapp_touchpoint {
     bool changed;
 } sapp_touchpoint;
 
+/*
+    sapp_mouse_sample
+
+    A single mouse motion sample recorded between two frames, see
+    sapp_desc.mouse_history_size and sapp_get_mouse_sample(). The timestamp
+    is in seconds relative to an arbitrary origin, only the difference
+    between two timestamps is meaningful.
+*/
+typedef struct sapp_mouse_sample {
+    double time;
+    float x, y;
+    float dx, dy;
+} sapp_mouse_sample;
+
+/*
+    sapp_frame_stats
+
+    Frame timing statistics over the last sapp_desc.frame_stats_window
+    frames, returned by sapp_query_frame_stats(). All durations are in
+    seconds. With present_timing, durations are measured between the
+    actual presents reported by the window system, otherwise between the
+    starts of two frames on the CPU.
+*/
+#define SAPP_FRAME_STATS_HISTOGRAM_BINS (64)
+typedef struct sapp_frame_stats {
+    int num_frames;             // number of frame durations in the statistics window
+    bool present_timing;        // true if durations are measured between actual presents
+    double min;
+    double max;
+    double avg;
+    double p50;                 // median
+    double p90;
+    double p99;
+    int num_spikes;             // number of frames which took longer than 1.5x the median
+    int num_dropped;            // number of missed vblanks (estimated from the median without present timing)
+    double histogram_bin_width; // width of a histogram bin (sapp_desc.frame_stats_bin_width)
+    int histogram[SAPP_FRAME_STATS_HISTOGRAM_BINS];     // frames per duration bin, the last bin also counts all longer frames
+} sapp_frame_stats;
+
+/*
+    sapp_window
+
+    A handle for one of the application's windows. The main window
+    is returned by sapp_main_window(), additional windows are opened
+    with sapp_open_window() (currently only supported on Linux/X11).
+    The window which received an event is stored in sapp_event.window.
+*/
+typedef struct sapp_window { uint32_t id; } sapp_window;
+
+/*
+    sapp_window_desc
+
+    Describes an additional window in sapp_open_window(). If width
+    or height is zero, the size of the main window will be used.
+*/
+typedef struct sapp_window_desc {
+    int width;
+    int height;
+    const char* window_title;           // UTF-8 encoded window title
+} sapp_window_desc;
+
 /*
     sapp_mousebutton
 
@@ -1293,6 +1808,7 @@ typedef struct sapp_event {
     int window_height;
     int framebuffer_width;              // = window_width * dpi_scale
     int framebuffer_height;             // = window_height * dpi_scale
+    sapp_window window;                 // the window which received the event, always valid
 } sapp_event;
 
 /*
@@ -1363,6 +1879,7 @@ typedef struct sapp_desc {
     void (*cleanup_cb)(void);
     void (*event_cb)(const sapp_event*);
     void (*fail_cb)(const char*);
+    void (*fixed_update_cb)(void);          // optional, see FIXED-TIMESTEP UPDATES
 
     void* user_data;                        // these are the user-provided callbacks with user data
     void (*init_userdata_cb)(void*);
@@ -1370,11 +1887,13 @@ typedef struct sapp_desc {
     void (*cleanup_userdata_cb)(void*);
     void (*event_userdata_cb)(const sapp_event*, void*);
     void (*fail_userdata_cb)(const char*, void*);
+    void (*fixed_update_userdata_cb)(void*);
 
     int width;                          // the preferred width of the window / canvas
     int height;                         // the preferred height of the window / canvas
     int sample_count;                   // MSAA sample count
     int swap_interval;                  // the preferred swap interval (ignored on some platforms)
+    bool adaptive_vsync;                // swap late frames immediately instead of waiting for the next vblank (Linux with GLX only)
     bool high_dpi;                      // whether the rendering canvas is full-resolution on HighDPI displays
     bool fullscreen;                    // whether the window should be created in fullscreen mode
     bool alpha;                         // whether the framebuffer should have an alpha channel (ignored on some platforms)
@@ -1386,6 +1905,23 @@ typedef struct sapp_desc {
     int max_dropped_files;              // max number of dropped files to process (default: 1)
     int max_dropped_file_path_length;   // max length in bytes of a dropped UTF-8 file path (default: 2048)
     sapp_icon_desc icon;                // the initial window icon to set
+    bool render_on_demand;              // only render frames after input, resize or sapp_request_frame() (Linux only)
+    int render_on_demand_timer_ms;      // render_on_demand: additionally render a frame every N milliseconds (default: 0, off)
+    bool headless;                      // run without a window, rendering into an offscreen framebuffer (Linux with SOKOL_FORCE_EGL only)
+    int headless_max_frames;            // headless: quit after this many frames (default: 0, no limit)
+    int headless_frame_rate;            // headless: fixed frame rate in Hz (default: 0, unthrottled)
+    bool render_thread;                 // call the init-, frame-, event- and cleanup-callbacks on a separate render thread (Linux only)
+    bool coalesce_mouse_moves;          // merge consecutive MOUSE_MOVE events into one event with summed deltas (Linux only)
+    int mouse_history_size;             // max number of mouse samples recorded per frame (default: 0, off) (Linux only)
+    int frame_stats_window;             // number of frames in sapp_query_frame_stats() (default: 256)
+    double frame_stats_bin_width;       // sapp_query_frame_stats() histogram bin width in seconds (default: 0.001)
+    bool present_timing;                // measure frame durations between actual presents where supported (Linux with GLX only)
+    int fixed_update_rate;              // fixed_update_cb calls per second (default: 60)
+    int fixed_update_max_ticks;         // max fixed_update_cb calls per frame, excess time is dropped (default: 8)
+    const char* input_record_path;      // record all events and frame durations into this file (Linux only)
+    const char* input_replay_path;      // replay events and frame durations from this file instead of live input (Linux only)
+    bool input_replay_unthrottled;      // input_replay_path: render frames as fast as possible (Linux only)
+    int resize_settle_ms;               // send RESIZE_SETTLED after the window size didn't change for N milliseconds (default: 0, off) (Linux only)
 
     /* backend-specific options */
     bool gl_force_gles2;                // if true, setup GLES2/WebGL even if GLES3/WebGL2 is available
@@ -1482,6 +2018,26 @@ SOKOL_APP_API_DECL void sapp_consume_event(void);
 SOKOL_APP_API_DECL uint64_t sapp_frame_count(void);
 /* get an averaged/smoothed frame duration in seconds */
 SOKOL_APP_API_DECL double sapp_frame_duration(void);
+/* get frame timing statistics over the last sapp_desc.frame_stats_window frames */
+SOKOL_APP_API_DECL sapp_frame_stats sapp_query_frame_stats(void);
+/* get the interpolation factor (0..1) between the last two fixed updates */
+SOKOL_APP_API_DECL double sapp_fixed_update_alpha(void);
+/* get the duration of one fixed update in seconds (1 / sapp_desc.fixed_update_rate) */
+SOKOL_APP_API_DECL double sapp_fixed_update_duration(void);
+/* get the number of fixed updates since the start of the application */
+SOKOL_APP_API_DECL uint64_t sapp_fixed_update_count(void);
+/* change the swap interval at runtime, 0 disables vsync (Linux and D3D11 only) */
+SOKOL_APP_API_DECL void sapp_set_swap_interval(int interval);
+/* enable or disable adaptive vsync at runtime (Linux with GLX only) */
+SOKOL_APP_API_DECL void sapp_set_adaptive_vsync(bool enabled);
+/* return true if adaptive vsync is requested and supported by the driver */
+SOKOL_APP_API_DECL bool sapp_adaptive_vsync(void);
+/* request a frame in render-on-demand mode (may be called from any thread) */
+SOKOL_APP_API_DECL void sapp_request_frame(void);
+/* add a changed area to the current frame's damage rect (Linux with EGL only) */
+SOKOL_APP_API_DECL void sapp_add_damage_rect(int x, int y, int width, int height);
+/* number of frames since the current back buffer was presented, 0 if unknown (Linux with EGL only) */
+SOKOL_APP_API_DECL int sapp_buffer_age(void);
 /* write string into clipboard */
 SOKOL_APP_API_DECL void sapp_set_clipboard_string(const char* str);
 /* read string from clipboard (usually during SAPP_EVENTTYPE_CLIPBOARD_PASTED) */
@@ -1494,6 +2050,25 @@ SOKOL_APP_API_DECL void sapp_set_icon(const sapp_icon_desc* icon_desc);
 SOKOL_APP_API_DECL int sapp_get_num_dropped_files(void);
 /* gets the dropped file paths */
 SOKOL_APP_API_DECL const char* sapp_get_dropped_file_path(int index);
+/* gets the number of mouse samples recorded since the last frame (see sapp_desc.mouse_history_size) */
+SOKOL_APP_API_DECL int sapp_get_num_mouse_samples(void);
+/* gets a recorded mouse sample, oldest first */
+SOKOL_APP_API_DECL sapp_mouse_sample sapp_get_mouse_sample(int index);
+
+/* get the handle of the main window */
+SOKOL_APP_API_DECL sapp_window sapp_main_window(void);
+/* open an additional window which shares the 3D context with the main window (only on Linux) */
+SOKOL_APP_API_DECL sapp_window sapp_open_window(const sapp_window_desc* desc);
+/* close an additional window */
+SOKOL_APP_API_DECL void sapp_close_window(sapp_window win);
+/* return true if the window handle refers to an open window */
+SOKOL_APP_API_DECL bool sapp_window_valid(sapp_window win);
+/* get the current framebuffer width of a window in pixels */
+SOKOL_APP_API_DECL int sapp_window_width(sapp_window win);
+/* get the current framebuffer height of a window in pixels */
+SOKOL_APP_API_DECL int sapp_window_height(sapp_window win);
+/* make a window the render target of the 3D context (must be called before rendering to a window) */
+SOKOL_APP_API_DECL void sapp_activate_window(sapp_window win);
 
 /* special run-function for SOKOL_NO_ENTRY (in standard mode this is an empty stub) */
 SOKOL_APP_API_DECL void sapp_run(const sapp_desc* desc);
@@ -1568,6 +2143,7 @@ inline void sapp_run(const sapp_desc& desc) { return sapp_run(&desc); }
 
 #include <string.h> // memset
 #include <stddef.h> // size_t
+#include <stdlib.h> // qsort
 
 /* check if the config defines are alright */
 #if defined(__APPLE__)
@@ -1630,6 +2206,11 @@ inline void sapp_run(const sapp_desc& desc) { return sapp_run(&desc); }
     #if !defined(SOKOL_GLCORE33)
     #error("sokol_app.h: unknown 3D API selected for Linux, must be SOKOL_GLCORE33")
     #endif
+    #if defined(SOKOL_FORCE_EGL)
+        #define _SAPP_EGL (1)
+    #else
+        #define _SAPP_GLX (1)
+    #endif
 #else
 #error "sokol_app.h: Unknown platform"
 #endif
@@ -1818,6 +2399,19 @@ inline void sapp_run(const sapp_desc& desc) { return sapp_run(&desc); }
     #include <limits.h> /* LONG_MAX */
     #include <pthread.h>    /* only used a linker-guard, search for _sapp_linux_run() and see first comment */
     #include <time.h>
+    #include <errno.h>
+    #include <unistd.h>         /* read, write, close */
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/timerfd.h>
+    #include <stdio.h>          /* fopen, fread, fwrite */
+    #if !defined(CLOCK_MONOTONIC) || !defined(TIMER_ABSTIME)
+    #error "sokol_app.h: POSIX clock functions not declared, include sokol_app.h before any system headers or define _GNU_SOURCE"
+    #endif
+    #if defined(_SAPP_EGL)
+        #include <EGL/egl.h>
+        #include <EGL/eglext.h>
+    #endif
 #endif
 
 /*== frame timing helpers ===================================================*/
@@ -1951,6 +2545,25 @@ _SOKOL_PRIVATE double _sapp_timestamp_now(_sapp_timestamp_t* ts) {
     #endif
 }
 
+/* unfiltered frame durations for sapp_query_frame_stats() */
+typedef struct {
+    double dur;
+    int missed;             /* missed vblanks, only valid with present timing */
+} _sapp_frame_stats_item_t;
+
+typedef struct {
+    _sapp_frame_stats_item_t* items;
+    double* sorted;         /* scratch buffer for computing percentiles */
+    int size;
+    int head;
+    int num;
+    bool present_timing;    /* items are measured between actual presents */
+    bool has_present;       /* the last_* values are valid */
+    int64_t last_ust;
+    int64_t last_msc;
+    int64_t last_sbc;
+} _sapp_frame_stats_t;
+
 typedef struct {
     double last;
     double accum;
@@ -1959,8 +2572,74 @@ typedef struct {
     int num;
     _sapp_timestamp_t timestamp;
     _sapp_ring_t ring;
+    _sapp_frame_stats_t stats;
 } _sapp_timing_t;
 
+_SOKOL_PRIVATE void _sapp_frame_stats_init(_sapp_frame_stats_t* s, int size) {
+    SOKOL_ASSERT(size > 0);
+    s->items = (_sapp_frame_stats_item_t*) SOKOL_CALLOC((size_t)size, sizeof(_sapp_frame_stats_item_t));
+    s->sorted = (double*) SOKOL_CALLOC((size_t)size, sizeof(double));
+    s->size = size;
+}
+
+_SOKOL_PRIVATE void _sapp_frame_stats_discard(_sapp_frame_stats_t* s) {
+    if (s->items) {
+        SOKOL_FREE(s->items);
+        s->items = 0;
+    }
+    if (s->sorted) {
+        SOKOL_FREE(s->sorted);
+        s->sorted = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_frame_stats_put(_sapp_frame_stats_t* s, double dur, int missed) {
+    if (0 == s->size) {
+        return;
+    }
+    s->items[s->head].dur = dur;
+    s->items[s->head].missed = missed;
+    s->head = (s->head + 1) % s->size;
+    if (s->num < s->size) {
+        s->num++;
+    }
+}
+
+/* a buffer swap has been presented: ust is the present timestamp in
+   microseconds, msc the vblank counter and sbc the swap counter (as in
+   GLX_OML_sync_control), a jump in sbc means that several swaps have
+   completed since the last call
+*/
+_SOKOL_PRIVATE void _sapp_frame_stats_present(_sapp_frame_stats_t* s, int64_t ust, int64_t msc, int64_t sbc, int swap_interval) {
+    if (s->has_present && (sbc <= s->last_sbc)) {
+        return;
+    }
+    if (!s->present_timing) {
+        /* don't mix CPU-side frame durations with present intervals */
+        s->head = 0;
+        s->num = 0;
+        s->present_timing = true;
+    }
+    if (s->has_present && (ust > s->last_ust)) {
+        const int64_t num_swaps = sbc - s->last_sbc;
+        int64_t missed = 0;
+        if (swap_interval > 0) {
+            missed = (msc - s->last_msc) - (num_swaps * swap_interval);
+            if (missed < 0) {
+                missed = 0;
+            }
+        }
+        const double dur = (double)(ust - s->last_ust) / (1000000.0 * (double)num_swaps);
+        for (int64_t i = 0; (i < num_swaps) && (i < s->size); i++) {
+            _sapp_frame_stats_put(s, dur, (0 == i) ? (int)missed : 0);
+        }
+    }
+    s->last_ust = ust;
+    s->last_msc = msc;
+    s->last_sbc = sbc;
+    s->has_present = true;
+}
+
 _SOKOL_PRIVATE void _sapp_timing_reset(_sapp_timing_t* t) {
     t->last = 0.0;
     t->accum = 0.0;
@@ -2008,6 +2687,7 @@ _SOKOL_PRIVATE void _sapp_timing_put(_sapp_timing_t* t, double dur) {
 
 _SOKOL_PRIVATE void _sapp_timing_discontinuity(_sapp_timing_t* t) {
     t->last = 0.0;
+    t->stats.has_present = false;
 }
 
 _SOKOL_PRIVATE void _sapp_timing_measure(_sapp_timing_t* t) {
@@ -2015,6 +2695,9 @@ _SOKOL_PRIVATE void _sapp_timing_measure(_sapp_timing_t* t) {
     if (t->last > 0.0) {
         double dur = now - t->last;
         _sapp_timing_put(t, dur);
+        if (!t->stats.present_timing) {
+            _sapp_frame_stats_put(&t->stats, dur, 0);
+        }
     }
     t->last = now;
 }
@@ -2023,6 +2706,9 @@ _SOKOL_PRIVATE void _sapp_timing_external(_sapp_timing_t* t, double now) {
     if (t->last > 0.0) {
         double dur = now - t->last;
         _sapp_timing_put(t, dur);
+        if (!t->stats.present_timing) {
+            _sapp_frame_stats_put(&t->stats, dur, 0);
+        }
     }
     t->last = now;
 }
@@ -2031,6 +2717,62 @@ _SOKOL_PRIVATE double _sapp_timing_get_avg(_sapp_timing_t* t) {
     return t->avg;
 }
 
+_SOKOL_PRIVATE int _sapp_cmp_double(const void* a, const void* b) {
+    const double da = *(const double*)a;
+    const double db = *(const double*)b;
+    return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+/* nearest-rank percentile of a sorted array */
+_SOKOL_PRIVATE double _sapp_percentile(const double* sorted, int num, double p) {
+    SOKOL_ASSERT(num > 0);
+    int index = (int)(p * (double)(num - 1) + 0.5);
+    if (index >= num) {
+        index = num - 1;
+    }
+    return sorted[index];
+}
+
+_SOKOL_PRIVATE void _sapp_frame_stats_query(_sapp_frame_stats_t* s, double bin_width, sapp_frame_stats* res) {
+    memset(res, 0, sizeof(sapp_frame_stats));
+    res->present_timing = s->present_timing;
+    res->histogram_bin_width = bin_width;
+    res->num_frames = s->num;
+    if (0 == s->num) {
+        return;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < s->num; i++) {
+        s->sorted[i] = s->items[i].dur;
+        sum += s->items[i].dur;
+    }
+    qsort(s->sorted, (size_t)s->num, sizeof(double), _sapp_cmp_double);
+    res->min = s->sorted[0];
+    res->max = s->sorted[s->num - 1];
+    res->avg = sum / (double)s->num;
+    res->p50 = _sapp_percentile(s->sorted, s->num, 0.5);
+    res->p90 = _sapp_percentile(s->sorted, s->num, 0.9);
+    res->p99 = _sapp_percentile(s->sorted, s->num, 0.99);
+    for (int i = 0; i < s->num; i++) {
+        const double dur = s->items[i].dur;
+        if (dur > (res->p50 * 1.5)) {
+            res->num_spikes++;
+        }
+        if (s->present_timing) {
+            res->num_dropped += s->items[i].missed;
+        }
+        else if ((res->p50 > 0.0) && (dur > (res->p50 * 1.5))) {
+            /* without present timestamps, estimate the missed vblanks from the median */
+            res->num_dropped += (int)(dur / res->p50 + 0.5) - 1;
+        }
+        int bin = (int)(dur / bin_width);
+        if (bin >= SAPP_FRAME_STATS_HISTOGRAM_BINS) {
+            bin = SAPP_FRAME_STATS_HISTOGRAM_BINS - 1;
+        }
+        res->histogram[bin]++;
+    }
+}
+
 /*== MACOS DECLARATIONS ======================================================*/
 #if defined(_SAPP_MACOS)
 @interface _sapp_macos_app_delegate : NSObject<NSApplicationDelegate>
@@ -2321,7 +3063,21 @@ typedef struct {
 #if defined(_SAPP_LINUX)
 
 #define _SAPP_X11_XDND_VERSION (5)
-
+#define _SAPP_X11_EVENT_QUEUE_SIZE (256)    /* must be a power of two */
+#define _SAPP_X11_SAMPLE_QUEUE_SIZE (1024)  /* must be a power of two */
+/* render thread mode: window state change requests posted by the render thread */
+#define _SAPP_X11_REQ_FULLSCREEN_ON     (1<<0)
+#define _SAPP_X11_REQ_FULLSCREEN_OFF    (1<<1)
+#define _SAPP_X11_REQ_MOUSE_LOCK        (1<<2)
+#define _SAPP_X11_REQ_MOUSE_UNLOCK      (1<<3)
+#define _SAPP_X11_REQ_MOUSE_SHOW        (1<<4)
+#define _SAPP_X11_REQ_MOUSE_HIDE        (1<<5)
+/* render thread mode: window state published by the X11 thread */
+#define _SAPP_X11_STATE_FULLSCREEN      (1<<0)
+#define _SAPP_X11_STATE_MOUSE_LOCKED    (1<<1)
+#define _SAPP_X11_STATE_MOUSE_SHOWN     (1<<2)
+
+#if defined(_SAPP_GLX)
 #define GLX_VENDOR 1
 #define GLX_RGBA_BIT 0x00000001
 #define GLX_WINDOW_BIT 0x00000001
@@ -2341,6 +3097,8 @@ typedef struct {
 #define GLX_CONTEXT_MAJOR_VERSION_ARB 0x2091
 #define GLX_CONTEXT_MINOR_VERSION_ARB 0x2092
 #define GLX_CONTEXT_FLAGS_ARB 0x2094
+#define GLX_BUFFER_SWAP_COMPLETE_INTEL_MASK 0x04000000
+#define GLX_BufferSwapComplete 1
 
 typedef XID GLXWindow;
 typedef XID GLXDrawable;
@@ -2365,6 +3123,22 @@ typedef void (*PFNGLXDESTROYWINDOWPROC)(Display*,GLXWindow);
 
 typedef int (*PFNGLXSWAPINTERVALMESAPROC)(int);
 typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLXContext,Bool,const int*);
+typedef Bool (*PFNGLXGETSYNCVALUESOMLPROC)(Display*,GLXDrawable,int64_t*,int64_t*,int64_t*);
+typedef void (*PFNGLXSELECTEVENTPROC)(Display*,GLXDrawable,unsigned long);
+
+/* GLX_INTEL_swap_event */
+typedef struct {
+    int type;
+    unsigned long serial;
+    Bool send_event;
+    Display* display;
+    GLXDrawable drawable;
+    int event_type;
+    int64_t ust;
+    int64_t msc;
+    int64_t sbc;
+} GLXBufferSwapComplete;
+#endif // _SAPP_GLX
 
 typedef struct {
     bool available;
@@ -2391,6 +3165,38 @@ typedef struct {
     Atom text_uri_list;
 } _sapp_xdnd_t;
 
+/* lock-free single-producer/single-consumer queue, head and tail
+   are free-running counters on separate cache lines
+*/
+typedef struct {
+    uint8_t* items;
+    size_t item_size;
+    uint32_t capacity;      /* must be a power of two */
+    __attribute__((aligned(64))) uint32_t head;     /* only written by the consumer */
+    __attribute__((aligned(64))) uint32_t tail;     /* only written by the producer */
+} __attribute__((aligned(64))) _sapp_x11_queue_t;
+
+/* render thread mode (sapp_desc.render_thread) */
+typedef struct {
+    bool active;
+    bool done;              /* set by the render thread when it has finished */
+    pthread_t thread;
+    int wake_fd;            /* signalled by the render thread to wake up the X11 event loop */
+    int space_fd;           /* signalled by the render thread when the X11 thread waits for a free queue slot */
+    bool producer_waiting;  /* set by the X11 thread while it waits on space_fd */
+    bool move_held;         /* set by the X11 thread while a mouse move is held back because the event queue was full */
+    sapp_event held_move;   /* only accessed by the X11 thread */
+    int window_width;       /* the X11 thread's copy of the main window size */
+    int window_height;
+    uint32_t requests;      /* _SAPP_X11_REQ_*, set by the render thread, cleared by the X11 thread */
+    uint32_t state;         /* _SAPP_X11_STATE_*, only written by the X11 thread */
+    bool drop_pending;      /* the X11 thread doesn't touch _sapp.drop until the render thread has copied it */
+    int drop_num_files;     /* the render thread's copy of the dropped files */
+    char* drop_buffer;
+    _sapp_x11_queue_t queue;            /* sapp_event */
+    _sapp_x11_queue_t sample_queue;     /* sapp_mouse_sample */
+} _sapp_x11_render_thread_t;
+
 typedef struct {
     uint8_t mouse_buttons;
     Display* display;
@@ -2398,6 +3204,10 @@ typedef struct {
     Window root;
     Colormap colormap;
     Window window;
+    Visual* visual;
+    int depth;
+    Window windows[SAPP_MAX_WINDOWS];   // additional windows, slot 0 is unused
+    Window mouse_window;
     Cursor hidden_cursor;
     int window_state;
     float dpi;
@@ -2413,8 +3223,19 @@ typedef struct {
     Atom NET_WM_STATE_FULLSCREEN;
     _sapp_xi_t xi;
     _sapp_xdnd_t xdnd;
+    int frame_event_fd;     /* render-on-demand: signalled by sapp_request_frame() */
+    int frame_timer_fd;     /* render-on-demand: optional frame timer */
+    _sapp_x11_render_thread_t rt;
+    sapp_event pending_move;    /* sapp_desc.coalesce_mouse_moves: the not yet sent mouse move */
+    bool pending_move_valid;
+    bool resize_pending;        /* a RESIZED event of the main window is sent before the next frame */
+    bool resize_settle_pending; /* sapp_desc.resize_settle_ms: a RESIZE_SETTLED event is pending */
+    int resized_width;          /* the main window size in the last RESIZED event */
+    int resized_height;
+    double resize_time;         /* time of the last RESIZED event in seconds */
 } _sapp_x11_t;
 
+#if defined(_SAPP_GLX)
 typedef struct {
     void* libgl;
     int major;
@@ -2423,6 +3244,7 @@ typedef struct {
     int error_base;
     GLXContext ctx;
     GLXWindow window;
+    GLXWindow windows[SAPP_MAX_WINDOWS];    // additional windows, slot 0 is unused
 
     // GLX 1.3 functions
     PFNGLXGETFBCONFIGSPROC GetFBConfigs;
@@ -2444,6 +3266,8 @@ typedef struct {
     PFNGLXSWAPINTERVALEXTPROC SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC SwapIntervalMESA;
     PFNGLXCREATECONTEXTATTRIBSARBPROC CreateContextAttribsARB;
+    PFNGLXGETSYNCVALUESOMLPROC GetSyncValuesOML;
+    PFNGLXSELECTEVENTPROC SelectEvent;
 
     // extension availability
     bool EXT_swap_control;
@@ -2451,8 +3275,30 @@ typedef struct {
     bool ARB_multisample;
     bool ARB_create_context;
     bool ARB_create_context_profile;
+    bool EXT_swap_control_tear;
+    bool OML_sync_control;
+    bool INTEL_swap_event;
+
+    // sapp_desc.present_timing: where the present timestamps come from
+    bool use_sync_values;
+    bool use_swap_event;
 } _sapp_glx_t;
 
+#else
+
+typedef struct {
+    EGLDisplay display;
+    EGLConfig config;
+    EGLContext context;
+    EGLSurface surface;
+    EGLSurface surfaces[SAPP_MAX_WINDOWS];  // additional windows, slot 0 is unused
+    bool EXT_buffer_age;
+    PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC SwapBuffersWithDamage;   // KHR or EXT variant, may be null
+    bool has_damage;
+    int damage_x0, damage_y0, damage_x1, damage_y1;             // damage rect in framebuffer pixels, origin top-left
+} _sapp_egl_t;
+#endif
+
 #endif // _SAPP_LINUX
 
 /*== COMMON DECLARATIONS =====================================================*/
@@ -2460,6 +3306,8 @@ typedef struct {
 /* helper macros */
 #define _sapp_def(val, def) (((val) == 0) ? (def) : (val))
 #define _sapp_absf(a) (((a)<0.0f)?-(a):(a))
+#define _sapp_min(a,b) (((a)<(b))?(a):(b))
+#define _sapp_max(a,b) (((a)>(b))?(a):(b))
 
 #define _SAPP_MAX_TITLE_LENGTH (128)
 #define _SAPP_FALLBACK_DEFAULT_WINDOW_WIDTH (640)
@@ -2469,6 +3317,10 @@ typedef struct {
 #define _SAPP_PIXELFORMAT_BGRA8 (27)
 #define _SAPP_PIXELFORMAT_DEPTH (41)
 #define _SAPP_PIXELFORMAT_DEPTH_STENCIL (42)
+/* window handles: slot index in the lower 16 bits, generation counter in the upper bits */
+#define _SAPP_WINDOW_SLOT_SHIFT (16)
+#define _SAPP_WINDOW_SLOT_MASK ((1<<_SAPP_WINDOW_SLOT_SHIFT)-1)
+#define _SAPP_MAIN_WINDOW_ID ((1<<_SAPP_WINDOW_SLOT_SHIFT)|0)
 
 #if defined(_SAPP_MACOS) || defined(_SAPP_IOS)
     // this is ARC compatible
@@ -2496,14 +3348,48 @@ typedef struct {
     char* buffer;
 } _sapp_drop_t;
 
+/* ring buffer of mouse samples recorded since the last frame */
+typedef struct {
+    sapp_mouse_sample* samples;
+    int size;
+    int start;
+    int num;
+} _sapp_mouse_history_t;
+
 typedef struct {
     float x, y;
     float dx, dy;
     bool shown;
     bool locked;
     bool pos_valid;
+    _sapp_mouse_history_t history;
 } _sapp_mouse_t;
 
+/* slot 0 is always the main window, additional windows live in the remaining slots */
+typedef struct {
+    uint32_t id;        // 0 if the slot is free
+    int width;
+    int height;
+} _sapp_window_t;
+
+typedef struct {
+    bool enabled;
+    double tick_duration;
+    double max_accum;
+    double accum;
+    double alpha;
+    uint64_t tick_count;
+} _sapp_fixed_update_t;
+
+#if defined(_SAPP_LINUX)
+typedef struct {
+    FILE* record_file;
+    FILE* replay_file;
+    bool replaying_event;       // true while a replayed event is dispatched
+    double frame_duration;      // the recorded frame duration of the current replayed frame
+} _sapp_input_log_t;
+#endif
+
 typedef struct {
     sapp_desc desc;
     bool valid;
@@ -2523,15 +3409,23 @@ typedef struct {
     int framebuffer_height;
     int sample_count;
     int swap_interval;
+    bool adaptive_vsync;
     float dpi_scale;
     uint64_t frame_count;
     _sapp_timing_t timing;
+    _sapp_fixed_update_t fixed_update;
+    #if defined(_SAPP_LINUX)
+        _sapp_input_log_t input_log;
+    #endif
     sapp_event event;
     _sapp_mouse_t mouse;
     _sapp_clipboard_t clipboard;
     _sapp_drop_t drop;
     sapp_icon_desc default_icon_desc;
     uint32_t* default_icon_pixels;
+    _sapp_window_t windows[SAPP_MAX_WINDOWS];
+    uint32_t window_gen;
+    sapp_window event_window;
     #if defined(_SAPP_MACOS)
         _sapp_macos_t macos;
     #elif defined(_SAPP_IOS)
@@ -2554,7 +3448,11 @@ typedef struct {
         _sapp_android_t android;
     #elif defined(_SAPP_LINUX)
         _sapp_x11_t x11;
-        _sapp_glx_t glx;
+        #if defined(_SAPP_GLX)
+            _sapp_glx_t glx;
+        #else
+            _sapp_egl_t egl;
+        #endif
     #endif
     char html5_canvas_selector[_SAPP_MAX_TITLE_LENGTH];
     char window_title[_SAPP_MAX_TITLE_LENGTH];      /* UTF-8 */
@@ -2598,6 +3496,15 @@ _SOKOL_PRIVATE void _sapp_call_frame(void) {
     }
 }
 
+_SOKOL_PRIVATE void _sapp_call_fixed_update(void) {
+    if (_sapp.desc.fixed_update_cb) {
+        _sapp.desc.fixed_update_cb();
+    }
+    else if (_sapp.desc.fixed_update_userdata_cb) {
+        _sapp.desc.fixed_update_userdata_cb(_sapp.desc.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sapp_call_cleanup(void) {
     if (!_sapp.cleanup_called) {
         if (_sapp.desc.cleanup_cb) {
@@ -2610,7 +3517,200 @@ _SOKOL_PRIVATE void _sapp_call_cleanup(void) {
     }
 }
 
+#if defined(_SAPP_LINUX)
+/* input log file format (in native byte order, so logs can't be exchanged
+   between little- and big-endian machines):
+
+    header: "SAPPINP" followed by the version byte
+    frame record: 'F', float64 frame duration
+    event record: 'E', uint8 type, uint32 window id, uint16 key code,
+                  uint32 char code, uint8 key repeat, uint32 modifiers,
+                  uint8 mouse button, 6x float32 mouse x/y/dx/dy and scroll x/y,
+                  4x int32 window and framebuffer size, uint8 num touches,
+                  and for each touch: uint64 identifier, 2x float32 pos, uint8 changed
+*/
+#define _SAPP_INPUT_LOG_VERSION (1)
+#define _SAPP_INPUT_LOG_FRAME ('F')
+#define _SAPP_INPUT_LOG_EVENT ('E')
+#define _SAPP_INPUT_LOG_MAX_RECORD_SIZE (64 + SAPP_MAX_TOUCHPOINTS * 17)
+
+_SOKOL_PRIVATE void _sapp_input_log_put(uint8_t* buf, int* pos, const void* ptr, int size) {
+    SOKOL_ASSERT((*pos + size) <= _SAPP_INPUT_LOG_MAX_RECORD_SIZE);
+    memcpy(&buf[*pos], ptr, (size_t)size);
+    *pos += size;
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_get(const uint8_t* buf, int* pos, void* ptr, int size) {
+    SOKOL_ASSERT((*pos + size) <= _SAPP_INPUT_LOG_MAX_RECORD_SIZE);
+    memcpy(ptr, &buf[*pos], (size_t)size);
+    *pos += size;
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_write(const uint8_t* buf, int size) {
+    SOKOL_ASSERT(_sapp.input_log.record_file);
+    if (fwrite(buf, (size_t)size, 1, _sapp.input_log.record_file) != 1) {
+        SOKOL_LOG("sokol_app.h: failed to write input log, recording stopped\n");
+        fclose(_sapp.input_log.record_file);
+        _sapp.input_log.record_file = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_record_event(const sapp_event* e) {
+    uint8_t buf[_SAPP_INPUT_LOG_MAX_RECORD_SIZE];
+    int pos = 0;
+    const uint8_t tag = _SAPP_INPUT_LOG_EVENT;
+    const uint8_t type = (uint8_t) e->type;
+    const uint16_t key_code = (uint16_t) e->key_code;
+    const uint8_t key_repeat = e->key_repeat ? 1 : 0;
+    const uint8_t mouse_button = (uint8_t) e->mouse_button;
+    const float floats[6] = { e->mouse_x, e->mouse_y, e->mouse_dx, e->mouse_dy, e->scroll_x, e->scroll_y };
+    const int32_t sizes[4] = { e->window_width, e->window_height, e->framebuffer_width, e->framebuffer_height };
+    const uint8_t num_touches = (uint8_t) _sapp_min(_sapp_max(e->num_touches, 0), SAPP_MAX_TOUCHPOINTS);
+    _sapp_input_log_put(buf, &pos, &tag, 1);
+    _sapp_input_log_put(buf, &pos, &type, 1);
+    _sapp_input_log_put(buf, &pos, &e->window.id, 4);
+    _sapp_input_log_put(buf, &pos, &key_code, 2);
+    _sapp_input_log_put(buf, &pos, &e->char_code, 4);
+    _sapp_input_log_put(buf, &pos, &key_repeat, 1);
+    _sapp_input_log_put(buf, &pos, &e->modifiers, 4);
+    _sapp_input_log_put(buf, &pos, &mouse_button, 1);
+    _sapp_input_log_put(buf, &pos, floats, (int)sizeof(floats));
+    _sapp_input_log_put(buf, &pos, sizes, (int)sizeof(sizes));
+    _sapp_input_log_put(buf, &pos, &num_touches, 1);
+    for (int i = 0; i < num_touches; i++) {
+        const sapp_touchpoint* tp = &e->touches[i];
+        const uint64_t identifier = (uint64_t) tp->identifier;
+        const uint8_t changed = tp->changed ? 1 : 0;
+        _sapp_input_log_put(buf, &pos, &identifier, 8);
+        _sapp_input_log_put(buf, &pos, &tp->pos_x, 4);
+        _sapp_input_log_put(buf, &pos, &tp->pos_y, 4);
+        _sapp_input_log_put(buf, &pos, &changed, 1);
+    }
+    _sapp_input_log_write(buf, pos);
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_record_frame(double duration) {
+    uint8_t buf[_SAPP_INPUT_LOG_MAX_RECORD_SIZE];
+    int pos = 0;
+    const uint8_t tag = _SAPP_INPUT_LOG_FRAME;
+    _sapp_input_log_put(buf, &pos, &tag, 1);
+    _sapp_input_log_put(buf, &pos, &duration, 8);
+    _sapp_input_log_write(buf, pos);
+}
+
+/* read an event record (without the tag byte), returns false on a truncated log */
+_SOKOL_PRIVATE bool _sapp_input_log_read_event(sapp_event* e) {
+    uint8_t buf[_SAPP_INPUT_LOG_MAX_RECORD_SIZE];
+    FILE* fp = _sapp.input_log.replay_file;
+    /* fixed-size part up to and including the number of touches */
+    const int fixed_size = 1 + 4 + 2 + 4 + 1 + 4 + 1 + 6*4 + 4*4 + 1;
+    if (fread(buf, (size_t)fixed_size, 1, fp) != 1) {
+        return false;
+    }
+    int pos = 0;
+    uint8_t type, key_repeat, mouse_button, num_touches;
+    uint16_t key_code;
+    float floats[6];
+    int32_t sizes[4];
+    _SAPP_CLEAR(sapp_event, *e);
+    _sapp_input_log_get(buf, &pos, &type, 1);
+    _sapp_input_log_get(buf, &pos, &e->window.id, 4);
+    _sapp_input_log_get(buf, &pos, &key_code, 2);
+    _sapp_input_log_get(buf, &pos, &e->char_code, 4);
+    _sapp_input_log_get(buf, &pos, &key_repeat, 1);
+    _sapp_input_log_get(buf, &pos, &e->modifiers, 4);
+    _sapp_input_log_get(buf, &pos, &mouse_button, 1);
+    _sapp_input_log_get(buf, &pos, floats, (int)sizeof(floats));
+    _sapp_input_log_get(buf, &pos, sizes, (int)sizeof(sizes));
+    _sapp_input_log_get(buf, &pos, &num_touches, 1);
+    if ((type >= _SAPP_EVENTTYPE_NUM) || (num_touches > SAPP_MAX_TOUCHPOINTS)) {
+        return false;
+    }
+    if ((num_touches > 0) && (fread(&buf[pos], (size_t)(num_touches * 17), 1, fp) != 1)) {
+        return false;
+    }
+    e->frame_count = _sapp.frame_count;
+    e->type = (sapp_event_type) type;
+    e->key_code = (sapp_keycode) key_code;
+    e->key_repeat = 0 != key_repeat;
+    e->mouse_button = (sapp_mousebutton) mouse_button;
+    e->mouse_x = floats[0];
+    e->mouse_y = floats[1];
+    e->mouse_dx = floats[2];
+    e->mouse_dy = floats[3];
+    e->scroll_x = floats[4];
+    e->scroll_y = floats[5];
+    e->window_width = sizes[0];
+    e->window_height = sizes[1];
+    e->framebuffer_width = sizes[2];
+    e->framebuffer_height = sizes[3];
+    e->num_touches = num_touches;
+    for (int i = 0; i < num_touches; i++) {
+        sapp_touchpoint* tp = &e->touches[i];
+        uint64_t identifier;
+        uint8_t changed;
+        _sapp_input_log_get(buf, &pos, &identifier, 8);
+        _sapp_input_log_get(buf, &pos, &tp->pos_x, 4);
+        _sapp_input_log_get(buf, &pos, &tp->pos_y, 4);
+        _sapp_input_log_get(buf, &pos, &changed, 1);
+        tp->identifier = (uintptr_t) identifier;
+        tp->changed = 0 != changed;
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_init(void) {
+    SOKOL_ASSERT(!(_sapp.desc.input_record_path && _sapp.desc.input_replay_path));
+    static const uint8_t header[8] = { 'S', 'A', 'P', 'P', 'I', 'N', 'P', _SAPP_INPUT_LOG_VERSION };
+    if (_sapp.desc.input_record_path) {
+        _sapp.input_log.record_file = fopen(_sapp.desc.input_record_path, "wb");
+        if (0 == _sapp.input_log.record_file) {
+            _sapp_fail("sokol_app.h: failed to create input log file for recording!\n");
+        }
+        _sapp_input_log_write(header, (int)sizeof(header));
+    }
+    else if (_sapp.desc.input_replay_path) {
+        _sapp.input_log.replay_file = fopen(_sapp.desc.input_replay_path, "rb");
+        if (0 == _sapp.input_log.replay_file) {
+            _sapp_fail("sokol_app.h: failed to open input log file for replay!\n");
+        }
+        uint8_t file_header[8];
+        if ((fread(file_header, sizeof(file_header), 1, _sapp.input_log.replay_file) != 1) ||
+            (0 != memcmp(header, file_header, sizeof(header))))
+        {
+            _sapp_fail("sokol_app.h: not a valid input log file, or version mismatch!\n");
+        }
+        /* replayed frames must not wait for input, and may run unthrottled */
+        _sapp.desc.render_on_demand = false;
+        if (_sapp.desc.input_replay_unthrottled) {
+            _sapp.swap_interval = 0;
+            _sapp.desc.headless_frame_rate = 0;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_input_log_discard(void) {
+    if (_sapp.input_log.record_file) {
+        fclose(_sapp.input_log.record_file);
+        _sapp.input_log.record_file = 0;
+    }
+    if (_sapp.input_log.replay_file) {
+        fclose(_sapp.input_log.replay_file);
+        _sapp.input_log.replay_file = 0;
+    }
+}
+#endif // _SAPP_LINUX
+
 _SOKOL_PRIVATE bool _sapp_call_event(const sapp_event* e) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.input_log.replay_file && !_sapp.input_log.replaying_event) {
+        /* live input is ignored during replay */
+        return false;
+    }
+    if (_sapp.input_log.record_file && _sapp.init_called && !_sapp.cleanup_called) {
+        _sapp_input_log_record_event(e);
+    }
+    #endif
     if (!_sapp.cleanup_called) {
         if (_sapp.desc.event_cb) {
             _sapp.desc.event_cb(e);
@@ -2675,6 +3775,10 @@ _SOKOL_PRIVATE sapp_desc _sapp_desc_defaults(const sapp_desc* in_desc) {
     desc.max_dropped_files = _sapp_def(desc.max_dropped_files, 1);
     desc.max_dropped_file_path_length = _sapp_def(desc.max_dropped_file_path_length, 2048);
     desc.window_title = _sapp_def(desc.window_title, "sokol_app");
+    desc.frame_stats_window = _sapp_def(desc.frame_stats_window, 256);
+    desc.frame_stats_bin_width = _sapp_def(desc.frame_stats_bin_width, 0.001);
+    desc.fixed_update_rate = _sapp_def(desc.fixed_update_rate, 60);
+    desc.fixed_update_max_ticks = _sapp_def(desc.fixed_update_max_ticks, 8);
     return desc;
 }
 
@@ -2687,8 +3791,20 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     SOKOL_ASSERT(desc->clipboard_size >= 0);
     SOKOL_ASSERT(desc->max_dropped_files >= 0);
     SOKOL_ASSERT(desc->max_dropped_file_path_length >= 0);
+    SOKOL_ASSERT(desc->headless_max_frames >= 0);
+    SOKOL_ASSERT(desc->headless_frame_rate >= 0);
+    SOKOL_ASSERT(desc->mouse_history_size >= 0);
+    SOKOL_ASSERT(desc->frame_stats_window >= 0);
+    SOKOL_ASSERT(desc->frame_stats_bin_width >= 0.0);
+    SOKOL_ASSERT(desc->fixed_update_rate >= 0);
+    SOKOL_ASSERT(desc->fixed_update_max_ticks >= 0);
     _SAPP_CLEAR(_sapp_t, _sapp);
     _sapp.desc = _sapp_desc_defaults(desc);
+    #if !defined(_SAPP_EGL)
+    if (_sapp.desc.headless) {
+        _sapp_fail("sapp_desc.headless is only supported on Linux with SOKOL_FORCE_EGL!\n");
+    }
+    #endif
     _sapp.first_frame = true;
     // NOTE: _sapp.desc.width/height may be 0! Platform backends need to deal with this
     _sapp.window_width = _sapp.desc.width;
@@ -2697,6 +3813,7 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     _sapp.framebuffer_height = _sapp.window_height;
     _sapp.sample_count = _sapp.desc.sample_count;
     _sapp.swap_interval = _sapp.desc.swap_interval;
+    _sapp.adaptive_vsync = _sapp.desc.adaptive_vsync;
     _sapp.html5_canvas_selector[0] = '#';
     _sapp_strcpy(_sapp.desc.html5_canvas_name, &_sapp.html5_canvas_selector[1], sizeof(_sapp.html5_canvas_selector) - 1);
     _sapp.desc.html5_canvas_name = &_sapp.html5_canvas_selector[1];
@@ -2718,7 +3835,21 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     _sapp.dpi_scale = 1.0f;
     _sapp.fullscreen = _sapp.desc.fullscreen;
     _sapp.mouse.shown = true;
+    if (_sapp.desc.mouse_history_size > 0) {
+        _sapp.mouse.history.size = _sapp.desc.mouse_history_size;
+        _sapp.mouse.history.samples = (sapp_mouse_sample*) SOKOL_CALLOC((size_t)_sapp.mouse.history.size, sizeof(sapp_mouse_sample));
+    }
+    _sapp.fixed_update.enabled = (0 != _sapp.desc.fixed_update_cb) || (0 != _sapp.desc.fixed_update_userdata_cb);
+    _sapp.fixed_update.tick_duration = 1.0 / (double)_sapp.desc.fixed_update_rate;
+    _sapp.fixed_update.max_accum = _sapp.fixed_update.tick_duration * (double)_sapp.desc.fixed_update_max_ticks;
+    #if defined(_SAPP_LINUX)
+    _sapp_input_log_init();
+    #endif
+    _sapp.windows[0].id = _SAPP_MAIN_WINDOW_ID;
+    _sapp.window_gen = 1;
+    _sapp.event_window.id = _SAPP_MAIN_WINDOW_ID;
     _sapp_timing_init(&_sapp.timing);
+    _sapp_frame_stats_init(&_sapp.timing.stats, _sapp.desc.frame_stats_window);
 }
 
 _SOKOL_PRIVATE void _sapp_discard_state(void) {
@@ -2733,9 +3864,49 @@ _SOKOL_PRIVATE void _sapp_discard_state(void) {
     if (_sapp.default_icon_pixels) {
         SOKOL_FREE((void*)_sapp.default_icon_pixels);
     }
+    if (_sapp.mouse.history.samples) {
+        SOKOL_FREE((void*)_sapp.mouse.history.samples);
+    }
+    _sapp_frame_stats_discard(&_sapp.timing.stats);
+    #if defined(_SAPP_LINUX)
+    _sapp_input_log_discard();
+    #endif
     _SAPP_CLEAR(_sapp_t, _sapp);
 }
 
+_SOKOL_PRIVATE int _sapp_window_slot(uint32_t id) {
+    return (int)(id & _SAPP_WINDOW_SLOT_MASK);
+}
+
+_SOKOL_PRIVATE _sapp_window_t* _sapp_lookup_window(uint32_t id) {
+    if (0 != id) {
+        const int slot = _sapp_window_slot(id);
+        if ((slot < SAPP_MAX_WINDOWS) && (_sapp.windows[slot].id == id)) {
+            return &_sapp.windows[slot];
+        }
+    }
+    return 0;
+}
+
+/* returns the slot index of a new additional window, or 0 if all slots are in use */
+_SOKOL_PRIVATE int _sapp_alloc_window(void) {
+    for (int slot = 1; slot < SAPP_MAX_WINDOWS; slot++) {
+        if (0 == _sapp.windows[slot].id) {
+            if (++_sapp.window_gen > (0xFFFFFFFF >> _SAPP_WINDOW_SLOT_SHIFT)) {
+                _sapp.window_gen = 2;
+            }
+            _sapp.windows[slot].id = (_sapp.window_gen << _SAPP_WINDOW_SLOT_SHIFT) | (uint32_t)slot;
+            return slot;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sapp_free_window(int slot) {
+    SOKOL_ASSERT((slot > 0) && (slot < SAPP_MAX_WINDOWS));
+    _SAPP_CLEAR(_sapp_window_t, _sapp.windows[slot]);
+}
+
 _SOKOL_PRIVATE void _sapp_init_event(sapp_event_type type) {
     memset(&_sapp.event, 0, sizeof(_sapp.event));
     _sapp.event.type = type;
@@ -2749,6 +3920,16 @@ _SOKOL_PRIVATE void _sapp_init_event(sapp_event_type type) {
     _sapp.event.mouse_y = _sapp.mouse.y;
     _sapp.event.mouse_dx = _sapp.mouse.dx;
     _sapp.event.mouse_dy = _sapp.mouse.dy;
+    _sapp.event.window = _sapp.event_window;
+    if (_sapp.event_window.id != _SAPP_MAIN_WINDOW_ID) {
+        const _sapp_window_t* win = _sapp_lookup_window(_sapp.event_window.id);
+        if (win) {
+            _sapp.event.window_width = win->width;
+            _sapp.event.window_height = win->height;
+            _sapp.event.framebuffer_width = win->width;
+            _sapp.event.framebuffer_height = win->height;
+        }
+    }
 }
 
 _SOKOL_PRIVATE bool _sapp_events_enabled(void) {
@@ -2772,13 +3953,111 @@ _SOKOL_PRIVATE void _sapp_clear_drop_buffer(void) {
     }
 }
 
+/* record a mouse sample for sapp_get_mouse_sample(), overwrites the oldest sample when full */
+_SOKOL_PRIVATE void _sapp_add_mouse_sample(const sapp_mouse_sample* smp) {
+    _sapp_mouse_history_t* h = &_sapp.mouse.history;
+    if (0 == h->size) {
+        return;
+    }
+    if (h->num < h->size) {
+        h->samples[(h->start + h->num) % h->size] = *smp;
+        h->num++;
+    }
+    else {
+        h->samples[h->start] = *smp;
+        h->start = (h->start + 1) % h->size;
+    }
+}
+
+#if defined(_SAPP_LINUX)
+/* dispatch the recorded events up to the next frame record, returns
+   false (and orders the application to quit) at the end of the log
+*/
+_SOKOL_PRIVATE bool _sapp_input_log_replay_frame(void) {
+    FILE* fp = _sapp.input_log.replay_file;
+    SOKOL_ASSERT(fp);
+    while (true) {
+        uint8_t tag;
+        if (fread(&tag, 1, 1, fp) != 1) {
+            break;
+        }
+        if (_SAPP_INPUT_LOG_FRAME == tag) {
+            double duration;
+            if (fread(&duration, sizeof(duration), 1, fp) != 1) {
+                break;
+            }
+            _sapp.input_log.frame_duration = duration;
+            return true;
+        }
+        else if (_SAPP_INPUT_LOG_EVENT == tag) {
+            sapp_event e;
+            if (!_sapp_input_log_read_event(&e)) {
+                break;
+            }
+            _sapp.input_log.replaying_event = true;
+            _sapp_call_event(&e);
+            _sapp.input_log.replaying_event = false;
+        }
+        else {
+            SOKOL_LOG("sokol_app.h: corrupt input log, replay stopped\n");
+            break;
+        }
+    }
+    _sapp.quit_ordered = true;
+    return false;
+}
+#endif
+
+/* the frame duration seen by the application, during input replay this is the recorded duration */
+_SOKOL_PRIVATE double _sapp_frame_duration(void) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.input_log.replay_file) {
+        return _sapp.input_log.frame_duration;
+    }
+    #endif
+    return _sapp_timing_get_avg(&_sapp.timing);
+}
+
+/* advance the fixed-update accumulator by the smoothed frame duration and
+   call the fixed update callback for each complete tick, the accumulator
+   is clamped so that a slow fixed update can't cause more and more ticks
+   per frame
+*/
+_SOKOL_PRIVATE void _sapp_fixed_update(void) {
+    _sapp_fixed_update_t* fu = &_sapp.fixed_update;
+    if (!fu->enabled || !_sapp.init_called || _sapp.cleanup_called) {
+        return;
+    }
+    fu->accum += _sapp_frame_duration();
+    if (fu->accum > fu->max_accum) {
+        fu->accum = fu->max_accum;
+    }
+    while (fu->accum >= fu->tick_duration) {
+        _sapp_call_fixed_update();
+        fu->accum -= fu->tick_duration;
+        fu->tick_count++;
+    }
+    fu->alpha = fu->accum / fu->tick_duration;
+}
+
 _SOKOL_PRIVATE void _sapp_frame(void) {
     if (_sapp.first_frame) {
         _sapp.first_frame = false;
         _sapp_call_init();
     }
+    #if defined(_SAPP_LINUX)
+    if (_sapp.input_log.replay_file && !_sapp_input_log_replay_frame()) {
+        return;
+    }
+    if (_sapp.input_log.record_file) {
+        _sapp_input_log_record_frame(_sapp_frame_duration());
+    }
+    #endif
+    _sapp_fixed_update();
     _sapp_call_frame();
     _sapp.frame_count++;
+    _sapp.mouse.history.start = 0;
+    _sapp.mouse.history.num = 0;
 }
 
 _SOKOL_PRIVATE bool _sapp_image_validate(const sapp_image_desc* desc) {
@@ -9838,6 +11117,7 @@ _SOKOL_PRIVATE void _sapp_x11_query_system_dpi(void) {
     }
 }
 
+/* also used for EGL extension strings */
 _SOKOL_PRIVATE bool _sapp_glx_has_ext(const char* ext, const char* extensions) {
     SOKOL_ASSERT(ext);
     const char* start = extensions;
@@ -9866,6 +11146,7 @@ _SOKOL_PRIVATE bool _sapp_glx_extsupported(const char* ext, const char* extensio
     }
 }
 
+#if defined(_SAPP_GLX)
 _SOKOL_PRIVATE void* _sapp_glx_getprocaddr(const char* procname)
 {
     if (_sapp.glx.GetProcAddress) {
@@ -9940,12 +11221,22 @@ _SOKOL_PRIVATE void _sapp_glx_init() {
         _sapp.glx.SwapIntervalMESA = (PFNGLXSWAPINTERVALMESAPROC) _sapp_glx_getprocaddr("glXSwapIntervalMESA");
         _sapp.glx.MESA_swap_control = 0 != _sapp.glx.SwapIntervalMESA;
     }
+    /* negative swap intervals for glXSwapIntervalEXT() */
+    _sapp.glx.EXT_swap_control_tear = _sapp.glx.EXT_swap_control && _sapp_glx_extsupported("GLX_EXT_swap_control_tear", exts);
     _sapp.glx.ARB_multisample = _sapp_glx_extsupported("GLX_ARB_multisample", exts);
     if (_sapp_glx_extsupported("GLX_ARB_create_context", exts)) {
         _sapp.glx.CreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC) _sapp_glx_getprocaddr("glXCreateContextAttribsARB");
         _sapp.glx.ARB_create_context = 0 != _sapp.glx.CreateContextAttribsARB;
     }
     _sapp.glx.ARB_create_context_profile = _sapp_glx_extsupported("GLX_ARB_create_context_profile", exts);
+    if (_sapp_glx_extsupported("GLX_OML_sync_control", exts)) {
+        _sapp.glx.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC) _sapp_glx_getprocaddr("glXGetSyncValuesOML");
+        _sapp.glx.OML_sync_control = 0 != _sapp.glx.GetSyncValuesOML;
+    }
+    if (_sapp_glx_extsupported("GLX_INTEL_swap_event", exts)) {
+        _sapp.glx.SelectEvent = (PFNGLXSELECTEVENTPROC) dlsym(_sapp.glx.libgl, "glXSelectEvent");
+        _sapp.glx.INTEL_swap_event = 0 != _sapp.glx.SelectEvent;
+    }
 }
 
 _SOKOL_PRIVATE int _sapp_glx_attrib(GLXFBConfig fbconfig, int attrib) {
@@ -10066,6 +11357,19 @@ _SOKOL_PRIVATE void _sapp_glx_create_context(void) {
     if (!_sapp.glx.window) {
         _sapp_fail("GLX: failed to create window");
     }
+    /* present timestamps: GLX_OML_sync_control is polled after each swap on
+       the rendering thread, GLX_INTEL_swap_event arrives as X11 event and is
+       only used without a render thread (since it's received on the X11 thread)
+    */
+    if (_sapp.desc.present_timing) {
+        if (_sapp.glx.OML_sync_control) {
+            _sapp.glx.use_sync_values = true;
+        }
+        else if (_sapp.glx.INTEL_swap_event && !_sapp.x11.rt.active) {
+            _sapp.glx.SelectEvent(_sapp.x11.display, _sapp.glx.window, GLX_BUFFER_SWAP_COMPLETE_INTEL_MASK);
+            _sapp.glx.use_swap_event = true;
+        }
+    }
 }
 
 _SOKOL_PRIVATE void _sapp_glx_destroy_context(void) {
@@ -10083,13 +11387,37 @@ _SOKOL_PRIVATE void _sapp_glx_make_current(void) {
     _sapp.glx.MakeCurrent(_sapp.x11.display, _sapp.glx.window, _sapp.glx.ctx);
 }
 
+_SOKOL_PRIVATE void _sapp_glx_release_current(void) {
+    _sapp.glx.MakeCurrent(_sapp.x11.display, None, NULL);
+}
+
 _SOKOL_PRIVATE void _sapp_glx_swap_buffers(void) {
     _sapp.glx.SwapBuffers(_sapp.x11.display, _sapp.glx.window);
+    if (_sapp.glx.use_sync_values) {
+        /* this reports the most recently completed swap, which usually
+           lags behind the swap which has just been queued
+        */
+        int64_t ust = 0, msc = 0, sbc = 0;
+        if (_sapp.glx.GetSyncValuesOML(_sapp.x11.display, _sapp.glx.window, &ust, &msc, &sbc)) {
+            _sapp_frame_stats_present(&_sapp.timing.stats, ust, msc, sbc, _sapp.swap_interval);
+        }
+    }
+}
+
+_SOKOL_PRIVATE bool _sapp_glx_adaptive_vsync(void) {
+    return _sapp.adaptive_vsync && _sapp.glx.EXT_swap_control_tear;
 }
 
 _SOKOL_PRIVATE void _sapp_glx_swapinterval(int interval) {
     _sapp_glx_make_current();
     if (_sapp.glx.EXT_swap_control) {
+        /* GLX_EXT_swap_control_tear: with a negative interval, a swap which
+           missed its vblank happens immediately (and may tear) instead of
+           waiting for the next vblank
+        */
+        if (_sapp_glx_adaptive_vsync() && (interval > 0)) {
+            interval = -interval;
+        }
         _sapp.glx.SwapIntervalEXT(_sapp.x11.display, _sapp.glx.window, interval);
     }
     else if (_sapp.glx.MESA_swap_control) {
@@ -10097,6 +11425,323 @@ _SOKOL_PRIVATE void _sapp_glx_swapinterval(int interval) {
     }
 }
 
+_SOKOL_PRIVATE bool _sapp_glx_create_extra_window(int slot) {
+    GLXFBConfig native = _sapp_glx_choosefbconfig();
+    if (0 == native) {
+        return false;
+    }
+    _sapp.glx.windows[slot] = _sapp.glx.CreateWindow(_sapp.x11.display, native, _sapp.x11.windows[slot], NULL);
+    if (!_sapp.glx.windows[slot]) {
+        return false;
+    }
+    /* only the main window waits for vsync */
+    if (_sapp.glx.EXT_swap_control) {
+        _sapp.glx.SwapIntervalEXT(_sapp.x11.display, _sapp.glx.windows[slot], 0);
+    }
+    else if (_sapp.glx.MESA_swap_control) {
+        _sapp.glx.MakeCurrent(_sapp.x11.display, _sapp.glx.windows[slot], _sapp.glx.ctx);
+        _sapp.glx.SwapIntervalMESA(0);
+        _sapp_glx_make_current();
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE void _sapp_glx_destroy_extra_window(int slot) {
+    if (_sapp.glx.windows[slot]) {
+        /* never leave a destroyed drawable current */
+        _sapp_glx_make_current();
+        _sapp.glx.DestroyWindow(_sapp.x11.display, _sapp.glx.windows[slot]);
+        _sapp.glx.windows[slot] = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_glx_make_current_extra(int slot) {
+    SOKOL_ASSERT(_sapp.glx.windows[slot]);
+    _sapp.glx.MakeCurrent(_sapp.x11.display, _sapp.glx.windows[slot], _sapp.glx.ctx);
+}
+
+_SOKOL_PRIVATE void _sapp_glx_swap_extra_buffers(void) {
+    for (int slot = 1; slot < SAPP_MAX_WINDOWS; slot++) {
+        if (_sapp.glx.windows[slot]) {
+            _sapp.glx.SwapBuffers(_sapp.x11.display, _sapp.glx.windows[slot]);
+        }
+    }
+}
+#endif // _SAPP_GLX
+
+#if defined(_SAPP_EGL)
+_SOKOL_PRIVATE void _sapp_egl_init_display(void) {
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        _sapp_fail("EGL: eglGetDisplay() failed");
+    }
+    EGLint major, minor;
+    if (!eglInitialize(_sapp.egl.display, &major, &minor)) {
+        _sapp_fail("EGL: eglInitialize() failed");
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        _sapp_fail("EGL: OpenGL API not supported");
+    }
+    const char* exts = eglQueryString(_sapp.egl.display, EGL_EXTENSIONS);
+    if (!_sapp_glx_extsupported("EGL_KHR_create_context", exts) && ((major == 1) && (minor < 5))) {
+        _sapp_fail("EGL: EGL 1.5 or EGL_KHR_create_context required");
+    }
+    _sapp.egl.EXT_buffer_age = _sapp_glx_extsupported("EGL_EXT_buffer_age", exts);
+    if (_sapp_glx_extsupported("EGL_KHR_swap_buffers_with_damage", exts)) {
+        _sapp.egl.SwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC) eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    }
+    else if (_sapp_glx_extsupported("EGL_EXT_swap_buffers_with_damage", exts)) {
+        _sapp.egl.SwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC) eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_egl_init(void) {
+    _sapp.egl.display = eglGetDisplay((EGLNativeDisplayType)_sapp.x11.display);
+    _sapp_egl_init_display();
+}
+
+/* headless mode: prefer Mesa's surfaceless platform which doesn't need an
+   X server, otherwise fall back to the default display
+*/
+_SOKOL_PRIVATE void _sapp_egl_init_headless(void) {
+    _sapp.egl.display = EGL_NO_DISPLAY;
+    const char* client_exts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (_sapp_glx_extsupported("EGL_MESA_platform_surfaceless", client_exts)) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (get_platform_display) {
+            _sapp.egl.display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, (void*)EGL_DEFAULT_DISPLAY, NULL);
+        }
+    }
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        _sapp.egl.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    _sapp_egl_init_display();
+}
+
+_SOKOL_PRIVATE EGLint _sapp_egl_attrib(EGLConfig config, EGLint attrib) {
+    EGLint value = 0;
+    eglGetConfigAttrib(_sapp.egl.display, config, attrib, &value);
+    return value;
+}
+
+/* same config selection as _sapp_glx_choosefbconfig(), surface_type is
+   EGL_WINDOW_BIT or EGL_PBUFFER_BIT (for headless mode)
+*/
+_SOKOL_PRIVATE EGLConfig _sapp_egl_choose_config(EGLint surface_type) {
+    const bool is_window = (EGL_WINDOW_BIT == surface_type);
+    EGLint native_count = 0;
+    if (!eglGetConfigs(_sapp.egl.display, NULL, 0, &native_count) || (0 == native_count)) {
+        _sapp_fail("EGL: No EGLConfigs returned");
+    }
+    EGLConfig* native_configs = (EGLConfig*) SOKOL_CALLOC((size_t)native_count, sizeof(EGLConfig));
+    eglGetConfigs(_sapp.egl.display, native_configs, native_count, &native_count);
+    _sapp_gl_fbconfig* usable_configs = (_sapp_gl_fbconfig*) SOKOL_CALLOC((size_t)native_count, sizeof(_sapp_gl_fbconfig));
+    int usable_count = 0;
+    for (int i = 0; i < native_count; i++) {
+        const EGLConfig n = native_configs[i];
+        _sapp_gl_fbconfig* u = usable_configs + usable_count;
+        _sapp_gl_init_fbconfig(u);
+        /* only consider RGB configs which support desktop GL, window configs must have an X11 visual */
+        if (0 == (_sapp_egl_attrib(n, EGL_SURFACE_TYPE) & surface_type)) {
+            continue;
+        }
+        if (0 == (_sapp_egl_attrib(n, EGL_RENDERABLE_TYPE) & EGL_OPENGL_BIT)) {
+            continue;
+        }
+        if (EGL_RGB_BUFFER != _sapp_egl_attrib(n, EGL_COLOR_BUFFER_TYPE)) {
+            continue;
+        }
+        if (is_window && (0 == _sapp_egl_attrib(n, EGL_NATIVE_VISUAL_ID))) {
+            continue;
+        }
+        u->red_bits = _sapp_egl_attrib(n, EGL_RED_SIZE);
+        u->green_bits = _sapp_egl_attrib(n, EGL_GREEN_SIZE);
+        u->blue_bits = _sapp_egl_attrib(n, EGL_BLUE_SIZE);
+        u->alpha_bits = _sapp_egl_attrib(n, EGL_ALPHA_SIZE);
+        u->depth_bits = _sapp_egl_attrib(n, EGL_DEPTH_SIZE);
+        u->stencil_bits = _sapp_egl_attrib(n, EGL_STENCIL_SIZE);
+        u->samples = _sapp_egl_attrib(n, EGL_SAMPLES);
+        /* EGL window surfaces are always double-buffered, pbuffers never */
+        u->doublebuffer = is_window;
+        u->handle = (uintptr_t) i;
+        usable_count++;
+    }
+    _sapp_gl_fbconfig desired;
+    _sapp_gl_init_fbconfig(&desired);
+    desired.red_bits = 8;
+    desired.green_bits = 8;
+    desired.blue_bits = 8;
+    desired.alpha_bits = 8;
+    desired.depth_bits = 24;
+    desired.stencil_bits = 8;
+    desired.doublebuffer = is_window;
+    desired.samples = _sapp.sample_count > 1 ? _sapp.sample_count : 0;
+    const _sapp_gl_fbconfig* closest = _sapp_gl_choose_fbconfig(&desired, usable_configs, usable_count);
+    EGLConfig result = 0;
+    if (closest) {
+        result = native_configs[closest->handle];
+    }
+    SOKOL_FREE(native_configs);
+    SOKOL_FREE(usable_configs);
+    return result;
+}
+
+_SOKOL_PRIVATE void _sapp_egl_choose_visual(Visual** visual, int* depth) {
+    _sapp.egl.config = _sapp_egl_choose_config(EGL_WINDOW_BIT);
+    if (0 == _sapp.egl.config) {
+        _sapp_fail("EGL: Failed to find a suitable EGLConfig");
+    }
+    XVisualInfo tmpl;
+    memset(&tmpl, 0, sizeof(tmpl));
+    tmpl.visualid = (VisualID) _sapp_egl_attrib(_sapp.egl.config, EGL_NATIVE_VISUAL_ID);
+    int num_visuals = 0;
+    XVisualInfo* result = XGetVisualInfo(_sapp.x11.display, VisualIDMask, &tmpl, &num_visuals);
+    if (!result) {
+        _sapp_fail("EGL: Failed to retrieve Visual for EGLConfig");
+    }
+    *visual = result->visual;
+    *depth = result->depth;
+    XFree(result);
+}
+
+_SOKOL_PRIVATE void _sapp_egl_make_current(void) {
+    eglMakeCurrent(_sapp.egl.display, _sapp.egl.surface, _sapp.egl.surface, _sapp.egl.context);
+}
+
+_SOKOL_PRIVATE void _sapp_egl_release_current(void) {
+    eglMakeCurrent(_sapp.egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+_SOKOL_PRIVATE void _sapp_egl_create_gl_context(void) {
+    SOKOL_ASSERT(_sapp.egl.config);
+    const EGLint attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_CONTEXT_FLAGS_KHR, EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR,
+        EGL_NONE
+    };
+    _sapp.egl.context = eglCreateContext(_sapp.egl.display, _sapp.egl.config, EGL_NO_CONTEXT, attribs);
+    if (EGL_NO_CONTEXT == _sapp.egl.context) {
+        _sapp_fail("EGL: failed to create GL context");
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_egl_create_context(void) {
+    _sapp_egl_create_gl_context();
+    _sapp.egl.surface = eglCreateWindowSurface(_sapp.egl.display, _sapp.egl.config, (EGLNativeWindowType)_sapp.x11.window, NULL);
+    if (EGL_NO_SURFACE == _sapp.egl.surface) {
+        _sapp_fail("EGL: failed to create window surface");
+    }
+    _sapp_egl_make_current();
+}
+
+/* headless mode: render into a pbuffer of the initial framebuffer size */
+_SOKOL_PRIVATE void _sapp_egl_create_headless_context(void) {
+    _sapp.egl.config = _sapp_egl_choose_config(EGL_PBUFFER_BIT);
+    if (0 == _sapp.egl.config) {
+        _sapp_fail("EGL: Failed to find a suitable EGLConfig for a pbuffer");
+    }
+    _sapp_egl_create_gl_context();
+    const EGLint attribs[] = {
+        EGL_WIDTH, _sapp.framebuffer_width,
+        EGL_HEIGHT, _sapp.framebuffer_height,
+        EGL_NONE
+    };
+    _sapp.egl.surface = eglCreatePbufferSurface(_sapp.egl.display, _sapp.egl.config, attribs);
+    if (EGL_NO_SURFACE == _sapp.egl.surface) {
+        _sapp_fail("EGL: failed to create pbuffer surface");
+    }
+    _sapp_egl_make_current();
+}
+
+_SOKOL_PRIVATE void _sapp_egl_destroy_context(void) {
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        return;
+    }
+    eglMakeCurrent(_sapp.egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (EGL_NO_SURFACE != _sapp.egl.surface) {
+        eglDestroySurface(_sapp.egl.display, _sapp.egl.surface);
+        _sapp.egl.surface = EGL_NO_SURFACE;
+    }
+    if (EGL_NO_CONTEXT != _sapp.egl.context) {
+        eglDestroyContext(_sapp.egl.display, _sapp.egl.context);
+        _sapp.egl.context = EGL_NO_CONTEXT;
+    }
+    eglTerminate(_sapp.egl.display);
+    _sapp.egl.display = EGL_NO_DISPLAY;
+}
+
+_SOKOL_PRIVATE void _sapp_egl_swap_buffers(void) {
+    if (_sapp.egl.has_damage && _sapp.egl.SwapBuffersWithDamage) {
+        /* EGL damage rects have their origin at the bottom-left */
+        const int x0 = _sapp_max(_sapp.egl.damage_x0, 0);
+        const int y0 = _sapp_max(_sapp.egl.damage_y0, 0);
+        const int x1 = _sapp_min(_sapp.egl.damage_x1, _sapp.framebuffer_width);
+        const int y1 = _sapp_min(_sapp.egl.damage_y1, _sapp.framebuffer_height);
+        const EGLint rect[4] = {
+            x0, _sapp.framebuffer_height - y1, _sapp_max(x1 - x0, 0), _sapp_max(y1 - y0, 0)
+        };
+        _sapp.egl.SwapBuffersWithDamage(_sapp.egl.display, _sapp.egl.surface, rect, 1);
+    }
+    else {
+        eglSwapBuffers(_sapp.egl.display, _sapp.egl.surface);
+    }
+    _sapp.egl.has_damage = false;
+}
+
+_SOKOL_PRIVATE void _sapp_egl_swapinterval(int interval) {
+    _sapp_egl_make_current();
+    eglSwapInterval(_sapp.egl.display, interval);
+}
+
+_SOKOL_PRIVATE bool _sapp_egl_create_extra_window(int slot) {
+    _sapp.egl.surfaces[slot] = eglCreateWindowSurface(_sapp.egl.display, _sapp.egl.config, (EGLNativeWindowType)_sapp.x11.windows[slot], NULL);
+    if (EGL_NO_SURFACE == _sapp.egl.surfaces[slot]) {
+        _sapp.egl.surfaces[slot] = 0;
+        return false;
+    }
+    /* only the main window waits for vsync, the swap interval applies
+       to the surface which is current when eglSwapInterval() is called */
+    eglMakeCurrent(_sapp.egl.display, _sapp.egl.surfaces[slot], _sapp.egl.surfaces[slot], _sapp.egl.context);
+    eglSwapInterval(_sapp.egl.display, 0);
+    _sapp_egl_make_current();
+    return true;
+}
+
+_SOKOL_PRIVATE void _sapp_egl_destroy_extra_window(int slot) {
+    if (_sapp.egl.surfaces[slot]) {
+        /* never leave a destroyed surface current */
+        _sapp_egl_make_current();
+        eglDestroySurface(_sapp.egl.display, _sapp.egl.surfaces[slot]);
+        _sapp.egl.surfaces[slot] = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_egl_make_current_extra(int slot) {
+    SOKOL_ASSERT(_sapp.egl.surfaces[slot]);
+    eglMakeCurrent(_sapp.egl.display, _sapp.egl.surfaces[slot], _sapp.egl.surfaces[slot], _sapp.egl.context);
+}
+
+/* unlike GLX, EGL can only swap the surface of the current context,
+   so this leaves the last additional window current */
+_SOKOL_PRIVATE void _sapp_egl_swap_extra_buffers(void) {
+    for (int slot = 1; slot < SAPP_MAX_WINDOWS; slot++) {
+        if (_sapp.egl.surfaces[slot]) {
+            _sapp_egl_make_current_extra(slot);
+            eglSwapBuffers(_sapp.egl.display, _sapp.egl.surfaces[slot]);
+        }
+    }
+}
+
+_SOKOL_PRIVATE int _sapp_egl_buffer_age(void) {
+    EGLint age = 0;
+    if (_sapp.egl.EXT_buffer_age && (EGL_NO_SURFACE != _sapp.egl.surface)) {
+        eglQuerySurface(_sapp.egl.display, _sapp.egl.surface, EGL_BUFFER_AGE_EXT, &age);
+    }
+    return age;
+}
+#endif // _SAPP_EGL
+
 _SOKOL_PRIVATE void _sapp_x11_send_event(Atom type, int a, int b, int c, int d, int e) {
     XEvent event;
     memset(&event, 0, sizeof(event));
@@ -10218,24 +11863,28 @@ _SOKOL_PRIVATE void _sapp_x11_lock_mouse(bool lock) {
     XFlush(_sapp.x11.display);
 }
 
-_SOKOL_PRIVATE void _sapp_x11_update_window_title(void) {
+_SOKOL_PRIVATE void _sapp_x11_set_window_title(Window window, const char* title) {
     Xutf8SetWMProperties(_sapp.x11.display,
-        _sapp.x11.window,
-        _sapp.window_title, _sapp.window_title,
+        window,
+        title, title,
         NULL, 0, NULL, NULL, NULL);
-    XChangeProperty(_sapp.x11.display, _sapp.x11.window,
+    XChangeProperty(_sapp.x11.display, window,
         _sapp.x11.NET_WM_NAME, _sapp.x11.UTF8_STRING, 8,
         PropModeReplace,
-        (unsigned char*)_sapp.window_title,
-        strlen(_sapp.window_title));
-    XChangeProperty(_sapp.x11.display, _sapp.x11.window,
+        (unsigned char*)title,
+        strlen(title));
+    XChangeProperty(_sapp.x11.display, window,
         _sapp.x11.NET_WM_ICON_NAME, _sapp.x11.UTF8_STRING, 8,
         PropModeReplace,
-        (unsigned char*)_sapp.window_title,
-        strlen(_sapp.window_title));
+        (unsigned char*)title,
+        strlen(title));
     XFlush(_sapp.x11.display);
 }
 
+_SOKOL_PRIVATE void _sapp_x11_update_window_title(void) {
+    _sapp_x11_set_window_title(_sapp.x11.window, _sapp.window_title);
+}
+
 _SOKOL_PRIVATE void _sapp_x11_set_icon(const sapp_icon_desc* icon_desc, int num_images) {
     SOKOL_ASSERT((num_images > 0) && (num_images <= SAPP_MAX_ICONIMAGES));
     int long_count = 0;
@@ -10353,6 +12002,67 @@ _SOKOL_PRIVATE void _sapp_x11_destroy_window(void) {
     XFlush(_sapp.x11.display);
 }
 
+_SOKOL_PRIVATE bool _sapp_x11_create_extra_window(int slot, const sapp_window_desc* desc) {
+    _sapp_window_t* win = &_sapp.windows[slot];
+    win->width = _sapp_def(desc->width, _sapp.window_width);
+    win->height = _sapp_def(desc->height, _sapp.window_height);
+    XSetWindowAttributes wa;
+    memset(&wa, 0, sizeof(wa));
+    const uint32_t wamask = CWBorderPixel | CWColormap | CWEventMask;
+    wa.colormap = _sapp.x11.colormap;
+    wa.border_pixel = 0;
+    wa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
+                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
+                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
+                    EnterWindowMask | LeaveWindowMask;
+    _sapp_x11_grab_error_handler();
+    _sapp.x11.windows[slot] = XCreateWindow(_sapp.x11.display,
+                                            _sapp.x11.root,
+                                            0, 0,
+                                            (uint32_t)win->width,
+                                            (uint32_t)win->height,
+                                            0,     /* border width */
+                                            _sapp.x11.depth,
+                                            InputOutput,
+                                            _sapp.x11.visual,
+                                            wamask,
+                                            &wa);
+    _sapp_x11_release_error_handler();
+    if (!_sapp.x11.windows[slot]) {
+        return false;
+    }
+    Atom protocols[] = {
+        _sapp.x11.WM_DELETE_WINDOW
+    };
+    XSetWMProtocols(_sapp.x11.display, _sapp.x11.windows[slot], protocols, 1);
+    _sapp_x11_set_window_title(_sapp.x11.windows[slot], desc->window_title ? desc->window_title : _sapp.window_title);
+    XMapWindow(_sapp.x11.display, _sapp.x11.windows[slot]);
+    XFlush(_sapp.x11.display);
+    return true;
+}
+
+_SOKOL_PRIVATE void _sapp_x11_destroy_extra_window(int slot) {
+    if (_sapp.x11.windows[slot]) {
+        XUnmapWindow(_sapp.x11.display, _sapp.x11.windows[slot]);
+        XDestroyWindow(_sapp.x11.display, _sapp.x11.windows[slot]);
+        _sapp.x11.windows[slot] = 0;
+        XFlush(_sapp.x11.display);
+    }
+}
+
+/* map an X11 window to a window slot, returns 0 for the main window and -1 for unknown windows */
+_SOKOL_PRIVATE int _sapp_x11_window_slot(Window window) {
+    if (window == _sapp.x11.window) {
+        return 0;
+    }
+    for (int slot = 1; slot < SAPP_MAX_WINDOWS; slot++) {
+        if ((0 != _sapp.windows[slot].id) && (_sapp.x11.windows[slot] == window)) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
 _SOKOL_PRIVATE bool _sapp_x11_window_visible(void) {
     XWindowAttributes wa;
     XGetWindowAttributes(_sapp.x11.display, _sapp.x11.window, &wa);
@@ -10461,74 +12171,290 @@ _SOKOL_PRIVATE uint32_t _sapp_x11_mods(uint32_t x11_mods) {
     return mods;
 }
 
-_SOKOL_PRIVATE void _sapp_x11_app_event(sapp_event_type type) {
-    if (_sapp_events_enabled()) {
-        _sapp_init_event(type);
-        _sapp_call_event(&_sapp.event);
+_SOKOL_PRIVATE void _sapp_x11_queue_init(_sapp_x11_queue_t* q, uint32_t capacity, size_t item_size) {
+    SOKOL_ASSERT((capacity > 0) && (0 == (capacity & (capacity - 1))));
+    q->items = (uint8_t*) SOKOL_CALLOC(capacity, item_size);
+    q->item_size = item_size;
+    q->capacity = capacity;
+    q->head = 0;
+    q->tail = 0;
+}
+
+_SOKOL_PRIVATE void _sapp_x11_queue_discard(_sapp_x11_queue_t* q) {
+    if (q->items) {
+        SOKOL_FREE(q->items);
+        q->items = 0;
     }
 }
 
-_SOKOL_PRIVATE sapp_mousebutton _sapp_x11_translate_button(const XEvent* event) {
-    switch (event->xbutton.button) {
-        case Button1: return SAPP_MOUSEBUTTON_LEFT;
-        case Button2: return SAPP_MOUSEBUTTON_MIDDLE;
-        case Button3: return SAPP_MOUSEBUTTON_RIGHT;
-        default:      return SAPP_MOUSEBUTTON_INVALID;
+_SOKOL_PRIVATE bool _sapp_x11_queue_empty(const _sapp_x11_queue_t* q) {
+    return q->head == __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+}
+
+_SOKOL_PRIVATE bool _sapp_x11_queue_push(_sapp_x11_queue_t* q, const void* item) {
+    const uint32_t tail = q->tail;
+    const uint32_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    if ((tail - head) == q->capacity) {
+        return false;
     }
+    memcpy(q->items + (tail & (q->capacity - 1)) * q->item_size, item, q->item_size);
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
 }
 
-_SOKOL_PRIVATE void _sapp_x11_mouse_event(sapp_event_type type, sapp_mousebutton btn, uint32_t mods) {
-    if (_sapp_events_enabled()) {
-        _sapp_init_event(type);
-        _sapp.event.mouse_button = btn;
-        _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
+_SOKOL_PRIVATE bool _sapp_x11_queue_pop(_sapp_x11_queue_t* q, void* item) {
+    const uint32_t head = q->head;
+    const uint32_t tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+        return false;
     }
+    memcpy(item, q->items + (head & (q->capacity - 1)) * q->item_size, q->item_size);
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    return true;
 }
 
-_SOKOL_PRIVATE void _sapp_x11_scroll_event(float x, float y, uint32_t mods) {
-    if (_sapp_events_enabled()) {
-        _sapp_init_event(SAPP_EVENTTYPE_MOUSE_SCROLL);
-        _sapp.event.modifiers = mods;
-        _sapp.event.scroll_x = x;
-        _sapp.event.scroll_y = y;
-        _sapp_call_event(&_sapp.event);
+/* X11 thread: block until the render thread has made room in the event queue
+   (or has finished), the render thread signals space_fd after draining the queue
+
+   Both threads update producer_waiting with an atomic exchange, so either the
+   render thread sees the flag and signals space_fd, or the X11 thread sees the
+   queue space (or the done flag) published before the render thread's exchange.
+*/
+_SOKOL_PRIVATE void _sapp_x11_wait_for_queue_space(void) {
+    (void) __atomic_exchange_n(&_sapp.x11.rt.producer_waiting, true, __ATOMIC_ACQ_REL);
+    /* check again, the render thread might have drained the queue before seeing the flag */
+    const uint32_t head = __atomic_load_n(&_sapp.x11.rt.queue.head, __ATOMIC_ACQUIRE);
+    if (((_sapp.x11.rt.queue.tail - head) == _sapp.x11.rt.queue.capacity) && !__atomic_load_n(&_sapp.x11.rt.done, __ATOMIC_ACQUIRE)) {
+        struct pollfd fds;
+        memset(&fds, 0, sizeof(fds));
+        fds.fd = _sapp.x11.rt.space_fd;
+        fds.events = POLLIN;
+        while ((poll(&fds, 1, -1) < 0) && (errno == EINTR)) {
+            /* interrupted by a signal, try again */
+        }
     }
+    __atomic_store_n(&_sapp.x11.rt.producer_waiting, false, __ATOMIC_RELAXED);
+    uint64_t val;
+    ssize_t res = read(_sapp.x11.rt.space_fd, &val, sizeof(val));
+    _SOKOL_UNUSED(res);
 }
 
-_SOKOL_PRIVATE void _sapp_x11_key_event(sapp_event_type type, sapp_keycode key, bool repeat, uint32_t mods) {
-    if (_sapp_events_enabled()) {
+_SOKOL_PRIVATE bool _sapp_x11_events_enabled(void) {
+    if (_sapp.x11.rt.active) {
+        /* _sapp.init_called is owned by the render thread, which drops
+           events arriving before the init callback has been called */
+        return (_sapp.desc.event_cb || _sapp.desc.event_userdata_cb);
+    }
+    return _sapp_events_enabled();
+}
+
+/* with a render thread, the window size and frame counter are owned by
+   the render thread and filled in when the event is dequeued
+*/
+_SOKOL_PRIVATE void _sapp_x11_init_event(sapp_event_type type) {
+    if (_sapp.x11.rt.active) {
+        memset(&_sapp.event, 0, sizeof(_sapp.event));
+        _sapp.event.type = type;
+        _sapp.event.mouse_button = SAPP_MOUSEBUTTON_INVALID;
+        _sapp.event.mouse_x = _sapp.mouse.x;
+        _sapp.event.mouse_y = _sapp.mouse.y;
+        _sapp.event.mouse_dx = _sapp.mouse.dx;
+        _sapp.event.mouse_dy = _sapp.mouse.dy;
+        _sapp.event.window = _sapp.event_window;
+    }
+    else {
         _sapp_init_event(type);
-        _sapp.event.key_code = key;
-        _sapp.event.key_repeat = repeat;
-        _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
-        /* check if a CLIPBOARD_PASTED event must be sent too */
-        if (_sapp.clipboard.enabled &&
-            (type == SAPP_EVENTTYPE_KEY_DOWN) &&
-            (_sapp.event.modifiers == SAPP_MODIFIER_CTRL) &&
-            (_sapp.event.key_code == SAPP_KEYCODE_V))
-        {
-            _sapp_init_event(SAPP_EVENTTYPE_CLIPBOARD_PASTED);
-            _sapp_call_event(&_sapp.event);
+    }
+}
+
+/* send a coalesced mouse move event (sapp_desc.coalesce_mouse_moves),
+   this happens before any other event and before the frame callback
+*/
+_SOKOL_PRIVATE void _sapp_x11_flush_mouse_move(void) {
+    if (_sapp.x11.pending_move_valid) {
+        _sapp.x11.pending_move_valid = false;
+        _sapp_call_event(&_sapp.x11.pending_move);
+    }
+}
+
+/* call the event callback, merging consecutive mouse moves of the same
+   window into a single event with summed deltas if requested
+*/
+_SOKOL_PRIVATE void _sapp_x11_call_event(const sapp_event* e) {
+    if (_sapp.desc.coalesce_mouse_moves) {
+        if (SAPP_EVENTTYPE_MOUSE_MOVE == e->type) {
+            if (_sapp.x11.pending_move_valid && (_sapp.x11.pending_move.window.id == e->window.id)) {
+                const float dx = _sapp.x11.pending_move.mouse_dx + e->mouse_dx;
+                const float dy = _sapp.x11.pending_move.mouse_dy + e->mouse_dy;
+                _sapp.x11.pending_move = *e;
+                _sapp.x11.pending_move.mouse_dx = dx;
+                _sapp.x11.pending_move.mouse_dy = dy;
+            }
+            else {
+                _sapp_x11_flush_mouse_move();
+                _sapp.x11.pending_move = *e;
+                _sapp.x11.pending_move_valid = true;
+            }
+            return;
         }
+        _sapp_x11_flush_mouse_move();
     }
+    _sapp_call_event(e);
 }
 
-_SOKOL_PRIVATE void _sapp_x11_char_event(uint32_t chr, bool repeat, uint32_t mods) {
-    if (_sapp_events_enabled()) {
-        _sapp_init_event(SAPP_EVENTTYPE_CHAR);
-        _sapp.event.char_code = chr;
-        _sapp.event.key_repeat = repeat;
-        _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
+/* X11 thread: hand an event over to the render thread, optionally wait
+   for a free queue slot, returns false if the event wasn't queued
+*/
+_SOKOL_PRIVATE bool _sapp_x11_push_event(const sapp_event* e, bool wait) {
+    while (!_sapp_x11_queue_push(&_sapp.x11.rt.queue, e)) {
+        if (!wait || __atomic_load_n(&_sapp.x11.rt.done, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        _sapp_x11_wait_for_queue_space();
     }
+    /* render-on-demand: wake up the render thread */
+    if (_sapp.x11.frame_event_fd >= 0) {
+        const uint64_t val = 1;
+        ssize_t res = write(_sapp.x11.frame_event_fd, &val, sizeof(val));
+        _SOKOL_UNUSED(res);
+    }
+    return true;
 }
 
-_SOKOL_PRIVATE sapp_keycode _sapp_x11_translate_key(int scancode) {
-    int dummy;
-    KeySym* keysyms = XGetKeyboardMapping(_sapp.x11.display, scancode, 1, &dummy);
-    SOKOL_ASSERT(keysyms);
+/* X11 thread: hand over a mouse move which was held back because the event
+   queue was full, the render thread wakes up the X11 thread after draining
+   the queue while a mouse move is held back
+*/
+_SOKOL_PRIVATE void _sapp_x11_flush_held_move(bool wait) {
+    if (_sapp.x11.rt.move_held) {
+        if (_sapp_x11_push_event(&_sapp.x11.rt.held_move, wait) || wait) {
+            __atomic_store_n(&_sapp.x11.rt.move_held, false, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/* call the event callback, or hand the event over to the render thread */
+_SOKOL_PRIVATE void _sapp_x11_dispatch_event(void) {
+    if (_sapp.x11.rt.active) {
+        if (_sapp.event.type == SAPP_EVENTTYPE_MOUSE_MOVE) {
+            if (_sapp.x11.rt.move_held && (_sapp.x11.rt.held_move.window.id == _sapp.event.window.id)) {
+                /* merge the deltas of the held back mouse move */
+                _sapp.event.mouse_dx += _sapp.x11.rt.held_move.mouse_dx;
+                _sapp.event.mouse_dy += _sapp.x11.rt.held_move.mouse_dy;
+            }
+            else {
+                _sapp_x11_flush_held_move(true);
+            }
+            /* the render thread is far behind: don't wait for a free slot,
+               but hold back the mouse move so that its deltas aren't lost
+            */
+            const bool held = !_sapp_x11_push_event(&_sapp.event, false);
+            if (held) {
+                _sapp.x11.rt.held_move = _sapp.event;
+            }
+            __atomic_store_n(&_sapp.x11.rt.move_held, held, __ATOMIC_RELEASE);
+        }
+        else {
+            /* all other events wait for a free slot so that no input is lost */
+            _sapp_x11_flush_held_move(true);
+            _sapp_x11_push_event(&_sapp.event, true);
+        }
+    }
+    else {
+        _sapp_x11_call_event(&_sapp.event);
+    }
+}
+
+/* record a mouse sample (sapp_desc.mouse_history_size), in render thread
+   mode samples are handed over to the render thread, and dropped if the
+   render thread is far behind
+*/
+_SOKOL_PRIVATE void _sapp_x11_mouse_sample(Time time) {
+    if (0 == _sapp.mouse.history.size) {
+        return;
+    }
+    sapp_mouse_sample smp;
+    smp.time = (double)time / 1000.0;
+    smp.x = _sapp.mouse.x;
+    smp.y = _sapp.mouse.y;
+    smp.dx = _sapp.mouse.dx;
+    smp.dy = _sapp.mouse.dy;
+    if (_sapp.x11.rt.active) {
+        _sapp_x11_queue_push(&_sapp.x11.rt.sample_queue, &smp);
+    }
+    else {
+        _sapp_add_mouse_sample(&smp);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_app_event(sapp_event_type type) {
+    if (_sapp_x11_events_enabled()) {
+        _sapp_x11_init_event(type);
+        _sapp_x11_dispatch_event();
+    }
+}
+
+_SOKOL_PRIVATE sapp_mousebutton _sapp_x11_translate_button(const XEvent* event) {
+    switch (event->xbutton.button) {
+        case Button1: return SAPP_MOUSEBUTTON_LEFT;
+        case Button2: return SAPP_MOUSEBUTTON_MIDDLE;
+        case Button3: return SAPP_MOUSEBUTTON_RIGHT;
+        default:      return SAPP_MOUSEBUTTON_INVALID;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_mouse_event(sapp_event_type type, sapp_mousebutton btn, uint32_t mods) {
+    if (_sapp_x11_events_enabled()) {
+        _sapp_x11_init_event(type);
+        _sapp.event.mouse_button = btn;
+        _sapp.event.modifiers = mods;
+        _sapp_x11_dispatch_event();
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_scroll_event(float x, float y, uint32_t mods) {
+    if (_sapp_x11_events_enabled()) {
+        _sapp_x11_init_event(SAPP_EVENTTYPE_MOUSE_SCROLL);
+        _sapp.event.modifiers = mods;
+        _sapp.event.scroll_x = x;
+        _sapp.event.scroll_y = y;
+        _sapp_x11_dispatch_event();
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_key_event(sapp_event_type type, sapp_keycode key, bool repeat, uint32_t mods) {
+    if (_sapp_x11_events_enabled()) {
+        _sapp_x11_init_event(type);
+        _sapp.event.key_code = key;
+        _sapp.event.key_repeat = repeat;
+        _sapp.event.modifiers = mods;
+        _sapp_x11_dispatch_event();
+        /* check if a CLIPBOARD_PASTED event must be sent too */
+        if (_sapp.clipboard.enabled &&
+            (type == SAPP_EVENTTYPE_KEY_DOWN) &&
+            (_sapp.event.modifiers == SAPP_MODIFIER_CTRL) &&
+            (_sapp.event.key_code == SAPP_KEYCODE_V))
+        {
+            _sapp_x11_init_event(SAPP_EVENTTYPE_CLIPBOARD_PASTED);
+            _sapp_x11_dispatch_event();
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_char_event(uint32_t chr, bool repeat, uint32_t mods) {
+    if (_sapp_x11_events_enabled()) {
+        _sapp_x11_init_event(SAPP_EVENTTYPE_CHAR);
+        _sapp.event.char_code = chr;
+        _sapp.event.key_repeat = repeat;
+        _sapp.event.modifiers = mods;
+        _sapp_x11_dispatch_event();
+    }
+}
+
+_SOKOL_PRIVATE sapp_keycode _sapp_x11_translate_key(int scancode) {
+    int dummy;
+    KeySym* keysyms = XGetKeyboardMapping(_sapp.x11.display, scancode, 1, &dummy);
+    SOKOL_ASSERT(keysyms);
     KeySym keysym = keysyms[0];
     XFree(keysyms);
     switch (keysym) {
@@ -10781,7 +12707,21 @@ _SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src) {
 static bool _sapp_x11_keycodes[256];
 
 _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
+    #if defined(_SAPP_GLX)
+    if (_sapp.glx.use_swap_event && (event->type == (_sapp.glx.event_base + GLX_BufferSwapComplete))) {
+        const GLXBufferSwapComplete* swap = (const GLXBufferSwapComplete*) event;
+        _sapp_frame_stats_present(&_sapp.timing.stats, swap->ust, swap->msc, swap->sbc, _sapp.swap_interval);
+        return;
+    }
+    #endif
     Bool filtered = XFilterEvent(event, None);
+    /* GenericEvents (raw mouse input) don't have an associated window */
+    const int win_slot = (event->type == GenericEvent) ? 0 : _sapp_x11_window_slot(event->xany.window);
+    if (win_slot < 0) {
+        /* a left-over event of an already closed window */
+        return;
+    }
+    _sapp.event_window.id = _sapp.windows[win_slot].id;
     switch (event->type) {
         case GenericEvent:
             if (_sapp.mouse.locked && _sapp.x11.xi.available) {
@@ -10791,6 +12731,9 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                             XIRawEvent* re = (XIRawEvent*) event->xcookie.data;
                             if (re->valuators.mask_len) {
                                 const double* values = re->raw_values;
+                                /* an axis which isn't in the valuator mask didn't move */
+                                _sapp.mouse.dx = 0.0f;
+                                _sapp.mouse.dy = 0.0f;
                                 if (XIMaskIsSet(re->valuators.mask, 0)) {
                                     _sapp.mouse.dx = (float) *values;
                                     values++;
@@ -10798,6 +12741,7 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                                 if (XIMaskIsSet(re->valuators.mask, 1)) {
                                     _sapp.mouse.dy = (float) *values;
                                 }
+                                _sapp_x11_mouse_sample(re->time);
                                 _sapp_x11_mouse_event(SAPP_EVENTTYPE_MOUSE_MOVE, SAPP_MOUSEBUTTON_INVALID, _sapp_x11_mods(event->xmotion.state));
                             }
                         }
@@ -10901,6 +12845,11 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
             break;
         case MotionNotify:
             if (!_sapp.mouse.locked) {
+                /* don't compute a mouse delta between positions in different windows */
+                if (event->xmotion.window != _sapp.x11.mouse_window) {
+                    _sapp.x11.mouse_window = event->xmotion.window;
+                    _sapp.mouse.pos_valid = false;
+                }
                 const float new_x = (float) event->xmotion.x;
                 const float new_y = (float) event->xmotion.y;
                 if (_sapp.mouse.pos_valid) {
@@ -10910,20 +12859,47 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                 _sapp.mouse.x = new_x;
                 _sapp.mouse.y = new_y;
                 _sapp.mouse.pos_valid = true;
+                _sapp_x11_mouse_sample(event->xmotion.time);
                 _sapp_x11_mouse_event(SAPP_EVENTTYPE_MOUSE_MOVE, SAPP_MOUSEBUTTON_INVALID, _sapp_x11_mods(event->xmotion.state));
             }
             break;
         case ConfigureNotify:
-            if ((event->xconfigure.width != _sapp.window_width) || (event->xconfigure.height != _sapp.window_height)) {
+            if (win_slot > 0) {
+                _sapp_window_t* win = &_sapp.windows[win_slot];
+                if ((event->xconfigure.width != win->width) || (event->xconfigure.height != win->height)) {
+                    win->width = event->xconfigure.width;
+                    win->height = event->xconfigure.height;
+                    _sapp_x11_app_event(SAPP_EVENTTYPE_RESIZED);
+                }
+            }
+            else if (_sapp.x11.rt.active) {
+                /* the render thread applies the new size when it dequeues the
+                   event, so it must be sent even without an event callback
+                */
+                if ((event->xconfigure.width != _sapp.x11.rt.window_width) || (event->xconfigure.height != _sapp.x11.rt.window_height)) {
+                    _sapp.x11.rt.window_width = event->xconfigure.width;
+                    _sapp.x11.rt.window_height = event->xconfigure.height;
+                    _sapp_x11_init_event(SAPP_EVENTTYPE_RESIZED);
+                    _sapp.event.window_width = _sapp.x11.rt.window_width;
+                    _sapp.event.window_height = _sapp.x11.rt.window_height;
+                    _sapp.event.framebuffer_width = _sapp.x11.rt.window_width;
+                    _sapp.event.framebuffer_height = _sapp.x11.rt.window_height;
+                    _sapp_x11_dispatch_event();
+                }
+            }
+            else {
+                /* the size is updated right away, but only one RESIZED event
+                   is sent per frame (see _sapp_x11_flush_resize())
+                */
                 _sapp.window_width = event->xconfigure.width;
                 _sapp.window_height = event->xconfigure.height;
                 _sapp.framebuffer_width = _sapp.window_width;
                 _sapp.framebuffer_height = _sapp.window_height;
-                _sapp_x11_app_event(SAPP_EVENTTYPE_RESIZED);
+                _sapp.x11.resize_pending = true;
             }
             break;
         case PropertyNotify:
-            if (event->xproperty.state == PropertyNewValue) {
+            if ((win_slot == 0) && (event->xproperty.state == PropertyNewValue)) {
                 if (event->xproperty.atom == _sapp.x11.WM_STATE) {
                     const int state = _sapp_x11_get_window_state();
                     if (state != _sapp.x11.window_state) {
@@ -10945,7 +12921,17 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
             if (event->xclient.message_type == _sapp.x11.WM_PROTOCOLS) {
                 const Atom protocol = (Atom)event->xclient.data.l[0];
                 if (protocol == _sapp.x11.WM_DELETE_WINDOW) {
-                    _sapp.quit_requested = true;
+                    if (win_slot > 0) {
+                        _sapp_x11_app_event(SAPP_EVENTTYPE_WINDOW_CLOSE_REQUESTED);
+                    }
+                    else if (_sapp.x11.rt.active) {
+                        /* the render thread sets _sapp.quit_requested when dequeuing this */
+                        _sapp_x11_init_event(SAPP_EVENTTYPE_QUIT_REQUESTED);
+                        _sapp_x11_dispatch_event();
+                    }
+                    else {
+                        _sapp.quit_requested = true;
+                    }
                 }
             }
             else if (event->xclient.message_type == _sapp.x11.xdnd.XdndEnter) {
@@ -11038,11 +13024,18 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                                                                 event->xselection.property,
                                                                 event->xselection.target,
                                                                 (unsigned char**) &data);
-                if (_sapp.drop.enabled && result) {
+                /* in render thread mode, a drop is ignored while the render
+                   thread hasn't taken over the previously dropped files yet
+                */
+                const bool drop_busy = _sapp.x11.rt.active && __atomic_load_n(&_sapp.x11.rt.drop_pending, __ATOMIC_ACQUIRE);
+                if (_sapp.drop.enabled && result && !drop_busy) {
                     if (_sapp_x11_parse_dropped_files_list(data)) {
-                        if (_sapp_events_enabled()) {
-                            _sapp_init_event(SAPP_EVENTTYPE_FILES_DROPPED);
-                            _sapp_call_event(&_sapp.event);
+                        if (_sapp_x11_events_enabled()) {
+                            _sapp_x11_init_event(SAPP_EVENTTYPE_FILES_DROPPED);
+                            if (_sapp.x11.rt.active) {
+                                __atomic_store_n(&_sapp.x11.rt.drop_pending, true, __ATOMIC_RELAXED);
+                            }
+                            _sapp_x11_dispatch_event();
                         }
                     }
                 }
@@ -11066,6 +13059,500 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
     }
 }
 
+_SOKOL_PRIVATE void _sapp_linux_init_render_on_demand(void) {
+    _sapp.x11.frame_event_fd = -1;
+    _sapp.x11.frame_timer_fd = -1;
+    if (!_sapp.desc.render_on_demand) {
+        return;
+    }
+    _sapp.x11.frame_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_sapp.x11.frame_event_fd < 0) {
+        _sapp_fail("eventfd() failed!\n");
+    }
+    if (_sapp.desc.render_on_demand_timer_ms > 0) {
+        _sapp.x11.frame_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        if (_sapp.x11.frame_timer_fd < 0) {
+            _sapp_fail("timerfd_create() failed!\n");
+        }
+        const int ms = _sapp.desc.render_on_demand_timer_ms;
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_interval.tv_sec = ms / 1000;
+        spec.it_interval.tv_nsec = (ms % 1000) * 1000000;
+        spec.it_value = spec.it_interval;
+        timerfd_settime(_sapp.x11.frame_timer_fd, 0, &spec, NULL);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_linux_discard_render_on_demand(void) {
+    if (_sapp.x11.frame_event_fd >= 0) {
+        close(_sapp.x11.frame_event_fd);
+        _sapp.x11.frame_event_fd = -1;
+    }
+    if (_sapp.x11.frame_timer_fd >= 0) {
+        close(_sapp.x11.frame_timer_fd);
+        _sapp.x11.frame_timer_fd = -1;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_linux_request_frame(void) {
+    if (_sapp.x11.frame_event_fd >= 0) {
+        const uint64_t val = 1;
+        /* can only fail if the counter would overflow, which means
+           that a frame request is pending anyway */
+        ssize_t res = write(_sapp.x11.frame_event_fd, &val, sizeof(val));
+        _SOKOL_UNUSED(res);
+    }
+}
+
+/* render-on-demand: the poll() timeout in milliseconds until a pending
+   RESIZE_SETTLED event is due, or -1 if none is pending
+*/
+_SOKOL_PRIVATE int _sapp_x11_resize_settle_timeout(void) {
+    if (!_sapp.x11.resize_settle_pending) {
+        return -1;
+    }
+    const double elapsed_ms = (_sapp_timestamp_now(&_sapp.timing.timestamp) - _sapp.x11.resize_time) * 1000.0;
+    const double remaining_ms = (double)_sapp.desc.resize_settle_ms - elapsed_ms;
+    return (remaining_ms > 0.0) ? ((int)remaining_ms + 1) : 0;
+}
+
+/* render-on-demand: block until an X11 event, a frame request or a timer
+   event arrives, returns immediately if X11 events are already queued
+
+   In render thread mode this is called on the render thread, which
+   doesn't wait for the X11 connection but for events handed over by
+   the X11 thread (which also signal the frame event fd)
+*/
+_SOKOL_PRIVATE void _sapp_linux_wait_for_frame(void) {
+    struct pollfd fds[3];
+    memset(fds, 0, sizeof(fds));
+    nfds_t num_fds = 0;
+    if (_sapp.x11.rt.active) {
+        if (!_sapp_x11_queue_empty(&_sapp.x11.rt.queue)) {
+            return;
+        }
+    }
+    else {
+        /* XPending() also flushes the output buffer */
+        if (XPending(_sapp.x11.display) > 0) {
+            return;
+        }
+        fds[num_fds].fd = ConnectionNumber(_sapp.x11.display);
+        fds[num_fds++].events = POLLIN;
+    }
+    const nfds_t first_counter_fd = num_fds;
+    fds[num_fds].fd = _sapp.x11.frame_event_fd;
+    fds[num_fds++].events = POLLIN;
+    if (_sapp.x11.frame_timer_fd >= 0) {
+        fds[num_fds].fd = _sapp.x11.frame_timer_fd;
+        fds[num_fds++].events = POLLIN;
+    }
+    while ((poll(fds, num_fds, _sapp_x11_resize_settle_timeout()) < 0) && (errno == EINTR)) {
+        /* interrupted by a signal, try again */
+    }
+    /* drain the event- and timer-fd counters */
+    uint64_t val;
+    for (nfds_t i = first_counter_fd; i < num_fds; i++) {
+        if (fds[i].revents & POLLIN) {
+            ssize_t res = read(fds[i].fd, &val, sizeof(val));
+            _SOKOL_UNUSED(res);
+        }
+    }
+    /* don't include the time spent waiting in the frame duration */
+    _sapp_timing_discontinuity(&_sapp.timing);
+}
+
+/* X11 thread: publish the window state for sapp_is_fullscreen(),
+   sapp_mouse_locked() and sapp_mouse_shown() on the render thread
+*/
+_SOKOL_PRIVATE void _sapp_linux_publish_window_state(void) {
+    uint32_t state = 0;
+    if (_sapp.fullscreen) {
+        state |= _SAPP_X11_STATE_FULLSCREEN;
+    }
+    if (_sapp.mouse.locked) {
+        state |= _SAPP_X11_STATE_MOUSE_LOCKED;
+    }
+    if (_sapp.mouse.shown) {
+        state |= _SAPP_X11_STATE_MOUSE_SHOWN;
+    }
+    __atomic_store_n(&_sapp.x11.rt.state, state, __ATOMIC_RELEASE);
+}
+
+/* X11 thread: apply the window state changes requested by the render thread,
+   only the processed request bits are cleared, so that a new request which
+   arrives in the meantime isn't lost (a request for the state which has
+   just been applied may be cleared, but this has no effect anyway)
+*/
+_SOKOL_PRIVATE void _sapp_linux_process_requests(void) {
+    const uint32_t req = __atomic_load_n(&_sapp.x11.rt.requests, __ATOMIC_ACQUIRE);
+    if (0 == req) {
+        return;
+    }
+    if (((req & _SAPP_X11_REQ_FULLSCREEN_ON) && !_sapp.fullscreen) || ((req & _SAPP_X11_REQ_FULLSCREEN_OFF) && _sapp.fullscreen)) {
+        _sapp_x11_toggle_fullscreen();
+    }
+    if (req & (_SAPP_X11_REQ_MOUSE_LOCK | _SAPP_X11_REQ_MOUSE_UNLOCK)) {
+        _sapp_x11_lock_mouse(0 != (req & _SAPP_X11_REQ_MOUSE_LOCK));
+    }
+    if (req & (_SAPP_X11_REQ_MOUSE_SHOW | _SAPP_X11_REQ_MOUSE_HIDE)) {
+        const bool show = 0 != (req & _SAPP_X11_REQ_MOUSE_SHOW);
+        if (_sapp.mouse.shown != show) {
+            _sapp_x11_show_mouse(show);
+            _sapp.mouse.shown = show;
+        }
+    }
+    _sapp_linux_publish_window_state();
+    __atomic_fetch_and(&_sapp.x11.rt.requests, ~req, __ATOMIC_RELEASE);
+}
+
+_SOKOL_PRIVATE void _sapp_linux_wake_x11_thread(void) {
+    const uint64_t val = 1;
+    ssize_t res = write(_sapp.x11.rt.wake_fd, &val, sizeof(val));
+    _SOKOL_UNUSED(res);
+}
+
+/* render thread: post a window state change to the X11 thread, replacing
+   a not yet processed request for the opposite state
+*/
+_SOKOL_PRIVATE void _sapp_linux_post_request(uint32_t set_bit, uint32_t clear_bit) {
+    uint32_t cur = __atomic_load_n(&_sapp.x11.rt.requests, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&_sapp.x11.rt.requests, &cur, (cur & ~clear_bit) | set_bit, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        /* retry with the updated value */
+    }
+    _sapp_linux_wake_x11_thread();
+}
+
+/* render thread: the requested window state if a request is still pending,
+   otherwise the state published by the X11 thread
+*/
+_SOKOL_PRIVATE bool _sapp_linux_window_state(uint32_t on_bit, uint32_t off_bit, uint32_t state_bit) {
+    const uint32_t req = __atomic_load_n(&_sapp.x11.rt.requests, __ATOMIC_ACQUIRE);
+    if (req & on_bit) {
+        return true;
+    }
+    if (req & off_bit) {
+        return false;
+    }
+    return 0 != (__atomic_load_n(&_sapp.x11.rt.state, __ATOMIC_ACQUIRE) & state_bit);
+}
+
+_SOKOL_PRIVATE void _sapp_linux_init_render_thread(void) {
+    _sapp.x11.rt.wake_fd = -1;
+    _sapp.x11.rt.space_fd = -1;
+    if (!_sapp.desc.render_thread) {
+        return;
+    }
+    _sapp.x11.rt.wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    _sapp.x11.rt.space_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((_sapp.x11.rt.wake_fd < 0) || (_sapp.x11.rt.space_fd < 0)) {
+        _sapp_fail("eventfd() failed!\n");
+    }
+    if (_sapp.drop.enabled) {
+        _sapp.x11.rt.drop_buffer = (char*) SOKOL_CALLOC(1, (size_t)_sapp.drop.buf_size);
+    }
+    _sapp_x11_queue_init(&_sapp.x11.rt.queue, _SAPP_X11_EVENT_QUEUE_SIZE, sizeof(sapp_event));
+    if (_sapp.mouse.history.size > 0) {
+        _sapp_x11_queue_init(&_sapp.x11.rt.sample_queue, _SAPP_X11_SAMPLE_QUEUE_SIZE, sizeof(sapp_mouse_sample));
+    }
+    _sapp.x11.rt.window_width = _sapp.window_width;
+    _sapp.x11.rt.window_height = _sapp.window_height;
+    _sapp.x11.rt.active = true;
+    _sapp_linux_publish_window_state();
+}
+
+_SOKOL_PRIVATE void _sapp_linux_discard_render_thread(void) {
+    if (_sapp.x11.rt.wake_fd >= 0) {
+        close(_sapp.x11.rt.wake_fd);
+        _sapp.x11.rt.wake_fd = -1;
+    }
+    if (_sapp.x11.rt.space_fd >= 0) {
+        close(_sapp.x11.rt.space_fd);
+        _sapp.x11.rt.space_fd = -1;
+    }
+    if (_sapp.x11.rt.drop_buffer) {
+        SOKOL_FREE(_sapp.x11.rt.drop_buffer);
+        _sapp.x11.rt.drop_buffer = 0;
+    }
+    _sapp_x11_queue_discard(&_sapp.x11.rt.queue);
+    _sapp_x11_queue_discard(&_sapp.x11.rt.sample_queue);
+    _sapp.x11.rt.active = false;
+}
+
+/* render thread: an app event which doesn't originate from the X11 thread */
+_SOKOL_PRIVATE void _sapp_linux_render_thread_app_event(sapp_event_type type) {
+    if (_sapp_events_enabled()) {
+        sapp_event e;
+        memset(&e, 0, sizeof(e));
+        e.type = type;
+        e.frame_count = _sapp.frame_count;
+        e.mouse_button = SAPP_MOUSEBUTTON_INVALID;
+        e.window_width = _sapp.window_width;
+        e.window_height = _sapp.window_height;
+        e.framebuffer_width = _sapp.framebuffer_width;
+        e.framebuffer_height = _sapp.framebuffer_height;
+        e.window.id = _SAPP_MAIN_WINDOW_ID;
+        _sapp_call_event(&e);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_main_window_app_event(sapp_event_type type) {
+    if (_sapp.x11.rt.active) {
+        _sapp_linux_render_thread_app_event(type);
+    }
+    else {
+        _sapp.event_window.id = _SAPP_MAIN_WINDOW_ID;
+        _sapp_x11_app_event(type);
+    }
+}
+
+/* send a single RESIZED event for all size changes of the main window since
+   the last frame, and a RESIZE_SETTLED event once the size didn't change for
+   sapp_desc.resize_settle_ms, this happens right before the frame callback
+*/
+_SOKOL_PRIVATE void _sapp_x11_flush_resize(void) {
+    if (_sapp.x11.resize_pending) {
+        _sapp.x11.resize_pending = false;
+        if ((_sapp.window_width != _sapp.x11.resized_width) || (_sapp.window_height != _sapp.x11.resized_height)) {
+            _sapp.x11.resized_width = _sapp.window_width;
+            _sapp.x11.resized_height = _sapp.window_height;
+            _sapp_x11_main_window_app_event(SAPP_EVENTTYPE_RESIZED);
+            if (_sapp.desc.resize_settle_ms > 0) {
+                _sapp.x11.resize_settle_pending = true;
+                _sapp.x11.resize_time = _sapp_timestamp_now(&_sapp.timing.timestamp);
+            }
+        }
+    }
+    if (_sapp.x11.resize_settle_pending && (0 == _sapp_x11_resize_settle_timeout())) {
+        _sapp.x11.resize_settle_pending = false;
+        _sapp_x11_main_window_app_event(SAPP_EVENTTYPE_RESIZE_SETTLED);
+    }
+}
+
+/* render thread: wake up the X11 thread if it waits for a free event queue slot */
+_SOKOL_PRIVATE void _sapp_linux_signal_queue_space(void) {
+    if (__atomic_exchange_n(&_sapp.x11.rt.producer_waiting, false, __ATOMIC_ACQ_REL)) {
+        const uint64_t val = 1;
+        ssize_t res = write(_sapp.x11.rt.space_fd, &val, sizeof(val));
+        _SOKOL_UNUSED(res);
+    }
+}
+
+/* render thread: dispatch the events handed over by the X11 thread */
+_SOKOL_PRIVATE void _sapp_linux_render_thread_events(void) {
+    if (_sapp.x11.rt.sample_queue.items) {
+        sapp_mouse_sample smp;
+        while (_sapp_x11_queue_pop(&_sapp.x11.rt.sample_queue, &smp)) {
+            _sapp_add_mouse_sample(&smp);
+        }
+    }
+    sapp_event e;
+    while (_sapp_x11_queue_pop(&_sapp.x11.rt.queue, &e)) {
+        if (SAPP_EVENTTYPE_QUIT_REQUESTED == e.type) {
+            _sapp.quit_requested = true;
+            continue;
+        }
+        if (SAPP_EVENTTYPE_FILES_DROPPED == e.type) {
+            /* take over the dropped files, the X11 thread may receive the next drop after this */
+            memcpy(_sapp.x11.rt.drop_buffer, _sapp.drop.buffer, (size_t)_sapp.drop.buf_size);
+            _sapp.x11.rt.drop_num_files = _sapp.drop.num_files;
+            __atomic_store_n(&_sapp.x11.rt.drop_pending, false, __ATOMIC_RELEASE);
+        }
+        if (SAPP_EVENTTYPE_RESIZED == e.type) {
+            /* the RESIZED event is sent by _sapp_x11_flush_resize() */
+            _sapp.window_width = e.window_width;
+            _sapp.window_height = e.window_height;
+            _sapp.framebuffer_width = e.framebuffer_width;
+            _sapp.framebuffer_height = e.framebuffer_height;
+            _sapp.x11.resize_pending = true;
+            continue;
+        }
+        else {
+            e.window_width = _sapp.window_width;
+            e.window_height = _sapp.window_height;
+            e.framebuffer_width = _sapp.framebuffer_width;
+            e.framebuffer_height = _sapp.framebuffer_height;
+        }
+        e.frame_count = _sapp.frame_count;
+        if (_sapp_events_enabled()) {
+            _sapp_x11_call_event(&e);
+        }
+    }
+    _sapp_linux_signal_queue_space();
+    if (__atomic_load_n(&_sapp.x11.rt.move_held, __ATOMIC_ACQUIRE)) {
+        _sapp_linux_wake_x11_thread();
+    }
+    _sapp_x11_flush_mouse_move();
+    _sapp_x11_flush_resize();
+}
+
+_SOKOL_PRIVATE void* _sapp_linux_render_thread_func(void* arg) {
+    _SOKOL_UNUSED(arg);
+    while (!_sapp.quit_ordered) {
+        /* the first frame is always rendered */
+        if (_sapp.desc.render_on_demand && (_sapp.frame_count > 0)) {
+            _sapp_linux_wait_for_frame();
+        }
+        _sapp_timing_measure(&_sapp.timing);
+        #if defined(_SAPP_GLX)
+            _sapp_glx_make_current();
+        #else
+            _sapp_egl_make_current();
+        #endif
+        _sapp_linux_render_thread_events();
+        _sapp_frame();
+        #if defined(_SAPP_GLX)
+            _sapp_glx_make_current();
+            _sapp_glx_swap_buffers();
+        #else
+            _sapp_egl_make_current();
+            _sapp_egl_swap_buffers();
+        #endif
+        /* the GL driver shares the X11 connection and may have read X11 events
+           into the Xlib event queue, the X11 thread wouldn't see them in poll()
+        */
+        if (XEventsQueued(_sapp.x11.display, QueuedAlready) > 0) {
+            _sapp_linux_wake_x11_thread();
+        }
+        if (_sapp.quit_requested && !_sapp.quit_ordered) {
+            _sapp_linux_render_thread_app_event(SAPP_EVENTTYPE_QUIT_REQUESTED);
+            if (_sapp.quit_requested) {
+                _sapp.quit_ordered = true;
+            }
+        }
+    }
+    _sapp_call_cleanup();
+    #if defined(_SAPP_GLX)
+        _sapp_glx_release_current();
+    #else
+        _sapp_egl_release_current();
+    #endif
+    __atomic_store_n(&_sapp.x11.rt.done, true, __ATOMIC_RELEASE);
+    _sapp_linux_wake_x11_thread();
+    _sapp_linux_signal_queue_space();
+    return 0;
+}
+
+/* render thread mode: the calling thread only pumps X11 events and hands
+   them over to the render thread, which owns the GL context and calls all
+   application callbacks
+*/
+_SOKOL_PRIVATE void _sapp_linux_run_render_thread(void) {
+    #if defined(_SAPP_GLX)
+        _sapp_glx_release_current();
+    #else
+        _sapp_egl_release_current();
+    #endif
+    if (0 != pthread_create(&_sapp.x11.rt.thread, NULL, _sapp_linux_render_thread_func, NULL)) {
+        _sapp_fail("pthread_create() failed!\n");
+    }
+    while (!__atomic_load_n(&_sapp.x11.rt.done, __ATOMIC_ACQUIRE)) {
+        _sapp_x11_flush_held_move(false);
+        /* XPending() also flushes the output buffer */
+        if (0 == XPending(_sapp.x11.display)) {
+            struct pollfd fds[2];
+            memset(fds, 0, sizeof(fds));
+            fds[0].fd = ConnectionNumber(_sapp.x11.display);
+            fds[0].events = POLLIN;
+            fds[1].fd = _sapp.x11.rt.wake_fd;
+            fds[1].events = POLLIN;
+            while ((poll(fds, 2, -1) < 0) && (errno == EINTR)) {
+                /* interrupted by a signal, try again */
+            }
+            if (fds[1].revents & POLLIN) {
+                uint64_t val;
+                ssize_t res = read(_sapp.x11.rt.wake_fd, &val, sizeof(val));
+                _SOKOL_UNUSED(res);
+            }
+        }
+        int count = XPending(_sapp.x11.display);
+        while (count--) {
+            XEvent event;
+            XNextEvent(_sapp.x11.display, &event);
+            _sapp_x11_process_event(&event);
+        }
+        /* window state changes requested by the render thread, and state
+           changes caused by X11 events (e.g. mouse unlock on focus loss)
+        */
+        _sapp_linux_process_requests();
+        _sapp_linux_publish_window_state();
+    }
+    pthread_join(_sapp.x11.rt.thread, NULL);
+    #if defined(_SAPP_GLX)
+        _sapp_glx_make_current();
+    #else
+        _sapp_egl_make_current();
+    #endif
+}
+
+#if defined(_SAPP_EGL)
+/* headless mode: advance the absolute frame deadline by one frame period and
+   sleep until it's reached, a frame which took too long resets the deadline
+   instead of rendering the following frames back-to-back to catch up
+*/
+_SOKOL_PRIVATE void _sapp_linux_headless_throttle(struct timespec* deadline, long frame_ns) {
+    deadline->tv_nsec += frame_ns;
+    while (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_nsec -= 1000000000;
+        deadline->tv_sec++;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if ((now.tv_sec > deadline->tv_sec) || ((now.tv_sec == deadline->tv_sec) && (now.tv_nsec >= deadline->tv_nsec))) {
+        *deadline = now;
+        return;
+    }
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL)) {
+        /* interrupted by a signal, try again */
+    }
+}
+
+/* headless mode: no X11 display connection, no window and no events,
+   the frame callback renders into an offscreen pbuffer
+*/
+_SOKOL_PRIVATE void _sapp_linux_run_headless(void) {
+    if (0 == _sapp.window_width) {
+        _sapp.window_width = 640;
+    }
+    if (0 == _sapp.window_height) {
+        _sapp.window_height = 480;
+    }
+    _sapp.framebuffer_width = _sapp.window_width;
+    _sapp.framebuffer_height = _sapp.window_height;
+    _sapp.fullscreen = false;
+    _sapp_egl_init_headless();
+    _sapp_egl_create_headless_context();
+    _sapp.valid = true;
+    const uint64_t max_frames = (uint64_t) _sapp.desc.headless_max_frames;
+    const long frame_ns = (_sapp.desc.headless_frame_rate > 0) ? (1000000000L / _sapp.desc.headless_frame_rate) : 0;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    while (!_sapp.quit_ordered) {
+        _sapp_timing_measure(&_sapp.timing);
+        _sapp_egl_make_current();
+        _sapp_frame();
+        _sapp_egl_make_current();
+        _sapp_egl_swap_buffers();
+        if ((max_frames > 0) && (_sapp.frame_count >= max_frames)) {
+            _sapp.quit_ordered = true;
+        }
+        /* handle quit-requested from sapp_request_quit() */
+        if (_sapp.quit_requested && !_sapp.quit_ordered) {
+            _sapp_x11_app_event(SAPP_EVENTTYPE_QUIT_REQUESTED);
+            if (_sapp.quit_requested) {
+                _sapp.quit_ordered = true;
+            }
+        }
+        if ((frame_ns > 0) && !_sapp.quit_ordered) {
+            _sapp_linux_headless_throttle(&deadline, frame_ns);
+        }
+    }
+    _sapp_call_cleanup();
+    _sapp_egl_destroy_context();
+}
+#endif // _SAPP_EGL
+
 _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     /* The following lines are here to trigger a linker error instead of an
         obscure runtime error if the user has forgotten to add -pthread to
@@ -11076,6 +13563,16 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     pthread_attr_destroy(&pthread_attr);
 
     _sapp_init_state(desc);
+    _sapp_linux_init_render_on_demand();
+    #if defined(_SAPP_EGL)
+    if (_sapp.desc.headless) {
+        _sapp_linux_run_headless();
+        _sapp_linux_discard_render_on_demand();
+        _sapp_discard_state();
+        return;
+    }
+    #endif
+    _sapp_linux_init_render_thread();
     _sapp.x11.window_state = NormalState;
 
     XInitThreads();
@@ -11091,31 +13588,71 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     _sapp.dpi_scale = _sapp.x11.dpi / 96.0f;
     _sapp_x11_init_extensions();
     _sapp_x11_create_hidden_cursor();
-    _sapp_glx_init();
     Visual* visual = 0;
     int depth = 0;
-    _sapp_glx_choose_visual(&visual, &depth);
+    #if defined(_SAPP_GLX)
+        _sapp_glx_init();
+        _sapp_glx_choose_visual(&visual, &depth);
+    #else
+        _sapp_egl_init();
+        _sapp_egl_choose_visual(&visual, &depth);
+    #endif
+    _sapp.x11.visual = visual;
+    _sapp.x11.depth = depth;
     _sapp_x11_create_window(visual, depth);
-    _sapp_glx_create_context();
+    #if defined(_SAPP_GLX)
+        _sapp_glx_create_context();
+    #else
+        _sapp_egl_create_context();
+    #endif
     sapp_set_icon(&desc->icon);
     _sapp.valid = true;
+    _sapp.x11.resized_width = _sapp.window_width;
+    _sapp.x11.resized_height = _sapp.window_height;
     _sapp_x11_show_window();
     if (_sapp.fullscreen) {
         _sapp_x11_set_fullscreen(true);
     }
-    _sapp_glx_swapinterval(_sapp.swap_interval);
+    #if defined(_SAPP_GLX)
+        _sapp_glx_swapinterval(_sapp.swap_interval);
+    #else
+        _sapp_egl_swapinterval(_sapp.swap_interval);
+    #endif
     XFlush(_sapp.x11.display);
+    if (_sapp.x11.rt.active) {
+        _sapp_linux_run_render_thread();
+    }
     while (!_sapp.quit_ordered) {
+        /* the first frame is always rendered */
+        if (_sapp.desc.render_on_demand && (_sapp.frame_count > 0)) {
+            _sapp_linux_wait_for_frame();
+        }
         _sapp_timing_measure(&_sapp.timing);
-        _sapp_glx_make_current();
+        #if defined(_SAPP_GLX)
+            _sapp_glx_make_current();
+        #else
+            _sapp_egl_make_current();
+        #endif
         int count = XPending(_sapp.x11.display);
         while (count--) {
             XEvent event;
             XNextEvent(_sapp.x11.display, &event);
             _sapp_x11_process_event(&event);
         }
+        _sapp_x11_flush_mouse_move();
+        _sapp_x11_flush_resize();
+        _sapp.event_window.id = _SAPP_MAIN_WINDOW_ID;
         _sapp_frame();
-        _sapp_glx_swap_buffers();
+        #if defined(_SAPP_GLX)
+            /* the frame callback may have left an additional window active */
+            _sapp_glx_make_current();
+            _sapp_glx_swap_extra_buffers();
+            _sapp_glx_swap_buffers();
+        #else
+            _sapp_egl_swap_extra_buffers();
+            _sapp_egl_make_current();
+            _sapp_egl_swap_buffers();
+        #endif
         XFlush(_sapp.x11.display);
         /* handle quit-requested, either from window or from sapp_request_quit() */
         if (_sapp.quit_requested && !_sapp.quit_ordered) {
@@ -11127,10 +13664,23 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
             }
         }
     }
+    /* in render thread mode, the cleanup callback has already been called */
     _sapp_call_cleanup();
-    _sapp_glx_destroy_context();
+    for (int slot = 1; slot < SAPP_MAX_WINDOWS; slot++) {
+        if (_sapp.windows[slot].id) {
+            sapp_window win = { _sapp.windows[slot].id };
+            sapp_close_window(win);
+        }
+    }
+    #if defined(_SAPP_GLX)
+        _sapp_glx_destroy_context();
+    #else
+        _sapp_egl_destroy_context();
+    #endif
     _sapp_x11_destroy_window();
     XCloseDisplay(_sapp.x11.display);
+    _sapp_linux_discard_render_thread();
+    _sapp_linux_discard_render_on_demand();
     _sapp_discard_state();
 }
 
@@ -11196,8 +13746,94 @@ SOKOL_API_IMPL uint64_t sapp_frame_count(void) {
     return _sapp.frame_count;
 }
 
+SOKOL_API_IMPL double sapp_fixed_update_alpha(void) {
+    return _sapp.fixed_update.alpha;
+}
+
+SOKOL_API_IMPL double sapp_fixed_update_duration(void) {
+    return _sapp.fixed_update.tick_duration;
+}
+
+SOKOL_API_IMPL uint64_t sapp_fixed_update_count(void) {
+    return _sapp.fixed_update.tick_count;
+}
+
 SOKOL_API_IMPL double sapp_frame_duration(void) {
-    return _sapp_timing_get_avg(&_sapp.timing);
+    return _sapp_frame_duration();
+}
+
+SOKOL_API_IMPL void sapp_set_swap_interval(int interval) {
+    SOKOL_ASSERT(interval >= 0);
+    _sapp.swap_interval = interval;
+    if (!_sapp.valid) {
+        return;
+    }
+    #if defined(_SAPP_GLX)
+        _sapp_glx_swapinterval(_sapp.swap_interval);
+    #elif defined(_SAPP_EGL)
+        if (!_sapp.desc.headless) {
+            _sapp_egl_swapinterval(_sapp.swap_interval);
+        }
+    #endif
+}
+
+SOKOL_API_IMPL void sapp_set_adaptive_vsync(bool enabled) {
+    _sapp.adaptive_vsync = enabled;
+    sapp_set_swap_interval(_sapp.swap_interval);
+}
+
+SOKOL_API_IMPL bool sapp_adaptive_vsync(void) {
+    #if defined(_SAPP_GLX)
+        return _sapp_glx_adaptive_vsync();
+    #else
+        return false;
+    #endif
+}
+
+SOKOL_API_IMPL sapp_frame_stats sapp_query_frame_stats(void) {
+    sapp_frame_stats res;
+    _sapp_frame_stats_query(&_sapp.timing.stats, _sapp.desc.frame_stats_bin_width, &res);
+    return res;
+}
+
+SOKOL_API_IMPL void sapp_request_frame(void) {
+    #if defined(_SAPP_LINUX)
+    _sapp_linux_request_frame();
+    #endif
+}
+
+SOKOL_API_IMPL void sapp_add_damage_rect(int x, int y, int width, int height) {
+    #if defined(_SAPP_EGL)
+    if ((width <= 0) || (height <= 0)) {
+        return;
+    }
+    if (_sapp.egl.has_damage) {
+        _sapp.egl.damage_x0 = _sapp_min(_sapp.egl.damage_x0, x);
+        _sapp.egl.damage_y0 = _sapp_min(_sapp.egl.damage_y0, y);
+        _sapp.egl.damage_x1 = _sapp_max(_sapp.egl.damage_x1, x + width);
+        _sapp.egl.damage_y1 = _sapp_max(_sapp.egl.damage_y1, y + height);
+    }
+    else {
+        _sapp.egl.has_damage = true;
+        _sapp.egl.damage_x0 = x;
+        _sapp.egl.damage_y0 = y;
+        _sapp.egl.damage_x1 = x + width;
+        _sapp.egl.damage_y1 = y + height;
+    }
+    #else
+    _SOKOL_UNUSED(x);
+    _SOKOL_UNUSED(y);
+    _SOKOL_UNUSED(width);
+    _SOKOL_UNUSED(height);
+    #endif
+}
+
+SOKOL_API_IMPL int sapp_buffer_age(void) {
+    #if defined(_SAPP_EGL)
+    return _sapp_egl_buffer_age();
+    #else
+    return 0;
+    #endif
 }
 
 SOKOL_API_IMPL int sapp_width(void) {
@@ -11271,6 +13907,11 @@ SOKOL_API_IMPL bool sapp_keyboard_shown(void) {
 }
 
 SOKOL_API_IMPL bool sapp_is_fullscreen(void) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        return _sapp_linux_window_state(_SAPP_X11_REQ_FULLSCREEN_ON, _SAPP_X11_REQ_FULLSCREEN_OFF, _SAPP_X11_STATE_FULLSCREEN);
+    }
+    #endif
     return _sapp.fullscreen;
 }
 
@@ -11282,19 +13923,42 @@ SOKOL_API_IMPL void sapp_toggle_fullscreen(void) {
     #elif defined(_SAPP_UWP)
     _sapp_uwp_toggle_fullscreen();
     #elif defined(_SAPP_LINUX)
-    _sapp_x11_toggle_fullscreen();
+    if (_sapp.x11.rt.active) {
+        if (sapp_is_fullscreen()) {
+            _sapp_linux_post_request(_SAPP_X11_REQ_FULLSCREEN_OFF, _SAPP_X11_REQ_FULLSCREEN_ON);
+        }
+        else {
+            _sapp_linux_post_request(_SAPP_X11_REQ_FULLSCREEN_ON, _SAPP_X11_REQ_FULLSCREEN_OFF);
+        }
+    }
+    else if (!_sapp.desc.headless) {
+        _sapp_x11_toggle_fullscreen();
+    }
     #endif
 }
 
 /* NOTE that sapp_show_mouse() does not "stack" like the Win32 or macOS API functions! */
 SOKOL_API_IMPL void sapp_show_mouse(bool show) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        if (show) {
+            _sapp_linux_post_request(_SAPP_X11_REQ_MOUSE_SHOW, _SAPP_X11_REQ_MOUSE_HIDE);
+        }
+        else {
+            _sapp_linux_post_request(_SAPP_X11_REQ_MOUSE_HIDE, _SAPP_X11_REQ_MOUSE_SHOW);
+        }
+        return;
+    }
+    #endif
     if (_sapp.mouse.shown != show) {
         #if defined(_SAPP_MACOS)
         _sapp_macos_show_mouse(show);
         #elif defined(_SAPP_WIN32)
         _sapp_win32_show_mouse(show);
         #elif defined(_SAPP_LINUX)
-        _sapp_x11_show_mouse(show);
+        if (!_sapp.desc.headless) {
+            _sapp_x11_show_mouse(show);
+        }
         #elif defined(_SAPP_UWP)
         _sapp_uwp_show_mouse(show);
         #endif
@@ -11303,6 +13967,11 @@ SOKOL_API_IMPL void sapp_show_mouse(bool show) {
 }
 
 SOKOL_API_IMPL bool sapp_mouse_shown(void) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        return _sapp_linux_window_state(_SAPP_X11_REQ_MOUSE_SHOW, _SAPP_X11_REQ_MOUSE_HIDE, _SAPP_X11_STATE_MOUSE_SHOWN);
+    }
+    #endif
     return _sapp.mouse.shown;
 }
 
@@ -11314,13 +13983,28 @@ SOKOL_API_IMPL void sapp_lock_mouse(bool lock) {
     #elif defined(_SAPP_WIN32)
     _sapp_win32_lock_mouse(lock);
     #elif defined(_SAPP_LINUX)
-    _sapp_x11_lock_mouse(lock);
+    if (_sapp.x11.rt.active) {
+        if (lock) {
+            _sapp_linux_post_request(_SAPP_X11_REQ_MOUSE_LOCK, _SAPP_X11_REQ_MOUSE_UNLOCK);
+        }
+        else {
+            _sapp_linux_post_request(_SAPP_X11_REQ_MOUSE_UNLOCK, _SAPP_X11_REQ_MOUSE_LOCK);
+        }
+    }
+    else if (!_sapp.desc.headless) {
+        _sapp_x11_lock_mouse(lock);
+    }
     #else
     _sapp.mouse.locked = lock;
     #endif
 }
 
 SOKOL_API_IMPL bool sapp_mouse_locked(void) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        return _sapp_linux_window_state(_SAPP_X11_REQ_MOUSE_LOCK, _SAPP_X11_REQ_MOUSE_UNLOCK, _SAPP_X11_STATE_MOUSE_LOCKED);
+    }
+    #endif
     return _sapp.mouse.locked;
 }
 
@@ -11384,7 +14068,9 @@ SOKOL_API_IMPL void sapp_set_window_title(const char* title) {
     #elif defined(_SAPP_WIN32)
         _sapp_win32_update_window_title();
     #elif defined(_SAPP_LINUX)
-        _sapp_x11_update_window_title();
+        if (!_sapp.desc.headless) {
+            _sapp_x11_update_window_title();
+        }
     #endif
 }
 
@@ -11410,20 +14096,146 @@ SOKOL_API_IMPL void sapp_set_icon(const sapp_icon_desc* desc) {
     #elif defined(_SAPP_WIN32)
         _sapp_win32_set_icon(desc, num_images);
     #elif defined(_SAPP_LINUX)
-        _sapp_x11_set_icon(desc, num_images);
+        if (!_sapp.desc.headless) {
+            _sapp_x11_set_icon(desc, num_images);
+        }
     #elif defined(_SAPP_EMSCRIPTEN)
         _sapp_emsc_set_icon(desc, num_images);
     #endif
 }
 
+SOKOL_API_IMPL sapp_window sapp_main_window(void) {
+    sapp_window res = { _SAPP_MAIN_WINDOW_ID };
+    return res;
+}
+
+SOKOL_API_IMPL sapp_window sapp_open_window(const sapp_window_desc* desc) {
+    SOKOL_ASSERT(_sapp.valid);
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->width >= 0) && (desc->height >= 0));
+    sapp_window res = { 0 };
+    #if defined(_SAPP_LINUX)
+        if (_sapp.desc.headless || _sapp.x11.rt.active) {
+            SOKOL_LOG("sapp_open_window: not supported in headless or render thread mode");
+            return res;
+        }
+        const int slot = _sapp_alloc_window();
+        if (0 == slot) {
+            SOKOL_LOG("sapp_open_window: too many windows (SAPP_MAX_WINDOWS)");
+            return res;
+        }
+        #if defined(_SAPP_GLX)
+            const bool created = _sapp_x11_create_extra_window(slot, desc) && _sapp_glx_create_extra_window(slot);
+        #else
+            const bool created = _sapp_x11_create_extra_window(slot, desc) && _sapp_egl_create_extra_window(slot);
+        #endif
+        if (created) {
+            res.id = _sapp.windows[slot].id;
+        }
+        else {
+            SOKOL_LOG("sapp_open_window: failed to create window");
+            #if defined(_SAPP_GLX)
+                _sapp_glx_destroy_extra_window(slot);
+            #else
+                _sapp_egl_destroy_extra_window(slot);
+            #endif
+            _sapp_x11_destroy_extra_window(slot);
+            _sapp_free_window(slot);
+        }
+    #else
+        _SOKOL_UNUSED(desc);
+        SOKOL_LOG("sapp_open_window: multiple windows are not supported on this platform");
+    #endif
+    return res;
+}
+
+SOKOL_API_IMPL void sapp_close_window(sapp_window win) {
+    const _sapp_window_t* w = _sapp_lookup_window(win.id);
+    if (w && (win.id != _SAPP_MAIN_WINDOW_ID)) {
+        const int slot = _sapp_window_slot(win.id);
+        #if defined(_SAPP_GLX)
+            _sapp_glx_destroy_extra_window(slot);
+        #elif defined(_SAPP_EGL)
+            _sapp_egl_destroy_extra_window(slot);
+        #endif
+        #if defined(_SAPP_LINUX)
+            _sapp_x11_destroy_extra_window(slot);
+        #endif
+        _sapp_free_window(slot);
+    }
+}
+
+SOKOL_API_IMPL bool sapp_window_valid(sapp_window win) {
+    return 0 != _sapp_lookup_window(win.id);
+}
+
+SOKOL_API_IMPL int sapp_window_width(sapp_window win) {
+    if (win.id == _SAPP_MAIN_WINDOW_ID) {
+        return sapp_width();
+    }
+    const _sapp_window_t* w = _sapp_lookup_window(win.id);
+    return w ? w->width : 0;
+}
+
+SOKOL_API_IMPL int sapp_window_height(sapp_window win) {
+    if (win.id == _SAPP_MAIN_WINDOW_ID) {
+        return sapp_height();
+    }
+    const _sapp_window_t* w = _sapp_lookup_window(win.id);
+    return w ? w->height : 0;
+}
+
+SOKOL_API_IMPL void sapp_activate_window(sapp_window win) {
+    SOKOL_ASSERT(_sapp.valid);
+    const _sapp_window_t* w = _sapp_lookup_window(win.id);
+    if (0 == w) {
+        return;
+    }
+    #if defined(_SAPP_GLX)
+        if (win.id == _SAPP_MAIN_WINDOW_ID) {
+            _sapp_glx_make_current();
+        }
+        else {
+            _sapp_glx_make_current_extra(_sapp_window_slot(win.id));
+        }
+    #elif defined(_SAPP_EGL)
+        if (win.id == _SAPP_MAIN_WINDOW_ID) {
+            _sapp_egl_make_current();
+        }
+        else {
+            _sapp_egl_make_current_extra(_sapp_window_slot(win.id));
+        }
+    #endif
+}
+
 SOKOL_API_IMPL int sapp_get_num_dropped_files(void) {
     SOKOL_ASSERT(_sapp.drop.enabled);
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        return _sapp.x11.rt.drop_num_files;
+    }
+    #endif
     return _sapp.drop.num_files;
 }
 
+SOKOL_API_IMPL int sapp_get_num_mouse_samples(void) {
+    return _sapp.mouse.history.num;
+}
+
+SOKOL_API_IMPL sapp_mouse_sample sapp_get_mouse_sample(int index) {
+    SOKOL_ASSERT((index >= 0) && (index < _sapp.mouse.history.num));
+    sapp_mouse_sample res;
+    memset(&res, 0, sizeof(res));
+    const _sapp_mouse_history_t* h = &_sapp.mouse.history;
+    if ((index >= 0) && (index < h->num)) {
+        res = h->samples[(h->start + index) % h->size];
+    }
+    return res;
+}
+
 SOKOL_API_IMPL const char* sapp_get_dropped_file_path(int index) {
     SOKOL_ASSERT(_sapp.drop.enabled);
-    SOKOL_ASSERT((index >= 0) && (index < _sapp.drop.num_files));
+    SOKOL_ASSERT((index >= 0) && (index < sapp_get_num_dropped_files()));
     SOKOL_ASSERT(_sapp.drop.buffer);
     if (!_sapp.drop.enabled) {
         return "";
@@ -11431,6 +14243,11 @@ SOKOL_API_IMPL const char* sapp_get_dropped_file_path(int index) {
     if ((index < 0) || (index >= _sapp.drop.max_files)) {
         return "";
     }
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.rt.active) {
+        return (const char*) &_sapp.x11.rt.drop_buffer[index * _sapp.drop.max_path_length];
+    }
+    #endif
     return (const char*) _sapp_dropped_file_path_ptr(index);
 }
 
@@ -110,6 +110,11 @@
 
         ...which takes the framebuffer width and height as float values.
 
+    --- or start rendering to an explicit swapchain (for instance the
+        default framebuffer of an additional window) with:
+
+            sg_begin_swapchain_pass(const sg_swapchain* swapchain, const sg_pass_action* action)
+
     --- or start rendering to an offscreen framebuffer with:
 
             sg_begin_pass(sg_pass pass, const sg_pass_action* action)
@@ -167,6 +172,7 @@
             sg_destroy_shader(sg_shader shd)
             sg_destroy_pipeline(sg_pipeline pip)
             sg_destroy_pass(sg_pass pass)
+            sg_destroy_query(sg_query qry)
 
     --- to set a new viewport rectangle, call
 
@@ -249,6 +255,19 @@
 
             bool sg_query_buffer_overflow(sg_buffer buf)
 
+        Buffers created with sg_buffer_desc.ring = true behave as GPU ring
+        buffers: the append cursor is *not* rewound at the start of a frame,
+        instead appended data wraps around to the start of the buffer. A ring
+        buffer only goes into the overflow state when an append would overwrite
+        data which is still in use by a frame the GPU hasn't finished yet
+        (this is tracked with fences where the 3D-API provides them, on GL
+        fences are only inserted while at least one ring buffer exists). This
+        allows a modestly sized buffer to absorb frames with spiky amounts of
+        streamed data, as long as the average amount per frame fits. Ring
+        buffers cannot be updated with sg_update_buffer(). On D3D11, ring
+        buffers are mapped with D3D11_MAP_WRITE_NO_OVERWRITE, and only with
+        D3D11_MAP_WRITE_DISCARD when the append cursor wraps around.
+
         NOTE: Due to restrictions in underlying 3D-APIs, appended chunks of
         data will be 4-byte aligned in the destination buffer. This means
         that there will be gaps in index buffers containing 16-bit indices
@@ -257,6 +276,40 @@
         is associated with one draw call, but will be problematic when
         a single indexed draw call spans several appended chunks of indices.
 
+    --- to stream the mipmaps of a large immutable image progressively, create
+        the image with sg_image_desc.streaming = true and only provide data
+        for the low-resolution mip tail (for instance mips 5..9 of a 512x512
+        image), the higher resolution mips are left empty:
+
+            sg_image img = sg_make_image(&(sg_image_desc){
+                .width = 512,
+                .height = 512,
+                .num_mipmaps = 10,
+                .pixel_format = SG_PIXELFORMAT_BC1_RGBA,
+                .streaming = true,
+                .data.subimage[0] = {
+                    [5] = SG_RANGE(mip5), [6] = SG_RANGE(mip6), ...
+                }
+            });
+
+        The image can be used for rendering right away, sampling is clamped
+        to the resident mips. Higher-resolution mips are provided later
+        (for instance after they have been loaded with sokol_fetch.h) one
+        at a time, going from lower to higher resolution:
+
+            sg_update_image_mip(img, 4, &(sg_image_data){ .subimage[0][4] = SG_RANGE(mip4) });
+
+        The data for mip_index must be in sg_image_data.subimage[face][mip_index].
+        Unlike sg_update_image(), sg_update_image_mip() may be called several
+        times per frame. The lowest currently resident mip is available in
+        sg_query_image_info().resident_mip. Calls with a mip_index outside
+        the image's mip chain or out of order are ignored (and reported
+        by the validation layer).
+
+        Streaming images are only supported when sg_query_features().mip_streaming
+        is true (GL 3.3, GLES3/WebGL2, D3D11). On GL the sampled mip range is
+        clamped with GL_TEXTURE_BASE_LEVEL, on D3D11 with SetResourceMinLOD().
+
     --- to check at runtime for optional features, limits and pixelformat support,
         call:
 
@@ -579,6 +632,119 @@
 
     https://github.com/floooh/sokol-samples/blob/master/glfw/multiwindow-glfw.c
 
+    BUFFER ARENAS
+    =============
+    Applications with many small meshes can avoid the per-object overhead
+    of one 3D-API buffer per sg_buffer by sub-allocating immutable buffers
+    from a few large "arena buffers".
+
+    --- create an arena buffer by setting sg_buffer_desc.arena to true,
+        and providing the arena capacity in .size (the data item must
+        be zero-initialized):
+
+            sg_buffer arena = sg_make_buffer(&(sg_buffer_desc){
+                .arena = true,
+                .type = SG_BUFFERTYPE_VERTEXBUFFER,
+                .size = 16 * 1024 * 1024
+            });
+
+        The arena size will be rounded up to the next power-of-two multiple
+        of the arena's block size (256 bytes).
+
+    --- sub-allocate an immutable buffer from the arena by setting
+        sg_buffer_desc.parent to the arena buffer, the buffer type defaults
+        to (and must be the same as) the arena's buffer type:
+
+            sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){
+                .parent = arena,
+                .data = SG_RANGE(vertices)
+            });
+
+        If the arena is exhausted, the sub-allocated buffer will be in
+        the FAILED resource state.
+
+    --- sub-allocated buffers are used like any other buffer in the
+        sg_bindings struct, sokol-gfx will substitute the arena buffer
+        and add the buffer's offset in the arena to the vertex- or
+        index-buffer offset. Since all buffers in an arena share the
+        same 3D-API buffer object, redundant buffer bindings will be
+        filtered by the state cache.
+
+    --- the byte offset of a sub-allocated buffer in its arena can be
+        queried with sg_query_buffer_info() in the .arena_offset item
+        (for instance to compute a base_element for sg_draw())
+
+    --- destroying a sub-allocated buffer returns its range to the arena,
+        destroying an arena buffer invalidates all buffers which have
+        been sub-allocated from it, any draw calls using those buffers
+        will be dropped
+
+    The arena uses a binary buddy allocator, each sub-allocation
+    occupies a power-of-two multiple of the 256 byte block size, which
+    also guarantees a 256 byte alignment of all sub-allocated buffers.
+
+    Buffer arenas are currently only supported on the GL and dummy
+    backends, check sg_query_features().buffer_arenas at runtime.
+
+    OCCLUSION QUERIES
+    =================
+    Occlusion queries allow to skip rendering expensive objects which
+    were completely hidden in a previous frame (for instance by first
+    rendering a cheap bounding box inside the query). Check
+    sg_query_features().occlusion_query whether occlusion queries are
+    supported.
+
+    --- create a query object with:
+
+            sg_query qry = sg_make_query(&(sg_query_object_desc){
+                .type = SG_QUERYTYPE_OCCLUSION  // this is the default
+            });
+
+    --- inside a render pass, wrap the draw calls to be tested into:
+
+            sg_begin_query(qry);
+            ...
+            sg_end_query();
+
+        Queries cannot be nested, and a query must be ended in the same
+        render pass it was started in. A query (or conditional rendering)
+        which is still active in sg_end_pass() is ended there, and reported
+        as error by the validation layer. Destroying an active query also
+        ends it first.
+
+    --- poll the most recent result with:
+
+            sg_query_result res = sg_poll_query(qry);
+
+        sg_poll_query() never waits for the GPU, results usually become
+        available one or more frames after the query was issued. If
+        res.available is false, no result has arrived yet and the object
+        should be treated as visible. res.frame_index is the frame index
+        (see sg_query_frame_index()) in which the returned result was
+        issued.
+
+        Each query object owns a small ring of backend query objects, if
+        all of them are still waiting for their result, sg_begin_query()
+        will silently skip the query instead of stalling the CPU.
+
+    --- alternatively (or additionally), the GPU can skip draw calls based
+        on the last query result without any CPU round-trip:
+
+            sg_begin_conditional_render(qry);
+            ...
+            sg_end_conditional_render();
+
+        If the result of the most recently ended query on qry isn't
+        available yet, the draw calls will be performed. Conditional
+        rendering is only supported when sg_query_features().conditional_render
+        is true, otherwise the functions are no-ops and all draw calls
+        will be performed.
+
+    Occlusion queries are currently supported on the GL (except GLES2/WebGL)
+    and dummy backends, conditional rendering only on desktop GL. On D3D11,
+    Metal and WebGPU, sg_query_features().occlusion_query is false and
+    sg_make_query() returns a query in FAILED state.
+
     TRACE HOOKS:
     ============
     sokol_gfx.h optionally allows to install "trace hook" callbacks for
@@ -732,6 +898,7 @@ typedef struct sg_image    { uint32_t id; } sg_image;
 typedef struct sg_shader   { uint32_t id; } sg_shader;
 typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
+typedef struct sg_query    { uint32_t id; } sg_query;
 typedef struct sg_context  { uint32_t id; } sg_context;
 
 /*
@@ -771,7 +938,8 @@ enum {
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,      /* NOTE: actual max vertex attrs can be less on GLES2, see sg_limits! */
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_SWAPCHAINS = 8
 };
 
 /*
@@ -959,6 +1127,10 @@ typedef struct sg_features {
     bool image_clamp_to_border;         // border color and clamp-to-border UV-wrap mode is supported
     bool mrt_independent_blend_state;   // multiple-render-target rendering can use per-render-target blend state
     bool mrt_independent_write_mask;    // multiple-render-target rendering can use per-render-target color write masks
+    bool buffer_arenas;                 // buffers can be sub-allocated from arena buffers (see BUFFER ARENAS)
+    bool occlusion_query;               // occlusion queries are supported (see OCCLUSION QUERIES)
+    bool conditional_render;            // draw calls can be skipped based on an occlusion query result
+    bool mip_streaming;                 // immutable images can be created with a partial mip chain (sg_image_desc.streaming)
     #if defined(SOKOL_ZIG_BINDINGS)
     uint32_t __pad[3];
     #endif
@@ -977,6 +1149,14 @@ typedef struct sg_limits {
     int gl_max_vertex_uniform_vectors;  // <= GL_MAX_VERTEX_UNIFORM_VECTORS (only on GL backends)
 } sg_limits;
 
+/*
+    Cumulative runtime statistics since sg_setup(), returned by sg_query_stats()
+*/
+typedef struct sg_stats {
+    uint32_t uniform_cache_hits;    // sg_apply_uniforms() calls which skipped the upload (see sg_gl_context_desc.uniform_cache)
+    uint32_t uniform_cache_misses;  // sg_apply_uniforms() calls which uploaded changed uniform data
+} sg_stats;
+
 /*
     sg_resource_state
 
@@ -1601,10 +1781,24 @@ typedef enum sg_action {
     - SG_DEFAULT_CLEAR_ALPHA:   1.0f
     - SG_DEFAULT_CLEAR_DEPTH:   1.0f
     - SG_DEFAULT_CLEAR_STENCIL: 0
+
+    In offscreen passes with MSAA render targets, the color attachments
+    are resolved into their images at the end of the pass. Set the
+    'dont_resolve' flag of a color attachment action to skip the resolve
+    for attachments which are only needed while the pass is active (for
+    instance all but the first attachment of a G-buffer pass). The
+    image content of a skipped attachment isn't updated in this pass.
+
+    On GL, the resolve is restricted to the area touched by draw calls
+    in the pass (the intersection of viewport and scissor rect at each
+    draw call), or the whole attachment if any color attachment is
+    cleared. Multisampled depth-stencil attachments are never resolved,
+    since sokol_gfx.h depth-stencil images can't be sampled.
 */
 typedef struct sg_color_attachment_action {
     sg_action action;
     sg_color value;
+    bool dont_resolve;      /* MSAA passes only: don't resolve into the attachment image at the end of the pass */
 } sg_color_attachment_action;
 
 typedef struct sg_depth_attachment_action {
@@ -1625,6 +1819,91 @@ typedef struct sg_pass_action {
     uint32_t _end_canary;
 } sg_pass_action;
 
+/*
+    sg_swapchain
+
+    The sg_swapchain struct describes an explicit default framebuffer
+    (for instance the swapchain of an additional window) in the function
+    sg_begin_swapchain_pass(). While sg_begin_default_pass() obtains the
+    default framebuffer through the callbacks in sg_context_desc, the
+    swapchain pass takes the 3D-API-specific objects directly from this
+    struct:
+
+    .width, .height
+        the size of the swapchain surface in pixels
+
+    .color_format, .depth_format, .sample_count
+        the pixel formats and MSAA sample count of the swapchain surface,
+        zero-initialized items default to the values in sg_desc.context
+
+    GL specific:
+        .gl.framebuffer
+            the GL framebuffer object to render into, this is usually
+            0 for the default framebuffer of the window's drawable,
+            the GL context must have been made current on that window
+            before calling sg_begin_swapchain_pass()
+
+    Metal specific:
+        .metal.render_pass_descriptor
+            a bridged MTLRenderPassDescriptor for the swapchain surface
+        .metal.drawable
+            an optional bridged MTLDrawable which will be presented
+            in sg_commit() (at most SG_MAX_SWAPCHAINS swapchain drawables
+            can be presented per frame), the caller must hold a strong
+            reference to the drawable until sg_commit() returns
+
+    D3D11 specific:
+        .d3d11.render_target_view
+            the ID3D11RenderTargetView of the swapchain surface
+        .d3d11.depth_stencil_view
+            an optional ID3D11DepthStencilView
+
+    WebGPU specific:
+        .wgpu.render_view
+        .wgpu.resolve_view
+        .wgpu.depth_stencil_view
+            the WGPUTextureView objects of the swapchain surface (see
+            the equivalent callbacks in sg_wgpu_context_desc)
+
+    All swapchains must have the same pixel formats and sample count as the
+    default framebuffer described in sg_desc.context, so that the same
+    pipeline objects can be used for all of them (this is checked by the
+    validation layer).
+*/
+typedef struct sg_gl_swapchain {
+    uint32_t framebuffer;
+} sg_gl_swapchain;
+
+typedef struct sg_metal_swapchain {
+    const void* render_pass_descriptor;
+    const void* drawable;
+} sg_metal_swapchain;
+
+typedef struct sg_d3d11_swapchain {
+    const void* render_target_view;
+    const void* depth_stencil_view;
+} sg_d3d11_swapchain;
+
+typedef struct sg_wgpu_swapchain {
+    const void* render_view;
+    const void* resolve_view;
+    const void* depth_stencil_view;
+} sg_wgpu_swapchain;
+
+typedef struct sg_swapchain {
+    uint32_t _start_canary;
+    int width;
+    int height;
+    sg_pixel_format color_format;
+    sg_pixel_format depth_format;
+    int sample_count;
+    sg_gl_swapchain gl;
+    sg_metal_swapchain metal;
+    sg_d3d11_swapchain d3d11;
+    sg_wgpu_swapchain wgpu;
+    uint32_t _end_canary;
+} sg_swapchain;
+
 /*
     sg_bindings
 
@@ -1672,6 +1951,9 @@ typedef struct sg_bindings {
     .usage:     SG_USAGE_IMMUTABLE
     .data.ptr   0       (*must* be valid for immutable buffers)
     .data.size  0       (*must* be > 0 for immutable buffers)
+    .arena      false   (create a sub-allocation arena, see BUFFER ARENAS)
+    .parent     { SG_INVALID_ID } (sub-allocate from this arena, see BUFFER ARENAS)
+    .ring       false   (sg_append_buffer() wraps around instead of rewinding each frame)
     .label      0       (optional string label for trace hooks)
 
     The label will be ignored by sokol_gfx.h, it is only useful
@@ -1718,6 +2000,9 @@ typedef struct sg_buffer_desc {
     sg_buffer_type type;
     sg_usage usage;
     sg_range data;
+    bool arena;
+    sg_buffer parent;
+    bool ring;
     const char* label;
     /* GL specific */
     uint32_t gl_buffers[SG_NUM_INFLIGHT_FRAMES];
@@ -1767,6 +2052,7 @@ typedef struct sg_image_data {
     .max_anisotropy     1 (must be 1..16)
     .min_lod            0.0f
     .max_lod            FLT_MAX
+    .streaming          false   (only the mip tail is initialized, see sg_update_image_mip())
     .data               an sg_image_data struct to define the initial content
     .label              0       (optional string label for trace hooks)
 
@@ -1787,7 +2073,8 @@ typedef struct sg_image_data {
     3D-textures are supported.
 
     Images with usage SG_USAGE_IMMUTABLE must be fully initialized by
-    providing a valid .data member which points to initialization data.
+    providing a valid .data member which points to initialization data,
+    except for streaming images where only the mip tail must be initialized.
 
     ADVANCED TOPIC: Injecting native 3D-API textures:
 
@@ -1831,6 +2118,7 @@ typedef struct sg_image_desc {
     uint32_t max_anisotropy;
     float min_lod;
     float max_lod;
+    bool streaming;
     sg_image_data data;
     const char* label;
     /* GL specific */
@@ -2111,6 +2399,53 @@ typedef struct sg_pass_desc {
     uint32_t _end_canary;
 } sg_pass_desc;
 
+/*
+    sg_query_type
+
+    The type of a query object, used in sg_query_object_desc.type, currently
+    only occlusion queries are supported:
+
+    SG_QUERYTYPE_OCCLUSION: returns whether any samples passed the
+        depth- and stencil-test between sg_begin_query() and sg_end_query()
+
+    The default query type is SG_QUERYTYPE_OCCLUSION.
+*/
+typedef enum sg_query_type {
+    _SG_QUERYTYPE_DEFAULT,  /* value 0 reserved for default-init */
+    SG_QUERYTYPE_OCCLUSION,
+    _SG_QUERYTYPE_NUM,
+    _SG_QUERYTYPE_FORCE_U32 = 0x7FFFFFFF
+} sg_query_type;
+
+/*
+    sg_query_object_desc
+
+    Creation parameters for sg_query objects, used in the
+    sg_make_query() call.
+
+    The default configuration is:
+
+    .type:      SG_QUERYTYPE_OCCLUSION
+    .label      0       (optional string label for trace hooks)
+*/
+typedef struct sg_query_object_desc {
+    uint32_t _start_canary;
+    sg_query_type type;
+    const char* label;
+    uint32_t _end_canary;
+} sg_query_object_desc;
+
+/*
+    sg_query_result
+
+    The most recent result of a query object, returned by sg_poll_query().
+*/
+typedef struct sg_query_result {
+    bool available;         /* true if a result has arrived */
+    bool visible;           /* occlusion query: true if any samples passed */
+    uint32_t frame_index;   /* the frame index in which the query was issued */
+} sg_query_result;
+
 /*
     sg_trace_hooks
 
@@ -2131,15 +2466,19 @@ typedef struct sg_trace_hooks {
     void (*make_shader)(const sg_shader_desc* desc, sg_shader result, void* user_data);
     void (*make_pipeline)(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data);
     void (*make_pass)(const sg_pass_desc* desc, sg_pass result, void* user_data);
+    void (*make_query)(const sg_query_object_desc* desc, sg_query result, void* user_data);
     void (*destroy_buffer)(sg_buffer buf, void* user_data);
     void (*destroy_image)(sg_image img, void* user_data);
     void (*destroy_shader)(sg_shader shd, void* user_data);
     void (*destroy_pipeline)(sg_pipeline pip, void* user_data);
     void (*destroy_pass)(sg_pass pass, void* user_data);
+    void (*destroy_query)(sg_query qry, void* user_data);
     void (*update_buffer)(sg_buffer buf, const sg_range* data, void* user_data);
     void (*update_image)(sg_image img, const sg_image_data* data, void* user_data);
+    void (*update_image_mip)(sg_image img, int mip_index, const sg_image_data* data, void* user_data);
     void (*append_buffer)(sg_buffer buf, const sg_range* data, int result, void* user_data);
     void (*begin_default_pass)(const sg_pass_action* pass_action, int width, int height, void* user_data);
+    void (*begin_swapchain_pass)(const sg_swapchain* swapchain, const sg_pass_action* pass_action, void* user_data);
     void (*begin_pass)(sg_pass pass, const sg_pass_action* pass_action, void* user_data);
     void (*apply_viewport)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
     void (*apply_scissor_rect)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
@@ -2147,6 +2486,10 @@ typedef struct sg_trace_hooks {
     void (*apply_bindings)(const sg_bindings* bindings, void* user_data);
     void (*apply_uniforms)(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data);
     void (*draw)(int base_element, int num_elements, int num_instances, void* user_data);
+    void (*begin_query)(sg_query qry, void* user_data);
+    void (*end_query)(void* user_data);
+    void (*begin_conditional_render)(sg_query qry, void* user_data);
+    void (*end_conditional_render)(void* user_data);
     void (*end_pass)(void* user_data);
     void (*commit)(void* user_data);
     void (*alloc_buffer)(sg_buffer result, void* user_data);
@@ -2181,6 +2524,7 @@ typedef struct sg_trace_hooks {
     void (*err_shader_pool_exhausted)(void* user_data);
     void (*err_pipeline_pool_exhausted)(void* user_data);
     void (*err_pass_pool_exhausted)(void* user_data);
+    void (*err_query_pool_exhausted)(void* user_data);
     void (*err_context_mismatch)(void* user_data);
     void (*err_pass_invalid)(void* user_data);
     void (*err_draw_invalid)(void* user_data);
@@ -2222,6 +2566,7 @@ typedef struct sg_buffer_info {
     bool append_overflow;           /* is buffer in overflow state (due to sg_append_buffer) */
     int num_slots;                  /* number of renaming-slots for dynamically updated buffers */
     int active_slot;                /* currently active write-slot for dynamically updated buffers */
+    int arena_offset;               /* byte offset of a sub-allocated buffer in its arena buffer */
 } sg_buffer_info;
 
 typedef struct sg_image_info {
@@ -2231,6 +2576,8 @@ typedef struct sg_image_info {
     int active_slot;                /* currently active write-slot for dynamically updated images */
     int width;                      /* image width */
     int height;                     /* image height */
+    int resident_mip;               /* lowest resident mip of a streaming image (0 for other images) */
+    sg_pixel_format pixel_format;   /* image pixel format */
 } sg_image_info;
 
 typedef struct sg_shader_info {
@@ -2265,10 +2612,21 @@ typedef struct sg_pass_info {
     .shader_pool_size       32
     .pipeline_pool_size     64
     .pass_pool_size         16
+    .query_pool_size        64
     .context_pool_size      16
     .sampler_cache_size     64
     .uniform_buffer_size    4 MB (4*1024*1024)
     .staging_buffer_size    8 MB (8*1024*1024)
+    .validation_cache       false
+
+    .validation_cache: only relevant when the validation layer is active
+        (SOKOL_DEBUG), if true, each pipeline remembers the last pass and
+        the last 4 resource bindings which passed validation in
+        sg_apply_pipeline() and sg_apply_bindings(), and repeating such a
+        call skips the validation (including all resource lookups) until
+        any resource is destroyed or a buffer overflows, this makes
+        debug builds much cheaper when the same pipeline is used with
+        the same bindings for many draws
 
     .context.color_format: default value depends on selected backend:
         all GL backends:    SG_PIXELFORMAT_RGBA8
@@ -2282,6 +2640,12 @@ typedef struct sg_pass_info {
             if this is true the GL backend will act in "GLES2 fallback mode" even
             when compiled with SOKOL_GLES3, this is useful to fall back
             to traditional WebGL if a browser doesn't support a WebGL2 context
+        .context.gl.uniform_cache
+            if this is true, the GL backend keeps a copy of the last uniform
+            data applied to each shader uniform block, and skips the glUniform*()
+            calls in sg_apply_uniforms() if the data is byte-identical (GL programs
+            keep their uniform values), the hit- and miss-counts can be
+            inspected with sg_query_stats()
 
     Metal specific:
         (NOTE: All Objective-C object references are transferred through
@@ -2358,6 +2722,7 @@ typedef struct sg_pass_info {
 */
 typedef struct sg_gl_context_desc {
     bool force_gles2;
+    bool uniform_cache;
 } sg_gl_context_desc;
 
 typedef struct sg_metal_context_desc {
@@ -2407,10 +2772,12 @@ typedef struct sg_desc {
     int shader_pool_size;
     int pipeline_pool_size;
     int pass_pool_size;
+    int query_pool_size;
     int context_pool_size;
     int uniform_buffer_size;
     int staging_buffer_size;
     int sampler_cache_size;
+    bool validation_cache;
     sg_context_desc context;
     uint32_t _end_canary;
 } sg_desc;
@@ -2430,19 +2797,23 @@ SOKOL_GFX_API_DECL sg_image sg_make_image(const sg_image_desc* desc);
 SOKOL_GFX_API_DECL sg_shader sg_make_shader(const sg_shader_desc* desc);
 SOKOL_GFX_API_DECL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc);
 SOKOL_GFX_API_DECL sg_pass sg_make_pass(const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL sg_query sg_make_query(const sg_query_object_desc* desc);
 SOKOL_GFX_API_DECL void sg_destroy_buffer(sg_buffer buf);
 SOKOL_GFX_API_DECL void sg_destroy_image(sg_image img);
 SOKOL_GFX_API_DECL void sg_destroy_shader(sg_shader shd);
 SOKOL_GFX_API_DECL void sg_destroy_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_destroy_pass(sg_pass pass);
+SOKOL_GFX_API_DECL void sg_destroy_query(sg_query qry);
 SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_data* data);
+SOKOL_GFX_API_DECL void sg_update_image_mip(sg_image img, int mip_index, const sg_image_data* data);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
 
 /* rendering functions */
 SOKOL_GFX_API_DECL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height);
 SOKOL_GFX_API_DECL void sg_begin_default_passf(const sg_pass_action* pass_action, float width, float height);
+SOKOL_GFX_API_DECL void sg_begin_swapchain_pass(const sg_swapchain* swapchain, const sg_pass_action* pass_action);
 SOKOL_GFX_API_DECL void sg_begin_pass(sg_pass pass, const sg_pass_action* pass_action);
 SOKOL_GFX_API_DECL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_viewportf(float x, float y, float width, float height, bool origin_top_left);
@@ -2452,6 +2823,10 @@ SOKOL_GFX_API_DECL void sg_apply_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_apply_bindings(const sg_bindings* bindings);
 SOKOL_GFX_API_DECL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_draw(int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_begin_query(sg_query qry);
+SOKOL_GFX_API_DECL void sg_end_query(void);
+SOKOL_GFX_API_DECL void sg_begin_conditional_render(sg_query qry);
+SOKOL_GFX_API_DECL void sg_end_conditional_render(void);
 SOKOL_GFX_API_DECL void sg_end_pass(void);
 SOKOL_GFX_API_DECL void sg_commit(void);
 
@@ -2460,6 +2835,7 @@ SOKOL_GFX_API_DECL sg_desc sg_query_desc(void);
 SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
 SOKOL_GFX_API_DECL sg_features sg_query_features(void);
 SOKOL_GFX_API_DECL sg_limits sg_query_limits(void);
+SOKOL_GFX_API_DECL sg_stats sg_query_stats(void);
 SOKOL_GFX_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_GFX_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
@@ -2467,6 +2843,9 @@ SOKOL_GFX_API_DECL sg_resource_state sg_query_image_state(sg_image img);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_shader_state(sg_shader shd);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pipeline_state(sg_pipeline pip);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pass_state(sg_pass pass);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_state(sg_query qry);
+/* get the most recent result of a query object (never waits for the GPU) */
+SOKOL_GFX_API_DECL sg_query_result sg_poll_query(sg_query qry);
 /* get runtime information about a resource */
 SOKOL_GFX_API_DECL sg_buffer_info sg_query_buffer_info(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_image_info sg_query_image_info(sg_image img);
@@ -2538,10 +2917,12 @@ inline sg_image sg_make_image(const sg_image_desc& desc) { return sg_make_image(
 inline sg_shader sg_make_shader(const sg_shader_desc& desc) { return sg_make_shader(&desc); }
 inline sg_pipeline sg_make_pipeline(const sg_pipeline_desc& desc) { return sg_make_pipeline(&desc); }
 inline sg_pass sg_make_pass(const sg_pass_desc& desc) { return sg_make_pass(&desc); }
+inline sg_query sg_make_query(const sg_query_object_desc& desc) { return sg_make_query(&desc); }
 inline void sg_update_image(sg_image img, const sg_image_data& data) { return sg_update_image(img, &data); }
 
 inline void sg_begin_default_pass(const sg_pass_action& pass_action, int width, int height) { return sg_begin_default_pass(&pass_action, width, height); }
 inline void sg_begin_default_passf(const sg_pass_action& pass_action, float width, float height) { return sg_begin_default_passf(&pass_action, width, height); }
+inline void sg_begin_swapchain_pass(const sg_swapchain& swapchain, const sg_pass_action& pass_action) { return sg_begin_swapchain_pass(&swapchain, &pass_action); }
 inline void sg_begin_pass(sg_pass pass, const sg_pass_action& pass_action) { return sg_begin_pass(pass, &pass_action); }
 inline void sg_apply_bindings(const sg_bindings& bindings) { return sg_apply_bindings(&bindings); }
 inline void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range& data) { return sg_apply_uniforms(stage, ub_index, &data); }
@@ -2821,6 +3202,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_READ_FRAMEBUFFER 0x8CA8
         #define GL_TEXTURE0 0x84C0
         #define GL_TEXTURE_MIN_LOD 0x813A
+        #define GL_TEXTURE_BASE_LEVEL 0x813C
         #define GL_CLAMP_TO_EDGE 0x812F
         #define GL_UNSIGNED_SHORT_5_6_5 0x8363
         #define GL_TEXTURE_WRAP_R 0x8072
@@ -2982,6 +3364,15 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_TEXTURE_BORDER_COLOR 0x1004
         #define GL_CURRENT_PROGRAM 0x8B8D
         #define GL_MAX_VERTEX_UNIFORM_VECTORS 0x8DFB
+        #define GL_ANY_SAMPLES_PASSED 0x8C2F
+        #define GL_QUERY_RESULT 0x8866
+        #define GL_QUERY_RESULT_AVAILABLE 0x8867
+        #define GL_QUERY_NO_WAIT 0x8E14
+        #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+        #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+        #define GL_ALREADY_SIGNALED 0x911A
+        #define GL_TIMEOUT_EXPIRED 0x911B
+        #define GL_CONDITION_SATISFIED 0x911C
     #endif
 
     #ifndef GL_UNSIGNED_INT_2_10_10_10_REV
@@ -3112,6 +3503,7 @@ enum {
     _SG_DEFAULT_SHADER_POOL_SIZE = 32,
     _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
     _SG_DEFAULT_PASS_POOL_SIZE = 16,
+    _SG_DEFAULT_QUERY_POOL_SIZE = 64,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
@@ -3131,18 +3523,232 @@ typedef struct {
 #define _sg_clamp(v,v0,v1) (((v)<(v0))?(v0):(((v)>(v1))?(v1):(v)))
 #define _sg_fequal(val,cmp,delta) ((((val)-(cmp))> -(delta))&&(((val)-(cmp))<(delta)))
 
+/*
+    buffer arena allocator: a binary buddy allocator which only keeps
+    track of byte ranges, the actual memory lives in the arena's
+    3D-API buffer object
+
+    The allocation state is kept in a complete binary tree with one byte
+    per node, a node's value is 0 if the node's range is completely
+    allocated, otherwise it is log2(largest free block in node range)+1,
+    where the block size unit is _SG_ARENA_BLOCK_SIZE.
+*/
+#define _SG_ARENA_BLOCK_SIZE (256)
+
+typedef struct {
+    int num_levels;     /* 0 if the buffer isn't an arena */
+    int num_blocks;     /* always a power of 2 */
+    uint8_t* nodes;     /* (2*num_blocks - 1) tree nodes */
+} _sg_arena_t;
+
+/* round an arena size up to a power-of-two multiple of the arena block size */
+_SOKOL_PRIVATE size_t _sg_arena_roundup_size(size_t size) {
+    size_t res = _SG_ARENA_BLOCK_SIZE;
+    while (res < size) {
+        res <<= 1;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE void _sg_arena_init(_sg_arena_t* arena, int size) {
+    SOKOL_ASSERT(arena && (0 == arena->nodes));
+    SOKOL_ASSERT((size >= _SG_ARENA_BLOCK_SIZE) && ((size % _SG_ARENA_BLOCK_SIZE) == 0));
+    arena->num_blocks = size / _SG_ARENA_BLOCK_SIZE;
+    SOKOL_ASSERT((arena->num_blocks & (arena->num_blocks - 1)) == 0);
+    arena->num_levels = 0;
+    while ((1 << arena->num_levels) < arena->num_blocks) {
+        arena->num_levels++;
+    }
+    const int num_nodes = 2 * arena->num_blocks - 1;
+    arena->nodes = (uint8_t*) SOKOL_MALLOC((size_t)num_nodes);
+    SOKOL_ASSERT(arena->nodes);
+    int level_start = 0;
+    for (int depth = 0; depth <= arena->num_levels; depth++) {
+        const int level_end = 2 * level_start + 1;
+        for (int i = level_start; i < level_end; i++) {
+            arena->nodes[i] = (uint8_t)(arena->num_levels - depth + 1);
+        }
+        level_start = level_end;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_arena_discard(_sg_arena_t* arena) {
+    SOKOL_ASSERT(arena);
+    if (arena->nodes) {
+        SOKOL_FREE(arena->nodes);
+        arena->nodes = 0;
+    }
+    arena->num_levels = 0;
+    arena->num_blocks = 0;
+}
+
+/* allocate a range of at least size bytes, returns the byte offset, or -1 if the arena is exhausted */
+_SOKOL_PRIVATE int _sg_arena_alloc(_sg_arena_t* arena, int size) {
+    SOKOL_ASSERT(arena && arena->nodes && (size > 0));
+    int level = 0;
+    while ((_SG_ARENA_BLOCK_SIZE << level) < size) {
+        level++;
+    }
+    const uint8_t need = (uint8_t)(level + 1);
+    if (arena->nodes[0] < need) {
+        return -1;
+    }
+    int index = 0;
+    int depth = 0;
+    while ((arena->num_levels - depth) != level) {
+        const int left = 2 * index + 1;
+        index = (arena->nodes[left] >= need) ? left : (left + 1);
+        depth++;
+    }
+    arena->nodes[index] = 0;
+    const int node_blocks = arena->num_blocks >> depth;
+    const int offset = ((index + 1) * node_blocks - arena->num_blocks) * _SG_ARENA_BLOCK_SIZE;
+    /* update the ancestors' largest free blocks */
+    while (index > 0) {
+        index = (index - 1) / 2;
+        const uint8_t l = arena->nodes[2 * index + 1];
+        const uint8_t r = arena->nodes[2 * index + 2];
+        arena->nodes[index] = (uint8_t)_sg_max(l, r);
+    }
+    return offset;
+}
+
+_SOKOL_PRIVATE void _sg_arena_free(_sg_arena_t* arena, int offset) {
+    SOKOL_ASSERT(arena && arena->nodes);
+    SOKOL_ASSERT((offset >= 0) && ((offset % _SG_ARENA_BLOCK_SIZE) == 0));
+    /* start at the leaf node and walk up to the allocated node */
+    int index = offset / _SG_ARENA_BLOCK_SIZE + arena->num_blocks - 1;
+    SOKOL_ASSERT(index < (2 * arena->num_blocks - 1));
+    int depth = arena->num_levels;
+    while (arena->nodes[index] != 0) {
+        SOKOL_ASSERT(index > 0);
+        index = (index - 1) / 2;
+        depth--;
+    }
+    uint8_t full = (uint8_t)(arena->num_levels - depth + 1);
+    arena->nodes[index] = full;
+    /* merge free buddies on the way up */
+    while (index > 0) {
+        index = (index - 1) / 2;
+        const uint8_t l = arena->nodes[2 * index + 1];
+        const uint8_t r = arena->nodes[2 * index + 2];
+        if ((l == full) && (r == full)) {
+            arena->nodes[index] = (uint8_t)(full + 1);
+        }
+        else {
+            arena->nodes[index] = (uint8_t)_sg_max(l, r);
+        }
+        full++;
+    }
+}
+
+/*
+    append ring tracking: for each frame which appended data to a ring buffer
+    and might not have been finished by the GPU yet, remember the append
+    position at the end of that frame, when the frame is finished, the ring's
+    tail moves up to that position
+*/
+#define _SG_RING_MAX_FRAMES (8)
+
+typedef struct {
+    uint32_t frame_index;
+    int end_pos;
+} _sg_ring_mark_t;
+
+typedef struct {
+    int tail;           /* start of the oldest data which might still be in use by the GPU */
+    int num_marks;
+    _sg_ring_mark_t marks[_SG_RING_MAX_FRAMES];
+} _sg_ring_t;
+
+/* release ring space of all frames up to and including completed_frame_index */
+_SOKOL_PRIVATE void _sg_ring_retire(_sg_ring_t* ring, int* append_pos, uint32_t completed_frame_index) {
+    SOKOL_ASSERT(ring && append_pos);
+    int num_retired = 0;
+    while ((num_retired < ring->num_marks) && (ring->marks[num_retired].frame_index <= completed_frame_index)) {
+        ring->tail = ring->marks[num_retired].end_pos;
+        num_retired++;
+    }
+    if (num_retired > 0) {
+        ring->num_marks -= num_retired;
+        for (int i = 0; i < ring->num_marks; i++) {
+            ring->marks[i] = ring->marks[i + num_retired];
+        }
+    }
+    if (0 == ring->num_marks) {
+        /* nothing in flight, rewind to keep the free space contiguous */
+        ring->tail = 0;
+        *append_pos = 0;
+    }
+}
+
+/* return the position where num_bytes can be written without overwriting in-flight data, or -1 */
+_SOKOL_PRIVATE int _sg_ring_alloc(const _sg_ring_t* ring, int size, int append_pos, int num_bytes) {
+    SOKOL_ASSERT(ring);
+    if (num_bytes > size) {
+        return -1;
+    }
+    if (0 == ring->num_marks) {
+        return append_pos;
+    }
+    if (append_pos > ring->tail) {
+        if ((append_pos + num_bytes) <= size) {
+            return append_pos;
+        }
+        else if (num_bytes <= ring->tail) {
+            /* wrap around, the rest of the buffer is skipped */
+            return 0;
+        }
+    }
+    else if ((append_pos < ring->tail) && ((append_pos + num_bytes) <= ring->tail)) {
+        return append_pos;
+    }
+    /* append_pos == tail with frames in flight means the ring is full */
+    return -1;
+}
+
+/* remember the append position at the end of the data appended in frame_index */
+_SOKOL_PRIVATE void _sg_ring_mark(_sg_ring_t* ring, uint32_t frame_index, int end_pos) {
+    SOKOL_ASSERT(ring);
+    if ((ring->num_marks > 0) && (ring->marks[ring->num_marks - 1].frame_index == frame_index)) {
+        ring->marks[ring->num_marks - 1].end_pos = end_pos;
+    }
+    else if (ring->num_marks < _SG_RING_MAX_FRAMES) {
+        ring->marks[ring->num_marks].frame_index = frame_index;
+        ring->marks[ring->num_marks].end_pos = end_pos;
+        ring->num_marks++;
+    }
+    else {
+        /* too many frames in flight, merge into the most recent mark (this only delays retirement) */
+        ring->marks[ring->num_marks - 1].frame_index = frame_index;
+        ring->marks[ring->num_marks - 1].end_pos = end_pos;
+    }
+}
+
+/* the fields needed by sg_apply_bindings() come first */
 typedef struct {
+    sg_buffer_type type;
+    int active_slot;
+    bool append_overflow;
+    sg_buffer parent_id;    /* arena buffer of a sub-allocated buffer */
+    int arena_offset;       /* byte offset in the arena buffer */
     int size;
     int append_pos;
-    bool append_overflow;
-    sg_buffer_type type;
     sg_usage usage;
     uint32_t update_frame_index;
     uint32_t append_frame_index;
     int num_slots;
-    int active_slot;
+    bool ring;
 } _sg_buffer_common_t;
 
+/* rarely accessed allocator state of arena and ring buffers, lives in a
+   separate array parallel to the buffer pool (see _sg_buffer_allocator())
+*/
+typedef struct {
+    _sg_arena_t arena;      /* allocator state if this is an arena buffer */
+    _sg_ring_t ring;        /* in-flight data if this is a ring buffer */
+} _sg_buffer_allocator_t;
+
 _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_buffer_desc* desc) {
     cmn->size = (int)desc->size;
     cmn->append_pos = 0;
@@ -3151,20 +3757,24 @@ _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_bu
     cmn->usage = desc->usage;
     cmn->update_frame_index = 0;
     cmn->append_frame_index = 0;
-    cmn->num_slots = (cmn->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
+    /* ring buffers don't rotate through per-frame buffers, in-flight data is tracked instead */
+    cmn->ring = desc->ring;
+    cmn->num_slots = ((cmn->usage == SG_USAGE_IMMUTABLE) || cmn->ring) ? 1 : SG_NUM_INFLIGHT_FRAMES;
     cmn->active_slot = 0;
 }
 
+/* the fields needed by sg_apply_bindings() come first */
 typedef struct {
     sg_image_type type;
+    int active_slot;
+    sg_pixel_format pixel_format;
+    int sample_count;
     bool render_target;
     int width;
     int height;
     int num_slices;
     int num_mipmaps;
     sg_usage usage;
-    sg_pixel_format pixel_format;
-    int sample_count;
     sg_filter min_filter;
     sg_filter mag_filter;
     sg_wrap wrap_u;
@@ -3174,7 +3784,8 @@ typedef struct {
     uint32_t max_anisotropy;
     uint32_t upd_frame_index;
     int num_slots;
-    int active_slot;
+    bool streaming;
+    int resident_mip;
 } _sg_image_common_t;
 
 _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_image_desc* desc) {
@@ -3197,6 +3808,18 @@ _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_imag
     cmn->upd_frame_index = 0;
     cmn->num_slots = (cmn->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
     cmn->active_slot = 0;
+    cmn->streaming = desc->streaming;
+    cmn->resident_mip = 0;
+    if (cmn->streaming) {
+        /* the first mip with data starts the resident mip tail */
+        cmn->resident_mip = cmn->num_mipmaps - 1;
+        for (int mip_index = 0; mip_index < cmn->num_mipmaps; mip_index++) {
+            if (desc->data.subimage[0][mip_index].ptr) {
+                cmn->resident_mip = mip_index;
+                break;
+            }
+        }
+    }
 }
 
 typedef struct {
@@ -3314,6 +3937,27 @@ _SOKOL_PRIVATE void _sg_pass_common_init(_sg_pass_common_t* cmn, const sg_pass_d
     }
 }
 
+/* number of backend query objects per sg_query */
+#define _SG_QUERY_RING_SIZE (4)
+
+typedef struct {
+    sg_query_type type;
+    int head;               /* ring slot for the next sg_begin_query() */
+    int tail;               /* oldest ring slot waiting for its result */
+    int num_pending;        /* number of issued queries waiting for their result */
+    int last_slot;          /* ring slot of the most recently ended query, or -1 */
+    uint32_t frame_index[_SG_QUERY_RING_SIZE];
+    sg_query_result result;
+} _sg_query_common_t;
+
+_SOKOL_PRIVATE void _sg_query_common_init(_sg_query_common_t* cmn, const sg_query_object_desc* desc) {
+    cmn->type = desc->type;
+    cmn->head = 0;
+    cmn->tail = 0;
+    cmn->num_pending = 0;
+    cmn->last_slot = -1;
+}
+
 /*=== GENERIC SAMPLER CACHE ==================================================*/
 
 /*
@@ -3456,6 +4100,12 @@ typedef struct {
 typedef _sg_dummy_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_query_common_t cmn;
+} _sg_dummy_query_t;
+typedef _sg_dummy_query_t _sg_query_t;
+
 typedef struct {
     _sg_slot_t slot;
 } _sg_dummy_context_t;
@@ -3465,24 +4115,24 @@ typedef _sg_dummy_context_t _sg_context_t;
 #elif defined(_SOKOL_ANY_GL)
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         GLuint buf[SG_NUM_INFLIGHT_FRAMES];
         bool ext_buffers;   /* if true, external buffers were injected with sg_buffer_desc.gl_buffers */
     } gl;
+    _sg_buffer_common_t cmn;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         GLenum target;
+        GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         GLuint depth_render_buffer;
         GLuint msaa_render_buffer;
-        GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         bool ext_textures;  /* if true, external textures were injected with sg_image_desc.gl_textures */
     } gl;
+    _sg_image_common_t cmn;
 } _sg_gl_image_t;
 typedef _sg_gl_image_t _sg_image_t;
 
@@ -3496,6 +4146,8 @@ typedef struct {
 typedef struct {
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
+    uint8_t* cache;         /* copy of the last applied uniform data (only with sg_gl_context_desc.uniform_cache) */
+    bool cache_valid;
 } _sg_gl_uniform_block_t;
 
 typedef struct {
@@ -3568,6 +4220,15 @@ typedef struct {
 typedef _sg_gl_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_query_common_t cmn;
+    struct {
+        GLuint ids[_SG_QUERY_RING_SIZE];
+    } gl;
+} _sg_gl_query_t;
+typedef _sg_gl_query_t _sg_query_t;
+
 typedef struct {
     _sg_slot_t slot;
     #if !defined(SOKOL_GLES2)
@@ -3614,19 +4275,45 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
 } _sg_gl_state_cache_t;
 
+/* number of frame fences, the GL backend waits if the GPU falls further behind */
+#define _SG_GL_MAX_FENCES (8)
+
+typedef struct {
+    #if !defined(SOKOL_GLES2)
+    GLsync sync;
+    #endif
+    uint32_t frame_index;
+} _sg_gl_fence_t;
+
+/* a rectangle in GL framebuffer coordinates, (x1,y1) is exclusive */
+typedef struct {
+    int x0, y0, x1, y1;
+} _sg_gl_rect_t;
+
 typedef struct {
     bool valid;
     bool gles2;
     bool in_pass;
     int cur_pass_width;
     int cur_pass_height;
+    _sg_gl_rect_t cur_viewport;
+    _sg_gl_rect_t cur_scissor;
+    _sg_gl_rect_t resolve_rect;     /* area touched by draw calls, resolved in _sg_gl_end_pass() */
+    bool resolve_atts[SG_MAX_COLOR_ATTACHMENTS];
+    bool need_resolve;              /* true if the current pass has color attachments to resolve */
     _sg_context_t* cur_context;
     _sg_pass_t* cur_pass;
     sg_pass cur_pass_id;
     _sg_gl_state_cache_t cache;
     bool ext_anisotropic;
+    bool uniform_cache;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
+    _sg_gl_fence_t fences[_SG_GL_MAX_FENCES];
+    int fence_tail;
+    int num_fences;
+    int num_ring_buffers;   /* frame fences are only inserted while ring buffers exist */
+    uint32_t completed_frame_index;
     #if _SOKOL_USE_WIN32_GL_LOADER
     HINSTANCE opengl32_dll;
     #endif
@@ -3637,25 +4324,25 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         ID3D11Buffer* buf;
     } d3d11;
+    _sg_buffer_common_t cmn;
 } _sg_d3d11_buffer_t;
 typedef _sg_d3d11_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
+        ID3D11ShaderResourceView* srv;
+        ID3D11SamplerState* smp;
         DXGI_FORMAT format;
         ID3D11Texture2D* tex2d;
         ID3D11Texture3D* tex3d;
         ID3D11Texture2D* texds;
         ID3D11Texture2D* texmsaa;
-        ID3D11ShaderResourceView* srv;
-        ID3D11SamplerState* smp;
     } d3d11;
+    _sg_image_common_t cmn;
 } _sg_d3d11_image_t;
 typedef _sg_d3d11_image_t _sg_image_t;
 
@@ -3720,6 +4407,14 @@ typedef struct {
 typedef _sg_d3d11_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+/* occlusion queries are not supported on D3D11 (sg_features.occlusion_query
+   is false and sg_make_query() fails), query slots only carry the common state */
+typedef struct {
+    _sg_slot_t slot;
+    _sg_query_common_t cmn;
+} _sg_d3d11_query_t;
+typedef _sg_d3d11_query_t _sg_query_t;
+
 typedef struct {
     _sg_slot_t slot;
 } _sg_d3d11_context_t;
@@ -3740,6 +4435,7 @@ typedef struct {
     int cur_width;
     int cur_height;
     int num_rtvs;
+    bool resolve_atts[SG_MAX_COLOR_ATTACHMENTS];
     _sg_pass_t* cur_pass;
     sg_pass cur_pass_id;
     _sg_pipeline_t* cur_pipeline;
@@ -3781,22 +4477,22 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         int buf[SG_NUM_INFLIGHT_FRAMES];  /* index into _sg_mtl_pool */
     } mtl;
+    _sg_buffer_common_t cmn;
 } _sg_mtl_buffer_t;
 typedef _sg_mtl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         int tex[SG_NUM_INFLIGHT_FRAMES];
+        int sampler_state;
         int depth_tex;
         int msaa_tex;
-        int sampler_state;
     } mtl;
+    _sg_image_common_t cmn;
 } _sg_mtl_image_t;
 typedef _sg_mtl_image_t _sg_image_t;
 
@@ -3846,6 +4542,14 @@ typedef struct {
 typedef _sg_mtl_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+/* occlusion queries are not supported on Metal (sg_features.occlusion_query
+   is false and sg_make_query() fails), query slots only carry the common state */
+typedef struct {
+    _sg_slot_t slot;
+    _sg_query_common_t cmn;
+} _sg_mtl_query_t;
+typedef _sg_mtl_query_t _sg_query_t;
+
 typedef struct {
     _sg_slot_t slot;
 } _sg_mtl_context_t;
@@ -3874,6 +4578,8 @@ typedef struct {
     const void*(*drawable_cb)(void);
     const void*(*drawable_userdata_cb)(void*);
     void* user_data;
+    const void* swapchain_drawables[SG_MAX_SWAPCHAINS];
+    int num_swapchain_drawables;
     uint32_t frame_index;
     uint32_t cur_frame_rotate_index;
     int ub_size;
@@ -3905,22 +4611,22 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         WGPUBuffer buf;
     } wgpu;
+    _sg_buffer_common_t cmn;
 } _sg_wgpu_buffer_t;
 typedef _sg_wgpu_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
-        WGPUTexture tex;
         WGPUTextureView tex_view;
-        WGPUTexture msaa_tex;
         WGPUSampler sampler;
+        WGPUTexture tex;
+        WGPUTexture msaa_tex;
     } wgpu;
+    _sg_image_common_t cmn;
 } _sg_wgpu_image_t;
 typedef _sg_wgpu_image_t _sg_image_t;
 
@@ -3967,6 +4673,14 @@ typedef struct {
 typedef _sg_wgpu_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+/* occlusion queries are not supported on WebGPU (sg_features.occlusion_query
+   is false and sg_make_query() fails), query slots only carry the common state */
+typedef struct {
+    _sg_slot_t slot;
+    _sg_query_common_t cmn;
+} _sg_wgpu_query_t;
+typedef _sg_wgpu_query_t _sg_query_t;
+
 typedef struct {
     _sg_slot_t slot;
 } _sg_wgpu_context_t;
@@ -4038,19 +4752,35 @@ typedef struct {
     int* free_queue;
 } _sg_pool_t;
 
+#define _SG_POOL_ALIGN (64)
+
+typedef struct {
+    uint8_t* base;
+    size_t pos;
+} _sg_pool_mem_t;
+
 typedef struct {
+    void* block;        /* all pool memory is allocated as one block */
     _sg_pool_t buffer_pool;
     _sg_pool_t image_pool;
     _sg_pool_t shader_pool;
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
+    _sg_pool_t query_pool;
     _sg_pool_t context_pool;
     _sg_buffer_t* buffers;
     _sg_image_t* images;
     _sg_shader_t* shaders;
     _sg_pipeline_t* pipelines;
     _sg_pass_t* passes;
+    _sg_query_t* queries;
     _sg_context_t* contexts;
+    /* parallel to buffers[] and images[], a resource's id if it can be bound
+       without further checks (see sg_apply_bindings()), otherwise SG_INVALID_ID
+    */
+    uint32_t* buffer_bind_ids;
+    uint32_t* image_bind_ids;
+    _sg_buffer_allocator_t* buffer_allocators;  /* parallel to buffers[] */
 } _sg_pools_t;
 
 /*=== VALIDATION LAYER DECLARATIONS ==========================================*/
@@ -4064,6 +4794,15 @@ typedef enum {
     _SG_VALIDATE_BUFFERDESC_DATA,
     _SG_VALIDATE_BUFFERDESC_DATA_SIZE,
     _SG_VALIDATE_BUFFERDESC_NO_DATA,
+    _SG_VALIDATE_BUFFERDESC_ARENA_SUPPORTED,
+    _SG_VALIDATE_BUFFERDESC_ARENA_USAGE,
+    _SG_VALIDATE_BUFFERDESC_ARENA_NO_DATA,
+    _SG_VALIDATE_BUFFERDESC_ARENA_INJECTED,
+    _SG_VALIDATE_BUFFERDESC_PARENT_USAGE,
+    _SG_VALIDATE_BUFFERDESC_PARENT_INJECTED,
+    _SG_VALIDATE_BUFFERDESC_PARENT_EXISTS,
+    _SG_VALIDATE_BUFFERDESC_PARENT_TYPE,
+    _SG_VALIDATE_BUFFERDESC_RING_USAGE,
 
     /* image data (for image creation and updating) */
     _SG_VALIDATE_IMAGEDATA_NODATA,
@@ -4082,6 +4821,10 @@ typedef enum {
     _SG_VALIDATE_IMAGEDESC_INJECTED_NO_DATA,
     _SG_VALIDATE_IMAGEDESC_DYNAMIC_NO_DATA,
     _SG_VALIDATE_IMAGEDESC_COMPRESSED_IMMUTABLE,
+    _SG_VALIDATE_IMAGEDESC_STREAMING_SUPPORT,
+    _SG_VALIDATE_IMAGEDESC_STREAMING_IMMUTABLE,
+    _SG_VALIDATE_IMAGEDESC_STREAMING_MIPMAPS,
+    _SG_VALIDATE_IMAGEDESC_STREAMING_MIP_TAIL,
 
     /* shader creation */
     _SG_VALIDATE_SHADERDESC_CANARY,
@@ -4125,10 +4868,38 @@ typedef enum {
     _SG_VALIDATE_PASSDESC_IMAGE_SIZES,
     _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS,
 
+    /* query creation */
+    _SG_VALIDATE_QUERYDESC_CANARY,
+    _SG_VALIDATE_QUERYDESC_SUPPORTED,
+
     /* sg_begin_pass validation */
     _SG_VALIDATE_BEGINPASS_PASS,
     _SG_VALIDATE_BEGINPASS_IMAGE,
 
+    /* sg_begin_swapchain_pass validation */
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_CANARY,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_SIZE,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_COLOR_FORMAT,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_DEPTH_FORMAT,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_SAMPLE_COUNT,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_D3D11_RTV,
+    _SG_VALIDATE_BEGINSWAPCHAINPASS_WGPU_VIEWS,
+
+    /* sg_begin_query / sg_end_query validation */
+    _SG_VALIDATE_BEGINQUERY_QUERY,
+    _SG_VALIDATE_BEGINQUERY_NESTED,
+    _SG_VALIDATE_ENDQUERY_NO_QUERY,
+
+    /* sg_begin_conditional_render / sg_end_conditional_render validation */
+    _SG_VALIDATE_BEGINCONDRENDER_QUERY,
+    _SG_VALIDATE_BEGINCONDRENDER_QUERY_ACTIVE,
+    _SG_VALIDATE_BEGINCONDRENDER_NESTED,
+    _SG_VALIDATE_ENDCONDRENDER_NOT_ACTIVE,
+
+    /* sg_end_pass validation */
+    _SG_VALIDATE_ENDPASS_QUERY,
+    _SG_VALIDATE_ENDPASS_CONDITIONAL_RENDER,
+
     /* sg_apply_pipeline validation */
     _SG_VALIDATE_APIP_PIPELINE_VALID_ID,
     _SG_VALIDATE_APIP_PIPELINE_EXISTS,
@@ -4148,11 +4919,13 @@ typedef enum {
     _SG_VALIDATE_ABND_VB_EXISTS,
     _SG_VALIDATE_ABND_VB_TYPE,
     _SG_VALIDATE_ABND_VB_OVERFLOW,
+    _SG_VALIDATE_ABND_VB_ARENA,
     _SG_VALIDATE_ABND_NO_IB,
     _SG_VALIDATE_ABND_IB,
     _SG_VALIDATE_ABND_IB_EXISTS,
     _SG_VALIDATE_ABND_IB_TYPE,
     _SG_VALIDATE_ABND_IB_OVERFLOW,
+    _SG_VALIDATE_ABND_IB_ARENA,
     _SG_VALIDATE_ABND_VS_IMGS,
     _SG_VALIDATE_ABND_VS_IMG_EXISTS,
     _SG_VALIDATE_ABND_VS_IMG_TYPES,
@@ -4170,6 +4943,7 @@ typedef enum {
     _SG_VALIDATE_UPDATEBUF_SIZE,
     _SG_VALIDATE_UPDATEBUF_ONCE,
     _SG_VALIDATE_UPDATEBUF_APPEND,
+    _SG_VALIDATE_UPDATEBUF_RING,
 
     /* sg_append_buffer validation */
     _SG_VALIDATE_APPENDBUF_USAGE,
@@ -4179,28 +4953,65 @@ typedef enum {
     /* sg_update_image validation */
     _SG_VALIDATE_UPDIMG_USAGE,
     _SG_VALIDATE_UPDIMG_NOTENOUGHDATA,
-    _SG_VALIDATE_UPDIMG_ONCE
+    _SG_VALIDATE_UPDIMG_ONCE,
+
+    /* sg_update_image_mip validation */
+    _SG_VALIDATE_UPDIMGMIP_STREAMING,
+    _SG_VALIDATE_UPDIMGMIP_RANGE,
+    _SG_VALIDATE_UPDIMGMIP_ORDER
 } _sg_validate_error_t;
 
+/* remembers the last successfully validated pass and bindings of each pipeline */
+#define _SG_VALIDATE_CACHE_NUM_BINDINGS (4)
+typedef struct {
+    uint32_t vertex_buffers[SG_MAX_SHADERSTAGE_BUFFERS];
+    uint32_t index_buffer;
+    uint32_t vs_images[SG_MAX_SHADERSTAGE_IMAGES];
+    uint32_t fs_images[SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_validate_cache_bindings_t;
+
+typedef struct {
+    uint32_t pip_id;
+    uint32_t pass_epoch;        /* 0 if no pass has been validated */
+    uint32_t pass_id;
+    uint32_t bind_epoch;        /* 0 if no bindings have been validated */
+    int num_bindings;
+    int next_bindings;          /* replaced round-robin when full */
+    _sg_validate_cache_bindings_t bindings[_SG_VALIDATE_CACHE_NUM_BINDINGS];
+} _sg_validate_cache_item_t;
+
+/* one item per pipeline pool slot, items are only valid for the current epoch */
+typedef struct {
+    uint32_t epoch;
+    _sg_validate_cache_item_t* items;
+} _sg_validate_cache_t;
+
 /*=== GENERIC BACKEND STATE ==================================================*/
 
 typedef struct {
     bool valid;
     sg_desc desc;       /* original desc with default values patched in */
     uint32_t frame_index;
+    uint32_t completed_frame_index;     /* most recent frame known to be finished by the GPU */
     sg_context active_context;
     sg_pass cur_pass;
     sg_pipeline cur_pipeline;
+    sg_query cur_query;
+    bool cur_query_issued;      /* false if sg_begin_query() was skipped because the query ring was full */
+    bool in_conditional_render;
+    sg_query cur_conditional_query;
     bool pass_valid;
     bool bindings_valid;
     bool next_draw_valid;
     #if defined(SOKOL_DEBUG)
     _sg_validate_error_t validate_error;
+    _sg_validate_cache_t validate_cache;
     #endif
     _sg_pools_t pools;
     sg_backend backend;
     sg_features features;
     sg_limits limits;
+    sg_stats stats;
     sg_pixelformat_info formats[_SG_PIXELFORMAT_NUM];
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_backend_t gl;
@@ -4679,6 +5490,10 @@ _SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     _SOKOL_UNUSED(desc);
     _sg.backend = SG_BACKEND_DUMMY;
+    _sg.features.buffer_arenas = true;
+    _sg.features.occlusion_query = true;
+    _sg.features.conditional_render = true;
+    _sg.features.mip_streaming = true;
     for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
         _sg.formats[i].sample = true;
         _sg.formats[i].filter = true;
@@ -4811,9 +5626,10 @@ _SOKOL_PRIVATE _sg_image_t* _sg_dummy_pass_ds_image(const _sg_pass_t* pass) {
     return pass->dmy.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_dummy_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+_SOKOL_PRIVATE void _sg_dummy_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
     SOKOL_ASSERT(action);
     _SOKOL_UNUSED(pass);
+    _SOKOL_UNUSED(swapchain);
     _SOKOL_UNUSED(action);
     _SOKOL_UNUSED(w);
     _SOKOL_UNUSED(h);
@@ -4827,6 +5643,11 @@ _SOKOL_PRIVATE void _sg_dummy_commit(void) {
     /* empty */
 }
 
+_SOKOL_PRIVATE uint32_t _sg_dummy_completed_frame_index(void) {
+    /* there's no GPU, all committed frames are finished */
+    return _sg.frame_index - 1;
+}
+
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     _SOKOL_UNUSED(x);
     _SOKOL_UNUSED(y);
@@ -4898,6 +5719,14 @@ _SOKOL_PRIVATE int _sg_dummy_append_buffer(_sg_buffer_t* buf, const sg_range* da
     return _sg_roundup((int)data->size, 4);
 }
 
+_SOKOL_PRIVATE void _sg_dummy_update_buffer_range(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    SOKOL_ASSERT((offset >= 0) && ((offset + (int)data->size) <= buf->cmn.size));
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+}
+
 _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     _SOKOL_UNUSED(data);
@@ -4906,6 +5735,53 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     }
 }
 
+_SOKOL_PRIVATE void _sg_dummy_update_image_mip(_sg_image_t* img, int mip_index, const sg_image_data* data) {
+    SOKOL_ASSERT(img && data);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(mip_index);
+    _SOKOL_UNUSED(data);
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_query(_sg_query_t* qry, const sg_query_object_desc* desc) {
+    SOKOL_ASSERT(qry && desc);
+    _sg_query_common_init(&qry->cmn, desc);
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_destroy_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry);
+    _SOKOL_UNUSED(qry);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_begin_query(_sg_query_t* qry, int slot) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE));
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_end_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry);
+    _SOKOL_UNUSED(qry);
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_query_result(_sg_query_t* qry, int slot, bool* out_visible) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE) && out_visible);
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    *out_visible = true;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_begin_conditional_render(_sg_query_t* qry, int slot) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE));
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_end_conditional_render(void) {
+    /* empty */
+}
+
 /*== GL BACKEND ==============================================================*/
 #elif defined(_SOKOL_ANY_GL)
 
@@ -4956,6 +5832,8 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glFramebufferRenderbuffer,         void, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)) \
     _SG_XMACRO(glCompressedTexImage2D,            void, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void * data)) \
     _SG_XMACRO(glCompressedTexImage3D,            void, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void * data)) \
+    _SG_XMACRO(glCompressedTexSubImage2D,         void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data)) \
+    _SG_XMACRO(glCompressedTexSubImage3D,         void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void * data)) \
     _SG_XMACRO(glActiveTexture,                   void, (GLenum texture)) \
     _SG_XMACRO(glTexSubImage3D,                   void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glRenderbufferStorage,             void, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)) \
@@ -5014,7 +5892,17 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glTexImage2D,                      void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
-    _SG_XMACRO(glCullFace,                        void, (GLenum mode))
+    _SG_XMACRO(glCullFace,                        void, (GLenum mode)) \
+    _SG_XMACRO(glGenQueries,                      void, (GLsizei n, GLuint * ids)) \
+    _SG_XMACRO(glDeleteQueries,                   void, (GLsizei n, const GLuint * ids)) \
+    _SG_XMACRO(glBeginQuery,                      void, (GLenum target, GLuint id)) \
+    _SG_XMACRO(glEndQuery,                        void, (GLenum target)) \
+    _SG_XMACRO(glGetQueryObjectuiv,               void, (GLuint id, GLenum pname, GLuint * params)) \
+    _SG_XMACRO(glBeginConditionalRender,          void, (GLuint id, GLenum mode)) \
+    _SG_XMACRO(glEndConditionalRender,            void, (void)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
@@ -5810,6 +6698,10 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.buffer_arenas = true;
+    _sg.features.occlusion_query = true;
+    _sg.features.conditional_render = true;
+    _sg.features.mip_streaming = true;
 
     /* scan extensions */
     bool has_s3tc = false;  /* BC1..BC3 */
@@ -5887,6 +6779,9 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = false;
+    _sg.features.buffer_arenas = true;
+    _sg.features.occlusion_query = true;
+    _sg.features.mip_streaming = true;
 
     bool has_s3tc = false;  /* BC1..BC3 */
     bool has_rgtc = false;  /* BC4 and BC5 */
@@ -6024,6 +6919,7 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles2(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = false;
+    _sg.features.buffer_arenas = true;
 
     /* limits */
     _sg_gl_init_limits();
@@ -6241,6 +7137,21 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_pipeline(_sg_pipeline_t* pip) {
     }
 }
 
+/* native GL code may have changed uniform values behind our back */
+_SOKOL_PRIVATE void _sg_gl_invalidate_uniform_caches(void) {
+    if (!_sg.gl.uniform_cache) {
+        return;
+    }
+    for (int i = 1; i < _sg.pools.shader_pool.size; i++) {
+        _sg_shader_t* shd = &_sg.pools.shaders[i];
+        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+            for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+                shd->gl.stage[stage_index].uniform_blocks[ub_index].cache_valid = false;
+            }
+        }
+    }
+}
+
 _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
     if (_sg.gl.cur_context) {
         _SG_GL_CHECK_ERROR();
@@ -6251,6 +7162,7 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
         }
         #endif
         memset(&_sg.gl.cache, 0, sizeof(_sg.gl.cache));
+        _sg_gl_invalidate_uniform_caches();
         _sg_gl_cache_clear_buffer_bindings(true);
         _SG_GL_CHECK_ERROR();
         _sg_gl_cache_clear_texture_bindings(true);
@@ -6325,10 +7237,10 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
 _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     /* assumes that _sg.gl is already zero-initialized */
     _sg.gl.valid = true;
+    _sg.gl.uniform_cache = desc->context.gl.uniform_cache;
     #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
     _sg.gl.gles2 = desc->context.gl.force_gles2;
     #else
-    _SOKOL_UNUSED(desc);
     _sg.gl.gles2 = false;
     #endif
 
@@ -6354,8 +7266,21 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #endif
 }
 
+_SOKOL_PRIVATE void _sg_gl_discard_fences(void) {
+    #if !defined(SOKOL_GLES2)
+    for (int i = 0; i < _sg.gl.num_fences; i++) {
+        _sg_gl_fence_t* fence = &_sg.gl.fences[(_sg.gl.fence_tail + i) % _SG_GL_MAX_FENCES];
+        glDeleteSync(fence->sync);
+        fence->sync = 0;
+    }
+    #endif
+    _sg.gl.fence_tail = 0;
+    _sg.gl.num_fences = 0;
+}
+
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    _sg_gl_discard_fences();
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -6420,7 +7345,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
             _sg_gl_cache_store_buffer_binding(gl_target);
             _sg_gl_cache_bind_buffer(gl_target, gl_buf);
             glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
-            if (buf->cmn.usage == SG_USAGE_IMMUTABLE) {
+            if ((buf->cmn.usage == SG_USAGE_IMMUTABLE) && !desc->arena) {
                 SOKOL_ASSERT(desc->data.ptr);
                 glBufferSubData(gl_target, 0, buf->cmn.size, desc->data.ptr);
             }
@@ -6428,6 +7353,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
         }
         buf->gl.buf[slot] = gl_buf;
     }
+    if (buf->cmn.ring) {
+        _sg.gl.num_ring_buffers++;
+    }
     _SG_GL_CHECK_ERROR();
     return SG_RESOURCESTATE_VALID;
 }
@@ -6435,6 +7363,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
 _SOKOL_PRIVATE void _sg_gl_destroy_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SG_GL_CHECK_ERROR();
+    if (buf->cmn.ring) {
+        SOKOL_ASSERT(_sg.gl.num_ring_buffers > 0);
+        _sg.gl.num_ring_buffers--;
+    }
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         if (buf->gl.buf[slot]) {
             _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
@@ -6597,7 +7529,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                         }
                         if ((SG_IMAGETYPE_2D == img->cmn.type) || (SG_IMAGETYPE_CUBE == img->cmn.type)) {
                             if (is_compressed) {
-                                const GLsizei data_size = (GLsizei) desc->data.subimage[face_index][mip_index].size;
+                                GLsizei data_size = (GLsizei) desc->data.subimage[face_index][mip_index].size;
+                                if (0 == data_ptr) {
+                                    /* non-resident mip of a streaming image, only allocate storage */
+                                    data_size = (GLsizei) _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1);
+                                }
                                 glCompressedTexImage2D(gl_img_target, mip_index, gl_internal_format,
                                     mip_width, mip_height, 0, data_size, data_ptr);
                             }
@@ -6617,7 +7553,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                                 mip_depth = 1;
                             }
                             if (is_compressed) {
-                                const GLsizei data_size = (GLsizei) desc->data.subimage[face_index][mip_index].size;
+                                GLsizei data_size = (GLsizei) desc->data.subimage[face_index][mip_index].size;
+                                if (0 == data_ptr) {
+                                    data_size = (GLsizei) (_sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1) * mip_depth);
+                                }
                                 glCompressedTexImage3D(gl_img_target, mip_index, gl_internal_format,
                                     mip_width, mip_height, mip_depth, 0, data_size, data_ptr);
                             }
@@ -6630,6 +7569,12 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                         #endif
                     }
                 }
+                #if !defined(SOKOL_GLES2)
+                if (!_sg.gl.gles2 && img->cmn.streaming) {
+                    /* only sample from the resident mips */
+                    glTexParameteri(img->gl.target, GL_TEXTURE_BASE_LEVEL, img->cmn.resident_mip);
+                }
+                #endif
                 _sg_gl_cache_restore_texture_binding(0);
             }
         }
@@ -6761,6 +7706,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             }
             SOKOL_ASSERT(ub_desc->size == (size_t)cur_uniform_offset);
             _SOKOL_UNUSED(cur_uniform_offset);
+            if (_sg.gl.uniform_cache) {
+                ub->cache = (uint8_t*) SOKOL_MALLOC(ub_desc->size);
+                SOKOL_ASSERT(ub->cache);
+                ub->cache_valid = false;
+            }
         }
     }
 
@@ -6804,6 +7754,15 @@ _SOKOL_PRIVATE void _sg_gl_destroy_shader(_sg_shader_t* shd) {
         glDeleteProgram(shd->gl.prog);
     }
     _SG_GL_CHECK_ERROR();
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            _sg_gl_uniform_block_t* ub = &shd->gl.stage[stage_index].uniform_blocks[ub_index];
+            if (ub->cache) {
+                SOKOL_FREE(ub->cache);
+                ub->cache = 0;
+            }
+        }
+    }
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
@@ -7067,13 +8026,45 @@ _SOKOL_PRIVATE _sg_image_t* _sg_gl_pass_ds_image(const _sg_pass_t* pass) {
     return pass->gl.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
-    /* FIXME: what if a texture used as render target is still bound, should we
-       unbind all currently bound textures in begin pass? */
-    SOKOL_ASSERT(action);
-    SOKOL_ASSERT(!_sg.gl.in_pass);
-    _SG_GL_CHECK_ERROR();
-    _sg.gl.in_pass = true;
+_SOKOL_PRIVATE _sg_gl_rect_t _sg_gl_rect(int x, int y, int w, int h) {
+    _sg_gl_rect_t r;
+    r.x0 = x;
+    r.y0 = y;
+    r.x1 = x + w;
+    r.y1 = y + h;
+    return r;
+}
+
+/* add the area covered by a draw call to the MSAA resolve area */
+_SOKOL_PRIVATE void _sg_gl_grow_resolve_rect(void) {
+    const _sg_gl_rect_t* vp = &_sg.gl.cur_viewport;
+    const _sg_gl_rect_t* sc = &_sg.gl.cur_scissor;
+    const int x0 = _sg_max(vp->x0, sc->x0);
+    const int y0 = _sg_max(vp->y0, sc->y0);
+    const int x1 = _sg_min(vp->x1, sc->x1);
+    const int y1 = _sg_min(vp->y1, sc->y1);
+    if ((x0 >= x1) || (y0 >= y1)) {
+        return;
+    }
+    _sg_gl_rect_t* r = &_sg.gl.resolve_rect;
+    if ((r->x0 >= r->x1) || (r->y0 >= r->y1)) {
+        r->x0 = x0; r->y0 = y0; r->x1 = x1; r->y1 = y1;
+    }
+    else {
+        r->x0 = _sg_min(r->x0, x0);
+        r->y0 = _sg_min(r->y0, y0);
+        r->x1 = _sg_max(r->x1, x1);
+        r->y1 = _sg_max(r->y1, y1);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
+    /* FIXME: what if a texture used as render target is still bound, should we
+       unbind all currently bound textures in begin pass? */
+    SOKOL_ASSERT(action);
+    SOKOL_ASSERT(!_sg.gl.in_pass);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.in_pass = true;
     _sg.gl.cur_pass = pass; /* can be 0 */
     if (pass) {
         _sg.gl.cur_pass_id.id = pass->slot.id;
@@ -7093,6 +8084,10 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
         SOKOL_ASSERT(pass->gl.fb);
         glBindFramebuffer(GL_FRAMEBUFFER, pass->gl.fb);
     }
+    else if (swapchain) {
+        /* explicit swapchain pass */
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)swapchain->gl.framebuffer);
+    }
     else {
         /* default pass */
         SOKOL_ASSERT(_sg.gl.cur_context);
@@ -7100,6 +8095,8 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
     }
     glViewport(0, 0, w, h);
     glScissor(0, 0, w, h);
+    _sg.gl.cur_viewport = _sg_gl_rect(0, 0, w, h);
+    _sg.gl.cur_scissor = _sg.gl.cur_viewport;
 
     /* clear color and depth-stencil attachments if needed */
     bool clear_color = false;
@@ -7109,6 +8106,21 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
             break;
         }
     }
+
+    /* setup the MSAA resolve, a clear touches the whole framebuffer */
+    _sg.gl.need_resolve = false;
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        _sg.gl.resolve_atts[i] = !action->colors[i].dont_resolve;
+        if (pass && (i < num_color_atts) && _sg.gl.resolve_atts[i] && (0 != pass->gl.color_atts[i].gl_msaa_resolve_buffer)) {
+            _sg.gl.need_resolve = true;
+        }
+    }
+    if (clear_color) {
+        _sg.gl.resolve_rect = _sg.gl.cur_viewport;
+    }
+    else {
+        memset(&_sg.gl.resolve_rect, 0, sizeof(_sg.gl.resolve_rect));
+    }
     const bool clear_depth = (action->depth.action == SG_ACTION_CLEAR);
     const bool clear_stencil = (action->stencil.action == SG_ACTION_CLEAR);
 
@@ -7220,19 +8232,25 @@ _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
         const _sg_pass_t* pass = _sg.gl.cur_pass;
         SOKOL_ASSERT(pass->slot.id == _sg.gl.cur_pass_id.id);
         bool is_msaa = (0 != _sg.gl.cur_pass->gl.color_atts[0].gl_msaa_resolve_buffer);
-        if (is_msaa) {
+        /* only resolve the area touched in this pass */
+        const _sg_gl_rect_t* r = &_sg.gl.resolve_rect;
+        const int x0 = _sg_max(r->x0, 0);
+        const int y0 = _sg_max(r->y0, 0);
+        const int x1 = _sg_min(r->x1, _sg.gl.cur_pass_width);
+        const int y1 = _sg_min(r->y1, _sg.gl.cur_pass_height);
+        if (is_msaa && (x0 < x1) && (y0 < y1)) {
             SOKOL_ASSERT(pass->gl.fb);
             glBindFramebuffer(GL_READ_FRAMEBUFFER, pass->gl.fb);
             SOKOL_ASSERT(pass->gl.color_atts[0].image);
-            const int w = pass->gl.color_atts[0].image->cmn.width;
-            const int h = pass->gl.color_atts[0].image->cmn.height;
             for (int att_index = 0; att_index < SG_MAX_COLOR_ATTACHMENTS; att_index++) {
                 const _sg_gl_attachment_t* gl_att = &pass->gl.color_atts[att_index];
                 if (gl_att->image) {
-                    SOKOL_ASSERT(gl_att->gl_msaa_resolve_buffer);
-                    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, gl_att->gl_msaa_resolve_buffer);
-                    glReadBuffer((GLenum)(GL_COLOR_ATTACHMENT0 + att_index));
-                    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                    if (_sg.gl.resolve_atts[att_index]) {
+                        SOKOL_ASSERT(gl_att->gl_msaa_resolve_buffer);
+                        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, gl_att->gl_msaa_resolve_buffer);
+                        glReadBuffer((GLenum)(GL_COLOR_ATTACHMENT0 + att_index));
+                        glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                    }
                 }
                 else {
                     break;
@@ -7245,6 +8263,7 @@ _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
     _sg.gl.cur_pass_id.id = SG_INVALID_ID;
     _sg.gl.cur_pass_width = 0;
     _sg.gl.cur_pass_height = 0;
+    _sg.gl.need_resolve = false;
 
     SOKOL_ASSERT(_sg.gl.cur_context);
     glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.cur_context->default_framebuffer);
@@ -7256,12 +8275,14 @@ _SOKOL_PRIVATE void _sg_gl_apply_viewport(int x, int y, int w, int h, bool origi
     SOKOL_ASSERT(_sg.gl.in_pass);
     y = origin_top_left ? (_sg.gl.cur_pass_height - (y+h)) : y;
     glViewport(x, y, w, h);
+    _sg.gl.cur_viewport = _sg_gl_rect(x, y, w, h);
 }
 
 _SOKOL_PRIVATE void _sg_gl_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
     SOKOL_ASSERT(_sg.gl.in_pass);
     y = origin_top_left ? (_sg.gl.cur_pass_height - (y+h)) : y;
     glScissor(x, y, w, h);
+    _sg.gl.cur_scissor = _sg_gl_rect(x, y, w, h);
 }
 
 _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
@@ -7574,8 +8595,18 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->slot.id == _sg.gl.cache.cur_pipeline->cmn.shader_id.id);
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].num_uniform_blocks > ub_index);
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == data->size);
-    const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
-    const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
+    _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    if (gl_ub->cache) {
+        /* GL programs keep their uniform values, skip the upload if nothing changed */
+        if (gl_ub->cache_valid && (0 == memcmp(gl_ub->cache, data->ptr, data->size))) {
+            _sg.stats.uniform_cache_hits++;
+            return;
+        }
+        memcpy(gl_ub->cache, data->ptr, data->size);
+        gl_ub->cache_valid = true;
+        _sg.stats.uniform_cache_misses++;
+    }
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
@@ -7623,6 +8654,9 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
 
 _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
+    if (_sg.gl.need_resolve) {
+        _sg_gl_grow_resolve_rect();
+    }
     const GLenum i_type = _sg.gl.cache.cur_index_type;
     const GLenum p_type = _sg.gl.cache.cur_primitive_type;
     if (0 != i_type) {
@@ -7652,11 +8686,58 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
     }
 }
 
+/* poll the frame fences without waiting, returns the most recent finished frame */
+_SOKOL_PRIVATE uint32_t _sg_gl_completed_frame_index(void) {
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        while (_sg.gl.num_fences > 0) {
+            _sg_gl_fence_t* fence = &_sg.gl.fences[_sg.gl.fence_tail];
+            GLenum res = glClientWaitSync(fence->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if ((res != GL_ALREADY_SIGNALED) && (res != GL_CONDITION_SATISFIED)) {
+                break;
+            }
+            _sg.gl.completed_frame_index = fence->frame_index;
+            glDeleteSync(fence->sync);
+            fence->sync = 0;
+            _sg.gl.fence_tail = (_sg.gl.fence_tail + 1) % _SG_GL_MAX_FENCES;
+            _sg.gl.num_fences--;
+        }
+        return _sg.gl.completed_frame_index;
+    }
+    #endif
+    /* no fences available, glBufferSubData() is implicitly synchronized by the driver */
+    return _sg.frame_index - 1;
+}
+
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
     SOKOL_ASSERT(!_sg.gl.in_pass);
     /* "soft" clear bindings (only those that are actually bound) */
     _sg_gl_cache_clear_buffer_bindings(false);
     _sg_gl_cache_clear_texture_bindings(false);
+    #if !defined(SOKOL_GLES2)
+    /* only ring buffers need to know when the GPU has finished a frame, so
+       applications without ring buffers don't pay for fences (or stall on them)
+    */
+    if (!_sg.gl.gles2 && (_sg.gl.num_ring_buffers > 0)) {
+        /* insert a fence for the committed frame, if the GPU is too far behind, wait for the oldest */
+        if (_sg.gl.num_fences == _SG_GL_MAX_FENCES) {
+            _sg_gl_fence_t* oldest = &_sg.gl.fences[_sg.gl.fence_tail];
+            GLenum res;
+            do {
+                res = glClientWaitSync(oldest->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            } while (res == GL_TIMEOUT_EXPIRED);
+            _sg.gl.completed_frame_index = oldest->frame_index;
+            glDeleteSync(oldest->sync);
+            oldest->sync = 0;
+            _sg.gl.fence_tail = (_sg.gl.fence_tail + 1) % _SG_GL_MAX_FENCES;
+            _sg.gl.num_fences--;
+        }
+        _sg_gl_fence_t* fence = &_sg.gl.fences[(_sg.gl.fence_tail + _sg.gl.num_fences) % _SG_GL_MAX_FENCES];
+        fence->sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        fence->frame_index = _sg.frame_index;
+        _sg.gl.num_fences++;
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
@@ -7698,6 +8779,21 @@ _SOKOL_PRIVATE int _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data,
     return _sg_roundup((int)data->size, 4);
 }
 
+/* write the content of a sub-allocated buffer into its arena buffer */
+_SOKOL_PRIVATE void _sg_gl_update_buffer_range(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    SOKOL_ASSERT((offset >= 0) && ((offset + (int)data->size) <= buf->cmn.size));
+    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
+    GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
+    SOKOL_ASSERT(gl_buf);
+    _SG_GL_CHECK_ERROR();
+    _sg_gl_cache_store_buffer_binding(gl_tgt);
+    _sg_gl_cache_bind_buffer(gl_tgt, gl_buf);
+    glBufferSubData(gl_tgt, offset, (GLsizeiptr)data->size, data->ptr);
+    _sg_gl_cache_restore_buffer_binding(gl_tgt);
+    _SG_GL_CHECK_ERROR();
+}
+
 _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     /* only one update per image per frame allowed */
@@ -7753,6 +8849,149 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
     _sg_gl_cache_restore_texture_binding(0);
 }
 
+_SOKOL_PRIVATE void _sg_gl_update_image_mip(_sg_image_t* img, int mip_index, const sg_image_data* data) {
+    SOKOL_ASSERT(img && data);
+    SOKOL_ASSERT(img->cmn.streaming && (img->cmn.num_slots == 1));
+    _SG_GL_CHECK_ERROR();
+    _sg_gl_cache_store_texture_binding(0);
+    _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[0]);
+    const bool is_compressed = _sg_is_compressed_pixel_format(img->cmn.pixel_format);
+    const GLenum gl_internal_format = _sg_gl_teximage_internal_format(img->cmn.pixel_format);
+    const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
+    const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
+    const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
+    const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+    const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        GLenum gl_img_target = img->gl.target;
+        if (SG_IMAGETYPE_CUBE == img->cmn.type) {
+            gl_img_target = _sg_gl_cubeface_target(face_index);
+        }
+        const GLvoid* data_ptr = data->subimage[face_index][mip_index].ptr;
+        const GLsizei data_size = (GLsizei) data->subimage[face_index][mip_index].size;
+        if ((SG_IMAGETYPE_2D == img->cmn.type) || (SG_IMAGETYPE_CUBE == img->cmn.type)) {
+            if (is_compressed) {
+                glCompressedTexSubImage2D(gl_img_target, mip_index, 0, 0, mip_width, mip_height, gl_internal_format, data_size, data_ptr);
+            }
+            else {
+                glTexSubImage2D(gl_img_target, mip_index, 0, 0, mip_width, mip_height, gl_img_format, gl_img_type, data_ptr);
+            }
+        }
+        #if !defined(SOKOL_GLES2)
+        else if (!_sg.gl.gles2 && ((SG_IMAGETYPE_3D == img->cmn.type) || (SG_IMAGETYPE_ARRAY == img->cmn.type))) {
+            int mip_depth = img->cmn.num_slices;
+            if (SG_IMAGETYPE_3D == img->cmn.type) {
+                mip_depth = _sg_max(mip_depth >> mip_index, 1);
+            }
+            if (is_compressed) {
+                glCompressedTexSubImage3D(gl_img_target, mip_index, 0, 0, 0, mip_width, mip_height, mip_depth, gl_internal_format, data_size, data_ptr);
+            }
+            else {
+                glTexSubImage3D(gl_img_target, mip_index, 0, 0, 0, mip_width, mip_height, mip_depth, gl_img_format, gl_img_type, data_ptr);
+            }
+        }
+        #endif
+    }
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        glTexParameteri(img->gl.target, GL_TEXTURE_BASE_LEVEL, mip_index);
+    }
+    #endif
+    _sg_gl_cache_restore_texture_binding(0);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_query(_sg_query_t* qry, const sg_query_object_desc* desc) {
+    SOKOL_ASSERT(qry && desc);
+    SOKOL_ASSERT(_sg.features.occlusion_query);
+    _SG_GL_CHECK_ERROR();
+    _sg_query_common_init(&qry->cmn, desc);
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        glGenQueries(_SG_QUERY_RING_SIZE, qry->gl.ids);
+        _SG_GL_CHECK_ERROR();
+        return SG_RESOURCESTATE_VALID;
+    }
+    #endif
+    return SG_RESOURCESTATE_FAILED;
+}
+
+_SOKOL_PRIVATE void _sg_gl_destroy_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry);
+    _SG_GL_CHECK_ERROR();
+    #if !defined(SOKOL_GLES2)
+    if (qry->gl.ids[0]) {
+        glDeleteQueries(_SG_QUERY_RING_SIZE, qry->gl.ids);
+    }
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_begin_query(_sg_query_t* qry, int slot) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE));
+    _SG_GL_CHECK_ERROR();
+    #if !defined(SOKOL_GLES2)
+    glBeginQuery(GL_ANY_SAMPLES_PASSED, qry->gl.ids[slot]);
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry);
+    _SOKOL_UNUSED(qry);
+    _SG_GL_CHECK_ERROR();
+    #if !defined(SOKOL_GLES2)
+    glEndQuery(GL_ANY_SAMPLES_PASSED);
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
+/* non-blocking check for a query result, returns false if the result isn't available yet */
+_SOKOL_PRIVATE bool _sg_gl_query_result(_sg_query_t* qry, int slot, bool* out_visible) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE) && out_visible);
+    bool available = false;
+    _SG_GL_CHECK_ERROR();
+    #if !defined(SOKOL_GLES2)
+    GLuint gl_available = 0;
+    glGetQueryObjectuiv(qry->gl.ids[slot], GL_QUERY_RESULT_AVAILABLE, &gl_available);
+    if (gl_available) {
+        GLuint gl_result = 0;
+        glGetQueryObjectuiv(qry->gl.ids[slot], GL_QUERY_RESULT, &gl_result);
+        *out_visible = (0 != gl_result);
+        available = true;
+    }
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(out_visible);
+    #endif
+    _SG_GL_CHECK_ERROR();
+    return available;
+}
+
+_SOKOL_PRIVATE void _sg_gl_begin_conditional_render(_sg_query_t* qry, int slot) {
+    SOKOL_ASSERT(qry && (slot >= 0) && (slot < _SG_QUERY_RING_SIZE));
+    _SG_GL_CHECK_ERROR();
+    #if defined(SOKOL_GLCORE33)
+    glBeginConditionalRender(qry->gl.ids[slot], GL_QUERY_NO_WAIT);
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_conditional_render(void) {
+    _SG_GL_CHECK_ERROR();
+    #if defined(SOKOL_GLCORE33)
+    glEndConditionalRender();
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
 /*== D3D11 BACKEND IMPLEMENTATION ============================================*/
 #elif defined(SOKOL_D3D11)
 
@@ -8081,6 +9320,14 @@ static inline void _sg_d3d11_UpdateSubresource(ID3D11DeviceContext* self, ID3D11
     #endif
 }
 
+static inline void _sg_d3d11_SetResourceMinLOD(ID3D11DeviceContext* self, ID3D11Resource* pResource, FLOAT MinLOD) {
+    #if defined(__cplusplus)
+        self->SetResourceMinLOD(pResource, MinLOD);
+    #else
+        self->lpVtbl->SetResourceMinLOD(self, pResource, MinLOD);
+    #endif
+}
+
 static inline void _sg_d3d11_DrawIndexed(ID3D11DeviceContext* self, UINT IndexCount, UINT StartIndexLocation, INT  BaseVertexLocation) {
     #if defined(__cplusplus)
         self->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
@@ -8418,6 +9665,9 @@ _SOKOL_PRIVATE void _sg_d3d11_init_caps(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.mip_streaming = true;
+    _sg.features.occlusion_query = false;
+    _sg.features.conditional_render = false;
 
     _sg.limits.max_image_size_2d = 16 * 1024;
     _sg.limits.max_image_size_cube = 16 * 1024;
@@ -8569,6 +9819,39 @@ _SOKOL_PRIVATE void _sg_d3d11_fill_subres_data(const _sg_image_t* img, const sg_
     }
 }
 
+/* upload the mips [first_mip, num_mipmaps) of a streaming image and clamp sampling to those mips */
+_SOKOL_PRIVATE void _sg_d3d11_upload_image_mips(_sg_image_t* img, const sg_image_data* data, int first_mip, int last_mip) {
+    SOKOL_ASSERT(img && data && img->cmn.streaming);
+    SOKOL_ASSERT(_sg.d3d11.ctx);
+    ID3D11Resource* d3d11_res = 0;
+    if (img->d3d11.tex3d) {
+        d3d11_res = (ID3D11Resource*) img->d3d11.tex3d;
+    }
+    else {
+        d3d11_res = (ID3D11Resource*) img->d3d11.tex2d;
+    }
+    SOKOL_ASSERT(d3d11_res);
+    const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6:1;
+    const int num_slices = (img->cmn.type == SG_IMAGETYPE_ARRAY) ? img->cmn.num_slices:1;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int slice_index = 0; slice_index < num_slices; slice_index++) {
+            for (int mip_index = first_mip; mip_index < last_mip; mip_index++) {
+                const UINT subres_index = (UINT)((((face_index * num_slices) + slice_index) * img->cmn.num_mipmaps) + mip_index);
+                const int mip_width = ((img->cmn.width>>mip_index)>0) ? img->cmn.width>>mip_index : 1;
+                const int mip_height = ((img->cmn.height>>mip_index)>0) ? img->cmn.height>>mip_index : 1;
+                const sg_range* subimg_data = &(data->subimage[face_index][mip_index]);
+                const size_t slice_size = subimg_data->size / (size_t)num_slices;
+                const size_t slice_offset = slice_size * (size_t)slice_index;
+                const uint8_t* slice_ptr = ((const uint8_t*)subimg_data->ptr) + slice_offset;
+                const UINT row_pitch = (UINT)_sg_row_pitch(img->cmn.pixel_format, mip_width, 1);
+                const UINT depth_pitch = (UINT)_sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1);
+                _sg_d3d11_UpdateSubresource(_sg.d3d11.ctx, d3d11_res, subres_index, NULL, slice_ptr, row_pitch, depth_pitch);
+            }
+        }
+    }
+    _sg_d3d11_SetResourceMinLOD(_sg.d3d11.ctx, d3d11_res, (FLOAT)first_mip);
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && desc);
     SOKOL_ASSERT(!img->d3d11.tex2d && !img->d3d11.tex3d && !img->d3d11.texds && !img->d3d11.texmsaa);
@@ -8610,7 +9893,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_image(_sg_image_t* img, const
 
         /* prepare initial content pointers */
         D3D11_SUBRESOURCE_DATA* init_data = 0;
-        if (!injected && (img->cmn.usage == SG_USAGE_IMMUTABLE) && !img->cmn.render_target) {
+        if (!injected && (img->cmn.usage == SG_USAGE_IMMUTABLE) && !img->cmn.render_target && !img->cmn.streaming) {
             _sg_d3d11_fill_subres_data(img, &desc->data);
             init_data = _sg.d3d11.subres_data;
         }
@@ -8660,7 +9943,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_image(_sg_image_t* img, const
                     d3d11_tex_desc.CPUAccessFlags = 0;
                 }
                 else {
-                    d3d11_tex_desc.Usage = _sg_d3d11_usage(img->cmn.usage);
+                    /* streaming images are updated with UpdateSubresource(), which needs D3D11_USAGE_DEFAULT */
+                    d3d11_tex_desc.Usage = img->cmn.streaming ? D3D11_USAGE_DEFAULT : _sg_d3d11_usage(img->cmn.usage);
                     d3d11_tex_desc.CPUAccessFlags = _sg_d3d11_cpu_access_flags(img->cmn.usage);
                 }
                 if (img->d3d11.format == DXGI_FORMAT_UNKNOWN) {
@@ -8743,7 +10027,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_image(_sg_image_t* img, const
                     d3d11_tex_desc.CPUAccessFlags = 0;
                 }
                 else {
-                    d3d11_tex_desc.Usage = _sg_d3d11_usage(img->cmn.usage);
+                    /* streaming images are updated with UpdateSubresource(), which needs D3D11_USAGE_DEFAULT */
+                    d3d11_tex_desc.Usage = img->cmn.streaming ? D3D11_USAGE_DEFAULT : _sg_d3d11_usage(img->cmn.usage);
                     d3d11_tex_desc.CPUAccessFlags = _sg_d3d11_cpu_access_flags(img->cmn.usage);
                 }
                 if (img->d3d11.format == DXGI_FORMAT_UNKNOWN) {
@@ -8823,6 +10108,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_image(_sg_image_t* img, const
             SOKOL_LOG("failed to create D3D11 sampler state\n");
             return SG_RESOURCESTATE_FAILED;
         }
+
+        /* a streaming image only gets its resident mip tail */
+        if (img->cmn.streaming) {
+            _sg_d3d11_upload_image_mips(img, &desc->data, img->cmn.resident_mip, img->cmn.num_mipmaps);
+        }
     }
     return SG_RESOURCESTATE_VALID;
 }
@@ -9295,7 +10585,7 @@ _SOKOL_PRIVATE _sg_image_t* _sg_d3d11_pass_ds_image(const _sg_pass_t* pass) {
     return pass->d3d11.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_d3d11_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+_SOKOL_PRIVATE void _sg_d3d11_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
     SOKOL_ASSERT(action);
     SOKOL_ASSERT(!_sg.d3d11.in_pass);
     SOKOL_ASSERT(_sg.d3d11.rtv_cb || _sg.d3d11.rtv_userdata_cb);
@@ -9303,6 +10593,9 @@ _SOKOL_PRIVATE void _sg_d3d11_begin_pass(_sg_pass_t* pass, const sg_pass_action*
     _sg.d3d11.in_pass = true;
     _sg.d3d11.cur_width = w;
     _sg.d3d11.cur_height = h;
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        _sg.d3d11.resolve_atts[i] = !action->colors[i].dont_resolve;
+    }
     if (pass) {
         _sg.d3d11.cur_pass = pass;
         _sg.d3d11.cur_pass_id.id = pass->slot.id;
@@ -9315,6 +10608,18 @@ _SOKOL_PRIVATE void _sg_d3d11_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         }
         _sg.d3d11.cur_dsv = pass->d3d11.ds_att.dsv;
     }
+    else if (swapchain) {
+        /* render to explicit swapchain */
+        _sg.d3d11.cur_pass = 0;
+        _sg.d3d11.cur_pass_id.id = SG_INVALID_ID;
+        _sg.d3d11.num_rtvs = 1;
+        _sg.d3d11.cur_rtvs[0] = (ID3D11RenderTargetView*) swapchain->d3d11.render_target_view;
+        for (int i = 1; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+            _sg.d3d11.cur_rtvs[i] = 0;
+        }
+        _sg.d3d11.cur_dsv = (ID3D11DepthStencilView*) swapchain->d3d11.depth_stencil_view;
+        SOKOL_ASSERT(_sg.d3d11.cur_rtvs[0]);
+    }
     else {
         /* render to default frame buffer */
         _sg.d3d11.cur_pass = 0;
@@ -9388,7 +10693,7 @@ _SOKOL_PRIVATE void _sg_d3d11_end_pass(void) {
             _sg_pass_attachment_t* cmn_att = &_sg.d3d11.cur_pass->cmn.color_atts[i];
             _sg_image_t* att_img = _sg.d3d11.cur_pass->d3d11.color_atts[i].image;
             SOKOL_ASSERT(att_img && (att_img->slot.id == cmn_att->image_id.id));
-            if (att_img->cmn.sample_count > 1) {
+            if ((att_img->cmn.sample_count > 1) && _sg.d3d11.resolve_atts[i]) {
                 /* FIXME: support MSAA resolve into 3D texture */
                 SOKOL_ASSERT(att_img->d3d11.tex2d && att_img->d3d11.texmsaa && !att_img->d3d11.tex3d);
                 SOKOL_ASSERT(DXGI_FORMAT_UNKNOWN != att_img->d3d11.format);
@@ -9571,6 +10876,7 @@ _SOKOL_PRIVATE int _sg_d3d11_append_buffer(_sg_buffer_t* buf, const sg_range* da
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
     SOKOL_ASSERT(_sg.d3d11.ctx);
     SOKOL_ASSERT(buf->d3d11.buf);
+    /* for ring buffers, new_frame is only true when the ring wraps around */
     D3D11_MAP map_type = new_frame ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
     D3D11_MAPPED_SUBRESOURCE d3d11_msr;
     HRESULT hr = _sg_d3d11_Map(_sg.d3d11.ctx, (ID3D11Resource*)buf->d3d11.buf, 0, map_type, 0, &d3d11_msr);
@@ -9638,6 +10944,10 @@ _SOKOL_PRIVATE void _sg_d3d11_update_image(_sg_image_t* img, const sg_image_data
     }
 }
 
+_SOKOL_PRIVATE void _sg_d3d11_update_image_mip(_sg_image_t* img, int mip_index, const sg_image_data* data) {
+    _sg_d3d11_upload_image_mips(img, data, mip_index, mip_index + 1);
+}
+
 /*== METAL BACKEND IMPLEMENTATION ============================================*/
 #elif defined(SOKOL_METAL)
 
@@ -10182,6 +11492,8 @@ _SOKOL_PRIVATE void _sg_mtl_init_caps(void) {
     #endif
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.occlusion_query = false;
+    _sg.features.conditional_render = false;
 
     #if defined(_SG_TARGET_MACOS)
         _sg.limits.max_image_size_2d = 16 * 1024;
@@ -10904,7 +12216,7 @@ _SOKOL_PRIVATE _sg_image_t* _sg_mtl_pass_ds_image(const _sg_pass_t* pass) {
     return pass->mtl.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+_SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
     SOKOL_ASSERT(action);
     SOKOL_ASSERT(!_sg.mtl.in_pass);
     SOKOL_ASSERT(_sg.mtl.cmd_queue);
@@ -10938,6 +12250,13 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
         /* offscreen render pass */
         pass_desc = [MTLRenderPassDescriptor renderPassDescriptor];
     }
+    else if (swapchain) {
+        /* explicit swapchain pass, remember the drawable for presentation in sg_commit() */
+        pass_desc = (__bridge MTLRenderPassDescriptor*) swapchain->metal.render_pass_descriptor;
+        if (swapchain->metal.drawable && (_sg.mtl.num_swapchain_drawables < SG_MAX_SWAPCHAINS)) {
+            _sg.mtl.swapchain_drawables[_sg.mtl.num_swapchain_drawables++] = swapchain->metal.drawable;
+        }
+    }
     else {
         /* default render pass, call user-provided callback to provide render pass descriptor */
         if (_sg.mtl.renderpass_descriptor_cb) {
@@ -10967,14 +12286,17 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
             SOKOL_ASSERT(att_img->slot.state == SG_RESOURCESTATE_VALID);
             SOKOL_ASSERT(att_img->slot.id == cmn_att->image_id.id);
             const bool is_msaa = (att_img->cmn.sample_count > 1);
+            const bool resolve = is_msaa && !action->colors[i].dont_resolve;
             pass_desc.colorAttachments[i].loadAction = _sg_mtl_load_action(action->colors[i].action);
-            pass_desc.colorAttachments[i].storeAction = is_msaa ? MTLStoreActionMultisampleResolve : MTLStoreActionStore;
+            pass_desc.colorAttachments[i].storeAction = resolve ? MTLStoreActionMultisampleResolve : MTLStoreActionStore;
             sg_color c = action->colors[i].value;
             pass_desc.colorAttachments[i].clearColor = MTLClearColorMake(c.r, c.g, c.b, c.a);
             if (is_msaa) {
                 SOKOL_ASSERT(att_img->mtl.msaa_tex != _SG_MTL_INVALID_SLOT_INDEX);
                 SOKOL_ASSERT(att_img->mtl.tex[mtl_att->image->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
                 pass_desc.colorAttachments[i].texture = _sg_mtl_id(att_img->mtl.msaa_tex);
+            }
+            if (resolve) {
                 pass_desc.colorAttachments[i].resolveTexture = _sg_mtl_id(att_img->mtl.tex[att_img->cmn.active_slot]);
                 pass_desc.colorAttachments[i].resolveLevel = (NSUInteger)cmn_att->mip_level;
                 switch (att_img->cmn.type) {
@@ -10988,7 +12310,7 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
                     default: break;
                 }
             }
-            else {
+            else if (!is_msaa) {
                 SOKOL_ASSERT(att_img->mtl.tex[att_img->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
                 pass_desc.colorAttachments[i].texture = _sg_mtl_id(att_img->mtl.tex[att_img->cmn.active_slot]);
                 pass_desc.colorAttachments[i].level = (NSUInteger)cmn_att->mip_level;
@@ -11070,6 +12392,11 @@ _SOKOL_PRIVATE void _sg_mtl_commit(void) {
     if (nil != cur_drawable) {
         [_sg.mtl.cmd_buffer presentDrawable:cur_drawable];
     }
+    for (int i = 0; i < _sg.mtl.num_swapchain_drawables; i++) {
+        [_sg.mtl.cmd_buffer presentDrawable:(__bridge id<MTLDrawable>)_sg.mtl.swapchain_drawables[i]];
+        _sg.mtl.swapchain_drawables[i] = 0;
+    }
+    _sg.mtl.num_swapchain_drawables = 0;
     [_sg.mtl.cmd_buffer commit];
 
     /* garbage-collect resources pending for release */
@@ -11653,6 +12980,8 @@ _SOKOL_PRIVATE void _sg_wgpu_init_caps(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.occlusion_query = false;
+    _sg.features.conditional_render = false;
 
     /* FIXME: max images size??? */
     _sg.limits.max_image_size_2d = 8 * 1024;
@@ -12728,7 +14057,7 @@ _SOKOL_PRIVATE _sg_image_t* _sg_wgpu_pass_ds_image(const _sg_pass_t* pass) {
     return pass->wgpu.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+_SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
     SOKOL_ASSERT(action);
     SOKOL_ASSERT(!_sg.wgpu.in_pass);
     SOKOL_ASSERT(_sg.wgpu.render_cmd_enc);
@@ -12758,7 +14087,7 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
             wgpu_color_att_desc[i].clearColor.b = action->colors[i].value.b;
             wgpu_color_att_desc[i].clearColor.a = action->colors[i].value.a;
             wgpu_color_att_desc[i].attachment = wgpu_att->render_tex_view;
-            if (wgpu_att->image->cmn.sample_count > 1) {
+            if ((wgpu_att->image->cmn.sample_count > 1) && !action->colors[i].dont_resolve) {
                 wgpu_color_att_desc[i].resolveTarget = wgpu_att->resolve_tex_view;
             }
         }
@@ -12777,10 +14106,20 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         }
     }
     else {
-        /* default render pass */
-        WGPUTextureView wgpu_render_view = _sg.wgpu.render_view_cb ? _sg.wgpu.render_view_cb() : _sg.wgpu.render_view_userdata_cb(_sg.wgpu.user_data);
-        WGPUTextureView wgpu_resolve_view = _sg.wgpu.resolve_view_cb ? _sg.wgpu.resolve_view_cb() : _sg.wgpu.resolve_view_userdata_cb(_sg.wgpu.user_data);
-        WGPUTextureView wgpu_depth_stencil_view = _sg.wgpu.depth_stencil_view_cb ? _sg.wgpu.depth_stencil_view_cb() : _sg.wgpu.depth_stencil_view_userdata_cb(_sg.wgpu.user_data);
+        /* default render pass or explicit swapchain pass */
+        WGPUTextureView wgpu_render_view;
+        WGPUTextureView wgpu_resolve_view;
+        WGPUTextureView wgpu_depth_stencil_view;
+        if (swapchain) {
+            wgpu_render_view = (WGPUTextureView) swapchain->wgpu.render_view;
+            wgpu_resolve_view = (WGPUTextureView) swapchain->wgpu.resolve_view;
+            wgpu_depth_stencil_view = (WGPUTextureView) swapchain->wgpu.depth_stencil_view;
+        }
+        else {
+            wgpu_render_view = _sg.wgpu.render_view_cb ? _sg.wgpu.render_view_cb() : _sg.wgpu.render_view_userdata_cb(_sg.wgpu.user_data);
+            wgpu_resolve_view = _sg.wgpu.resolve_view_cb ? _sg.wgpu.resolve_view_cb() : _sg.wgpu.resolve_view_userdata_cb(_sg.wgpu.user_data);
+            wgpu_depth_stencil_view = _sg.wgpu.depth_stencil_view_cb ? _sg.wgpu.depth_stencil_view_cb() : _sg.wgpu.depth_stencil_view_userdata_cb(_sg.wgpu.user_data);
+        }
 
         WGPURenderPassDescriptor pass_desc;
         memset(&pass_desc, 0, sizeof(pass_desc));
@@ -13332,17 +14671,17 @@ static inline _sg_image_t* _sg_pass_ds_image(const _sg_pass_t* pass) {
     #endif
 }
 
-static inline void _sg_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+static inline void _sg_begin_pass(_sg_pass_t* pass, const sg_swapchain* swapchain, const sg_pass_action* action, int w, int h) {
     #if defined(_SOKOL_ANY_GL)
-    _sg_gl_begin_pass(pass, action, w, h);
+    _sg_gl_begin_pass(pass, swapchain, action, w, h);
     #elif defined(SOKOL_METAL)
-    _sg_mtl_begin_pass(pass, action, w, h);
+    _sg_mtl_begin_pass(pass, swapchain, action, w, h);
     #elif defined(SOKOL_D3D11)
-    _sg_d3d11_begin_pass(pass, action, w, h);
+    _sg_d3d11_begin_pass(pass, swapchain, action, w, h);
     #elif defined(SOKOL_WGPU)
-    _sg_wgpu_begin_pass(pass, action, w, h);
+    _sg_wgpu_begin_pass(pass, swapchain, action, w, h);
     #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_begin_pass(pass, action, w, h);
+    _sg_dummy_begin_pass(pass, swapchain, action, w, h);
     #else
     #error("INVALID BACKEND");
     #endif
@@ -13364,6 +14703,18 @@ static inline void _sg_end_pass(void) {
     #endif
 }
 
+/* return the most recent frame index which is known to be finished by the GPU */
+static inline uint32_t _sg_completed_frame_index(void) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_completed_frame_index();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_completed_frame_index();
+    #else
+    /* the other backends never have more than SG_NUM_INFLIGHT_FRAMES frames in flight */
+    return (_sg.frame_index > SG_NUM_INFLIGHT_FRAMES) ? (_sg.frame_index - SG_NUM_INFLIGHT_FRAMES - 1) : 0;
+    #endif
+}
+
 static inline void _sg_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_apply_viewport(x, y, w, h, origin_top_left);
@@ -13514,6 +14865,20 @@ static inline int _sg_append_buffer(_sg_buffer_t* buf, const sg_range* data, boo
     #endif
 }
 
+static inline void _sg_update_buffer_range(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_buffer_range(buf, offset, data);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_buffer_range(buf, offset, data);
+    #else
+    /* buffer arenas are not supported on this backend (see sg_features.buffer_arenas) */
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
 static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_update_image(img, data);
@@ -13530,79 +14895,202 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data)
     #endif
 }
 
-/*== RESOURCE POOLS ==========================================================*/
-
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
-    /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)pool->size;
-    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
-    SOKOL_ASSERT(pool->gen_ctrs);
-    memset(pool->gen_ctrs, 0, gen_ctrs_size);
-    /* it's not a bug to only reserve 'num' here */
-    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)num);
-    SOKOL_ASSERT(pool->free_queue);
-    /* never allocate the zero-th pool item since the invalid id is 0 */
-    for (int i = pool->size-1; i >= 1; i--) {
-        pool->free_queue[pool->queue_top++] = i;
-    }
+static inline void _sg_update_image_mip(_sg_image_t* img, int mip_index, const sg_image_data* data) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_image_mip(img, mip_index, data);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_update_image_mip(img, mip_index, data);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_image_mip(img, mip_index, data);
+    #else
+    /* streaming images are not supported on this backend (see sg_features.mip_streaming) */
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(mip_index);
+    _SOKOL_UNUSED(data);
+    SOKOL_UNREACHABLE;
+    #endif
 }
 
-_SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    SOKOL_FREE(pool->free_queue);
-    pool->free_queue = 0;
-    SOKOL_ASSERT(pool->gen_ctrs);
-    SOKOL_FREE(pool->gen_ctrs);
-    pool->gen_ctrs = 0;
-    pool->size = 0;
-    pool->queue_top = 0;
+static inline sg_resource_state _sg_create_query(_sg_query_t* qry, const sg_query_object_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_query(qry, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_query(qry, desc);
+    #else
+    /* occlusion queries are not supported on this backend (see sg_features.occlusion_query) */
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(desc);
+    return SG_RESOURCESTATE_FAILED;
+    #endif
 }
 
-_SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    if (pool->queue_top > 0) {
-        int slot_index = pool->free_queue[--pool->queue_top];
-        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
-        return slot_index;
-    }
-    else {
-        /* pool exhausted */
-        return _SG_INVALID_SLOT_INDEX;
-    }
+static inline void _sg_destroy_query(_sg_query_t* qry) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_query(qry);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_query(qry);
+    #else
+    _SOKOL_UNUSED(qry);
+    #endif
 }
 
-_SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
-    SOKOL_ASSERT(pool);
-    SOKOL_ASSERT(pool->free_queue);
-    SOKOL_ASSERT(pool->queue_top < pool->size);
-    #ifdef SOKOL_DEBUG
-    /* debug check against double-free */
-    for (int i = 0; i < pool->queue_top; i++) {
-        SOKOL_ASSERT(pool->free_queue[i] != slot_index);
-    }
+static inline void _sg_begin_query(_sg_query_t* qry, int slot) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_query(qry, slot);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_begin_query(qry, slot);
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    SOKOL_UNREACHABLE;
     #endif
-    pool->free_queue[pool->queue_top++] = slot_index;
-    SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
 }
 
-_SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
-    SOKOL_ASSERT(slot);
-    memset(slot, 0, sizeof(_sg_slot_t));
+static inline void _sg_end_query(_sg_query_t* qry) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_query(qry);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_end_query(qry);
+    #else
+    _SOKOL_UNUSED(qry);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline bool _sg_query_result(_sg_query_t* qry, int slot, bool* out_visible) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_query_result(qry, slot, out_visible);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_query_result(qry, slot, out_visible);
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(out_visible);
+    SOKOL_UNREACHABLE;
+    return false;
+    #endif
+}
+
+static inline void _sg_begin_conditional_render(_sg_query_t* qry, int slot) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_conditional_render(qry, slot);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_begin_conditional_render(qry, slot);
+    #else
+    _SOKOL_UNUSED(qry);
+    _SOKOL_UNUSED(slot);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline void _sg_end_conditional_render(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_conditional_render();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_end_conditional_render();
+    #else
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+/*== RESOURCE POOLS ==========================================================*/
+
+/*
+    All pools live in a single memory block: the resource arrays come first
+    (each aligned to a cache line), followed by the rarely accessed
+    generation counters and free queues. _sg_pool_mem_alloc() carves
+    sub-ranges out of the block, with a null base pointer it only computes
+    the required size.
+*/
+_SOKOL_PRIVATE void* _sg_pool_mem_alloc(_sg_pool_mem_t* mem, size_t size) {
+    mem->pos = (mem->pos + (_SG_POOL_ALIGN - 1)) & ~(size_t)(_SG_POOL_ALIGN - 1);
+    void* ptr = mem->base ? (mem->base + mem->pos) : 0;
+    mem->pos += size;
+    return ptr;
+}
+
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, _sg_pool_mem_t* mem) {
+    SOKOL_ASSERT(pool && (num >= 1) && mem);
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    pool->size = num + 1;
+    pool->queue_top = 0;
+    /* generation counters indexable by pool slot index, slot 0 is reserved */
+    pool->gen_ctrs = (uint32_t*) _sg_pool_mem_alloc(mem, sizeof(uint32_t) * (size_t)pool->size);
+    /* it's not a bug to only reserve 'num' here */
+    pool->free_queue = (int*) _sg_pool_mem_alloc(mem, sizeof(int) * (size_t)num);
+    if (mem->base) {
+        /* never allocate the zero-th pool item since the invalid id is 0 */
+        for (int i = pool->size-1; i >= 1; i--) {
+            pool->free_queue[pool->queue_top++] = i;
+        }
+    }
+}
+
+_SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_queue);
+    if (pool->queue_top > 0) {
+        int slot_index = pool->free_queue[--pool->queue_top];
+        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+        return slot_index;
+    }
+    else {
+        /* pool exhausted */
+        return _SG_INVALID_SLOT_INDEX;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_queue);
+    SOKOL_ASSERT(pool->queue_top < pool->size);
+    #ifdef SOKOL_DEBUG
+    /* debug check against double-free */
+    for (int i = 0; i < pool->queue_top; i++) {
+        SOKOL_ASSERT(pool->free_queue[i] != slot_index);
+    }
+    #endif
+    pool->free_queue[pool->queue_top++] = slot_index;
+    SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
+}
+
+_SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
+    SOKOL_ASSERT(slot);
+    memset(slot, 0, sizeof(_sg_slot_t));
+}
+
+_SOKOL_PRIVATE _sg_buffer_allocator_t* _sg_buffer_allocator(const _sg_pools_t* p, const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(p && p->buffers && p->buffer_allocators && buf);
+    SOKOL_ASSERT((buf >= p->buffers) && (buf < (p->buffers + p->buffer_pool.size)));
+    return &p->buffer_allocators[buf - p->buffers];
+}
+
+/* must be called whenever a buffer's state, overflow flag or parent changes */
+_SOKOL_PRIVATE void _sg_update_buffer_bind_id(_sg_pools_t* p, const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(p && buf);
+    SOKOL_ASSERT((buf >= p->buffers) && (buf < (p->buffers + p->buffer_pool.size)));
+    const bool bindable = (buf->slot.state == SG_RESOURCESTATE_VALID) &&
+                          !buf->cmn.append_overflow &&
+                          (buf->cmn.parent_id.id == SG_INVALID_ID);
+    p->buffer_bind_ids[buf - p->buffers] = bindable ? buf->slot.id : (uint32_t)SG_INVALID_ID;
+}
+
+/* must be called whenever an image's state changes */
+_SOKOL_PRIVATE void _sg_update_image_bind_id(_sg_pools_t* p, const _sg_image_t* img) {
+    SOKOL_ASSERT(p && img);
+    SOKOL_ASSERT((img >= p->images) && (img < (p->images + p->image_pool.size)));
+    p->image_bind_ids[img - p->images] = (img->slot.state == SG_RESOURCESTATE_VALID) ? img->slot.id : (uint32_t)SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_reset_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
+    memset(_sg_buffer_allocator(&_sg.pools, buf), 0, sizeof(_sg_buffer_allocator_t));
     _sg_slot_t slot = buf->slot;
     memset(buf, 0, sizeof(_sg_buffer_t));
     buf->slot = slot;
     buf->slot.state = SG_RESOURCESTATE_ALLOC;
+    _sg_update_buffer_bind_id(&_sg.pools, buf);
 }
 
 _SOKOL_PRIVATE void _sg_reset_image(_sg_image_t* img) {
@@ -13611,6 +15099,7 @@ _SOKOL_PRIVATE void _sg_reset_image(_sg_image_t* img) {
     memset(img, 0, sizeof(_sg_image_t));
     img->slot = slot;
     img->slot.state = SG_RESOURCESTATE_ALLOC;
+    _sg_update_image_bind_id(&_sg.pools, img);
 }
 
 _SOKOL_PRIVATE void _sg_reset_shader(_sg_shader_t* shd) {
@@ -13637,6 +15126,14 @@ _SOKOL_PRIVATE void _sg_reset_pass(_sg_pass_t* pass) {
     pass->slot.state = SG_RESOURCESTATE_ALLOC;
 }
 
+_SOKOL_PRIVATE void _sg_reset_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry);
+    _sg_slot_t slot = qry->slot;
+    memset(qry, 0, sizeof(_sg_query_t));
+    qry->slot = slot;
+    qry->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
 _SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
     _sg_slot_t slot = ctx->slot;
@@ -13645,67 +15142,55 @@ _SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
     ctx->slot.state = SG_RESOURCESTATE_ALLOC;
 }
 
+_SOKOL_PRIVATE void _sg_layout_pools(_sg_pools_t* p, const sg_desc* desc, _sg_pool_mem_t* mem) {
+    /* note: the pools here will have an additional item, since slot 0 is reserved */
+    p->buffer_bind_ids = (uint32_t*) _sg_pool_mem_alloc(mem, sizeof(uint32_t) * (size_t)(desc->buffer_pool_size + 1));
+    p->image_bind_ids = (uint32_t*) _sg_pool_mem_alloc(mem, sizeof(uint32_t) * (size_t)(desc->image_pool_size + 1));
+    p->buffers = (_sg_buffer_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_buffer_t) * (size_t)(desc->buffer_pool_size + 1));
+    p->images = (_sg_image_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_image_t) * (size_t)(desc->image_pool_size + 1));
+    p->shaders = (_sg_shader_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_shader_t) * (size_t)(desc->shader_pool_size + 1));
+    p->pipelines = (_sg_pipeline_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_pipeline_t) * (size_t)(desc->pipeline_pool_size + 1));
+    p->passes = (_sg_pass_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_pass_t) * (size_t)(desc->pass_pool_size + 1));
+    p->queries = (_sg_query_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_query_t) * (size_t)(desc->query_pool_size + 1));
+    p->contexts = (_sg_context_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_context_t) * (size_t)(desc->context_pool_size + 1));
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size, mem);
+    _sg_init_pool(&p->image_pool, desc->image_pool_size, mem);
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size, mem);
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size, mem);
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size, mem);
+    _sg_init_pool(&p->query_pool, desc->query_pool_size, mem);
+    _sg_init_pool(&p->context_pool, desc->context_pool_size, mem);
+    /* cold per-buffer data goes behind everything that's needed for resource lookup */
+    p->buffer_allocators = (_sg_buffer_allocator_t*) _sg_pool_mem_alloc(mem, sizeof(_sg_buffer_allocator_t) * (size_t)(desc->buffer_pool_size + 1));
+}
+
 _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     SOKOL_ASSERT(p);
     SOKOL_ASSERT(desc);
-    /* note: the pools here will have an additional item, since slot 0 is reserved */
     SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * (size_t)p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
-    SOKOL_ASSERT(p->buffers);
-    memset(p->buffers, 0, buffer_pool_byte_size);
-
     SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * (size_t)p->image_pool.size;
-    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
-    SOKOL_ASSERT(p->images);
-    memset(p->images, 0, image_pool_byte_size);
-
     SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * (size_t)p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
-    SOKOL_ASSERT(p->shaders);
-    memset(p->shaders, 0, shader_pool_byte_size);
-
     SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * (size_t)p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
-    SOKOL_ASSERT(p->pipelines);
-    memset(p->pipelines, 0, pipeline_pool_byte_size);
-
     SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * (size_t)p->pass_pool.size;
-    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
-    SOKOL_ASSERT(p->passes);
-    memset(p->passes, 0, pass_pool_byte_size);
-
+    SOKOL_ASSERT((desc->query_pool_size > 0) && (desc->query_pool_size < _SG_MAX_POOL_SIZE));
     SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * (size_t)p->context_pool.size;
-    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
-    SOKOL_ASSERT(p->contexts);
-    memset(p->contexts, 0, context_pool_byte_size);
+    /* first pass computes the overall size, second pass assigns the pointers */
+    _sg_pool_mem_t mem;
+    memset(&mem, 0, sizeof(mem));
+    _sg_layout_pools(p, desc, &mem);
+    const size_t block_size = mem.pos + _SG_POOL_ALIGN;
+    p->block = SOKOL_MALLOC(block_size);
+    SOKOL_ASSERT(p->block);
+    memset(p->block, 0, block_size);
+    mem.base = (uint8_t*) (((uintptr_t)p->block + (_SG_POOL_ALIGN - 1)) & ~(uintptr_t)(_SG_POOL_ALIGN - 1));
+    mem.pos = 0;
+    _sg_layout_pools(p, desc, &mem);
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
-    SOKOL_ASSERT(p);
-    SOKOL_FREE(p->contexts);    p->contexts = 0;
-    SOKOL_FREE(p->passes);      p->passes = 0;
-    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
-    SOKOL_FREE(p->shaders);     p->shaders = 0;
-    SOKOL_FREE(p->images);      p->images = 0;
-    SOKOL_FREE(p->buffers);     p->buffers = 0;
-    _sg_discard_pool(&p->context_pool);
-    _sg_discard_pool(&p->pass_pool);
-    _sg_discard_pool(&p->pipeline_pool);
-    _sg_discard_pool(&p->shader_pool);
-    _sg_discard_pool(&p->image_pool);
-    _sg_discard_pool(&p->buffer_pool);
+    SOKOL_ASSERT(p && p->block);
+    SOKOL_FREE(p->block);
+    memset(p, 0, sizeof(_sg_pools_t));
 }
 
 /* allocate the slot at slot_index:
@@ -13772,6 +15257,13 @@ _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     return &p->passes[slot_index];
 }
 
+_SOKOL_PRIVATE _sg_query_t* _sg_query_at(const _sg_pools_t* p, uint32_t qry_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != qry_id));
+    int slot_index = _sg_slot_index(qry_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->query_pool.size));
+    return &p->queries[slot_index];
+}
+
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
     int slot_index = _sg_slot_index(context_id);
@@ -13780,6 +15272,24 @@ _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t cont
 }
 
 /* returns pointer to resource with matching id check, may return 0 */
+/* true if a buffer is valid, not overflown and not sub-allocated from an arena,
+   only reads the dense buffer_bind_ids array, not the buffer object
+*/
+_SOKOL_PRIVATE bool _sg_buffer_bindable(const _sg_pools_t* p, uint32_t buf_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
+    int slot_index = _sg_slot_index(buf_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
+    return p->buffer_bind_ids[slot_index] == buf_id;
+}
+
+/* true if an image is valid, only reads the dense image_bind_ids array */
+_SOKOL_PRIVATE bool _sg_image_bindable(const _sg_pools_t* p, uint32_t img_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
+    int slot_index = _sg_slot_index(img_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
+    return p->image_bind_ids[slot_index] == img_id;
+}
+
 _SOKOL_PRIVATE _sg_buffer_t* _sg_lookup_buffer(const _sg_pools_t* p, uint32_t buf_id) {
     if (SG_INVALID_ID != buf_id) {
         _sg_buffer_t* buf = _sg_buffer_at(p, buf_id);
@@ -13833,6 +15343,17 @@ _SOKOL_PRIVATE _sg_pass_t* _sg_lookup_pass(const _sg_pools_t* p, uint32_t pass_i
     return 0;
 }
 
+_SOKOL_PRIVATE _sg_query_t* _sg_lookup_query(const _sg_pools_t* p, uint32_t qry_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != qry_id) {
+        _sg_query_t* qry = _sg_query_at(p, qry_id);
+        if (qry->slot.id == qry_id) {
+            return qry;
+        }
+    }
+    return 0;
+}
+
 _SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t ctx_id) {
     SOKOL_ASSERT(p);
     if (SG_INVALID_ID != ctx_id) {
@@ -13856,7 +15377,11 @@ _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
         if (p->buffers[i].slot.ctx_id == ctx_id) {
             sg_resource_state state = p->buffers[i].slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_buffer(&p->buffers[i]);
+                /* buffers in an arena don't own a 3D-API object */
+                if (p->buffers[i].cmn.parent_id.id == SG_INVALID_ID) {
+                    _sg_destroy_buffer(&p->buffers[i]);
+                    _sg_arena_discard(&_sg_buffer_allocator(p, &p->buffers[i])->arena);
+                }
             }
         }
     }
@@ -13892,6 +15417,14 @@ _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
             }
         }
     }
+    for (int i = 1; i < p->query_pool.size; i++) {
+        if (p->queries[i].slot.ctx_id == ctx_id) {
+            sg_resource_state state = p->queries[i].slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                _sg_destroy_query(&p->queries[i]);
+            }
+        }
+    }
 }
 
 /*== VALIDATION LAYER ========================================================*/
@@ -13905,6 +15438,15 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_BUFFERDESC_DATA:          return "immutable buffers must be initialized with data (sg_buffer_desc.data.ptr and sg_buffer_desc.data.size)";
         case _SG_VALIDATE_BUFFERDESC_DATA_SIZE:     return "immutable buffer data size differs from buffer size";
         case _SG_VALIDATE_BUFFERDESC_NO_DATA:       return "dynamic/stream usage buffers cannot be initialized with data";
+        case _SG_VALIDATE_BUFFERDESC_ARENA_SUPPORTED:   return "buffer arenas are not supported by this backend (sg_features.buffer_arenas)";
+        case _SG_VALIDATE_BUFFERDESC_ARENA_USAGE:       return "arena buffers must have SG_USAGE_IMMUTABLE";
+        case _SG_VALIDATE_BUFFERDESC_ARENA_NO_DATA:     return "arena buffers cannot be initialized with data";
+        case _SG_VALIDATE_BUFFERDESC_ARENA_INJECTED:    return "arena buffers cannot be injected";
+        case _SG_VALIDATE_BUFFERDESC_PARENT_USAGE:      return "buffers in an arena must have SG_USAGE_IMMUTABLE";
+        case _SG_VALIDATE_BUFFERDESC_PARENT_INJECTED:   return "buffers in an arena cannot be injected";
+        case _SG_VALIDATE_BUFFERDESC_PARENT_EXISTS:     return "sg_buffer_desc.parent must be a valid arena buffer";
+        case _SG_VALIDATE_BUFFERDESC_PARENT_TYPE:       return "buffer type must match type of arena buffer in sg_buffer_desc.parent";
+        case _SG_VALIDATE_BUFFERDESC_RING_USAGE:        return "ring buffers must have SG_USAGE_DYNAMIC or SG_USAGE_STREAM";
 
         /* image data (in image creation and updating) */
         case _SG_VALIDATE_IMAGEDATA_NODATA:         return "sg_image_data: no data (.ptr and/or .size is zero)";
@@ -13923,6 +15465,10 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_IMAGEDESC_INJECTED_NO_DATA:   return "images with injected textures cannot be initialized with data";
         case _SG_VALIDATE_IMAGEDESC_DYNAMIC_NO_DATA:    return "dynamic/stream images cannot be initialized with data";
         case _SG_VALIDATE_IMAGEDESC_COMPRESSED_IMMUTABLE:   return "compressed images must be immutable";
+        case _SG_VALIDATE_IMAGEDESC_STREAMING_SUPPORT:      return "streaming images not supported by backend (sg_features.mip_streaming)";
+        case _SG_VALIDATE_IMAGEDESC_STREAMING_IMMUTABLE:    return "streaming images must be immutable, not render targets and not injected";
+        case _SG_VALIDATE_IMAGEDESC_STREAMING_MIPMAPS:      return "streaming images must have more than one mipmap";
+        case _SG_VALIDATE_IMAGEDESC_STREAMING_MIP_TAIL:     return "streaming images must only provide data for a complete mip tail";
 
         /* shader creation */
         case _SG_VALIDATE_SHADERDESC_CANARY:                return "sg_shader_desc not initialized";
@@ -13971,6 +15517,34 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_BEGINPASS_PASS:       return "sg_begin_pass: pass must be valid";
         case _SG_VALIDATE_BEGINPASS_IMAGE:      return "sg_begin_pass: one or more attachment images are not valid";
 
+        /* sg_begin_swapchain_pass */
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_CANARY:        return "sg_begin_swapchain_pass: sg_swapchain not initialized";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_SIZE:          return "sg_begin_swapchain_pass: swapchain width and height must be > 0";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_COLOR_FORMAT:  return "sg_begin_swapchain_pass: swapchain color_format must match sg_desc.context.color_format";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_DEPTH_FORMAT:  return "sg_begin_swapchain_pass: swapchain depth_format must match sg_desc.context.depth_format";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_SAMPLE_COUNT:  return "sg_begin_swapchain_pass: swapchain sample_count must match sg_desc.context.sample_count";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_D3D11_RTV:     return "sg_begin_swapchain_pass: D3D11 swapchain requires render_target_view";
+        case _SG_VALIDATE_BEGINSWAPCHAINPASS_WGPU_VIEWS:    return "sg_begin_swapchain_pass: WebGPU swapchain requires render_view and depth_stencil_view";
+
+        /* query creation */
+        case _SG_VALIDATE_QUERYDESC_CANARY:     return "sg_query_object_desc not initialized";
+        case _SG_VALIDATE_QUERYDESC_SUPPORTED:  return "occlusion queries are not supported by this backend (sg_features.occlusion_query)";
+
+        /* sg_begin_query / sg_end_query */
+        case _SG_VALIDATE_BEGINQUERY_QUERY:     return "sg_begin_query: query object not valid";
+        case _SG_VALIDATE_BEGINQUERY_NESTED:    return "sg_begin_query: queries cannot be nested (missing sg_end_query())";
+        case _SG_VALIDATE_ENDQUERY_NO_QUERY:    return "sg_end_query: no active query (missing sg_begin_query())";
+
+        /* sg_begin_conditional_render / sg_end_conditional_render */
+        case _SG_VALIDATE_BEGINCONDRENDER_QUERY:        return "sg_begin_conditional_render: query object not valid";
+        case _SG_VALIDATE_BEGINCONDRENDER_QUERY_ACTIVE: return "sg_begin_conditional_render: query is still active (missing sg_end_query())";
+        case _SG_VALIDATE_BEGINCONDRENDER_NESTED:       return "sg_begin_conditional_render: conditional rendering cannot be nested (missing sg_end_conditional_render())";
+        case _SG_VALIDATE_ENDCONDRENDER_NOT_ACTIVE:     return "sg_end_conditional_render: conditional rendering not active (missing sg_begin_conditional_render())";
+
+        /* sg_end_pass */
+        case _SG_VALIDATE_ENDPASS_QUERY:                return "sg_end_pass: occlusion query still active (missing sg_end_query())";
+        case _SG_VALIDATE_ENDPASS_CONDITIONAL_RENDER:   return "sg_end_pass: conditional rendering still active (missing sg_end_conditional_render())";
+
         /* sg_apply_pipeline */
         case _SG_VALIDATE_APIP_PIPELINE_VALID_ID:   return "sg_apply_pipeline: invalid pipeline id provided";
         case _SG_VALIDATE_APIP_PIPELINE_EXISTS:     return "sg_apply_pipeline: pipeline object no longer alive";
@@ -13990,11 +15564,13 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_ABND_VB_EXISTS:           return "sg_apply_bindings: vertex buffer no longer alive";
         case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER";
         case _SG_VALIDATE_ABND_VB_OVERFLOW:         return "sg_apply_bindings: buffer in vertex buffer slot is overflown";
+        case _SG_VALIDATE_ABND_VB_ARENA:            return "sg_apply_bindings: arena of buffer in vertex buffer slot no longer exists";
         case _SG_VALIDATE_ABND_NO_IB:               return "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided";
         case _SG_VALIDATE_ABND_IB:                  return "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided";
         case _SG_VALIDATE_ABND_IB_EXISTS:           return "sg_apply_bindings: index buffer no longer alive";
         case _SG_VALIDATE_ABND_IB_TYPE:             return "sg_apply_bindings: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER";
         case _SG_VALIDATE_ABND_IB_OVERFLOW:         return "sg_apply_bindings: buffer in index buffer slot is overflown";
+        case _SG_VALIDATE_ABND_IB_ARENA:            return "sg_apply_bindings: arena of buffer in index buffer slot no longer exists";
         case _SG_VALIDATE_ABND_VS_IMGS:             return "sg_apply_bindings: vertex shader image count doesn't match sg_shader_desc";
         case _SG_VALIDATE_ABND_VS_IMG_EXISTS:       return "sg_apply_bindings: vertex shader image no longer alive";
         case _SG_VALIDATE_ABND_VS_IMG_TYPES:        return "sg_apply_bindings: one or more vertex shader image types don't match sg_shader_desc";
@@ -14012,6 +15588,7 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_UPDATEBUF_SIZE:       return "sg_update_buffer: update size is bigger than buffer size";
         case _SG_VALIDATE_UPDATEBUF_ONCE:       return "sg_update_buffer: only one update allowed per buffer and frame";
         case _SG_VALIDATE_UPDATEBUF_APPEND:     return "sg_update_buffer: cannot call sg_update_buffer and sg_append_buffer in same frame";
+        case _SG_VALIDATE_UPDATEBUF_RING:       return "sg_update_buffer: cannot update ring buffer (use sg_append_buffer)";
 
         /* sg_append_buffer */
         case _SG_VALIDATE_APPENDBUF_USAGE:      return "sg_append_buffer: cannot append to immutable buffer";
@@ -14022,6 +15599,11 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_UPDIMG_USAGE:         return "sg_update_image: cannot update immutable image";
         case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
 
+        /* sg_update_image_mip */
+        case _SG_VALIDATE_UPDIMGMIP_STREAMING:  return "sg_update_image_mip: image must be created with sg_image_desc.streaming";
+        case _SG_VALIDATE_UPDIMGMIP_RANGE:      return "sg_update_image_mip: mip_index must be >= 0 and < num_mipmaps";
+        case _SG_VALIDATE_UPDIMGMIP_ORDER:      return "sg_update_image_mip: mip_index must be the next higher resolution mip (resident_mip - 1)";
+
         default: return "unknown validation error";
     }
 }
@@ -14052,6 +15634,93 @@ _SOKOL_PRIVATE bool _sg_validate_end(void) {
         return true;
     }
 }
+
+_SOKOL_PRIVATE void _sg_validate_cache_setup(void) {
+    _sg.validate_cache.epoch = 1;
+    if (_sg.desc.validation_cache) {
+        const size_t size = (size_t)_sg.pools.pipeline_pool.size * sizeof(_sg_validate_cache_item_t);
+        _sg.validate_cache.items = (_sg_validate_cache_item_t*) SOKOL_MALLOC(size);
+        SOKOL_ASSERT(_sg.validate_cache.items);
+        memset(_sg.validate_cache.items, 0, size);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_validate_cache_discard(void) {
+    if (_sg.validate_cache.items) {
+        SOKOL_FREE(_sg.validate_cache.items);
+        _sg.validate_cache.items = 0;
+    }
+}
+
+/* returns the cache item of a pipeline, or 0 if the cache is disabled */
+_SOKOL_PRIVATE _sg_validate_cache_item_t* _sg_validate_cache_item(uint32_t pip_id) {
+    if (_sg.validate_cache.items && (pip_id != SG_INVALID_ID)) {
+        return &_sg.validate_cache.items[_sg_slot_index(pip_id)];
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE bool _sg_validate_cache_bindings_equal(const _sg_validate_cache_bindings_t* cb, const sg_bindings* bindings) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        if (cb->vertex_buffers[i] != bindings->vertex_buffers[i].id) {
+            return false;
+        }
+    }
+    if (cb->index_buffer != bindings->index_buffer.id) {
+        return false;
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if ((cb->vs_images[i] != bindings->vs_images[i].id) || (cb->fs_images[i] != bindings->fs_images[i].id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sg_validate_cache_find_bindings(const _sg_validate_cache_item_t* item, const sg_bindings* bindings) {
+    if (item->bind_epoch != _sg.validate_cache.epoch) {
+        return false;
+    }
+    for (int i = 0; i < item->num_bindings; i++) {
+        if (_sg_validate_cache_bindings_equal(&item->bindings[i], bindings)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+_SOKOL_PRIVATE void _sg_validate_cache_add_bindings(_sg_validate_cache_item_t* item, const sg_bindings* bindings) {
+    if (item->bind_epoch != _sg.validate_cache.epoch) {
+        item->bind_epoch = _sg.validate_cache.epoch;
+        item->num_bindings = 0;
+        item->next_bindings = 0;
+    }
+    _sg_validate_cache_bindings_t* cb = &item->bindings[item->next_bindings];
+    item->next_bindings = (item->next_bindings + 1) % _SG_VALIDATE_CACHE_NUM_BINDINGS;
+    if (item->num_bindings < _SG_VALIDATE_CACHE_NUM_BINDINGS) {
+        item->num_bindings++;
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        cb->vertex_buffers[i] = bindings->vertex_buffers[i].id;
+    }
+    cb->index_buffer = bindings->index_buffer.id;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        cb->vs_images[i] = bindings->vs_images[i].id;
+        cb->fs_images[i] = bindings->fs_images[i].id;
+    }
+}
+
+/* must be called when a resource is destroyed or a buffer overflows,
+   this makes all cached validation results stale at once
+*/
+_SOKOL_PRIVATE void _sg_validate_cache_invalidate(void) {
+    if (0 == ++_sg.validate_cache.epoch) {
+        if (_sg.validate_cache.items) {
+            memset(_sg.validate_cache.items, 0, (size_t)_sg.pools.pipeline_pool.size * sizeof(_sg_validate_cache_item_t));
+        }
+        _sg.validate_cache.epoch = 1;
+    }
+}
 #endif
 
 _SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
@@ -14068,29 +15737,49 @@ _SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
                         (0 != desc->mtl_buffers[0]) ||
                         (0 != desc->d3d11_buffer) ||
                         (0 != desc->wgpu_buffer);
-        if (!injected && (desc->usage == SG_USAGE_IMMUTABLE)) {
+        if (desc->arena) {
+            SOKOL_VALIDATE(_sg.features.buffer_arenas, _SG_VALIDATE_BUFFERDESC_ARENA_SUPPORTED);
+            SOKOL_VALIDATE(desc->usage == SG_USAGE_IMMUTABLE, _SG_VALIDATE_BUFFERDESC_ARENA_USAGE);
+            SOKOL_VALIDATE(!injected, _SG_VALIDATE_BUFFERDESC_ARENA_INJECTED);
+            SOKOL_VALIDATE(0 == desc->data.ptr, _SG_VALIDATE_BUFFERDESC_ARENA_NO_DATA);
+        }
+        else if (!injected && (desc->usage == SG_USAGE_IMMUTABLE)) {
             SOKOL_VALIDATE((0 != desc->data.ptr) && (desc->data.size > 0), _SG_VALIDATE_BUFFERDESC_DATA);
             SOKOL_VALIDATE(desc->size == desc->data.size, _SG_VALIDATE_BUFFERDESC_DATA_SIZE);
         }
         else {
             SOKOL_VALIDATE(0 == desc->data.ptr, _SG_VALIDATE_BUFFERDESC_NO_DATA);
         }
+        if (desc->ring) {
+            SOKOL_VALIDATE(desc->usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_BUFFERDESC_RING_USAGE);
+        }
+        if (desc->parent.id != SG_INVALID_ID) {
+            SOKOL_VALIDATE(_sg.features.buffer_arenas, _SG_VALIDATE_BUFFERDESC_ARENA_SUPPORTED);
+            SOKOL_VALIDATE(desc->usage == SG_USAGE_IMMUTABLE, _SG_VALIDATE_BUFFERDESC_PARENT_USAGE);
+            SOKOL_VALIDATE(!injected, _SG_VALIDATE_BUFFERDESC_PARENT_INJECTED);
+            const _sg_buffer_t* parent = _sg_lookup_buffer(&_sg.pools, desc->parent.id);
+            SOKOL_VALIDATE(parent && (parent->slot.state == SG_RESOURCESTATE_VALID) && (0 != _sg_buffer_allocator(&_sg.pools, parent)->arena.nodes), _SG_VALIDATE_BUFFERDESC_PARENT_EXISTS);
+            if (parent) {
+                SOKOL_VALIDATE(parent->cmn.type == desc->type, _SG_VALIDATE_BUFFERDESC_PARENT_TYPE);
+            }
+        }
         return SOKOL_VALIDATE_END();
     #endif
 }
 
-_SOKOL_PRIVATE void _sg_validate_image_data(const sg_image_data* data, sg_pixel_format fmt, int width, int height, int num_faces, int num_mips, int num_slices) {
+_SOKOL_PRIVATE void _sg_validate_image_data(const sg_image_data* data, sg_pixel_format fmt, int width, int height, int num_faces, int first_mip, int num_mips, int num_slices) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(data);
         _SOKOL_UNUSED(fmt);
         _SOKOL_UNUSED(width);
         _SOKOL_UNUSED(height);
         _SOKOL_UNUSED(num_faces);
+        _SOKOL_UNUSED(first_mip);
         _SOKOL_UNUSED(num_mips);
         _SOKOL_UNUSED(num_slices);
     #else
         for (int face_index = 0; face_index < num_faces; face_index++) {
-            for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            for (int mip_index = first_mip; mip_index < num_mips; mip_index++) {
                 const bool has_data = data->subimage[face_index][mip_index].ptr != 0;
                 const bool has_size = data->subimage[face_index][mip_index].size > 0;
                 SOKOL_VALIDATE(has_data && has_size, _SG_VALIDATE_IMAGEDATA_NODATA);
@@ -14121,6 +15810,27 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
                               (0 != desc->mtl_textures[0]) ||
                               (0 != desc->d3d11_texture) ||
                               (0 != desc->wgpu_texture);
+        int first_mip = 0;
+        if (desc->streaming) {
+            SOKOL_VALIDATE(_sg.features.mip_streaming, _SG_VALIDATE_IMAGEDESC_STREAMING_SUPPORT);
+            SOKOL_VALIDATE(!desc->render_target && (usage == SG_USAGE_IMMUTABLE) && !injected, _SG_VALIDATE_IMAGEDESC_STREAMING_IMMUTABLE);
+            SOKOL_VALIDATE(desc->num_mipmaps > 1, _SG_VALIDATE_IMAGEDESC_STREAMING_MIPMAPS);
+            /* only the mip tail starting at the first mip with data must be initialized */
+            first_mip = _sg_max(desc->num_mipmaps - 1, 0);
+            for (int mip_index = 0; mip_index < desc->num_mipmaps; mip_index++) {
+                if (desc->data.subimage[0][mip_index].ptr) {
+                    first_mip = mip_index;
+                    break;
+                }
+            }
+            for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+                for (int mip_index = 0; mip_index < first_mip; mip_index++) {
+                    const bool no_data = 0 == desc->data.subimage[face_index][mip_index].ptr;
+                    const bool no_size = 0 == desc->data.subimage[face_index][mip_index].size;
+                    SOKOL_VALIDATE(no_data && no_size, _SG_VALIDATE_IMAGEDESC_STREAMING_MIP_TAIL);
+                }
+            }
+        }
         if (desc->render_target) {
             SOKOL_ASSERT(((int)fmt >= 0) && ((int)fmt < _SG_PIXELFORMAT_NUM));
             SOKOL_VALIDATE(_sg.formats[fmt].render, _SG_VALIDATE_IMAGEDESC_RT_PIXELFORMAT);
@@ -14153,6 +15863,7 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
                     desc->width,
                     desc->height,
                     (desc->type == SG_IMAGETYPE_CUBE) ? 6 : 1,
+                    first_mip,
                     desc->num_mipmaps,
                     desc->num_slices);
             }
@@ -14425,12 +16136,121 @@ _SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_begin_swapchain_pass(const sg_swapchain* swapchain) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(swapchain);
+        return true;
+    #else
+        SOKOL_ASSERT(swapchain);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(swapchain->_start_canary == 0, _SG_VALIDATE_BEGINSWAPCHAINPASS_CANARY);
+        SOKOL_VALIDATE(swapchain->_end_canary == 0, _SG_VALIDATE_BEGINSWAPCHAINPASS_CANARY);
+        SOKOL_VALIDATE((swapchain->width > 0) && (swapchain->height > 0), _SG_VALIDATE_BEGINSWAPCHAINPASS_SIZE);
+        /* the pipelines are created for the default framebuffer attributes */
+        const sg_pixel_format color_fmt = _sg_def(swapchain->color_format, _sg.desc.context.color_format);
+        const sg_pixel_format depth_fmt = _sg_def(swapchain->depth_format, _sg.desc.context.depth_format);
+        const int sample_count = _sg_def(swapchain->sample_count, _sg.desc.context.sample_count);
+        SOKOL_VALIDATE(color_fmt == _sg.desc.context.color_format, _SG_VALIDATE_BEGINSWAPCHAINPASS_COLOR_FORMAT);
+        SOKOL_VALIDATE(depth_fmt == _sg.desc.context.depth_format, _SG_VALIDATE_BEGINSWAPCHAINPASS_DEPTH_FORMAT);
+        SOKOL_VALIDATE(sample_count == _sg.desc.context.sample_count, _SG_VALIDATE_BEGINSWAPCHAINPASS_SAMPLE_COUNT);
+        #if defined(SOKOL_D3D11)
+        SOKOL_VALIDATE(0 != swapchain->d3d11.render_target_view, _SG_VALIDATE_BEGINSWAPCHAINPASS_D3D11_RTV);
+        #elif defined(SOKOL_WGPU)
+        SOKOL_VALIDATE((0 != swapchain->wgpu.render_view) && (0 != swapchain->wgpu.depth_stencil_view), _SG_VALIDATE_BEGINSWAPCHAINPASS_WGPU_VIEWS);
+        #endif
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_query_object_desc(const sg_query_object_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_QUERYDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_QUERYDESC_CANARY);
+        SOKOL_VALIDATE(_sg.features.occlusion_query, _SG_VALIDATE_QUERYDESC_SUPPORTED);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_query(const _sg_query_t* qry) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(qry);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(qry && (qry->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_BEGINQUERY_QUERY);
+        SOKOL_VALIDATE(_sg.cur_query.id == SG_INVALID_ID, _SG_VALIDATE_BEGINQUERY_NESTED);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end_query(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.cur_query.id != SG_INVALID_ID, _SG_VALIDATE_ENDQUERY_NO_QUERY);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_conditional_render(sg_query qry_id, const _sg_query_t* qry) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(qry_id);
+        _SOKOL_UNUSED(qry);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(qry && (qry->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_BEGINCONDRENDER_QUERY);
+        SOKOL_VALIDATE(_sg.cur_query.id != qry_id.id, _SG_VALIDATE_BEGINCONDRENDER_QUERY_ACTIVE);
+        SOKOL_VALIDATE(!_sg.in_conditional_render, _SG_VALIDATE_BEGINCONDRENDER_NESTED);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end_conditional_render(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.in_conditional_render, _SG_VALIDATE_ENDCONDRENDER_NOT_ACTIVE);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end_pass(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.cur_query.id == SG_INVALID_ID, _SG_VALIDATE_ENDPASS_QUERY);
+        SOKOL_VALIDATE(!_sg.in_conditional_render, _SG_VALIDATE_ENDPASS_CONDITIONAL_RENDER);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(pip_id);
         return true;
     #else
         SOKOL_VALIDATE_BEGIN();
+        /* a pipeline/pass combination which passed validation in the current
+           cache epoch can't have changed, since any resource destruction starts
+           a new epoch, this also skips the pipeline and shader lookups
+        */
+        _sg_validate_cache_item_t* cache_item = _sg_validate_cache_item(pip_id.id);
+        if (cache_item &&
+            (cache_item->pip_id == pip_id.id) &&
+            (cache_item->pass_epoch == _sg.validate_cache.epoch) &&
+            (cache_item->pass_id == _sg.cur_pass.id))
+        {
+            return SOKOL_VALIDATE_END();
+        }
         /* the pipeline object must be alive and valid */
         SOKOL_VALIDATE(pip_id.id != SG_INVALID_ID, _SG_VALIDATE_APIP_PIPELINE_VALID_ID);
         const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
@@ -14468,7 +16288,17 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
             SOKOL_VALIDATE(pip->cmn.depth_format == _sg.desc.context.depth_format, _SG_VALIDATE_APIP_DEPTH_FORMAT);
             SOKOL_VALIDATE(pip->cmn.sample_count == _sg.desc.context.sample_count, _SG_VALIDATE_APIP_SAMPLE_COUNT);
         }
-        return SOKOL_VALIDATE_END();
+        const bool res = SOKOL_VALIDATE_END();
+        if (res && cache_item && (pass || (_sg.cur_pass.id == SG_INVALID_ID))) {
+            if (cache_item->pip_id != pip_id.id) {
+                /* a different pipeline in the same pool slot */
+                memset(cache_item, 0, sizeof(_sg_validate_cache_item_t));
+                cache_item->pip_id = pip_id.id;
+            }
+            cache_item->pass_epoch = _sg.validate_cache.epoch;
+            cache_item->pass_id = _sg.cur_pass.id;
+        }
+        return res;
     #endif
 }
 
@@ -14479,6 +16309,17 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
     #else
         SOKOL_VALIDATE_BEGIN();
 
+        /* bindings which recently passed validation with the same pipeline in the
+           current cache epoch can't have changed (see _sg_validate_apply_pipeline())
+        */
+        _sg_validate_cache_item_t* cache_item = _sg_validate_cache_item(_sg.cur_pipeline.id);
+        if (cache_item &&
+            (cache_item->pip_id == _sg.cur_pipeline.id) &&
+            _sg_validate_cache_find_bindings(cache_item, bindings))
+        {
+            return SOKOL_VALIDATE_END();
+        }
+
         /* a pipeline object must have been applied */
         SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
         const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
@@ -14488,6 +16329,8 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
         }
         SOKOL_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_ABND_PIPELINE_VALID);
         SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
+        /* only combinations of fully valid resources may be cached */
+        bool all_valid = pip->slot.state == SG_RESOURCESTATE_VALID;
 
         /* has expected vertex buffers, and vertex buffers still exist */
         for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
@@ -14499,6 +16342,12 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_VB_TYPE);
                     SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_VB_OVERFLOW);
+                    if (buf->cmn.parent_id.id != SG_INVALID_ID) {
+                        SOKOL_VALIDATE(0 != _sg_lookup_buffer(&_sg.pools, buf->cmn.parent_id.id), _SG_VALIDATE_ABND_VB_ARENA);
+                    }
+                }
+                else {
+                    all_valid = false;
                 }
             }
             else {
@@ -14523,6 +16372,12 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
             if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
                 SOKOL_VALIDATE(SG_BUFFERTYPE_INDEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_IB_TYPE);
                 SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_IB_OVERFLOW);
+                if (buf->cmn.parent_id.id != SG_INVALID_ID) {
+                    SOKOL_VALIDATE(0 != _sg_lookup_buffer(&_sg.pools, buf->cmn.parent_id.id), _SG_VALIDATE_ABND_IB_ARENA);
+                }
+            }
+            else {
+                all_valid = false;
             }
         }
 
@@ -14536,6 +16391,9 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(img->cmn.type == stage->images[i].image_type, _SG_VALIDATE_ABND_VS_IMG_TYPES);
                 }
+                else {
+                    all_valid = false;
+                }
             }
             else {
                 SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
@@ -14552,12 +16410,23 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(img->cmn.type == stage->images[i].image_type, _SG_VALIDATE_ABND_FS_IMG_TYPES);
                 }
+                else {
+                    all_valid = false;
+                }
             }
             else {
                 SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
             }
         }
-        return SOKOL_VALIDATE_END();
+        const bool res = SOKOL_VALIDATE_END();
+        if (res && all_valid && cache_item) {
+            if (cache_item->pip_id != _sg.cur_pipeline.id) {
+                memset(cache_item, 0, sizeof(_sg_validate_cache_item_t));
+                cache_item->pip_id = _sg.cur_pipeline.id;
+            }
+            _sg_validate_cache_add_bindings(cache_item, bindings);
+        }
+        return res;
     #endif
 }
 
@@ -14599,6 +16468,7 @@ _SOKOL_PRIVATE bool _sg_validate_update_buffer(const _sg_buffer_t* buf, const sg
         SOKOL_VALIDATE(buf->cmn.size >= (int)data->size, _SG_VALIDATE_UPDATEBUF_SIZE);
         SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_ONCE);
         SOKOL_VALIDATE(buf->cmn.append_frame_index != _sg.frame_index, _SG_VALIDATE_UPDATEBUF_APPEND);
+        SOKOL_VALIDATE(!buf->cmn.ring, _SG_VALIDATE_UPDATEBUF_RING);
         return SOKOL_VALIDATE_END();
     #endif
 }
@@ -14612,7 +16482,7 @@ _SOKOL_PRIVATE bool _sg_validate_append_buffer(const _sg_buffer_t* buf, const sg
         SOKOL_ASSERT(buf && data && data->ptr);
         SOKOL_VALIDATE_BEGIN();
         SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_APPENDBUF_USAGE);
-        SOKOL_VALIDATE(buf->cmn.size >= (buf->cmn.append_pos + (int)data->size), _SG_VALIDATE_APPENDBUF_SIZE);
+        SOKOL_VALIDATE(buf->cmn.size >= ((buf->cmn.ring ? 0 : buf->cmn.append_pos) + (int)data->size), _SG_VALIDATE_APPENDBUF_SIZE);
         SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_APPENDBUF_UPDATE);
         return SOKOL_VALIDATE_END();
     #endif
@@ -14633,18 +16503,56 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
             img->cmn.width,
             img->cmn.height,
             (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1,
+            0,
             img->cmn.num_mipmaps,
             img->cmn.num_slices);
         return SOKOL_VALIDATE_END();
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_update_image_mip(const _sg_image_t* img, int mip_index, const sg_image_data* data) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(mip_index);
+        _SOKOL_UNUSED(data);
+        return true;
+    #else
+        SOKOL_ASSERT(img && data);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(img->cmn.streaming, _SG_VALIDATE_UPDIMGMIP_STREAMING);
+        const bool in_range = (mip_index >= 0) && (mip_index < img->cmn.num_mipmaps);
+        SOKOL_VALIDATE(in_range, _SG_VALIDATE_UPDIMGMIP_RANGE);
+        SOKOL_VALIDATE(mip_index == (img->cmn.resident_mip - 1), _SG_VALIDATE_UPDIMGMIP_ORDER);
+        if (in_range) {
+            _sg_validate_image_data(data,
+                img->cmn.pixel_format,
+                img->cmn.width,
+                img->cmn.height,
+                (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1,
+                mip_index,
+                mip_index + 1,
+                img->cmn.num_slices);
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 /*== fill in desc default values =============================================*/
 _SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
     sg_buffer_desc def = *desc;
+    if (def.parent.id != SG_INVALID_ID) {
+        /* buffers in an arena inherit the arena's buffer type */
+        const _sg_buffer_t* parent = _sg_lookup_buffer(&_sg.pools, def.parent.id);
+        if (parent) {
+            def.type = _sg_def(def.type, parent->cmn.type);
+        }
+    }
     def.type = _sg_def(def.type, SG_BUFFERTYPE_VERTEXBUFFER);
     def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
-    if (def.size == 0) {
+    if (def.arena) {
+        def.size = _sg_arena_roundup_size(def.size);
+    }
+    else if (def.size == 0) {
         def.size = def.data.size;
     }
     else if (def.data.size == 0) {
@@ -14808,6 +16716,12 @@ _SOKOL_PRIVATE sg_pass_desc _sg_pass_desc_defaults(const sg_pass_desc* desc) {
     return def;
 }
 
+_SOKOL_PRIVATE sg_query_object_desc _sg_query_object_desc_defaults(const sg_query_object_desc* desc) {
+    sg_query_object_desc def = *desc;
+    def.type = _sg_def(def.type, SG_QUERYTYPE_OCCLUSION);
+    return def;
+}
+
 /*== allocate/initialize resource private functions ==========================*/
 _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
     sg_buffer res;
@@ -14874,6 +16788,19 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     return res;
 }
 
+_SOKOL_PRIVATE sg_query _sg_alloc_query(void) {
+    sg_query res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.query_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.query_pool, &_sg.pools.queries[slot_index].slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
 _SOKOL_PRIVATE void _sg_dealloc_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(buf_id.id != SG_INVALID_ID);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
@@ -14914,18 +16841,79 @@ _SOKOL_PRIVATE void _sg_dealloc_pass(sg_pass pass_id) {
     _sg_pool_free_index(&_sg.pools.pass_pool, _sg_slot_index(pass_id.id));
 }
 
+_SOKOL_PRIVATE void _sg_dealloc_query(sg_query qry_id) {
+    SOKOL_ASSERT(qry_id.id != SG_INVALID_ID);
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    SOKOL_ASSERT(qry && qry->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&qry->slot);
+    _sg_pool_free_index(&_sg.pools.query_pool, _sg_slot_index(qry_id.id));
+}
+
+/* sub-allocate a buffer from its arena, this doesn't create a 3D-API object */
+_SOKOL_PRIVATE sg_resource_state _sg_create_arena_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(buf && desc);
+    _sg_buffer_t* parent = _sg_lookup_buffer(&_sg.pools, desc->parent.id);
+    if (!(parent && (parent->slot.state == SG_RESOURCESTATE_VALID) && _sg_buffer_allocator(&_sg.pools, parent)->arena.nodes && (parent->cmn.type == desc->type))) {
+        SOKOL_LOG("sg_make_buffer: sg_buffer_desc.parent is not a valid arena buffer\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    _sg_buffer_common_init(&buf->cmn, desc);
+    const int offset = _sg_arena_alloc(&_sg_buffer_allocator(&_sg.pools, parent)->arena, buf->cmn.size);
+    if (offset < 0) {
+        SOKOL_LOG("sg_make_buffer: buffer arena exhausted\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    buf->cmn.parent_id = desc->parent;
+    buf->cmn.arena_offset = offset;
+    _sg_update_buffer_range(parent, offset, &desc->data);
+    return SG_RESOURCESTATE_VALID;
+}
+
+/* return a sub-allocated buffer's range to its arena (if the arena still exists) */
+_SOKOL_PRIVATE void _sg_destroy_arena_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf && (buf->cmn.parent_id.id != SG_INVALID_ID));
+    _sg_buffer_t* parent = _sg_lookup_buffer(&_sg.pools, buf->cmn.parent_id.id);
+    if (parent && _sg_buffer_allocator(&_sg.pools, parent)->arena.nodes) {
+        _sg_arena_free(&_sg_buffer_allocator(&_sg.pools, parent)->arena, buf->cmn.arena_offset);
+    }
+}
+
+/* resolve a sub-allocated buffer to its arena buffer, adds the arena offset, may return 0 */
+_SOKOL_PRIVATE _sg_buffer_t* _sg_resolve_arena_buffer(_sg_buffer_t* buf, int* inout_offset) {
+    SOKOL_ASSERT(buf && (buf->cmn.parent_id.id != SG_INVALID_ID) && inout_offset);
+    _sg_buffer_t* parent = _sg_lookup_buffer(&_sg.pools, buf->cmn.parent_id.id);
+    if (parent && (parent->slot.state == SG_RESOURCESTATE_VALID)) {
+        *inout_offset += buf->cmn.arena_offset;
+        return parent;
+    }
+    return 0;
+}
+
 _SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf_id.id != SG_INVALID_ID && desc);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
     buf->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_buffer_desc(desc)) {
-        buf->slot.state = _sg_create_buffer(buf, desc);
+    if ((desc->arena || (desc->parent.id != SG_INVALID_ID)) && !_sg.features.buffer_arenas) {
+        SOKOL_LOG("sg_make_buffer: buffer arenas not supported by backend\n");
+        buf->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    else if (_sg_validate_buffer_desc(desc)) {
+        if (desc->parent.id != SG_INVALID_ID) {
+            buf->slot.state = _sg_create_arena_buffer(buf, desc);
+        }
+        else {
+            buf->slot.state = _sg_create_buffer(buf, desc);
+            if (desc->arena && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+                _sg_arena_init(&_sg_buffer_allocator(&_sg.pools, buf)->arena, buf->cmn.size);
+            }
+        }
     }
     else {
         buf->slot.state = SG_RESOURCESTATE_FAILED;
     }
     SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID)||(buf->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_update_buffer_bind_id(&_sg.pools, buf);
 }
 
 _SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
@@ -14933,13 +16921,18 @@ _SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
     _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
     SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
     img->slot.ctx_id = _sg.active_context.id;
-    if (_sg_validate_image_desc(desc)) {
+    if (desc->streaming && !_sg.features.mip_streaming) {
+        SOKOL_LOG("streaming images are not supported by this backend (see sg_features.mip_streaming)\n");
+        img->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    else if (_sg_validate_image_desc(desc)) {
         img->slot.state = _sg_create_image(img, desc);
     }
     else {
         img->slot.state = SG_RESOURCESTATE_FAILED;
     }
     SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID)||(img->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_update_image_bind_id(&_sg.pools, img);
 }
 
 _SOKOL_PRIVATE void _sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
@@ -15011,12 +17004,39 @@ _SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
     SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
 }
 
+_SOKOL_PRIVATE void _sg_init_query(sg_query qry_id, const sg_query_object_desc* desc) {
+    SOKOL_ASSERT(qry_id.id != SG_INVALID_ID && desc);
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    SOKOL_ASSERT(qry && qry->slot.state == SG_RESOURCESTATE_ALLOC);
+    qry->slot.ctx_id = _sg.active_context.id;
+    if (!_sg.features.occlusion_query) {
+        SOKOL_LOG("sg_make_query: occlusion queries not supported by backend\n");
+        qry->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    else if (_sg_validate_query_object_desc(desc)) {
+        qry->slot.state = _sg_create_query(qry, desc);
+    }
+    else {
+        qry->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((qry->slot.state == SG_RESOURCESTATE_VALID)||(qry->slot.state == SG_RESOURCESTATE_FAILED));
+}
+
 _SOKOL_PRIVATE bool _sg_uninit_buffer(sg_buffer buf_id) {
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     if (buf) {
         if (buf->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_buffer(buf);
+            if (buf->cmn.parent_id.id != SG_INVALID_ID) {
+                _sg_destroy_arena_buffer(buf);
+            }
+            else {
+                _sg_destroy_buffer(buf);
+                _sg_arena_discard(&_sg_buffer_allocator(&_sg.pools, buf)->arena);
+            }
             _sg_reset_buffer(buf);
+            #if defined(SOKOL_DEBUG)
+            _sg_validate_cache_invalidate();
+            #endif
             return true;
         }
         else {
@@ -15033,6 +17053,9 @@ _SOKOL_PRIVATE bool _sg_uninit_image(sg_image img_id) {
         if (img->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_image(img);
             _sg_reset_image(img);
+            #if defined(SOKOL_DEBUG)
+            _sg_validate_cache_invalidate();
+            #endif
             return true;
         }
         else {
@@ -15049,6 +17072,9 @@ _SOKOL_PRIVATE bool _sg_uninit_shader(sg_shader shd_id) {
         if (shd->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_shader(shd);
             _sg_reset_shader(shd);
+            #if defined(SOKOL_DEBUG)
+            _sg_validate_cache_invalidate();
+            #endif
             return true;
         }
         else {
@@ -15065,6 +17091,9 @@ _SOKOL_PRIVATE bool _sg_uninit_pipeline(sg_pipeline pip_id) {
         if (pip->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_pipeline(pip);
             _sg_reset_pipeline(pip);
+            #if defined(SOKOL_DEBUG)
+            _sg_validate_cache_invalidate();
+            #endif
             return true;
         }
         else {
@@ -15081,6 +17110,9 @@ _SOKOL_PRIVATE bool _sg_uninit_pass(sg_pass pass_id) {
         if (pass->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_pass(pass);
             _sg_reset_pass(pass);
+            #if defined(SOKOL_DEBUG)
+            _sg_validate_cache_invalidate();
+            #endif
             return true;
         }
         else {
@@ -15091,6 +17123,44 @@ _SOKOL_PRIVATE bool _sg_uninit_pass(sg_pass pass_id) {
     return false;
 }
 
+_SOKOL_PRIVATE bool _sg_uninit_query(sg_query qry_id) {
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    if (qry) {
+        if (qry->slot.ctx_id == _sg.active_context.id) {
+            _sg_destroy_query(qry);
+            _sg_reset_query(qry);
+            return true;
+        }
+        else {
+            SOKOL_LOG("_sg_uninit_query: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
+        }
+    }
+    return false;
+}
+
+/* fetch all query results which are available without waiting for the GPU */
+_SOKOL_PRIVATE void _sg_poll_query(_sg_query_t* qry) {
+    SOKOL_ASSERT(qry && (qry->slot.state == SG_RESOURCESTATE_VALID));
+    int num_pollable = qry->cmn.num_pending;
+    if ((_sg.cur_query.id == qry->slot.id) && _sg.cur_query_issued) {
+        /* the currently active query can't be polled */
+        num_pollable--;
+    }
+    for (; num_pollable > 0; num_pollable--) {
+        const int slot = qry->cmn.tail;
+        bool visible = true;
+        if (!_sg_query_result(qry, slot, &visible)) {
+            break;
+        }
+        qry->cmn.result.available = true;
+        qry->cmn.result.visible = visible;
+        qry->cmn.result.frame_index = qry->cmn.frame_index[slot];
+        qry->cmn.tail = (slot + 1) % _SG_QUERY_RING_SIZE;
+        qry->cmn.num_pending--;
+    }
+}
+
 /*== PUBLIC API FUNCTIONS ====================================================*/
 
 #if defined(SOKOL_METAL)
@@ -15128,12 +17198,16 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg.desc.shader_pool_size = _sg_def(_sg.desc.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
     _sg.desc.pipeline_pool_size = _sg_def(_sg.desc.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
     _sg.desc.pass_pool_size = _sg_def(_sg.desc.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
+    _sg.desc.query_pool_size = _sg_def(_sg.desc.query_pool_size, _SG_DEFAULT_QUERY_POOL_SIZE);
     _sg.desc.context_pool_size = _sg_def(_sg.desc.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
     _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
     _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
     _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
 
     _sg_setup_pools(&_sg.pools, &_sg.desc);
+    #if defined(SOKOL_DEBUG)
+    _sg_validate_cache_setup();
+    #endif
     _sg.frame_index = 1;
     _sg_setup_backend(&_sg.desc);
     _sg.valid = true;
@@ -15153,6 +17227,9 @@ SOKOL_API_IMPL void sg_shutdown(void) {
         }
     }
     _sg_discard_backend();
+    #if defined(SOKOL_DEBUG)
+    _sg_validate_cache_discard();
+    #endif
     _sg_discard_pools(&_sg.pools);
     _sg.valid = false;
 }
@@ -15181,6 +17258,11 @@ SOKOL_API_IMPL sg_limits sg_query_limits(void) {
     return _sg.limits;
 }
 
+SOKOL_API_IMPL sg_stats sg_query_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.stats;
+}
+
 SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
     SOKOL_ASSERT(_sg.valid);
     int fmt_index = (int) fmt;
@@ -15210,6 +17292,9 @@ SOKOL_API_IMPL sg_context sg_setup_context(void) {
 SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_destroy_all_resources(&_sg.pools, ctx_id.id);
+    #if defined(SOKOL_DEBUG)
+    _sg_validate_cache_invalidate();
+    #endif
     _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
     if (ctx) {
         _sg_destroy_context(ctx);
@@ -15465,6 +17550,25 @@ SOKOL_API_IMPL sg_resource_state sg_query_pass_state(sg_pass pass_id) {
     return res;
 }
 
+SOKOL_API_IMPL sg_resource_state sg_query_state(sg_query qry_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    sg_resource_state res = qry ? qry->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_query_result sg_poll_query(sg_query qry_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_query_result res;
+    memset(&res, 0, sizeof(res));
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    if (qry && (qry->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_poll_query(qry);
+        res = qry->cmn.result;
+    }
+    return res;
+}
+
 /*-- allocate and initialize resource ----------------------------------------*/
 SOKOL_API_IMPL sg_buffer sg_make_buffer(const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
@@ -15546,6 +17650,22 @@ SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
     return pass_id;
 }
 
+SOKOL_API_IMPL sg_query sg_make_query(const sg_query_object_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_query_object_desc desc_def = _sg_query_object_desc_defaults(desc);
+    sg_query qry_id = _sg_alloc_query();
+    if (qry_id.id != SG_INVALID_ID) {
+        _sg_init_query(qry_id, &desc_def);
+    }
+    else {
+        SOKOL_LOG("query pool exhausted!");
+        _SG_TRACE_NOARGS(err_query_pool_exhausted);
+    }
+    _SG_TRACE_ARGS(make_query, &desc_def, qry_id);
+    return qry_id;
+}
+
 /*-- destroy resource --------------------------------------------------------*/
 SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
@@ -15587,6 +17707,47 @@ SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
     }
 }
 
+/* end the active query and conditional rendering, also called when a pass
+   ends or a query is destroyed while still active, so that the backend
+   never has an open query on a destroyed object or outside a pass
+*/
+_SOKOL_PRIVATE void _sg_end_active_query(void) {
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, _sg.cur_query.id);
+    if (qry && _sg.cur_query_issued) {
+        _sg_end_query(qry);
+        qry->cmn.last_slot = (qry->cmn.head + _SG_QUERY_RING_SIZE - 1) % _SG_QUERY_RING_SIZE;
+    }
+    _sg.cur_query.id = SG_INVALID_ID;
+    _sg.cur_query_issued = false;
+}
+
+_SOKOL_PRIVATE void _sg_end_active_conditional_render(void) {
+    if (_sg.in_conditional_render) {
+        _sg_end_conditional_render();
+        _sg.in_conditional_render = false;
+    }
+    _sg.cur_conditional_query.id = SG_INVALID_ID;
+}
+
+SOKOL_API_IMPL void sg_destroy_query(sg_query qry_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_query, qry_id);
+    /* don't match SG_INVALID_ID against 'no active query' */
+    if (qry_id.id != SG_INVALID_ID) {
+        if (_sg.cur_query.id == qry_id.id) {
+            SOKOL_LOG("sg_destroy_query: destroying active query (missing sg_end_query())");
+            _sg_end_active_query();
+        }
+        if (_sg.cur_conditional_query.id == qry_id.id) {
+            SOKOL_LOG("sg_destroy_query: destroying query used for conditional rendering (missing sg_end_conditional_render())");
+            _sg_end_active_conditional_render();
+        }
+    }
+    if (_sg_uninit_query(qry_id)) {
+        _sg_dealloc_query(qry_id);
+    }
+}
+
 SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(pass_action);
@@ -15595,7 +17756,7 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
-    _sg_begin_pass(0, &pa, width, height);
+    _sg_begin_pass(0, 0, &pa, width, height);
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
 
@@ -15603,6 +17764,24 @@ SOKOL_API_IMPL void sg_begin_default_passf(const sg_pass_action* pass_action, fl
     sg_begin_default_pass(pass_action, (int)width, (int)height);
 }
 
+SOKOL_API_IMPL void sg_begin_swapchain_pass(const sg_swapchain* swapchain, const sg_pass_action* pass_action) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(swapchain && pass_action);
+    SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
+    _sg.cur_pass.id = SG_INVALID_ID;
+    if (_sg_validate_begin_swapchain_pass(swapchain)) {
+        _sg.pass_valid = true;
+        sg_pass_action pa;
+        _sg_resolve_default_pass_action(pass_action, &pa);
+        _sg_begin_pass(0, swapchain, &pa, swapchain->width, swapchain->height);
+        _SG_TRACE_ARGS(begin_swapchain_pass, swapchain, pass_action);
+    }
+    else {
+        _sg.pass_valid = false;
+        _SG_TRACE_NOARGS(err_pass_invalid);
+    }
+}
+
 SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_action) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(pass_action);
@@ -15617,7 +17796,7 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
-        _sg_begin_pass(pass, &pa, w, h);
+        _sg_begin_pass(pass, 0, &pa, w, h);
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
     else {
@@ -15689,14 +17868,28 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
     SOKOL_ASSERT(pip);
 
+    /* buffers sub-allocated from an arena are bound as arena buffer plus offset */
     _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
     int num_vbs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++, num_vbs++) {
-        if (bindings->vertex_buffers[i].id) {
-            vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
-            SOKOL_ASSERT(vbs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vbs[i]->slot.state);
-            _sg.next_draw_valid &= !vbs[i]->cmn.append_overflow;
+        const uint32_t buf_id = bindings->vertex_buffers[i].id;
+        if (buf_id) {
+            vb_offsets[i] = bindings->vertex_buffer_offsets[i];
+            if (_sg_buffer_bindable(&_sg.pools, buf_id)) {
+                /* the common case, doesn't touch the buffer object */
+                vbs[i] = _sg_buffer_at(&_sg.pools, buf_id);
+            }
+            else {
+                vbs[i] = _sg_lookup_buffer(&_sg.pools, buf_id);
+                SOKOL_ASSERT(vbs[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vbs[i]->slot.state);
+                _sg.next_draw_valid &= !vbs[i]->cmn.append_overflow;
+                if (vbs[i]->cmn.parent_id.id != SG_INVALID_ID) {
+                    vbs[i] = _sg_resolve_arena_buffer(vbs[i], &vb_offsets[i]);
+                    _sg.next_draw_valid &= (0 != vbs[i]);
+                }
+            }
         }
         else {
             break;
@@ -15704,20 +17897,36 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     }
 
     _sg_buffer_t* ib = 0;
+    int ib_offset = bindings->index_buffer_offset;
     if (bindings->index_buffer.id) {
-        ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
-        SOKOL_ASSERT(ib);
-        _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == ib->slot.state);
-        _sg.next_draw_valid &= !ib->cmn.append_overflow;
+        if (_sg_buffer_bindable(&_sg.pools, bindings->index_buffer.id)) {
+            ib = _sg_buffer_at(&_sg.pools, bindings->index_buffer.id);
+        }
+        else {
+            ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+            SOKOL_ASSERT(ib);
+            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == ib->slot.state);
+            _sg.next_draw_valid &= !ib->cmn.append_overflow;
+            if (ib->cmn.parent_id.id != SG_INVALID_ID) {
+                ib = _sg_resolve_arena_buffer(ib, &ib_offset);
+                _sg.next_draw_valid &= (0 != ib);
+            }
+        }
     }
 
     _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_vs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_vs_imgs++) {
-        if (bindings->vs_images[i].id) {
-            vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
-            SOKOL_ASSERT(vs_imgs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_imgs[i]->slot.state);
+        const uint32_t img_id = bindings->vs_images[i].id;
+        if (img_id) {
+            if (_sg_image_bindable(&_sg.pools, img_id)) {
+                vs_imgs[i] = _sg_image_at(&_sg.pools, img_id);
+            }
+            else {
+                vs_imgs[i] = _sg_lookup_image(&_sg.pools, img_id);
+                SOKOL_ASSERT(vs_imgs[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_imgs[i]->slot.state);
+            }
         }
         else {
             break;
@@ -15727,18 +17936,22 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_fs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_fs_imgs++) {
-        if (bindings->fs_images[i].id) {
-            fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
-            SOKOL_ASSERT(fs_imgs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_imgs[i]->slot.state);
+        const uint32_t img_id = bindings->fs_images[i].id;
+        if (img_id) {
+            if (_sg_image_bindable(&_sg.pools, img_id)) {
+                fs_imgs[i] = _sg_image_at(&_sg.pools, img_id);
+            }
+            else {
+                fs_imgs[i] = _sg_lookup_image(&_sg.pools, img_id);
+                SOKOL_ASSERT(fs_imgs[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_imgs[i]->slot.state);
+            }
         }
         else {
             break;
         }
     }
     if (_sg.next_draw_valid) {
-        const int* vb_offsets = bindings->vertex_buffer_offsets;
-        int ib_offset = bindings->index_buffer_offset;
         _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
         _SG_TRACE_ARGS(apply_bindings, bindings);
     }
@@ -15802,12 +18015,79 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
     _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
+SOKOL_API_IMPL void sg_begin_query(sg_query qry_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    if (!_sg_validate_begin_query(qry)) {
+        return;
+    }
+    if (!_sg.pass_valid) {
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!(qry && (qry->slot.state == SG_RESOURCESTATE_VALID))) {
+        return;
+    }
+    _sg.cur_query = qry_id;
+    _sg.cur_query_issued = false;
+    /* never wait for the GPU, if all ring slots are still pending, skip this query */
+    _sg_poll_query(qry);
+    if (qry->cmn.num_pending < _SG_QUERY_RING_SIZE) {
+        const int slot = qry->cmn.head;
+        qry->cmn.frame_index[slot] = _sg.frame_index;
+        qry->cmn.head = (slot + 1) % _SG_QUERY_RING_SIZE;
+        qry->cmn.num_pending++;
+        _sg.cur_query_issued = true;
+        _sg_begin_query(qry, slot);
+    }
+    _SG_TRACE_ARGS(begin_query, qry_id);
+}
+
+SOKOL_API_IMPL void sg_end_query(void) {
+    SOKOL_ASSERT(_sg.valid);
+    if (!_sg_validate_end_query()) {
+        return;
+    }
+    _sg_end_active_query();
+    _SG_TRACE_NOARGS(end_query);
+}
+
+SOKOL_API_IMPL void sg_begin_conditional_render(sg_query qry_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_query_t* qry = _sg_lookup_query(&_sg.pools, qry_id.id);
+    if (!_sg_validate_begin_conditional_render(qry_id, qry)) {
+        return;
+    }
+    if (!_sg.features.conditional_render || !_sg.pass_valid || _sg.in_conditional_render) {
+        return;
+    }
+    if (qry && (qry->slot.state == SG_RESOURCESTATE_VALID) && (qry->cmn.last_slot >= 0)) {
+        _sg_begin_conditional_render(qry, qry->cmn.last_slot);
+        _sg.in_conditional_render = true;
+        _sg.cur_conditional_query = qry_id;
+    }
+    _SG_TRACE_ARGS(begin_conditional_render, qry_id);
+}
+
+SOKOL_API_IMPL void sg_end_conditional_render(void) {
+    SOKOL_ASSERT(_sg.valid);
+    if (!_sg_validate_end_conditional_render()) {
+        return;
+    }
+    _sg_end_active_conditional_render();
+    _SG_TRACE_NOARGS(end_conditional_render);
+}
+
 SOKOL_API_IMPL void sg_end_pass(void) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    /* a query or conditional render must not stay open across passes */
+    _sg_validate_end_pass();
+    _sg_end_active_query();
+    _sg_end_active_conditional_render();
     _sg_end_pass();
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
@@ -15820,6 +18100,7 @@ SOKOL_API_IMPL void sg_commit(void) {
     _sg_commit();
     _SG_TRACE_NOARGS(commit);
     _sg.frame_index++;
+    _sg.completed_frame_index = _sg_completed_frame_index();
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
@@ -15852,23 +18133,58 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     int result;
     if (buf) {
-        /* rewind append cursor in a new frame */
+        /* rewind append cursor in a new frame (ring buffers keep their cursor) */
         if (buf->cmn.append_frame_index != _sg.frame_index) {
-            buf->cmn.append_pos = 0;
+            if (!buf->cmn.ring) {
+                buf->cmn.append_pos = 0;
+            }
             buf->cmn.append_overflow = false;
         }
-        if ((buf->cmn.append_pos + _sg_roundup((int)data->size, 4)) > buf->cmn.size) {
+        const int num_bytes = _sg_roundup((int)data->size, 4);
+        _sg_ring_t* ring = &_sg_buffer_allocator(&_sg.pools, buf)->ring;
+        if (buf->cmn.ring) {
+            /* first try with the known GPU progress, then poll the fences */
+            _sg_ring_retire(ring, &buf->cmn.append_pos, _sg.completed_frame_index);
+            int pos = _sg_ring_alloc(ring, buf->cmn.size, buf->cmn.append_pos, num_bytes);
+            if (pos < 0) {
+                _sg.completed_frame_index = _sg_completed_frame_index();
+                _sg_ring_retire(ring, &buf->cmn.append_pos, _sg.completed_frame_index);
+                pos = _sg_ring_alloc(ring, buf->cmn.size, buf->cmn.append_pos, num_bytes);
+            }
+            if (pos < 0) {
+                buf->cmn.append_overflow = true;
+            }
+            else {
+                buf->cmn.append_pos = pos;
+            }
+        }
+        else if ((buf->cmn.append_pos + num_bytes) > buf->cmn.size) {
             buf->cmn.append_overflow = true;
         }
+        _sg_update_buffer_bind_id(&_sg.pools, buf);
+        #if defined(SOKOL_DEBUG)
+        if (buf->cmn.append_overflow) {
+            /* sg_apply_bindings() must report the overflowing buffer */
+            _sg_validate_cache_invalidate();
+        }
+        #endif
         const int start_pos = buf->cmn.append_pos;
         if (buf->slot.state == SG_RESOURCESTATE_VALID) {
             if (_sg_validate_append_buffer(buf, data)) {
                 if (!buf->cmn.append_overflow && (data->size > 0)) {
                     /* update and append on same buffer in same frame not allowed */
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
-                    int copied_num_bytes = _sg_append_buffer(buf, data, buf->cmn.append_frame_index != _sg.frame_index);
+                    /* a ring buffer keeps its content across frames, and only starts
+                       over (which allows the backend to discard the old content) when
+                       the append cursor wraps around to the start of the buffer
+                    */
+                    const bool new_frame = buf->cmn.ring ? (0 == start_pos) : (buf->cmn.append_frame_index != _sg.frame_index);
+                    int copied_num_bytes = _sg_append_buffer(buf, data, new_frame);
                     buf->cmn.append_pos += copied_num_bytes;
                     buf->cmn.append_frame_index = _sg.frame_index;
+                    if (buf->cmn.ring) {
+                        _sg_ring_mark(ring, _sg.frame_index, buf->cmn.append_pos);
+                    }
                 }
             }
         }
@@ -15902,6 +18218,26 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL void sg_update_image_mip(sg_image img_id, int mip_index, const sg_image_data* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(data);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        /* the mip index is also checked without the validation layer,
+           since the backends would write outside the texture's mip chain
+        */
+        const bool mip_valid = img->cmn.streaming &&
+                               (mip_index >= 0) &&
+                               (mip_index < img->cmn.num_mipmaps) &&
+                               (mip_index == (img->cmn.resident_mip - 1));
+        if (_sg_validate_update_image_mip(img, mip_index, data) && mip_valid) {
+            _sg_update_image_mip(img, mip_index, data);
+            img->cmn.resident_mip = mip_index;
+        }
+    }
+    _SG_TRACE_ARGS(update_image_mip, img_id, mip_index, data);
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
@@ -15927,6 +18263,7 @@ SOKOL_API_IMPL sg_buffer_info sg_query_buffer_info(sg_buffer buf_id) {
         info.append_frame_index = buf->cmn.append_frame_index;
         info.append_pos = buf->cmn.append_pos;
         info.append_overflow = buf->cmn.append_overflow;
+        info.arena_offset = buf->cmn.arena_offset;
         #if defined(SOKOL_D3D11)
         info.num_slots = 1;
         info.active_slot = 0;
@@ -15957,6 +18294,8 @@ SOKOL_API_IMPL sg_image_info sg_query_image_info(sg_image img_id) {
         #endif
         info.width = img->cmn.width;
         info.height = img->cmn.height;
+        info.resident_mip = img->cmn.resident_mip;
+        info.pixel_format = img->cmn.pixel_format;
     }
     return info;
 }
@@ -49,6 +49,17 @@
             Returns an initialized sg_context_desc function initialized
             by calling sokol_app.h functions.
 
+        sg_swapchain sapp_sgswapchain(sapp_window win):
+
+            Returns an initialized sg_swapchain struct for rendering into
+            a sokol_app.h window with sg_begin_swapchain_pass(). For the main
+            window, the 3D-API objects are the same as in the default pass
+            (on Metal the drawable is left empty because the main window's
+            drawable is presented through sg_context_desc.metal.drawable_cb),
+            for additional windows (currently GL only) only the framebuffer
+            size is filled in, the window must be made active with
+            sapp_activate_window() before starting the pass.
+
     LICENSE
     =======
     zlib/libpng license
@@ -95,6 +106,7 @@ extern "C" {
 
 #if defined(SOKOL_GFX_INCLUDED) && defined(SOKOL_APP_INCLUDED)
 SOKOL_GLUE_API_DECL sg_context_desc sapp_sgcontext(void);
+SOKOL_GLUE_API_DECL sg_swapchain sapp_sgswapchain(sapp_window win);
 #endif
 
 #ifdef __cplusplus
@@ -132,6 +144,25 @@ SOKOL_API_IMPL sg_context_desc sapp_sgcontext(void) {
     desc.wgpu.depth_stencil_view_cb = sapp_wgpu_get_depth_stencil_view;
     return desc;
 }
+
+SOKOL_API_IMPL sg_swapchain sapp_sgswapchain(sapp_window win) {
+    sg_swapchain swapchain;
+    memset(&swapchain, 0, sizeof(swapchain));
+    swapchain.width = sapp_window_width(win);
+    swapchain.height = sapp_window_height(win);
+    swapchain.color_format = (sg_pixel_format) sapp_color_format();
+    swapchain.depth_format = (sg_pixel_format) sapp_depth_format();
+    swapchain.sample_count = sapp_sample_count();
+    if (win.id == sapp_main_window().id) {
+        swapchain.metal.render_pass_descriptor = sapp_metal_get_renderpass_descriptor();
+        swapchain.d3d11.render_target_view = sapp_d3d11_get_render_target_view();
+        swapchain.d3d11.depth_stencil_view = sapp_d3d11_get_depth_stencil_view();
+        swapchain.wgpu.render_view = sapp_wgpu_get_render_view();
+        swapchain.wgpu.resolve_view = sapp_wgpu_get_resolve_view();
+        swapchain.wgpu.depth_stencil_view = sapp_wgpu_get_depth_stencil_view();
+    }
+    return swapchain;
+}
 #endif
 
 #endif /* SOKOL_GLUE_IMPL */
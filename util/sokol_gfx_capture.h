@@ -0,0 +1,2043 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_GFX_CAPTURE_IMPL)
+#define SOKOL_GFX_CAPTURE_IMPL
+#endif
+#ifndef SOKOL_GFX_CAPTURE_INCLUDED
+/*
+    sokol_gfx_capture.h -- record sokol_gfx.h calls into a binary stream
+                           and replay them
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_GFX_CAPTURE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_gfx_capture.h:
+
+        sokol_gfx.h
+
+    The sokol_gfx.h implementation must be compiled with debug trace hooks
+    enabled by defining:
+
+        SOKOL_TRACE_HOOKS
+
+    ...before including the sokol_gfx.h implementation (this is only
+    needed for capturing, not for replaying).
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)             - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)             - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)               - your own free function (default: free(p))
+    SOKOL_LOG(msg)              - your own logging function (default: puts(msg))
+    SOKOL_GFX_CAPTURE_API_DECL  - public function declaration prefix (default: extern)
+    SOKOL_API_DECL              - same as SOKOL_GFX_CAPTURE_API_DECL
+    SOKOL_API_IMPL              - public function implementation prefix (default: -)
+
+    If sokol_gfx_capture.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_GFX_CAPTURE_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_gfx_capture.h hooks into sokol_gfx.h via sg_install_trace_hooks()
+    and serializes the sokol-gfx calls of an application, including
+    resource creation parameters, buffer and image data, and uniform data,
+    into a compact binary stream in memory. The application decides
+    what to do with the stream (usually write it to a file).
+
+    The stream can then be replayed by another program (or the same
+    program) with the sokol-gfx backend of its choice. For instance, a
+    frame captured in a production build can be replayed in a headless
+    CI job to measure the CPU cost of the sokol-gfx calls, or to compare
+    draw call counts across versions.
+
+    CAPTURING
+    =========
+    Call sg_capture_setup() right after sg_setup(), this installs the
+    trace hooks and starts recording resource creation and destruction:
+
+        sg_capture_setup(&(sg_capture_desc_t){
+            .buffer_size = ...,     // size of the capture buffer, default: 16 MB
+        });
+
+    Resource creation and destruction calls are always recorded, so that
+    all resources used in a captured frame can be recreated during replay.
+    All other calls (buffer and image updates, passes, draw calls, ...)
+    are only recorded when a capture is active. To capture the next N frames
+    (a frame ends with sg_commit()), call:
+
+        sg_capture_frames(N);
+
+    To check whether a capture is still in progress:
+
+        bool capturing = sg_capture_active();
+
+    Once the capture is finished, get a pointer to the captured data:
+
+        sg_range data = sg_capture_data();
+        fwrite(data.ptr, data.size, 1, fp);
+
+    The returned data remains valid until sg_capture_shutdown() is called,
+    and it grows while more resources are created.
+
+    If the capture buffer overflows, recording stops and the stream
+    is truncated to the last complete call, check for this with:
+
+        bool overflow = sg_capture_overflow();
+
+    To remove the trace hooks and free the capture buffer, call:
+
+        sg_capture_shutdown();
+
+    Please note:
+
+        - the content of dynamic and stream buffers and images is only
+          captured during an active capture. If the frames you capture
+          depend on updates which happened earlier, start capturing
+          from the first frame
+        - injected native resources (sg_buffer_desc.gl_buffers[] etc...)
+          are captured without their native handles, and will not be
+          valid during replay
+        - the stream is a memory dump of the sokol-gfx desc structs, it can
+          only be replayed by a program built with the same sokol_gfx.h
+          version and the same pointer size (this is checked at replay
+          start)
+
+    REPLAYING
+    =========
+    Replaying doesn't require sg_capture_setup() (and trace hooks
+    shouldn't capture into the same stream which is replayed). After
+    sg_setup(), start a replay with a pointer to the captured data, the
+    data must remain valid until sg_capture_replay_end() is called:
+
+        if (!sg_capture_replay_begin(&data)) {
+            // data isn't a valid capture stream
+        }
+
+    ...then replay one frame at a time (this issues the recorded
+    sokol-gfx calls up to and including the next sg_commit()):
+
+        while (sg_capture_replay_frame()) {
+            ...
+        }
+
+    To get the number of replayed frames, draw calls and other
+    recorded calls, call:
+
+        sg_capture_replay_info_t info = sg_capture_replay_info();
+
+    Finally, end the replay, this destroys all sokol-gfx resources which
+    were created during the replay and are still alive:
+
+        sg_capture_replay_end();
+
+    The shader code is replayed as it was recorded, so the replaying
+    program must use a backend which is compatible with the captured shader
+    code (for instance, a capture from a GL application can be replayed
+    with the GL backend on a software renderer, or on the dummy backend to
+    only measure the CPU overhead of sokol-gfx).
+
+    A minimal headless replay program:
+
+        int main() {
+            sg_setup(&(sg_desc){0});
+            sg_range data = load_file("capture.bin");
+            if (sg_capture_replay_begin(&data)) {
+                while (sg_capture_replay_frame()) { }
+                sg_capture_replay_info_t info = sg_capture_replay_info();
+                printf("frames: %d, draws: %d\n", info.num_frames, info.num_draws);
+                sg_capture_replay_end();
+            }
+            sg_shutdown();
+        }
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_GFX_CAPTURE_INCLUDED (1)
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_gfx_capture.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_GFX_CAPTURE_API_DECL)
+#define SOKOL_GFX_CAPTURE_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_GFX_CAPTURE_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_GFX_CAPTURE_IMPL)
+#define SOKOL_GFX_CAPTURE_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_GFX_CAPTURE_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_GFX_CAPTURE_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sg_capture_desc_t {
+    int buffer_size;        // size of the capture buffer in bytes, default: 16 MB
+} sg_capture_desc_t;
+
+typedef struct sg_capture_replay_info_t {
+    int num_frames;         // number of replayed sg_commit() calls
+    int num_draws;          // number of replayed sg_draw() calls
+    int num_calls;          // overall number of replayed sokol-gfx calls
+} sg_capture_replay_info_t;
+
+/* capturing */
+SOKOL_GFX_CAPTURE_API_DECL void sg_capture_setup(const sg_capture_desc_t* desc);
+SOKOL_GFX_CAPTURE_API_DECL void sg_capture_shutdown(void);
+SOKOL_GFX_CAPTURE_API_DECL void sg_capture_frames(int num_frames);
+SOKOL_GFX_CAPTURE_API_DECL bool sg_capture_active(void);
+SOKOL_GFX_CAPTURE_API_DECL bool sg_capture_overflow(void);
+SOKOL_GFX_CAPTURE_API_DECL sg_range sg_capture_data(void);
+
+/* replaying */
+SOKOL_GFX_CAPTURE_API_DECL bool sg_capture_replay_begin(const sg_range* data);
+SOKOL_GFX_CAPTURE_API_DECL bool sg_capture_replay_frame(void);
+SOKOL_GFX_CAPTURE_API_DECL sg_capture_replay_info_t sg_capture_replay_info(void);
+SOKOL_GFX_CAPTURE_API_DECL void sg_capture_replay_end(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_GFX_CAPTURE_INCLUDED */
+
+/*=== IMPLEMENTATION =========================================================*/
+#ifdef SOKOL_GFX_CAPTURE_IMPL
+#define SOKOL_GFX_CAPTURE_IMPL_INCLUDED (1)
+
+#include <string.h> /* memset, memcpy, strlen */
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #include <stdio.h>
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _sg_capture_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SG_CAPTURE_INIT_COOKIE (0xCA9CA9CA)
+#define _SG_CAPTURE_DEFAULT_BUFFER_SIZE (16 * 1024 * 1024)
+#define _SG_CAPTURE_MAGIC (0x50434753)  /* 'SGCP' */
+#define _SG_CAPTURE_VERSION (2)
+#define _SG_CAPTURE_BLOB_ALIGN (8)
+#define _SG_CAPTURE_SLOT_MASK (0xFFFF)
+#define _SG_CAPTURE_MAX_POOL_SIZE (_SG_CAPTURE_SLOT_MASK + 1)
+
+typedef enum {
+    _SG_CAPTURE_CMD_INVALID,
+    _SG_CAPTURE_CMD_MAKE_BUFFER,
+    _SG_CAPTURE_CMD_MAKE_IMAGE,
+    _SG_CAPTURE_CMD_MAKE_SHADER,
+    _SG_CAPTURE_CMD_MAKE_PIPELINE,
+    _SG_CAPTURE_CMD_MAKE_PASS,
+    _SG_CAPTURE_CMD_MAKE_QUERY,
+    _SG_CAPTURE_CMD_DESTROY_BUFFER,
+    _SG_CAPTURE_CMD_DESTROY_IMAGE,
+    _SG_CAPTURE_CMD_DESTROY_SHADER,
+    _SG_CAPTURE_CMD_DESTROY_PIPELINE,
+    _SG_CAPTURE_CMD_DESTROY_PASS,
+    _SG_CAPTURE_CMD_DESTROY_QUERY,
+    _SG_CAPTURE_CMD_ALLOC_BUFFER,
+    _SG_CAPTURE_CMD_ALLOC_IMAGE,
+    _SG_CAPTURE_CMD_ALLOC_SHADER,
+    _SG_CAPTURE_CMD_ALLOC_PIPELINE,
+    _SG_CAPTURE_CMD_ALLOC_PASS,
+    _SG_CAPTURE_CMD_DEALLOC_BUFFER,
+    _SG_CAPTURE_CMD_DEALLOC_IMAGE,
+    _SG_CAPTURE_CMD_DEALLOC_SHADER,
+    _SG_CAPTURE_CMD_DEALLOC_PIPELINE,
+    _SG_CAPTURE_CMD_DEALLOC_PASS,
+    _SG_CAPTURE_CMD_INIT_BUFFER,
+    _SG_CAPTURE_CMD_INIT_IMAGE,
+    _SG_CAPTURE_CMD_INIT_SHADER,
+    _SG_CAPTURE_CMD_INIT_PIPELINE,
+    _SG_CAPTURE_CMD_INIT_PASS,
+    _SG_CAPTURE_CMD_UNINIT_BUFFER,
+    _SG_CAPTURE_CMD_UNINIT_IMAGE,
+    _SG_CAPTURE_CMD_UNINIT_SHADER,
+    _SG_CAPTURE_CMD_UNINIT_PIPELINE,
+    _SG_CAPTURE_CMD_UNINIT_PASS,
+    _SG_CAPTURE_CMD_FAIL_BUFFER,
+    _SG_CAPTURE_CMD_FAIL_IMAGE,
+    _SG_CAPTURE_CMD_FAIL_SHADER,
+    _SG_CAPTURE_CMD_FAIL_PIPELINE,
+    _SG_CAPTURE_CMD_FAIL_PASS,
+    _SG_CAPTURE_CMD_RESET_STATE_CACHE,
+    _SG_CAPTURE_CMD_UPDATE_BUFFER,
+    _SG_CAPTURE_CMD_UPDATE_IMAGE,
+    _SG_CAPTURE_CMD_UPDATE_IMAGE_MIP,
+    _SG_CAPTURE_CMD_APPEND_BUFFER,
+    _SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS,
+    _SG_CAPTURE_CMD_BEGIN_PASS,
+    _SG_CAPTURE_CMD_APPLY_VIEWPORT,
+    _SG_CAPTURE_CMD_APPLY_SCISSOR_RECT,
+    _SG_CAPTURE_CMD_APPLY_PIPELINE,
+    _SG_CAPTURE_CMD_APPLY_BINDINGS,
+    _SG_CAPTURE_CMD_APPLY_UNIFORMS,
+    _SG_CAPTURE_CMD_DRAW,
+    _SG_CAPTURE_CMD_BEGIN_QUERY,
+    _SG_CAPTURE_CMD_END_QUERY,
+    _SG_CAPTURE_CMD_BEGIN_CONDITIONAL_RENDER,
+    _SG_CAPTURE_CMD_END_CONDITIONAL_RENDER,
+    _SG_CAPTURE_CMD_END_PASS,
+    _SG_CAPTURE_CMD_COMMIT,
+    _SG_CAPTURE_CMD_PUSH_DEBUG_GROUP,
+    _SG_CAPTURE_CMD_POP_DEBUG_GROUP,
+    _SG_CAPTURE_CMD_NUM,
+} _sg_capture_cmd_t;
+
+/* the stream header, used to reject streams which can't be replayed */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ptr_size;
+    uint32_t buffer_desc_size;
+    uint32_t image_desc_size;
+    uint32_t shader_desc_size;
+    uint32_t pipeline_desc_size;
+    uint32_t pass_desc_size;
+    uint32_t query_desc_size;
+    uint32_t bindings_size;
+    uint32_t pass_action_size;
+    int buffer_pool_size;
+    int image_pool_size;
+    int shader_pool_size;
+    int pipeline_pool_size;
+    int pass_pool_size;
+    int query_pool_size;
+} _sg_capture_header_t;
+
+/* each recorded call starts with a record header, followed by the arguments */
+typedef struct {
+    uint32_t cmd;
+    uint32_t size;      /* size of the arguments in bytes */
+} _sg_capture_record_t;
+
+/*
+    The same 'transfer' functions are used for writing and reading the
+    call arguments, so that the stream layout can't get out of sync.
+    When writing, pointers in the written desc structs are cleared and
+    the pointed-to data is appended as length-prefixed blobs, when reading,
+    the pointers are patched to point to the blob data in the stream.
+*/
+typedef struct {
+    bool writing;
+    bool error;
+    uint8_t* wbuf;
+    const uint8_t* rbuf;
+    size_t size;
+    size_t pos;
+} _sg_capture_stream_t;
+
+/* maps captured resource ids to resource ids created during replay */
+typedef struct {
+    int size;
+    uint32_t* captured_ids;
+    uint32_t* replay_ids;
+} _sg_capture_id_map_t;
+
+typedef struct {
+    _sg_capture_id_map_t buffers;
+    _sg_capture_id_map_t images;
+    _sg_capture_id_map_t shaders;
+    _sg_capture_id_map_t pipelines;
+    _sg_capture_id_map_t passes;
+    _sg_capture_id_map_t queries;
+} _sg_capture_id_maps_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    sg_capture_desc_t desc;
+    sg_trace_hooks hooks;       /* the previously installed trace hooks */
+    _sg_capture_stream_t stream;
+    int frames_to_capture;
+    bool overflow;
+    struct {
+        bool active;
+        _sg_capture_stream_t stream;
+        _sg_capture_id_maps_t ids;
+        sg_capture_replay_info_t info;
+    } replay;
+} _sg_capture_state_t;
+static _sg_capture_state_t _sg_capture;
+
+/*=== STREAM HELPERS =========================================================*/
+_SOKOL_PRIVATE size_t _sg_capture_roundup(size_t val, size_t round_to) {
+    return (val + (round_to - 1)) & ~(round_to - 1);
+}
+
+/* transfer plain data */
+_SOKOL_PRIVATE void _sg_capture_xfer(_sg_capture_stream_t* s, void* ptr, size_t size) {
+    if (s->error) {
+        return;
+    }
+    if ((s->pos + size) > s->size) {
+        s->error = true;
+        return;
+    }
+    if (s->writing) {
+        memcpy(s->wbuf + s->pos, ptr, size);
+    }
+    else {
+        memcpy(ptr, s->rbuf + s->pos, size);
+    }
+    s->pos += size;
+}
+
+/* transfer a length-prefixed blob, when writing the pointer will be cleared */
+_SOKOL_PRIVATE void _sg_capture_xfer_blob(_sg_capture_stream_t* s, const void** ptr, size_t* size) {
+    uint32_t blob_size = (s->writing && *ptr) ? (uint32_t)*size : 0;
+    _sg_capture_xfer(s, &blob_size, sizeof(blob_size));
+    if (s->error) {
+        return;
+    }
+    const size_t start = _sg_capture_roundup(s->pos, _SG_CAPTURE_BLOB_ALIGN);
+    const size_t end = start + blob_size;
+    if (end > s->size) {
+        s->error = true;
+        return;
+    }
+    if (s->writing) {
+        if (blob_size > 0) {
+            memcpy(s->wbuf + start, *ptr, blob_size);
+        }
+        *ptr = 0;
+    }
+    else {
+        *ptr = (blob_size > 0) ? (s->rbuf + start) : 0;
+        *size = blob_size;
+    }
+    s->pos = end;
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_range(_sg_capture_stream_t* s, sg_range* range) {
+    _sg_capture_xfer_blob(s, &range->ptr, &range->size);
+    if (!s->writing && !s->error && (0 == range->ptr)) {
+        range->size = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_str(_sg_capture_stream_t* s, const char** str) {
+    size_t size = (s->writing && *str) ? (strlen(*str) + 1) : 0;
+    const void* ptr = *str;
+    _sg_capture_xfer_blob(s, &ptr, &size);
+    *str = (const char*) ptr;
+}
+
+/*
+    Transfer a desc struct which contains pointers. Writing reserves space
+    for the struct, the caller then transfers the pointed-to data (which
+    clears the pointers), and _sg_capture_xfer_struct_end() writes the struct.
+*/
+_SOKOL_PRIVATE size_t _sg_capture_xfer_struct_begin(_sg_capture_stream_t* s, void* ptr, size_t size) {
+    const size_t pos = s->pos;
+    if (s->writing) {
+        if ((s->pos + size) > s->size) {
+            s->error = true;
+        }
+        else {
+            s->pos += size;
+        }
+    }
+    else {
+        _sg_capture_xfer(s, ptr, size);
+    }
+    return pos;
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_struct_end(_sg_capture_stream_t* s, size_t pos, const void* ptr, size_t size) {
+    if (s->writing && !s->error) {
+        memcpy(s->wbuf + pos, ptr, size);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_image_data(_sg_capture_stream_t* s, sg_image_data* data) {
+    for (int face = 0; face < SG_CUBEFACE_NUM; face++) {
+        for (int mip = 0; mip < SG_MAX_MIPMAPS; mip++) {
+            _sg_capture_xfer_range(s, &data->subimage[face][mip]);
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_buffer_desc(_sg_capture_stream_t* s, sg_buffer_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_buffer_desc));
+    _sg_capture_xfer_range(s, &desc->data);
+    _sg_capture_xfer_str(s, &desc->label);
+    memset(desc->gl_buffers, 0, sizeof(desc->gl_buffers));
+    memset((void*)desc->mtl_buffers, 0, sizeof(desc->mtl_buffers));
+    desc->d3d11_buffer = 0;
+    desc->wgpu_buffer = 0;
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_buffer_desc));
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_image_desc(_sg_capture_stream_t* s, sg_image_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_image_desc));
+    _sg_capture_xfer_image_data(s, &desc->data);
+    _sg_capture_xfer_str(s, &desc->label);
+    memset(desc->gl_textures, 0, sizeof(desc->gl_textures));
+    desc->gl_texture_target = 0;
+    memset((void*)desc->mtl_textures, 0, sizeof(desc->mtl_textures));
+    desc->d3d11_texture = 0;
+    desc->d3d11_shader_resource_view = 0;
+    desc->wgpu_texture = 0;
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_image_desc));
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_shader_stage_desc(_sg_capture_stream_t* s, sg_shader_stage_desc* stage) {
+    _sg_capture_xfer_str(s, &stage->source);
+    _sg_capture_xfer_range(s, &stage->bytecode);
+    _sg_capture_xfer_str(s, &stage->entry);
+    _sg_capture_xfer_str(s, &stage->d3d11_target);
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            _sg_capture_xfer_str(s, &stage->uniform_blocks[ub_index].uniforms[u_index].name);
+        }
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        _sg_capture_xfer_str(s, &stage->images[img_index].name);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_shader_desc(_sg_capture_stream_t* s, sg_shader_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_shader_desc));
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        _sg_capture_xfer_str(s, &desc->attrs[i].name);
+        _sg_capture_xfer_str(s, &desc->attrs[i].sem_name);
+    }
+    _sg_capture_xfer_shader_stage_desc(s, &desc->vs);
+    _sg_capture_xfer_shader_stage_desc(s, &desc->fs);
+    _sg_capture_xfer_str(s, &desc->label);
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_shader_desc));
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_pipeline_desc(_sg_capture_stream_t* s, sg_pipeline_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_pipeline_desc));
+    _sg_capture_xfer_str(s, &desc->label);
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_pipeline_desc));
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_pass_desc(_sg_capture_stream_t* s, sg_pass_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_pass_desc));
+    _sg_capture_xfer_str(s, &desc->label);
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_pass_desc));
+}
+
+_SOKOL_PRIVATE void _sg_capture_xfer_query_desc(_sg_capture_stream_t* s, sg_query_object_desc* desc) {
+    const size_t pos = _sg_capture_xfer_struct_begin(s, desc, sizeof(sg_query_object_desc));
+    _sg_capture_xfer_str(s, &desc->label);
+    _sg_capture_xfer_struct_end(s, pos, desc, sizeof(sg_query_object_desc));
+}
+
+/*=== CAPTURING ==============================================================*/
+_SOKOL_PRIVATE bool _sg_capture_recording(_sg_capture_cmd_t cmd) {
+    if ((_SG_CAPTURE_INIT_COOKIE != _sg_capture.init_cookie) || _sg_capture.overflow) {
+        return false;
+    }
+    /* resource creation and destruction is always recorded */
+    if (cmd <= _SG_CAPTURE_CMD_FAIL_PASS) {
+        return true;
+    }
+    return _sg_capture.frames_to_capture > 0;
+}
+
+_SOKOL_PRIVATE size_t _sg_capture_record_begin(_sg_capture_cmd_t cmd) {
+    _sg_capture_stream_t* s = &_sg_capture.stream;
+    const size_t pos = s->pos;
+    _sg_capture_record_t rec = { (uint32_t)cmd, 0 };
+    _sg_capture_xfer(s, &rec, sizeof(rec));
+    return pos;
+}
+
+_SOKOL_PRIVATE void _sg_capture_record_end(size_t pos) {
+    _sg_capture_stream_t* s = &_sg_capture.stream;
+    if (s->error) {
+        /* drop the incomplete record and stop recording */
+        SOKOL_LOG("sokol_gfx_capture.h: capture buffer overflow, increase sg_capture_desc_t.buffer_size!");
+        s->pos = pos;
+        s->error = false;
+        _sg_capture.overflow = true;
+        _sg_capture.frames_to_capture = 0;
+        return;
+    }
+    s->pos = _sg_capture_roundup(s->pos, _SG_CAPTURE_BLOB_ALIGN);
+    if (s->pos > s->size) {
+        s->pos = s->size;
+    }
+    _sg_capture_record_t rec;
+    memcpy(&rec, s->wbuf + pos, sizeof(rec));
+    rec.size = (uint32_t)(s->pos - (pos + sizeof(rec)));
+    memcpy(s->wbuf + pos, &rec, sizeof(rec));
+}
+
+_SOKOL_PRIVATE void _sg_capture_record_id(_sg_capture_cmd_t cmd, uint32_t id) {
+    if (_sg_capture_recording(cmd)) {
+        const size_t pos = _sg_capture_record_begin(cmd);
+        _sg_capture_xfer(&_sg_capture.stream, &id, sizeof(id));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_record_noargs(_sg_capture_cmd_t cmd) {
+    if (_sg_capture_recording(cmd)) {
+        _sg_capture_record_end(_sg_capture_record_begin(cmd));
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_reset_state_cache(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.reset_state_cache) {
+        _sg_capture.hooks.reset_state_cache(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_RESET_STATE_CACHE);
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_buffer(const sg_buffer_desc* desc, sg_buffer result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_buffer) {
+        _sg_capture.hooks.make_buffer(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_BUFFER)) {
+        sg_buffer_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_BUFFER);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_buffer_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_image(const sg_image_desc* desc, sg_image result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_image) {
+        _sg_capture.hooks.make_image(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_IMAGE)) {
+        sg_image_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_IMAGE);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_image_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_shader(const sg_shader_desc* desc, sg_shader result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_shader) {
+        _sg_capture.hooks.make_shader(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_SHADER)) {
+        sg_shader_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_SHADER);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_shader_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_pipeline(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_pipeline) {
+        _sg_capture.hooks.make_pipeline(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_PIPELINE)) {
+        sg_pipeline_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_PIPELINE);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_pipeline_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_pass(const sg_pass_desc* desc, sg_pass result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_pass) {
+        _sg_capture.hooks.make_pass(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_PASS)) {
+        sg_pass_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_PASS);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_pass_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_make_query(const sg_query_object_desc* desc, sg_query result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.make_query) {
+        _sg_capture.hooks.make_query(desc, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_MAKE_QUERY)) {
+        sg_query_object_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_MAKE_QUERY);
+        _sg_capture_xfer(&_sg_capture.stream, &result, sizeof(result));
+        _sg_capture_xfer_query_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_buffer(sg_buffer buf, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_buffer) {
+        _sg_capture.hooks.destroy_buffer(buf, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_BUFFER, buf.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_image(sg_image img, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_image) {
+        _sg_capture.hooks.destroy_image(img, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_IMAGE, img.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_shader(sg_shader shd, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_shader) {
+        _sg_capture.hooks.destroy_shader(shd, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_SHADER, shd.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_pipeline(sg_pipeline pip, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_pipeline) {
+        _sg_capture.hooks.destroy_pipeline(pip, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_PIPELINE, pip.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_pass(sg_pass pass, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_pass) {
+        _sg_capture.hooks.destroy_pass(pass, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_PASS, pass.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_destroy_query(sg_query qry, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.destroy_query) {
+        _sg_capture.hooks.destroy_query(qry, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DESTROY_QUERY, qry.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_alloc_buffer(sg_buffer result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.alloc_buffer) {
+        _sg_capture.hooks.alloc_buffer(result, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_ALLOC_BUFFER, result.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_alloc_image(sg_image result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.alloc_image) {
+        _sg_capture.hooks.alloc_image(result, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_ALLOC_IMAGE, result.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_alloc_shader(sg_shader result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.alloc_shader) {
+        _sg_capture.hooks.alloc_shader(result, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_ALLOC_SHADER, result.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_alloc_pipeline(sg_pipeline result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.alloc_pipeline) {
+        _sg_capture.hooks.alloc_pipeline(result, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_ALLOC_PIPELINE, result.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_alloc_pass(sg_pass result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.alloc_pass) {
+        _sg_capture.hooks.alloc_pass(result, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_ALLOC_PASS, result.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_dealloc_buffer(sg_buffer buf_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.dealloc_buffer) {
+        _sg_capture.hooks.dealloc_buffer(buf_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DEALLOC_BUFFER, buf_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_dealloc_image(sg_image img_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.dealloc_image) {
+        _sg_capture.hooks.dealloc_image(img_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DEALLOC_IMAGE, img_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_dealloc_shader(sg_shader shd_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.dealloc_shader) {
+        _sg_capture.hooks.dealloc_shader(shd_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DEALLOC_SHADER, shd_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_dealloc_pipeline(sg_pipeline pip_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.dealloc_pipeline) {
+        _sg_capture.hooks.dealloc_pipeline(pip_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DEALLOC_PIPELINE, pip_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_dealloc_pass(sg_pass pass_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.dealloc_pass) {
+        _sg_capture.hooks.dealloc_pass(pass_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_DEALLOC_PASS, pass_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.init_buffer) {
+        _sg_capture.hooks.init_buffer(buf_id, desc, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_INIT_BUFFER)) {
+        sg_buffer_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_INIT_BUFFER);
+        _sg_capture_xfer(&_sg_capture.stream, &buf_id, sizeof(buf_id));
+        _sg_capture_xfer_buffer_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_init_image(sg_image img_id, const sg_image_desc* desc, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.init_image) {
+        _sg_capture.hooks.init_image(img_id, desc, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_INIT_IMAGE)) {
+        sg_image_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_INIT_IMAGE);
+        _sg_capture_xfer(&_sg_capture.stream, &img_id, sizeof(img_id));
+        _sg_capture_xfer_image_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_init_shader(sg_shader shd_id, const sg_shader_desc* desc, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.init_shader) {
+        _sg_capture.hooks.init_shader(shd_id, desc, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_INIT_SHADER)) {
+        sg_shader_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_INIT_SHADER);
+        _sg_capture_xfer(&_sg_capture.stream, &shd_id, sizeof(shd_id));
+        _sg_capture_xfer_shader_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.init_pipeline) {
+        _sg_capture.hooks.init_pipeline(pip_id, desc, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_INIT_PIPELINE)) {
+        sg_pipeline_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_INIT_PIPELINE);
+        _sg_capture_xfer(&_sg_capture.stream, &pip_id, sizeof(pip_id));
+        _sg_capture_xfer_pipeline_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_init_pass(sg_pass pass_id, const sg_pass_desc* desc, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.init_pass) {
+        _sg_capture.hooks.init_pass(pass_id, desc, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_INIT_PASS)) {
+        sg_pass_desc desc_copy = *desc;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_INIT_PASS);
+        _sg_capture_xfer(&_sg_capture.stream, &pass_id, sizeof(pass_id));
+        _sg_capture_xfer_pass_desc(&_sg_capture.stream, &desc_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_uninit_buffer(sg_buffer buf_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.uninit_buffer) {
+        _sg_capture.hooks.uninit_buffer(buf_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_UNINIT_BUFFER, buf_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_uninit_image(sg_image img_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.uninit_image) {
+        _sg_capture.hooks.uninit_image(img_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_UNINIT_IMAGE, img_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_uninit_shader(sg_shader shd_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.uninit_shader) {
+        _sg_capture.hooks.uninit_shader(shd_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_UNINIT_SHADER, shd_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_uninit_pipeline(sg_pipeline pip_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.uninit_pipeline) {
+        _sg_capture.hooks.uninit_pipeline(pip_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_UNINIT_PIPELINE, pip_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_uninit_pass(sg_pass pass_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.uninit_pass) {
+        _sg_capture.hooks.uninit_pass(pass_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_UNINIT_PASS, pass_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_fail_buffer(sg_buffer buf_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.fail_buffer) {
+        _sg_capture.hooks.fail_buffer(buf_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_FAIL_BUFFER, buf_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_fail_image(sg_image img_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.fail_image) {
+        _sg_capture.hooks.fail_image(img_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_FAIL_IMAGE, img_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_fail_shader(sg_shader shd_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.fail_shader) {
+        _sg_capture.hooks.fail_shader(shd_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_FAIL_SHADER, shd_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_fail_pipeline(sg_pipeline pip_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.fail_pipeline) {
+        _sg_capture.hooks.fail_pipeline(pip_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_FAIL_PIPELINE, pip_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_fail_pass(sg_pass pass_id, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.fail_pass) {
+        _sg_capture.hooks.fail_pass(pass_id, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_FAIL_PASS, pass_id.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_update_buffer(sg_buffer buf, const sg_range* data, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.update_buffer) {
+        _sg_capture.hooks.update_buffer(buf, data, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_UPDATE_BUFFER)) {
+        sg_range data_copy = *data;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_UPDATE_BUFFER);
+        _sg_capture_xfer(&_sg_capture.stream, &buf, sizeof(buf));
+        _sg_capture_xfer_range(&_sg_capture.stream, &data_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_update_image(sg_image img, const sg_image_data* data, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.update_image) {
+        _sg_capture.hooks.update_image(img, data, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_UPDATE_IMAGE)) {
+        sg_image_data data_copy = *data;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_UPDATE_IMAGE);
+        _sg_capture_xfer(&_sg_capture.stream, &img, sizeof(img));
+        _sg_capture_xfer_image_data(&_sg_capture.stream, &data_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_update_image_mip(sg_image img, int mip_index, const sg_image_data* data, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.update_image_mip) {
+        _sg_capture.hooks.update_image_mip(img, mip_index, data, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_UPDATE_IMAGE_MIP)) {
+        sg_image_data data_copy = *data;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_UPDATE_IMAGE_MIP);
+        _sg_capture_xfer(&_sg_capture.stream, &img, sizeof(img));
+        _sg_capture_xfer(&_sg_capture.stream, &mip_index, sizeof(mip_index));
+        _sg_capture_xfer_image_data(&_sg_capture.stream, &data_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_append_buffer(sg_buffer buf, const sg_range* data, int result, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.append_buffer) {
+        _sg_capture.hooks.append_buffer(buf, data, result, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_APPEND_BUFFER)) {
+        sg_range data_copy = *data;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_APPEND_BUFFER);
+        _sg_capture_xfer(&_sg_capture.stream, &buf, sizeof(buf));
+        _sg_capture_xfer_range(&_sg_capture.stream, &data_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_begin_default_pass(const sg_pass_action* pass_action, int width, int height, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.begin_default_pass) {
+        _sg_capture.hooks.begin_default_pass(pass_action, width, height, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS)) {
+        sg_pass_action action = *pass_action;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS);
+        _sg_capture_xfer(&_sg_capture.stream, &action, sizeof(action));
+        _sg_capture_xfer(&_sg_capture.stream, &width, sizeof(width));
+        _sg_capture_xfer(&_sg_capture.stream, &height, sizeof(height));
+        _sg_capture_record_end(pos);
+    }
+}
+
+/* swapchain passes are recorded as default passes, the native swapchain objects can't be replayed */
+_SOKOL_PRIVATE void _sg_capture_begin_swapchain_pass(const sg_swapchain* swapchain, const sg_pass_action* pass_action, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.begin_swapchain_pass) {
+        _sg_capture.hooks.begin_swapchain_pass(swapchain, pass_action, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS)) {
+        sg_pass_action action = *pass_action;
+        int width = swapchain->width;
+        int height = swapchain->height;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS);
+        _sg_capture_xfer(&_sg_capture.stream, &action, sizeof(action));
+        _sg_capture_xfer(&_sg_capture.stream, &width, sizeof(width));
+        _sg_capture_xfer(&_sg_capture.stream, &height, sizeof(height));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_begin_pass(sg_pass pass, const sg_pass_action* pass_action, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.begin_pass) {
+        _sg_capture.hooks.begin_pass(pass, pass_action, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_BEGIN_PASS)) {
+        sg_pass_action action = *pass_action;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_BEGIN_PASS);
+        _sg_capture_xfer(&_sg_capture.stream, &pass, sizeof(pass));
+        _sg_capture_xfer(&_sg_capture.stream, &action, sizeof(action));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_record_rect(_sg_capture_cmd_t cmd, int x, int y, int width, int height, bool origin_top_left) {
+    if (_sg_capture_recording(cmd)) {
+        const size_t pos = _sg_capture_record_begin(cmd);
+        int args[5] = { x, y, width, height, origin_top_left ? 1 : 0 };
+        _sg_capture_xfer(&_sg_capture.stream, args, sizeof(args));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_apply_viewport(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.apply_viewport) {
+        _sg_capture.hooks.apply_viewport(x, y, width, height, origin_top_left, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_rect(_SG_CAPTURE_CMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sg_capture_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.apply_scissor_rect) {
+        _sg_capture.hooks.apply_scissor_rect(x, y, width, height, origin_top_left, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_rect(_SG_CAPTURE_CMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sg_capture_apply_pipeline(sg_pipeline pip, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.apply_pipeline) {
+        _sg_capture.hooks.apply_pipeline(pip, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_APPLY_PIPELINE, pip.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_apply_bindings(const sg_bindings* bindings, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.apply_bindings) {
+        _sg_capture.hooks.apply_bindings(bindings, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_APPLY_BINDINGS)) {
+        sg_bindings bind = *bindings;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_APPLY_BINDINGS);
+        _sg_capture_xfer(&_sg_capture.stream, &bind, sizeof(bind));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.apply_uniforms) {
+        _sg_capture.hooks.apply_uniforms(stage, ub_index, data, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_APPLY_UNIFORMS)) {
+        sg_range data_copy = *data;
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_APPLY_UNIFORMS);
+        _sg_capture_xfer(&_sg_capture.stream, &stage, sizeof(stage));
+        _sg_capture_xfer(&_sg_capture.stream, &ub_index, sizeof(ub_index));
+        _sg_capture_xfer_range(&_sg_capture.stream, &data_copy);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_draw(int base_element, int num_elements, int num_instances, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.draw) {
+        _sg_capture.hooks.draw(base_element, num_elements, num_instances, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_DRAW)) {
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_DRAW);
+        int args[3] = { base_element, num_elements, num_instances };
+        _sg_capture_xfer(&_sg_capture.stream, args, sizeof(args));
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_begin_query(sg_query qry, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.begin_query) {
+        _sg_capture.hooks.begin_query(qry, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_BEGIN_QUERY, qry.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_end_query(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.end_query) {
+        _sg_capture.hooks.end_query(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_END_QUERY);
+}
+
+_SOKOL_PRIVATE void _sg_capture_begin_conditional_render(sg_query qry, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.begin_conditional_render) {
+        _sg_capture.hooks.begin_conditional_render(qry, _sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_id(_SG_CAPTURE_CMD_BEGIN_CONDITIONAL_RENDER, qry.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_end_conditional_render(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.end_conditional_render) {
+        _sg_capture.hooks.end_conditional_render(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_END_CONDITIONAL_RENDER);
+}
+
+_SOKOL_PRIVATE void _sg_capture_end_pass(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.end_pass) {
+        _sg_capture.hooks.end_pass(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_END_PASS);
+}
+
+_SOKOL_PRIVATE void _sg_capture_commit(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.commit) {
+        _sg_capture.hooks.commit(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_COMMIT);
+    if (_sg_capture.frames_to_capture > 0) {
+        _sg_capture.frames_to_capture--;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_push_debug_group(const char* name, void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.push_debug_group) {
+        _sg_capture.hooks.push_debug_group(name, _sg_capture.hooks.user_data);
+    }
+    if (_sg_capture_recording(_SG_CAPTURE_CMD_PUSH_DEBUG_GROUP)) {
+        const size_t pos = _sg_capture_record_begin(_SG_CAPTURE_CMD_PUSH_DEBUG_GROUP);
+        _sg_capture_xfer_str(&_sg_capture.stream, &name);
+        _sg_capture_record_end(pos);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_capture_pop_debug_group(void* user_data) {
+    (void)user_data;
+    if (_sg_capture.hooks.pop_debug_group) {
+        _sg_capture.hooks.pop_debug_group(_sg_capture.hooks.user_data);
+    }
+    _sg_capture_record_noargs(_SG_CAPTURE_CMD_POP_DEBUG_GROUP);
+}
+
+_SOKOL_PRIVATE void _sg_capture_write_header(void) {
+    sg_desc desc = sg_query_desc();
+    _sg_capture_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = _SG_CAPTURE_MAGIC;
+    hdr.version = _SG_CAPTURE_VERSION;
+    hdr.ptr_size = (uint32_t) sizeof(void*);
+    hdr.buffer_desc_size = (uint32_t) sizeof(sg_buffer_desc);
+    hdr.image_desc_size = (uint32_t) sizeof(sg_image_desc);
+    hdr.shader_desc_size = (uint32_t) sizeof(sg_shader_desc);
+    hdr.pipeline_desc_size = (uint32_t) sizeof(sg_pipeline_desc);
+    hdr.pass_desc_size = (uint32_t) sizeof(sg_pass_desc);
+    hdr.query_desc_size = (uint32_t) sizeof(sg_query_object_desc);
+    hdr.bindings_size = (uint32_t) sizeof(sg_bindings);
+    hdr.pass_action_size = (uint32_t) sizeof(sg_pass_action);
+    hdr.buffer_pool_size = desc.buffer_pool_size;
+    hdr.image_pool_size = desc.image_pool_size;
+    hdr.shader_pool_size = desc.shader_pool_size;
+    hdr.pipeline_pool_size = desc.pipeline_pool_size;
+    hdr.pass_pool_size = desc.pass_pool_size;
+    hdr.query_pool_size = desc.query_pool_size;
+    _sg_capture_xfer(&_sg_capture.stream, &hdr, sizeof(hdr));
+    SOKOL_ASSERT(!_sg_capture.stream.error);
+    _sg_capture.stream.pos = _sg_capture_roundup(_sg_capture.stream.pos, _SG_CAPTURE_BLOB_ALIGN);
+}
+
+/*=== REPLAYING ==============================================================*/
+/* the pool size comes from the stream header and must have been validated */
+_SOKOL_PRIVATE bool _sg_capture_id_map_init(_sg_capture_id_map_t* map, int size) {
+    SOKOL_ASSERT((size > 0) && (size <= _SG_CAPTURE_MAX_POOL_SIZE));
+    const size_t num_bytes = (size_t)size * sizeof(uint32_t);
+    map->captured_ids = (uint32_t*) SOKOL_MALLOC(num_bytes);
+    map->replay_ids = (uint32_t*) SOKOL_MALLOC(num_bytes);
+    if ((0 == map->captured_ids) || (0 == map->replay_ids)) {
+        return false;
+    }
+    map->size = size;
+    memset(map->captured_ids, 0, num_bytes);
+    memset(map->replay_ids, 0, num_bytes);
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_capture_id_map_discard(_sg_capture_id_map_t* map) {
+    if (map->replay_ids) {
+        SOKOL_FREE(map->replay_ids);
+    }
+    if (map->captured_ids) {
+        SOKOL_FREE(map->captured_ids);
+    }
+    memset(map, 0, sizeof(_sg_capture_id_map_t));
+}
+
+_SOKOL_PRIVATE void _sg_capture_discard_id_maps(_sg_capture_id_maps_t* ids) {
+    _sg_capture_id_map_discard(&ids->buffers);
+    _sg_capture_id_map_discard(&ids->images);
+    _sg_capture_id_map_discard(&ids->shaders);
+    _sg_capture_id_map_discard(&ids->pipelines);
+    _sg_capture_id_map_discard(&ids->passes);
+    _sg_capture_id_map_discard(&ids->queries);
+}
+
+_SOKOL_PRIVATE bool _sg_capture_valid_pool_size(int size) {
+    return (size > 0) && (size <= _SG_CAPTURE_MAX_POOL_SIZE);
+}
+
+_SOKOL_PRIVATE void _sg_capture_id_map_add(_sg_capture_id_map_t* map, uint32_t captured_id, uint32_t replay_id) {
+    const int slot_index = (int)(captured_id & _SG_CAPTURE_SLOT_MASK);
+    if ((captured_id != SG_INVALID_ID) && (slot_index < map->size)) {
+        map->captured_ids[slot_index] = captured_id;
+        map->replay_ids[slot_index] = replay_id;
+    }
+}
+
+_SOKOL_PRIVATE uint32_t _sg_capture_id_map_lookup(const _sg_capture_id_map_t* map, uint32_t captured_id) {
+    const int slot_index = (int)(captured_id & _SG_CAPTURE_SLOT_MASK);
+    if ((captured_id != SG_INVALID_ID) && (slot_index < map->size) && (map->captured_ids[slot_index] == captured_id)) {
+        return map->replay_ids[slot_index];
+    }
+    return SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sg_capture_id_map_remove(_sg_capture_id_map_t* map, uint32_t captured_id) {
+    const int slot_index = (int)(captured_id & _SG_CAPTURE_SLOT_MASK);
+    if ((captured_id != SG_INVALID_ID) && (slot_index < map->size) && (map->captured_ids[slot_index] == captured_id)) {
+        map->captured_ids[slot_index] = SG_INVALID_ID;
+        map->replay_ids[slot_index] = SG_INVALID_ID;
+    }
+}
+
+_SOKOL_PRIVATE sg_buffer _sg_capture_buffer(uint32_t captured_id) {
+    sg_buffer res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.buffers, captured_id) };
+    return res;
+}
+
+_SOKOL_PRIVATE sg_image _sg_capture_image(uint32_t captured_id) {
+    sg_image res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.images, captured_id) };
+    return res;
+}
+
+_SOKOL_PRIVATE sg_shader _sg_capture_shader(uint32_t captured_id) {
+    sg_shader res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.shaders, captured_id) };
+    return res;
+}
+
+_SOKOL_PRIVATE sg_pipeline _sg_capture_pipeline(uint32_t captured_id) {
+    sg_pipeline res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.pipelines, captured_id) };
+    return res;
+}
+
+_SOKOL_PRIVATE sg_pass _sg_capture_pass(uint32_t captured_id) {
+    sg_pass res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.passes, captured_id) };
+    return res;
+}
+
+_SOKOL_PRIVATE sg_query _sg_capture_query(uint32_t captured_id) {
+    sg_query res = { _sg_capture_id_map_lookup(&_sg_capture.replay.ids.queries, captured_id) };
+    return res;
+}
+
+/* the lifecycle calls below assert on resources which are not in the alloc state,
+   a damaged stream must not be able to trigger those */
+_SOKOL_PRIVATE bool _sg_capture_buffer_allocated(uint32_t captured_id) {
+    return SG_RESOURCESTATE_ALLOC == sg_query_buffer_state(_sg_capture_buffer(captured_id));
+}
+
+_SOKOL_PRIVATE bool _sg_capture_image_allocated(uint32_t captured_id) {
+    return SG_RESOURCESTATE_ALLOC == sg_query_image_state(_sg_capture_image(captured_id));
+}
+
+_SOKOL_PRIVATE bool _sg_capture_shader_allocated(uint32_t captured_id) {
+    return SG_RESOURCESTATE_ALLOC == sg_query_shader_state(_sg_capture_shader(captured_id));
+}
+
+_SOKOL_PRIVATE bool _sg_capture_pipeline_allocated(uint32_t captured_id) {
+    return SG_RESOURCESTATE_ALLOC == sg_query_pipeline_state(_sg_capture_pipeline(captured_id));
+}
+
+_SOKOL_PRIVATE bool _sg_capture_pass_allocated(uint32_t captured_id) {
+    return SG_RESOURCESTATE_ALLOC == sg_query_pass_state(_sg_capture_pass(captured_id));
+}
+
+/* patch resource ids in desc structs to the ids created during replay */
+_SOKOL_PRIVATE void _sg_capture_remap_buffer_desc(sg_buffer_desc* desc) {
+    desc->parent = _sg_capture_buffer(desc->parent.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_remap_pipeline_desc(sg_pipeline_desc* desc) {
+    desc->shader = _sg_capture_shader(desc->shader.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_remap_pass_desc(sg_pass_desc* desc) {
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        desc->color_attachments[i].image = _sg_capture_image(desc->color_attachments[i].image.id);
+    }
+    desc->depth_stencil_attachment.image = _sg_capture_image(desc->depth_stencil_attachment.image.id);
+}
+
+_SOKOL_PRIVATE void _sg_capture_remap_bindings(sg_bindings* bind) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        bind->vertex_buffers[i] = _sg_capture_buffer(bind->vertex_buffers[i].id);
+    }
+    bind->index_buffer = _sg_capture_buffer(bind->index_buffer.id);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        bind->vs_images[i] = _sg_capture_image(bind->vs_images[i].id);
+        bind->fs_images[i] = _sg_capture_image(bind->fs_images[i].id);
+    }
+}
+
+_SOKOL_PRIVATE uint32_t _sg_capture_read_id(_sg_capture_stream_t* s) {
+    uint32_t id = SG_INVALID_ID;
+    _sg_capture_xfer(s, &id, sizeof(id));
+    return id;
+}
+
+/* replay a single record, returns false if the stream is damaged */
+_SOKOL_PRIVATE bool _sg_capture_replay_record(_sg_capture_stream_t* s, _sg_capture_cmd_t cmd) {
+    _sg_capture_id_maps_t* ids = &_sg_capture.replay.ids;
+    switch (cmd) {
+        case _SG_CAPTURE_CMD_RESET_STATE_CACHE:
+            sg_reset_state_cache();
+            break;
+        case _SG_CAPTURE_CMD_MAKE_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_buffer_desc desc;
+            _sg_capture_xfer_buffer_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_remap_buffer_desc(&desc);
+                _sg_capture_id_map_add(&ids->buffers, id, sg_make_buffer(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_MAKE_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_image_desc desc;
+            _sg_capture_xfer_image_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_id_map_add(&ids->images, id, sg_make_image(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_MAKE_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_shader_desc desc;
+            _sg_capture_xfer_shader_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_id_map_add(&ids->shaders, id, sg_make_shader(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_MAKE_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_pipeline_desc desc;
+            _sg_capture_xfer_pipeline_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_remap_pipeline_desc(&desc);
+                _sg_capture_id_map_add(&ids->pipelines, id, sg_make_pipeline(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_MAKE_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_pass_desc desc;
+            _sg_capture_xfer_pass_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_remap_pass_desc(&desc);
+                _sg_capture_id_map_add(&ids->passes, id, sg_make_pass(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_MAKE_QUERY: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_query_object_desc desc;
+            _sg_capture_xfer_query_desc(s, &desc);
+            if (!s->error) {
+                _sg_capture_id_map_add(&ids->queries, id, sg_make_query(&desc).id);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_buffer(_sg_capture_buffer(id));
+            _sg_capture_id_map_remove(&ids->buffers, id);
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_image(_sg_capture_image(id));
+            _sg_capture_id_map_remove(&ids->images, id);
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_shader(_sg_capture_shader(id));
+            _sg_capture_id_map_remove(&ids->shaders, id);
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_pipeline(_sg_capture_pipeline(id));
+            _sg_capture_id_map_remove(&ids->pipelines, id);
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_pass(_sg_capture_pass(id));
+            _sg_capture_id_map_remove(&ids->passes, id);
+        } break;
+        case _SG_CAPTURE_CMD_DESTROY_QUERY: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_destroy_query(_sg_capture_query(id));
+            _sg_capture_id_map_remove(&ids->queries, id);
+        } break;
+        case _SG_CAPTURE_CMD_ALLOC_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            _sg_capture_id_map_add(&ids->buffers, id, sg_alloc_buffer().id);
+        } break;
+        case _SG_CAPTURE_CMD_ALLOC_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            _sg_capture_id_map_add(&ids->images, id, sg_alloc_image().id);
+        } break;
+        case _SG_CAPTURE_CMD_ALLOC_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            _sg_capture_id_map_add(&ids->shaders, id, sg_alloc_shader().id);
+        } break;
+        case _SG_CAPTURE_CMD_ALLOC_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            _sg_capture_id_map_add(&ids->pipelines, id, sg_alloc_pipeline().id);
+        } break;
+        case _SG_CAPTURE_CMD_ALLOC_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            _sg_capture_id_map_add(&ids->passes, id, sg_alloc_pass().id);
+        } break;
+        case _SG_CAPTURE_CMD_DEALLOC_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_buffer_allocated(id)) {
+                sg_dealloc_buffer(_sg_capture_buffer(id));
+            }
+            _sg_capture_id_map_remove(&ids->buffers, id);
+        } break;
+        case _SG_CAPTURE_CMD_DEALLOC_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_image_allocated(id)) {
+                sg_dealloc_image(_sg_capture_image(id));
+            }
+            _sg_capture_id_map_remove(&ids->images, id);
+        } break;
+        case _SG_CAPTURE_CMD_DEALLOC_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_shader_allocated(id)) {
+                sg_dealloc_shader(_sg_capture_shader(id));
+            }
+            _sg_capture_id_map_remove(&ids->shaders, id);
+        } break;
+        case _SG_CAPTURE_CMD_DEALLOC_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_pipeline_allocated(id)) {
+                sg_dealloc_pipeline(_sg_capture_pipeline(id));
+            }
+            _sg_capture_id_map_remove(&ids->pipelines, id);
+        } break;
+        case _SG_CAPTURE_CMD_DEALLOC_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_pass_allocated(id)) {
+                sg_dealloc_pass(_sg_capture_pass(id));
+            }
+            _sg_capture_id_map_remove(&ids->passes, id);
+        } break;
+        case _SG_CAPTURE_CMD_INIT_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_buffer_desc desc;
+            _sg_capture_xfer_buffer_desc(s, &desc);
+            if (!s->error && _sg_capture_buffer_allocated(id)) {
+                _sg_capture_remap_buffer_desc(&desc);
+                sg_init_buffer(_sg_capture_buffer(id), &desc);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_INIT_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_image_desc desc;
+            _sg_capture_xfer_image_desc(s, &desc);
+            if (!s->error && _sg_capture_image_allocated(id)) {
+                sg_init_image(_sg_capture_image(id), &desc);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_INIT_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_shader_desc desc;
+            _sg_capture_xfer_shader_desc(s, &desc);
+            if (!s->error && _sg_capture_shader_allocated(id)) {
+                sg_init_shader(_sg_capture_shader(id), &desc);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_INIT_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_pipeline_desc desc;
+            _sg_capture_xfer_pipeline_desc(s, &desc);
+            if (!s->error && _sg_capture_pipeline_allocated(id)) {
+                _sg_capture_remap_pipeline_desc(&desc);
+                sg_init_pipeline(_sg_capture_pipeline(id), &desc);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_INIT_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_pass_desc desc;
+            _sg_capture_xfer_pass_desc(s, &desc);
+            if (!s->error && _sg_capture_pass_allocated(id)) {
+                _sg_capture_remap_pass_desc(&desc);
+                sg_init_pass(_sg_capture_pass(id), &desc);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_UNINIT_BUFFER:
+            sg_uninit_buffer(_sg_capture_buffer(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_UNINIT_IMAGE:
+            sg_uninit_image(_sg_capture_image(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_UNINIT_SHADER:
+            sg_uninit_shader(_sg_capture_shader(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_UNINIT_PIPELINE:
+            sg_uninit_pipeline(_sg_capture_pipeline(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_UNINIT_PASS:
+            sg_uninit_pass(_sg_capture_pass(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_FAIL_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_buffer_allocated(id)) {
+                sg_fail_buffer(_sg_capture_buffer(id));
+            }
+        } break;
+        case _SG_CAPTURE_CMD_FAIL_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_image_allocated(id)) {
+                sg_fail_image(_sg_capture_image(id));
+            }
+        } break;
+        case _SG_CAPTURE_CMD_FAIL_SHADER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_shader_allocated(id)) {
+                sg_fail_shader(_sg_capture_shader(id));
+            }
+        } break;
+        case _SG_CAPTURE_CMD_FAIL_PIPELINE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_pipeline_allocated(id)) {
+                sg_fail_pipeline(_sg_capture_pipeline(id));
+            }
+        } break;
+        case _SG_CAPTURE_CMD_FAIL_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            if (_sg_capture_pass_allocated(id)) {
+                sg_fail_pass(_sg_capture_pass(id));
+            }
+        } break;
+        case _SG_CAPTURE_CMD_UPDATE_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_range data;
+            _sg_capture_xfer_range(s, &data);
+            if (!s->error) {
+                sg_update_buffer(_sg_capture_buffer(id), &data);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_UPDATE_IMAGE: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_image_data data;
+            _sg_capture_xfer_image_data(s, &data);
+            if (!s->error) {
+                sg_update_image(_sg_capture_image(id), &data);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_UPDATE_IMAGE_MIP: {
+            const uint32_t id = _sg_capture_read_id(s);
+            int mip_index = 0;
+            sg_image_data data;
+            _sg_capture_xfer(s, &mip_index, sizeof(mip_index));
+            _sg_capture_xfer_image_data(s, &data);
+            if (!s->error) {
+                sg_update_image_mip(_sg_capture_image(id), mip_index, &data);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_APPEND_BUFFER: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_range data;
+            _sg_capture_xfer_range(s, &data);
+            if (!s->error) {
+                sg_append_buffer(_sg_capture_buffer(id), &data);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_BEGIN_DEFAULT_PASS: {
+            sg_pass_action action;
+            int width = 0, height = 0;
+            _sg_capture_xfer(s, &action, sizeof(action));
+            _sg_capture_xfer(s, &width, sizeof(width));
+            _sg_capture_xfer(s, &height, sizeof(height));
+            if (!s->error) {
+                sg_begin_default_pass(&action, width, height);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_BEGIN_PASS: {
+            const uint32_t id = _sg_capture_read_id(s);
+            sg_pass_action action;
+            _sg_capture_xfer(s, &action, sizeof(action));
+            if (!s->error) {
+                sg_begin_pass(_sg_capture_pass(id), &action);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_APPLY_VIEWPORT:
+        case _SG_CAPTURE_CMD_APPLY_SCISSOR_RECT: {
+            int args[5] = { 0 };
+            _sg_capture_xfer(s, args, sizeof(args));
+            if (!s->error) {
+                if (cmd == _SG_CAPTURE_CMD_APPLY_VIEWPORT) {
+                    sg_apply_viewport(args[0], args[1], args[2], args[3], 0 != args[4]);
+                }
+                else {
+                    sg_apply_scissor_rect(args[0], args[1], args[2], args[3], 0 != args[4]);
+                }
+            }
+        } break;
+        case _SG_CAPTURE_CMD_APPLY_PIPELINE:
+            sg_apply_pipeline(_sg_capture_pipeline(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_APPLY_BINDINGS: {
+            sg_bindings bind;
+            _sg_capture_xfer(s, &bind, sizeof(bind));
+            if (!s->error) {
+                _sg_capture_remap_bindings(&bind);
+                sg_apply_bindings(&bind);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_APPLY_UNIFORMS: {
+            sg_shader_stage stage = SG_SHADERSTAGE_VS;
+            int ub_index = 0;
+            sg_range data;
+            _sg_capture_xfer(s, &stage, sizeof(stage));
+            _sg_capture_xfer(s, &ub_index, sizeof(ub_index));
+            _sg_capture_xfer_range(s, &data);
+            if (!s->error) {
+                sg_apply_uniforms(stage, ub_index, &data);
+            }
+        } break;
+        case _SG_CAPTURE_CMD_DRAW: {
+            int args[3] = { 0 };
+            _sg_capture_xfer(s, args, sizeof(args));
+            if (!s->error) {
+                sg_draw(args[0], args[1], args[2]);
+                _sg_capture.replay.info.num_draws++;
+            }
+        } break;
+        case _SG_CAPTURE_CMD_BEGIN_QUERY:
+            sg_begin_query(_sg_capture_query(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_END_QUERY:
+            sg_end_query();
+            break;
+        case _SG_CAPTURE_CMD_BEGIN_CONDITIONAL_RENDER:
+            sg_begin_conditional_render(_sg_capture_query(_sg_capture_read_id(s)));
+            break;
+        case _SG_CAPTURE_CMD_END_CONDITIONAL_RENDER:
+            sg_end_conditional_render();
+            break;
+        case _SG_CAPTURE_CMD_END_PASS:
+            sg_end_pass();
+            break;
+        case _SG_CAPTURE_CMD_COMMIT:
+            sg_commit();
+            _sg_capture.replay.info.num_frames++;
+            break;
+        case _SG_CAPTURE_CMD_PUSH_DEBUG_GROUP: {
+            const char* name = 0;
+            _sg_capture_xfer_str(s, &name);
+            if (!s->error) {
+                sg_push_debug_group(name ? name : "");
+            }
+        } break;
+        case _SG_CAPTURE_CMD_POP_DEBUG_GROUP:
+            sg_pop_debug_group();
+            break;
+        default:
+            /* unknown command, skip */
+            return !s->error;
+    }
+    _sg_capture.replay.info.num_calls++;
+    return !s->error;
+}
+
+_SOKOL_PRIVATE void _sg_capture_replay_destroy_resources(void) {
+    _sg_capture_id_maps_t* ids = &_sg_capture.replay.ids;
+    for (int i = 0; i < ids->passes.size; i++) {
+        sg_destroy_pass(_sg_capture_pass(ids->passes.captured_ids[i]));
+    }
+    for (int i = 0; i < ids->pipelines.size; i++) {
+        sg_destroy_pipeline(_sg_capture_pipeline(ids->pipelines.captured_ids[i]));
+    }
+    for (int i = 0; i < ids->shaders.size; i++) {
+        sg_destroy_shader(_sg_capture_shader(ids->shaders.captured_ids[i]));
+    }
+    for (int i = 0; i < ids->images.size; i++) {
+        sg_destroy_image(_sg_capture_image(ids->images.captured_ids[i]));
+    }
+    for (int i = 0; i < ids->queries.size; i++) {
+        sg_destroy_query(_sg_capture_query(ids->queries.captured_ids[i]));
+    }
+    for (int i = 0; i < ids->buffers.size; i++) {
+        sg_destroy_buffer(_sg_capture_buffer(ids->buffers.captured_ids[i]));
+    }
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void sg_capture_setup(const sg_capture_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(sg_isvalid());
+    memset(&_sg_capture, 0, sizeof(_sg_capture));
+    _sg_capture.desc = *desc;
+    _sg_capture.desc.buffer_size = _sg_capture_def(_sg_capture.desc.buffer_size, _SG_CAPTURE_DEFAULT_BUFFER_SIZE);
+    SOKOL_ASSERT(_sg_capture.desc.buffer_size > (int)sizeof(_sg_capture_header_t));
+    _sg_capture.stream.writing = true;
+    _sg_capture.stream.size = (size_t)_sg_capture.desc.buffer_size;
+    _sg_capture.stream.wbuf = (uint8_t*) SOKOL_MALLOC(_sg_capture.stream.size);
+    SOKOL_ASSERT(_sg_capture.stream.wbuf);
+    _sg_capture_write_header();
+    _sg_capture.init_cookie = _SG_CAPTURE_INIT_COOKIE;
+
+    /* hook into sokol_gfx functions */
+    sg_trace_hooks hooks;
+    memset(&hooks, 0, sizeof(hooks));
+    hooks.reset_state_cache = _sg_capture_reset_state_cache;
+    hooks.make_buffer = _sg_capture_make_buffer;
+    hooks.make_image = _sg_capture_make_image;
+    hooks.make_shader = _sg_capture_make_shader;
+    hooks.make_pipeline = _sg_capture_make_pipeline;
+    hooks.make_pass = _sg_capture_make_pass;
+    hooks.make_query = _sg_capture_make_query;
+    hooks.destroy_buffer = _sg_capture_destroy_buffer;
+    hooks.destroy_image = _sg_capture_destroy_image;
+    hooks.destroy_shader = _sg_capture_destroy_shader;
+    hooks.destroy_pipeline = _sg_capture_destroy_pipeline;
+    hooks.destroy_pass = _sg_capture_destroy_pass;
+    hooks.destroy_query = _sg_capture_destroy_query;
+    hooks.update_buffer = _sg_capture_update_buffer;
+    hooks.update_image = _sg_capture_update_image;
+    hooks.update_image_mip = _sg_capture_update_image_mip;
+    hooks.append_buffer = _sg_capture_append_buffer;
+    hooks.begin_default_pass = _sg_capture_begin_default_pass;
+    hooks.begin_swapchain_pass = _sg_capture_begin_swapchain_pass;
+    hooks.begin_pass = _sg_capture_begin_pass;
+    hooks.apply_viewport = _sg_capture_apply_viewport;
+    hooks.apply_scissor_rect = _sg_capture_apply_scissor_rect;
+    hooks.apply_pipeline = _sg_capture_apply_pipeline;
+    hooks.apply_bindings = _sg_capture_apply_bindings;
+    hooks.apply_uniforms = _sg_capture_apply_uniforms;
+    hooks.draw = _sg_capture_draw;
+    hooks.begin_query = _sg_capture_begin_query;
+    hooks.end_query = _sg_capture_end_query;
+    hooks.begin_conditional_render = _sg_capture_begin_conditional_render;
+    hooks.end_conditional_render = _sg_capture_end_conditional_render;
+    hooks.end_pass = _sg_capture_end_pass;
+    hooks.commit = _sg_capture_commit;
+    hooks.alloc_buffer = _sg_capture_alloc_buffer;
+    hooks.alloc_image = _sg_capture_alloc_image;
+    hooks.alloc_shader = _sg_capture_alloc_shader;
+    hooks.alloc_pipeline = _sg_capture_alloc_pipeline;
+    hooks.alloc_pass = _sg_capture_alloc_pass;
+    hooks.dealloc_buffer = _sg_capture_dealloc_buffer;
+    hooks.dealloc_image = _sg_capture_dealloc_image;
+    hooks.dealloc_shader = _sg_capture_dealloc_shader;
+    hooks.dealloc_pipeline = _sg_capture_dealloc_pipeline;
+    hooks.dealloc_pass = _sg_capture_dealloc_pass;
+    hooks.init_buffer = _sg_capture_init_buffer;
+    hooks.init_image = _sg_capture_init_image;
+    hooks.init_shader = _sg_capture_init_shader;
+    hooks.init_pipeline = _sg_capture_init_pipeline;
+    hooks.init_pass = _sg_capture_init_pass;
+    hooks.uninit_buffer = _sg_capture_uninit_buffer;
+    hooks.uninit_image = _sg_capture_uninit_image;
+    hooks.uninit_shader = _sg_capture_uninit_shader;
+    hooks.uninit_pipeline = _sg_capture_uninit_pipeline;
+    hooks.uninit_pass = _sg_capture_uninit_pass;
+    hooks.fail_buffer = _sg_capture_fail_buffer;
+    hooks.fail_image = _sg_capture_fail_image;
+    hooks.fail_shader = _sg_capture_fail_shader;
+    hooks.fail_pipeline = _sg_capture_fail_pipeline;
+    hooks.fail_pass = _sg_capture_fail_pass;
+    hooks.push_debug_group = _sg_capture_push_debug_group;
+    hooks.pop_debug_group = _sg_capture_pop_debug_group;
+    _sg_capture.hooks = sg_install_trace_hooks(&hooks);
+}
+
+SOKOL_API_IMPL void sg_capture_shutdown(void) {
+    SOKOL_ASSERT(_SG_CAPTURE_INIT_COOKIE == _sg_capture.init_cookie);
+    /* restore original trace hooks */
+    sg_install_trace_hooks(&_sg_capture.hooks);
+    SOKOL_FREE(_sg_capture.stream.wbuf);
+    _sg_capture.stream.wbuf = 0;
+    _sg_capture.init_cookie = 0;
+}
+
+SOKOL_API_IMPL void sg_capture_frames(int num_frames) {
+    SOKOL_ASSERT(_SG_CAPTURE_INIT_COOKIE == _sg_capture.init_cookie);
+    SOKOL_ASSERT(num_frames >= 0);
+    if (!_sg_capture.overflow) {
+        _sg_capture.frames_to_capture = num_frames;
+    }
+}
+
+SOKOL_API_IMPL bool sg_capture_active(void) {
+    SOKOL_ASSERT(_SG_CAPTURE_INIT_COOKIE == _sg_capture.init_cookie);
+    return _sg_capture.frames_to_capture > 0;
+}
+
+SOKOL_API_IMPL bool sg_capture_overflow(void) {
+    SOKOL_ASSERT(_SG_CAPTURE_INIT_COOKIE == _sg_capture.init_cookie);
+    return _sg_capture.overflow;
+}
+
+SOKOL_API_IMPL sg_range sg_capture_data(void) {
+    SOKOL_ASSERT(_SG_CAPTURE_INIT_COOKIE == _sg_capture.init_cookie);
+    sg_range res = { _sg_capture.stream.wbuf, _sg_capture.stream.pos };
+    return res;
+}
+
+SOKOL_API_IMPL bool sg_capture_replay_begin(const sg_range* data) {
+    SOKOL_ASSERT(data && data->ptr);
+    SOKOL_ASSERT(!_sg_capture.replay.active);
+    _sg_capture_header_t hdr;
+    if (data->size < sizeof(hdr)) {
+        SOKOL_LOG("sg_capture_replay_begin(): data too small");
+        return false;
+    }
+    memcpy(&hdr, data->ptr, sizeof(hdr));
+    if ((hdr.magic != _SG_CAPTURE_MAGIC) || (hdr.version != _SG_CAPTURE_VERSION)) {
+        SOKOL_LOG("sg_capture_replay_begin(): not a sokol_gfx_capture.h stream, or version mismatch");
+        return false;
+    }
+    if ((hdr.ptr_size != sizeof(void*)) ||
+        (hdr.buffer_desc_size != sizeof(sg_buffer_desc)) ||
+        (hdr.image_desc_size != sizeof(sg_image_desc)) ||
+        (hdr.shader_desc_size != sizeof(sg_shader_desc)) ||
+        (hdr.pipeline_desc_size != sizeof(sg_pipeline_desc)) ||
+        (hdr.pass_desc_size != sizeof(sg_pass_desc)) ||
+        (hdr.query_desc_size != sizeof(sg_query_object_desc)) ||
+        (hdr.bindings_size != sizeof(sg_bindings)) ||
+        (hdr.pass_action_size != sizeof(sg_pass_action)))
+    {
+        SOKOL_LOG("sg_capture_replay_begin(): stream was captured with a different sokol_gfx.h version or CPU architecture");
+        return false;
+    }
+    /* the pool sizes only size the id remapping tables, but come from
+       untrusted data, so reject anything that sokol_gfx.h can't have written
+    */
+    if (!_sg_capture_valid_pool_size(hdr.buffer_pool_size) ||
+        !_sg_capture_valid_pool_size(hdr.image_pool_size) ||
+        !_sg_capture_valid_pool_size(hdr.shader_pool_size) ||
+        !_sg_capture_valid_pool_size(hdr.pipeline_pool_size) ||
+        !_sg_capture_valid_pool_size(hdr.pass_pool_size) ||
+        !_sg_capture_valid_pool_size(hdr.query_pool_size))
+    {
+        SOKOL_LOG("sg_capture_replay_begin(): invalid resource pool sizes in stream header");
+        return false;
+    }
+    memset(&_sg_capture.replay, 0, sizeof(_sg_capture.replay));
+    _sg_capture.replay.stream.rbuf = (const uint8_t*) data->ptr;
+    _sg_capture.replay.stream.size = data->size;
+    _sg_capture.replay.stream.pos = _sg_capture_roundup(sizeof(hdr), _SG_CAPTURE_BLOB_ALIGN);
+    _sg_capture_id_maps_t* ids = &_sg_capture.replay.ids;
+    if (!_sg_capture_id_map_init(&ids->buffers, hdr.buffer_pool_size) ||
+        !_sg_capture_id_map_init(&ids->images, hdr.image_pool_size) ||
+        !_sg_capture_id_map_init(&ids->shaders, hdr.shader_pool_size) ||
+        !_sg_capture_id_map_init(&ids->pipelines, hdr.pipeline_pool_size) ||
+        !_sg_capture_id_map_init(&ids->passes, hdr.pass_pool_size) ||
+        !_sg_capture_id_map_init(&ids->queries, hdr.query_pool_size))
+    {
+        SOKOL_LOG("sg_capture_replay_begin(): failed to allocate id remapping tables");
+        _sg_capture_discard_id_maps(ids);
+        return false;
+    }
+    _sg_capture.replay.active = true;
+    return true;
+}
+
+SOKOL_API_IMPL bool sg_capture_replay_frame(void) {
+    SOKOL_ASSERT(_sg_capture.replay.active);
+    _sg_capture_stream_t* s = &_sg_capture.replay.stream;
+    bool replayed = false;
+    while (!s->error && ((s->pos + sizeof(_sg_capture_record_t)) <= s->size)) {
+        _sg_capture_record_t rec;
+        _sg_capture_xfer(s, &rec, sizeof(rec));
+        const size_t end = s->pos + rec.size;
+        if (end > s->size) {
+            s->error = true;
+            break;
+        }
+        /* bound all reads of the record's arguments by the record size, so
+           that a damaged record can't consume data of the following records
+        */
+        const size_t stream_size = s->size;
+        s->size = end;
+        const bool rec_ok = _sg_capture_replay_record(s, (_sg_capture_cmd_t)rec.cmd);
+        s->size = stream_size;
+        if (!rec_ok) {
+            s->error = true;
+            SOKOL_LOG("sg_capture_replay_frame(): damaged stream");
+            break;
+        }
+        s->pos = end;
+        replayed = true;
+        if (rec.cmd == _SG_CAPTURE_CMD_COMMIT) {
+            break;
+        }
+    }
+    return replayed;
+}
+
+SOKOL_API_IMPL sg_capture_replay_info_t sg_capture_replay_info(void) {
+    return _sg_capture.replay.info;
+}
+
+SOKOL_API_IMPL void sg_capture_replay_end(void) {
+    SOKOL_ASSERT(_sg_capture.replay.active);
+    _sg_capture_replay_destroy_resources();
+    _sg_capture_discard_id_maps(&_sg_capture.replay.ids);
+    _sg_capture.replay.active = false;
+}
+
+#endif /* SOKOL_GFX_CAPTURE_IMPL */
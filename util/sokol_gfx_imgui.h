@@ -280,15 +280,19 @@ typedef enum sg_imgui_cmd_t {
     SG_IMGUI_CMD_MAKE_SHADER,
     SG_IMGUI_CMD_MAKE_PIPELINE,
     SG_IMGUI_CMD_MAKE_PASS,
+    SG_IMGUI_CMD_MAKE_QUERY,
     SG_IMGUI_CMD_DESTROY_BUFFER,
     SG_IMGUI_CMD_DESTROY_IMAGE,
     SG_IMGUI_CMD_DESTROY_SHADER,
     SG_IMGUI_CMD_DESTROY_PIPELINE,
     SG_IMGUI_CMD_DESTROY_PASS,
+    SG_IMGUI_CMD_DESTROY_QUERY,
     SG_IMGUI_CMD_UPDATE_BUFFER,
     SG_IMGUI_CMD_UPDATE_IMAGE,
+    SG_IMGUI_CMD_UPDATE_IMAGE_MIP,
     SG_IMGUI_CMD_APPEND_BUFFER,
     SG_IMGUI_CMD_BEGIN_DEFAULT_PASS,
+    SG_IMGUI_CMD_BEGIN_SWAPCHAIN_PASS,
     SG_IMGUI_CMD_BEGIN_PASS,
     SG_IMGUI_CMD_APPLY_VIEWPORT,
     SG_IMGUI_CMD_APPLY_SCISSOR_RECT,
@@ -296,6 +300,10 @@ typedef enum sg_imgui_cmd_t {
     SG_IMGUI_CMD_APPLY_BINDINGS,
     SG_IMGUI_CMD_APPLY_UNIFORMS,
     SG_IMGUI_CMD_DRAW,
+    SG_IMGUI_CMD_BEGIN_QUERY,
+    SG_IMGUI_CMD_END_QUERY,
+    SG_IMGUI_CMD_BEGIN_CONDITIONAL_RENDER,
+    SG_IMGUI_CMD_END_CONDITIONAL_RENDER,
     SG_IMGUI_CMD_END_PASS,
     SG_IMGUI_CMD_COMMIT,
     SG_IMGUI_CMD_ALLOC_BUFFER,
@@ -330,6 +338,7 @@ typedef enum sg_imgui_cmd_t {
     SG_IMGUI_CMD_ERR_SHADER_POOL_EXHAUSTED,
     SG_IMGUI_CMD_ERR_PIPELINE_POOL_EXHAUSTED,
     SG_IMGUI_CMD_ERR_PASS_POOL_EXHAUSTED,
+    SG_IMGUI_CMD_ERR_QUERY_POOL_EXHAUSTED,
     SG_IMGUI_CMD_ERR_CONTEXT_MISMATCH,
     SG_IMGUI_CMD_ERR_PASS_INVALID,
     SG_IMGUI_CMD_ERR_DRAW_INVALID,
@@ -356,6 +365,10 @@ typedef struct sg_imgui_args_make_pass_t {
     sg_pass result;
 } sg_imgui_args_make_pass_t;
 
+typedef struct sg_imgui_args_make_query_t {
+    sg_query result;
+} sg_imgui_args_make_query_t;
+
 typedef struct sg_imgui_args_destroy_buffer_t {
     sg_buffer buffer;
 } sg_imgui_args_destroy_buffer_t;
@@ -376,6 +389,10 @@ typedef struct sg_imgui_args_destroy_pass_t {
     sg_pass pass;
 } sg_imgui_args_destroy_pass_t;
 
+typedef struct sg_imgui_args_destroy_query_t {
+    sg_query query;
+} sg_imgui_args_destroy_query_t;
+
 typedef struct sg_imgui_args_update_buffer_t {
     sg_buffer buffer;
     size_t data_size;
@@ -385,6 +402,11 @@ typedef struct sg_imgui_args_update_image_t {
     sg_image image;
 } sg_imgui_args_update_image_t;
 
+typedef struct sg_imgui_args_update_image_mip_t {
+    sg_image image;
+    int mip_index;
+} sg_imgui_args_update_image_mip_t;
+
 typedef struct sg_imgui_args_append_buffer_t {
     sg_buffer buffer;
     size_t data_size;
@@ -397,6 +419,12 @@ typedef struct sg_imgui_args_begin_default_pass_t {
     int height;
 } sg_imgui_args_begin_default_pass_t;
 
+typedef struct sg_imgui_args_begin_swapchain_pass_t {
+    sg_pass_action action;
+    int width;
+    int height;
+} sg_imgui_args_begin_swapchain_pass_t;
+
 typedef struct sg_imgui_args_begin_pass_t {
     sg_pass pass;
     sg_pass_action action;
@@ -534,6 +562,14 @@ typedef struct sg_imgui_args_fail_pass_t {
     sg_pass pass;
 } sg_imgui_args_fail_pass_t;
 
+typedef struct sg_imgui_args_begin_query_t {
+    sg_query query;
+} sg_imgui_args_begin_query_t;
+
+typedef struct sg_imgui_args_begin_conditional_render_t {
+    sg_query query;
+} sg_imgui_args_begin_conditional_render_t;
+
 typedef struct sg_imgui_args_push_debug_group_t {
     sg_imgui_str_t name;
 } sg_imgui_args_push_debug_group_t;
@@ -544,15 +580,19 @@ typedef union sg_imgui_args_t {
     sg_imgui_args_make_shader_t make_shader;
     sg_imgui_args_make_pipeline_t make_pipeline;
     sg_imgui_args_make_pass_t make_pass;
+    sg_imgui_args_make_query_t make_query;
     sg_imgui_args_destroy_buffer_t destroy_buffer;
     sg_imgui_args_destroy_image_t destroy_image;
     sg_imgui_args_destroy_shader_t destroy_shader;
     sg_imgui_args_destroy_pipeline_t destroy_pipeline;
     sg_imgui_args_destroy_pass_t destroy_pass;
+    sg_imgui_args_destroy_query_t destroy_query;
     sg_imgui_args_update_buffer_t update_buffer;
     sg_imgui_args_update_image_t update_image;
+    sg_imgui_args_update_image_mip_t update_image_mip;
     sg_imgui_args_append_buffer_t append_buffer;
     sg_imgui_args_begin_default_pass_t begin_default_pass;
+    sg_imgui_args_begin_swapchain_pass_t begin_swapchain_pass;
     sg_imgui_args_begin_pass_t begin_pass;
     sg_imgui_args_apply_viewport_t apply_viewport;
     sg_imgui_args_apply_scissor_rect_t apply_scissor_rect;
@@ -560,6 +600,8 @@ typedef union sg_imgui_args_t {
     sg_imgui_args_apply_bindings_t apply_bindings;
     sg_imgui_args_apply_uniforms_t apply_uniforms;
     sg_imgui_args_draw_t draw;
+    sg_imgui_args_begin_query_t begin_query;
+    sg_imgui_args_begin_conditional_render_t begin_conditional_render;
     sg_imgui_args_alloc_buffer_t alloc_buffer;
     sg_imgui_args_alloc_image_t alloc_image;
     sg_imgui_args_alloc_shader_t alloc_shader;
@@ -1624,6 +1666,10 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             }
             break;
 
+        case SG_IMGUI_CMD_MAKE_QUERY:
+            _sg_imgui_snprintf(&str, "%d: sg_make_query(desc=..) => 0x%08X", index, item->args.make_query.result.id);
+            break;
+
         case SG_IMGUI_CMD_DESTROY_BUFFER:
             {
                 sg_imgui_str_t res_id = _sg_imgui_buffer_id_string(ctx, item->args.destroy_buffer.buffer);
@@ -1659,6 +1705,10 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             }
             break;
 
+        case SG_IMGUI_CMD_DESTROY_QUERY:
+            _sg_imgui_snprintf(&str, "%d: sg_destroy_query(qry=0x%08X)", index, item->args.destroy_query.query.id);
+            break;
+
         case SG_IMGUI_CMD_UPDATE_BUFFER:
             {
                 sg_imgui_str_t res_id = _sg_imgui_buffer_id_string(ctx, item->args.update_buffer.buffer);
@@ -1675,6 +1725,15 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             }
             break;
 
+        case SG_IMGUI_CMD_UPDATE_IMAGE_MIP:
+            {
+                sg_imgui_str_t res_id = _sg_imgui_image_id_string(ctx, item->args.update_image_mip.image);
+                _sg_imgui_snprintf(&str, "%d: sg_update_image_mip(img=%s, mip_index=%d, data=..)",
+                    index, res_id.buf,
+                    item->args.update_image_mip.mip_index);
+            }
+            break;
+
         case SG_IMGUI_CMD_APPEND_BUFFER:
             {
                 sg_imgui_str_t res_id = _sg_imgui_buffer_id_string(ctx, item->args.append_buffer.buffer);
@@ -1692,6 +1751,13 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
                 item->args.begin_default_pass.height);
             break;
 
+        case SG_IMGUI_CMD_BEGIN_SWAPCHAIN_PASS:
+            _sg_imgui_snprintf(&str, "%d: sg_begin_swapchain_pass(swapchain=.., pass_action=..) (width=%d, height=%d)",
+                index,
+                item->args.begin_swapchain_pass.width,
+                item->args.begin_swapchain_pass.height);
+            break;
+
         case SG_IMGUI_CMD_BEGIN_PASS:
             {
                 sg_imgui_str_t res_id = _sg_imgui_pass_id_string(ctx, item->args.begin_pass.pass);
@@ -1746,6 +1812,22 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
                 item->args.draw.num_instances);
             break;
 
+        case SG_IMGUI_CMD_BEGIN_QUERY:
+            _sg_imgui_snprintf(&str, "%d: sg_begin_query(qry=0x%08X)", index, item->args.begin_query.query.id);
+            break;
+
+        case SG_IMGUI_CMD_END_QUERY:
+            _sg_imgui_snprintf(&str, "%d: sg_end_query()", index);
+            break;
+
+        case SG_IMGUI_CMD_BEGIN_CONDITIONAL_RENDER:
+            _sg_imgui_snprintf(&str, "%d: sg_begin_conditional_render(qry=0x%08X)", index, item->args.begin_conditional_render.query.id);
+            break;
+
+        case SG_IMGUI_CMD_END_CONDITIONAL_RENDER:
+            _sg_imgui_snprintf(&str, "%d: sg_end_conditional_render()", index);
+            break;
+
         case SG_IMGUI_CMD_END_PASS:
             _sg_imgui_snprintf(&str, "%d: sg_end_pass()", index);
             break;
@@ -1958,6 +2040,10 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             _sg_imgui_snprintf(&str, "%d: sg_err_pass_pool_exhausted()", index);
             break;
 
+        case SG_IMGUI_CMD_ERR_QUERY_POOL_EXHAUSTED:
+            _sg_imgui_snprintf(&str, "%d: sg_err_query_pool_exhausted()", index);
+            break;
+
         case SG_IMGUI_CMD_ERR_CONTEXT_MISMATCH:
             _sg_imgui_snprintf(&str, "%d: sg_err_context_mismatch()", index);
             break;
@@ -2080,6 +2166,20 @@ _SOKOL_PRIVATE void _sg_imgui_make_pass(const sg_pass_desc* desc, sg_pass pass_i
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_make_query(const sg_query_object_desc* desc, sg_query qry_id, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_MAKE_QUERY;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.make_query.result = qry_id;
+    }
+    if (ctx->hooks.make_query) {
+        ctx->hooks.make_query(desc, qry_id, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_destroy_buffer(sg_buffer buf, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2165,6 +2265,20 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_pass(sg_pass pass, void* user_data) {
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_destroy_query(sg_query qry, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_DESTROY_QUERY;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.destroy_query.query = qry;
+    }
+    if (ctx->hooks.destroy_query) {
+        ctx->hooks.destroy_query(qry, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_update_buffer(sg_buffer buf, const sg_range* data, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2194,6 +2308,21 @@ _SOKOL_PRIVATE void _sg_imgui_update_image(sg_image img, const sg_image_data* da
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_update_image_mip(sg_image img, int mip_index, const sg_image_data* data, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_UPDATE_IMAGE_MIP;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.update_image_mip.image = img;
+        item->args.update_image_mip.mip_index = mip_index;
+    }
+    if (ctx->hooks.update_image_mip) {
+        ctx->hooks.update_image_mip(img, mip_index, data, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_append_buffer(sg_buffer buf, const sg_range* data, int result, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2227,6 +2356,23 @@ _SOKOL_PRIVATE void _sg_imgui_begin_default_pass(const sg_pass_action* pass_acti
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_begin_swapchain_pass(const sg_swapchain* swapchain, const sg_pass_action* pass_action, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        SOKOL_ASSERT(swapchain && pass_action);
+        item->cmd = SG_IMGUI_CMD_BEGIN_SWAPCHAIN_PASS;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.begin_swapchain_pass.action = *pass_action;
+        item->args.begin_swapchain_pass.width = swapchain->width;
+        item->args.begin_swapchain_pass.height = swapchain->height;
+    }
+    if (ctx->hooks.begin_swapchain_pass) {
+        ctx->hooks.begin_swapchain_pass(swapchain, pass_action, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_begin_pass(sg_pass pass, const sg_pass_action* pass_action, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2345,6 +2491,60 @@ _SOKOL_PRIVATE void _sg_imgui_draw(int base_element, int num_elements, int num_i
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_begin_query(sg_query qry, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_BEGIN_QUERY;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.begin_query.query = qry;
+    }
+    if (ctx->hooks.begin_query) {
+        ctx->hooks.begin_query(qry, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_end_query(void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_END_QUERY;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+    }
+    if (ctx->hooks.end_query) {
+        ctx->hooks.end_query(ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_begin_conditional_render(sg_query qry, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_BEGIN_CONDITIONAL_RENDER;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.begin_conditional_render.query = qry;
+    }
+    if (ctx->hooks.begin_conditional_render) {
+        ctx->hooks.begin_conditional_render(qry, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_end_conditional_render(void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_END_CONDITIONAL_RENDER;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+    }
+    if (ctx->hooks.end_conditional_render) {
+        ctx->hooks.end_conditional_render(ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_end_pass(void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2845,6 +3045,19 @@ _SOKOL_PRIVATE void _sg_imgui_err_pass_pool_exhausted(void* user_data) {
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_err_query_pool_exhausted(void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_ERR_QUERY_POOL_EXHAUSTED;
+        item->color = _SG_IMGUI_COLOR_ERR;
+    }
+    if (ctx->hooks.err_query_pool_exhausted) {
+        ctx->hooks.err_query_pool_exhausted(ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_err_context_mismatch(void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -3649,6 +3862,9 @@ _SOKOL_PRIVATE void _sg_imgui_draw_passaction_panel(sg_imgui_t* ctx, sg_pass pas
                 igText("    SG_ACTION_CLEAR: %s", _sg_imgui_color_string(&color_str, c_att->value));
                 break;
         }
+        if (c_att->dont_resolve) {
+            igText("    dont_resolve");
+        }
     }
     const sg_depth_attachment_action* d_att = &action->depth;
     igText("  Depth Attachment:");
@@ -3725,6 +3941,12 @@ _SOKOL_PRIVATE void _sg_imgui_draw_capture_panel(sg_imgui_t* ctx) {
                 _sg_imgui_draw_passaction_panel(ctx, inv_pass, &item->args.begin_default_pass.action);
             }
             break;
+        case SG_IMGUI_CMD_BEGIN_SWAPCHAIN_PASS:
+            {
+                sg_pass inv_pass = { SG_INVALID_ID };
+                _sg_imgui_draw_passaction_panel(ctx, inv_pass, &item->args.begin_swapchain_pass.action);
+            }
+            break;
         case SG_IMGUI_CMD_BEGIN_PASS:
             _sg_imgui_draw_passaction_panel(ctx, item->args.begin_pass.pass, &item->args.begin_pass.action);
             igSeparator();
@@ -3853,15 +4075,19 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     hooks.make_shader = _sg_imgui_make_shader;
     hooks.make_pipeline = _sg_imgui_make_pipeline;
     hooks.make_pass = _sg_imgui_make_pass;
+    hooks.make_query = _sg_imgui_make_query;
     hooks.destroy_buffer = _sg_imgui_destroy_buffer;
     hooks.destroy_image = _sg_imgui_destroy_image;
     hooks.destroy_shader = _sg_imgui_destroy_shader;
     hooks.destroy_pipeline = _sg_imgui_destroy_pipeline;
     hooks.destroy_pass = _sg_imgui_destroy_pass;
+    hooks.destroy_query = _sg_imgui_destroy_query;
     hooks.update_buffer = _sg_imgui_update_buffer;
     hooks.update_image = _sg_imgui_update_image;
+    hooks.update_image_mip = _sg_imgui_update_image_mip;
     hooks.append_buffer = _sg_imgui_append_buffer;
     hooks.begin_default_pass = _sg_imgui_begin_default_pass;
+    hooks.begin_swapchain_pass = _sg_imgui_begin_swapchain_pass;
     hooks.begin_pass = _sg_imgui_begin_pass;
     hooks.apply_viewport = _sg_imgui_apply_viewport;
     hooks.apply_scissor_rect = _sg_imgui_apply_scissor_rect;
@@ -3869,6 +4095,10 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     hooks.apply_bindings = _sg_imgui_apply_bindings;
     hooks.apply_uniforms = _sg_imgui_apply_uniforms;
     hooks.draw = _sg_imgui_draw;
+    hooks.begin_query = _sg_imgui_begin_query;
+    hooks.end_query = _sg_imgui_end_query;
+    hooks.begin_conditional_render = _sg_imgui_begin_conditional_render;
+    hooks.end_conditional_render = _sg_imgui_end_conditional_render;
     hooks.end_pass = _sg_imgui_end_pass;
     hooks.commit = _sg_imgui_commit;
     hooks.alloc_buffer = _sg_imgui_alloc_buffer;
@@ -3903,6 +4133,7 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     hooks.err_shader_pool_exhausted = _sg_imgui_err_shader_pool_exhausted;
     hooks.err_pipeline_pool_exhausted = _sg_imgui_err_pipeline_pool_exhausted;
     hooks.err_pass_pool_exhausted = _sg_imgui_err_pass_pool_exhausted;
+    hooks.err_query_pool_exhausted = _sg_imgui_err_query_pool_exhausted;
     hooks.err_context_mismatch = _sg_imgui_err_context_mismatch;
     hooks.err_pass_invalid = _sg_imgui_err_pass_invalid;
     hooks.err_draw_invalid = _sg_imgui_err_draw_invalid;
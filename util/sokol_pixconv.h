@@ -0,0 +1,911 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_PIXCONV_IMPL)
+#define SOKOL_PIXCONV_IMPL
+#endif
+#ifndef SOKOL_PIXCONV_INCLUDED
+/*
+    sokol_pixconv.h -- pixel format conversion for sokol_gfx.h image uploads
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_PIXCONV_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_pixconv.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)             - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)             - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)               - your own free function (default: free(p))
+    SOKOL_PIXCONV_NO_SIMD       - only use the plain C conversion code
+    SOKOL_PIXCONV_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_DECL              - same as SOKOL_PIXCONV_API_DECL
+    SOKOL_API_IMPL              - public function implementation prefix (default: -)
+
+    If sokol_pixconv.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_PIXCONV_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_pixconv.h converts pixel data from common 'application side'
+    formats into the sokol_gfx.h pixel formats, for instance RGB8 into
+    RGBA8, 32-bit floats into SG_PIXELFORMAT_RGBA16F, or sRGB-encoded
+    colors into linear color values.
+
+    The conversion functions can be used standalone, or through
+    spc_update_image() which converts the data into the pixel format
+    of a dynamic or stream-update image and then calls sg_update_image().
+
+    SIMD SUPPORT
+    ============
+    The performance critical conversions have SSE2, SSSE3, AVX2 and NEON
+    code paths, which are selected at compile time from the target
+    instruction set predefined by the compiler (e.g. -msse2, -mavx2,
+    /arch:AVX2 or the ARM NEON defaults), with a plain C fallback for
+    all other targets:
+
+        - float to half-float: SSE2, F16C (-mf16c, or /arch:AVX2 on MSVC),
+          NEON (only on 64-bit ARM)
+        - unorm8 to float: SSE2, AVX2, NEON
+        - float to unorm8: SSE2, NEON
+        - RGB8 to RGBA8: SSSE3, NEON
+        - RGBA8 to BGRA8 (and back): SSE2, NEON
+
+    The sRGB-to-linear conversions and unorm8 to half-float are done
+    with lookup tables which are initialized in spc_setup().
+
+    Define SOKOL_PIXCONV_NO_SIMD before including the implementation
+    to only use the plain C code (for instance to compare the results
+    or performance). The throughput benchmark in bench/pixconvbench.c
+    does exactly this (run it with 'make run-pixconv' in bench/).
+
+    The SIMD and plain C code paths produce the same results, except for
+    the half-float conversion of NaN values when the F16C or NEON
+    path is used (the hardware preserves the NaN payload).
+
+    STEP-BY-STEP
+    ============
+    Call spc_setup() once (it's not necessary to call sg_setup() before
+    if you only need the standalone conversion functions):
+
+        spc_setup(&(spc_desc_t){0});
+
+    To convert pixel data into a buffer provided by you, call:
+
+        bool spc_convert(spc_format src_fmt, const void* src, sg_pixel_format dst_fmt, void* dst, size_t num_pixels)
+
+    The source pixel format is one of:
+
+        SPC_FORMAT_R8       - 1 byte per pixel
+        SPC_FORMAT_RG8      - 2 bytes per pixel
+        SPC_FORMAT_RGB8     - 3 bytes per pixel
+        SPC_FORMAT_RGBA8    - 4 bytes per pixel
+        SPC_FORMAT_BGRA8    - 4 bytes per pixel, red and blue swapped
+        SPC_FORMAT_SRGB8    - 3 bytes per pixel, sRGB encoded
+        SPC_FORMAT_SRGBA8   - 4 bytes per pixel, sRGB encoded color, linear alpha
+        SPC_FORMAT_R32F     - 1 float per pixel
+        SPC_FORMAT_RG32F    - 2 floats per pixel
+        SPC_FORMAT_RGB32F   - 3 floats per pixel
+        SPC_FORMAT_RGBA32F  - 4 floats per pixel
+
+    The supported conversions are:
+
+        R8              => R8, R16F, R32F
+        RG8             => RG8, RG16F, RG32F
+        RGB8, SRGB8     => RGBA8, RGBA16F, RGBA32F
+        RGBA8, SRGBA8   => RGBA8, BGRA8, RGBA16F, RGBA32F
+        BGRA8           => RGBA8, BGRA8
+        R32F            => R16F, R32F
+        RG32F           => RG16F, RG32F
+        RGB32F          => RGBA16F, RGBA32F
+        RGBA32F         => RGBA8, RGBA16F, RGBA32F
+
+    Missing alpha channels are set to 1.0, and floating point values
+    are clamped to 0.0..1.0 when converted to RGBA8. spc_convert() returns
+    false (and doesn't write the destination) for unsupported conversions,
+    you can also check upfront with:
+
+        bool spc_can_convert(spc_format src_fmt, sg_pixel_format dst_fmt)
+
+    The source and destination buffer must not overlap, and must have
+    room for 'num_pixels' pixels. The byte size of a number of pixels is
+    returned by:
+
+        size_t spc_src_size(spc_format fmt, size_t num_pixels)
+        size_t spc_dst_size(sg_pixel_format fmt, size_t num_pixels)
+
+    To update a dynamic or stream-update image from pixel data in a
+    different format, call spc_update_image() instead of sg_update_image():
+
+        spc_update_image(img, SPC_FORMAT_RGB8, &(sg_image_data){
+            .subimage[0][0] = { .ptr=rgb_pixels, .size=width*height*3 }
+        });
+
+    This converts each subimage into the image's pixel format (as returned
+    by sg_query_image_info()) and calls sg_update_image() with the result.
+    The number of pixels of a subimage is derived from its byte size, so
+    the source rows must be tightly packed. The converted data is kept
+    in an internal scratch buffer which grows as needed (the initial size
+    can be provided in spc_desc_t.scratch_size). If no conversion is
+    needed, sg_update_image() is called with the original data.
+
+    At shutdown, call:
+
+        spc_shutdown();
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_PIXCONV_INCLUDED
+#include <stddef.h>     // size_t
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_pixconv.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_PIXCONV_API_DECL)
+#define SOKOL_PIXCONV_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_PIXCONV_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_PIXCONV_IMPL)
+#define SOKOL_PIXCONV_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_PIXCONV_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_PIXCONV_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum spc_format {
+    SPC_FORMAT_INVALID,
+    SPC_FORMAT_R8,
+    SPC_FORMAT_RG8,
+    SPC_FORMAT_RGB8,
+    SPC_FORMAT_RGBA8,
+    SPC_FORMAT_BGRA8,
+    SPC_FORMAT_SRGB8,
+    SPC_FORMAT_SRGBA8,
+    SPC_FORMAT_R32F,
+    SPC_FORMAT_RG32F,
+    SPC_FORMAT_RGB32F,
+    SPC_FORMAT_RGBA32F,
+    _SPC_FORMAT_NUM,
+    _SPC_FORMAT_FORCE_U32 = 0x7FFFFFFF
+} spc_format;
+
+typedef struct spc_desc_t {
+    size_t scratch_size;        // initial size of the spc_update_image() scratch buffer, default: 0
+} spc_desc_t;
+
+SOKOL_PIXCONV_API_DECL void spc_setup(const spc_desc_t* desc);
+SOKOL_PIXCONV_API_DECL void spc_shutdown(void);
+SOKOL_PIXCONV_API_DECL bool spc_can_convert(spc_format src_fmt, sg_pixel_format dst_fmt);
+SOKOL_PIXCONV_API_DECL size_t spc_src_size(spc_format fmt, size_t num_pixels);
+SOKOL_PIXCONV_API_DECL size_t spc_dst_size(sg_pixel_format fmt, size_t num_pixels);
+SOKOL_PIXCONV_API_DECL bool spc_convert(spc_format src_fmt, const void* src, sg_pixel_format dst_fmt, void* dst, size_t num_pixels);
+SOKOL_PIXCONV_API_DECL bool spc_update_image(sg_image img, spc_format src_fmt, const sg_image_data* data);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_PIXCONV_INCLUDED
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_PIXCONV_IMPL
+#define SOKOL_PIXCONV_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy
+#include <math.h>   // powf
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#if !defined(SOKOL_PIXCONV_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define _SPC_SSE2 (1)
+        #include <emmintrin.h>
+    #endif
+    #if defined(_SPC_SSE2) && (defined(__SSSE3__) || defined(__AVX2__))
+        #define _SPC_SSSE3 (1)
+        #include <tmmintrin.h>
+    #endif
+    #if defined(_SPC_SSE2) && defined(__AVX2__)
+        #define _SPC_AVX2 (1)
+    #endif
+    #if defined(_SPC_SSE2) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+        #define _SPC_F16C (1)
+    #endif
+    #if defined(_SPC_AVX2) || defined(_SPC_F16C)
+        #include <immintrin.h>
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define _SPC_NEON (1)
+        #include <arm_neon.h>
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            #define _SPC_NEON_F16 (1)
+        #endif
+    #endif
+#endif
+
+#define _SPC_INIT_COOKIE (0x5C0FFEE5)
+#define _SPC_CHUNK_PIXELS (256)
+
+typedef struct {
+    uint32_t init_cookie;
+    spc_desc_t desc;
+    uint8_t srgb_to_unorm8[256];
+    uint16_t srgb_to_f16[256];
+    uint16_t unorm8_to_f16[256];
+    float srgb_to_f32[256];
+    float unorm8_to_f32[256];
+    uint8_t* scratch;
+    size_t scratch_size;
+} _spc_state_t;
+static _spc_state_t _spc;
+
+/*=== SCALAR CONVERSION ======================================================*/
+
+// round-to-nearest-even float to half-float conversion without
+// branches on the mantissa, see:
+// https://gist.github.com/rygorous/2156668
+_SOKOL_PRIVATE uint16_t _spc_f32_to_f16_scalar(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    const uint32_t sign = x & 0x80000000;
+    x ^= sign;
+    uint32_t o;
+    if (x >= 0x47800000) {
+        // NaN stays NaN (as quiet NaN), too large values become infinity
+        o = (x > 0x7F800000) ? 0x7E00 : 0x7C00;
+    }
+    else if (x < 0x38800000) {
+        // result is a denormal or zero, let the FPU do the rounding
+        // by adding a magic value (0.5f)
+        float ff;
+        memcpy(&ff, &x, sizeof(ff));
+        ff += 0.5f;
+        memcpy(&o, &ff, sizeof(o));
+        o -= 0x3F000000;
+    }
+    else {
+        const uint32_t mant_odd = (x >> 13) & 1;
+        // rebias exponent and round
+        x += 0xC8000FFF;
+        x += mant_odd;
+        o = x >> 13;
+    }
+    return (uint16_t)(o | (sign >> 16));
+}
+
+_SOKOL_PRIVATE uint8_t _spc_f32_to_unorm8_scalar(float f) {
+    // written so that NaN is mapped to 0
+    if (!(f > 0.0f)) {
+        f = 0.0f;
+    }
+    else if (f > 1.0f) {
+        f = 1.0f;
+    }
+    return (uint8_t)(f * 255.0f + 0.5f);
+}
+
+_SOKOL_PRIVATE float _spc_srgb_to_linear(float c) {
+    if (c <= 0.04045f) {
+        return c / 12.92f;
+    }
+    else {
+        return powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+}
+
+_SOKOL_PRIVATE void _spc_init_tables(void) {
+    for (int i = 0; i < 256; i++) {
+        const float unorm = (float)i * (1.0f / 255.0f);
+        const float lin = _spc_srgb_to_linear((float)i / 255.0f);
+        _spc.unorm8_to_f32[i] = unorm;
+        _spc.unorm8_to_f16[i] = _spc_f32_to_f16_scalar(unorm);
+        _spc.srgb_to_f32[i] = lin;
+        _spc.srgb_to_f16[i] = _spc_f32_to_f16_scalar(lin);
+        _spc.srgb_to_unorm8[i] = _spc_f32_to_unorm8_scalar(lin);
+    }
+}
+
+/*=== CONVERSION KERNELS =====================================================*/
+
+// convert 'num' floats to half-floats
+_SOKOL_PRIVATE void _spc_f32_to_f16(const float* src, uint16_t* dst, size_t num) {
+    size_t i = 0;
+    #if defined(_SPC_F16C)
+        for (; (i + 8) <= num; i += 8) {
+            const __m256 f = _mm256_loadu_ps(src + i);
+            _mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        }
+    #elif defined(_SPC_SSE2)
+        // same algorithm as _spc_f32_to_f16_scalar(), 8 values per iteration
+        const __m128 mask_sign = _mm_set1_ps(-0.0f);
+        const __m128i c_f16max = _mm_set1_epi32(0x47800000);
+        const __m128i c_nanbit = _mm_set1_epi32(0x200);
+        const __m128i c_infty = _mm_set1_epi32(0x7C00);
+        const __m128i c_min_normal = _mm_set1_epi32(0x38800000);
+        const __m128i c_subnorm_magic = _mm_set1_epi32(0x3F000000);
+        const __m128i c_normal_bias = _mm_set1_epi32((int)0xC8000FFF);
+        for (; (i + 8) <= num; i += 8) {
+            __m128i res[2];
+            for (int k = 0; k < 2; k++) {
+                const __m128 f = _mm_loadu_ps(src + i + k * 4);
+                const __m128 justsign = _mm_and_ps(mask_sign, f);
+                const __m128 absf = _mm_xor_ps(f, justsign);
+                const __m128i absf_int = _mm_castps_si128(absf);
+                const __m128 b_isnan = _mm_cmpunord_ps(absf, absf);
+                const __m128i b_isregular = _mm_cmpgt_epi32(c_f16max, absf_int);
+                const __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(_mm_castps_si128(b_isnan), c_nanbit), c_infty);
+                const __m128i b_issub = _mm_cmpgt_epi32(c_min_normal, absf_int);
+                const __m128 subnorm1 = _mm_add_ps(absf, _mm_castsi128_ps(c_subnorm_magic));
+                const __m128i subnorm2 = _mm_sub_epi32(_mm_castps_si128(subnorm1), c_subnorm_magic);
+                const __m128i mantodd = _mm_srai_epi32(_mm_slli_epi32(absf_int, 31 - 13), 31);
+                const __m128i round1 = _mm_add_epi32(absf_int, c_normal_bias);
+                const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(round1, mantodd), 13);
+                const __m128i nonspecial = _mm_or_si128(_mm_and_si128(subnorm2, b_issub), _mm_andnot_si128(b_issub, normal));
+                const __m128i joined = _mm_or_si128(_mm_and_si128(nonspecial, b_isregular), _mm_andnot_si128(b_isregular, inf_or_nan));
+                // the sign shift sign-extends negative values, so that the
+                // signed saturating pack below keeps the low 16 bits intact
+                const __m128i sign_shift = _mm_srai_epi32(_mm_castps_si128(justsign), 16);
+                res[k] = _mm_or_si128(joined, sign_shift);
+            }
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(res[0], res[1]));
+        }
+    #elif defined(_SPC_NEON_F16)
+        for (; (i + 4) <= num; i += 4) {
+            const float16x4_t h = vcvt_f16_f32(vld1q_f32(src + i));
+            vst1_u16(dst + i, vreinterpret_u16_f16(h));
+        }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = _spc_f32_to_f16_scalar(src[i]);
+    }
+}
+
+// convert 'num' unorm8 values to floats in the range 0.0..1.0
+_SOKOL_PRIVATE void _spc_unorm8_to_f32(const uint8_t* src, float* dst, size_t num) {
+    size_t i = 0;
+    #if defined(_SPC_AVX2)
+        const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+        for (; (i + 16) <= num; i += 16) {
+            const __m128i u8 = _mm_loadu_si128((const __m128i*)(src + i));
+            const __m256i lo = _mm256_cvtepu8_epi32(u8);
+            const __m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(u8, 8));
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+            _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+        }
+    #elif defined(_SPC_SSE2)
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+        const __m128i zero = _mm_setzero_si128();
+        for (; (i + 16) <= num; i += 16) {
+            const __m128i u8 = _mm_loadu_si128((const __m128i*)(src + i));
+            const __m128i u16_lo = _mm_unpacklo_epi8(u8, zero);
+            const __m128i u16_hi = _mm_unpackhi_epi8(u8, zero);
+            const __m128i u32[4] = {
+                _mm_unpacklo_epi16(u16_lo, zero), _mm_unpackhi_epi16(u16_lo, zero),
+                _mm_unpacklo_epi16(u16_hi, zero), _mm_unpackhi_epi16(u16_hi, zero),
+            };
+            for (int k = 0; k < 4; k++) {
+                _mm_storeu_ps(dst + i + k * 4, _mm_mul_ps(_mm_cvtepi32_ps(u32[k]), scale));
+            }
+        }
+    #elif defined(_SPC_NEON)
+        const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+        for (; (i + 16) <= num; i += 16) {
+            const uint8x16_t u8 = vld1q_u8(src + i);
+            const uint16x8_t u16_lo = vmovl_u8(vget_low_u8(u8));
+            const uint16x8_t u16_hi = vmovl_u8(vget_high_u8(u8));
+            vst1q_f32(dst + i + 0, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(u16_lo))), scale));
+            vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(u16_lo))), scale));
+            vst1q_f32(dst + i + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(u16_hi))), scale));
+            vst1q_f32(dst + i + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(u16_hi))), scale));
+        }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = (float)src[i] * (1.0f / 255.0f);
+    }
+}
+
+// convert 'num' floats to unorm8 values, with clamping to 0.0..1.0
+_SOKOL_PRIVATE void _spc_f32_to_unorm8(const float* src, uint8_t* dst, size_t num) {
+    size_t i = 0;
+    #if defined(_SPC_SSE2)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        for (; (i + 16) <= num; i += 16) {
+            __m128i u32[4];
+            for (int k = 0; k < 4; k++) {
+                // NOTE: _mm_max_ps() returns the second operand for NaN
+                const __m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + k * 4), zero), one);
+                u32[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(f, scale), half));
+            }
+            const __m128i u16_lo = _mm_packs_epi32(u32[0], u32[1]);
+            const __m128i u16_hi = _mm_packs_epi32(u32[2], u32[3]);
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(u16_lo, u16_hi));
+        }
+    #elif defined(_SPC_NEON)
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t scale = vdupq_n_f32(255.0f);
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        for (; (i + 8) <= num; i += 8) {
+            // NaN survives min/max, but is converted to 0 by vcvtq_u32_f32()
+            const float32x4_t f0 = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+            const float32x4_t f1 = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), zero), one);
+            const uint32x4_t u0 = vcvtq_u32_f32(vaddq_f32(vmulq_f32(f0, scale), half));
+            const uint32x4_t u1 = vcvtq_u32_f32(vaddq_f32(vmulq_f32(f1, scale), half));
+            vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(u0), vmovn_u32(u1))));
+        }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = _spc_f32_to_unorm8_scalar(src[i]);
+    }
+}
+
+// expand RGB8 to RGBA8 pixels with alpha set to 255
+_SOKOL_PRIVATE void _spc_rgb8_to_rgba8(const uint8_t* src, uint8_t* dst, size_t num_pixels) {
+    size_t i = 0;
+    #if defined(_SPC_SSSE3)
+        // each 16-byte load covers 4 pixels, the last load of an iteration
+        // reads 4 bytes past the 16 pixels, hence the 18-pixel loop condition
+        const __m128i shuf = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+        const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+        for (; (i + 18) <= num_pixels; i += 16) {
+            const uint8_t* s = src + i * 3;
+            uint8_t* d = dst + i * 4;
+            for (int k = 0; k < 4; k++) {
+                const __m128i rgb = _mm_loadu_si128((const __m128i*)(s + k * 12));
+                _mm_storeu_si128((__m128i*)(d + k * 16), _mm_or_si128(_mm_shuffle_epi8(rgb, shuf), alpha));
+            }
+        }
+    #elif defined(_SPC_NEON)
+        for (; (i + 16) <= num_pixels; i += 16) {
+            const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+    #endif
+    for (; i < num_pixels; i++) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+// swap the R and B channels of RGBA8 or BGRA8 pixels
+_SOKOL_PRIVATE void _spc_swap_rb8(const uint8_t* src, uint8_t* dst, size_t num_pixels) {
+    size_t i = 0;
+    #if defined(_SPC_SSE2)
+        const __m128i mask_ga = _mm_set1_epi32((int)0xFF00FF00);
+        const __m128i mask_lo = _mm_set1_epi32(0x000000FF);
+        for (; (i + 4) <= num_pixels; i += 4) {
+            const __m128i c = _mm_loadu_si128((const __m128i*)(src + i * 4));
+            const __m128i ga = _mm_and_si128(c, mask_ga);
+            const __m128i r = _mm_slli_epi32(_mm_and_si128(c, mask_lo), 16);
+            const __m128i b = _mm_and_si128(_mm_srli_epi32(c, 16), mask_lo);
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(ga, _mm_or_si128(r, b)));
+        }
+    #elif defined(_SPC_NEON)
+        for (; (i + 16) <= num_pixels; i += 16) {
+            uint8x16x4_t c = vld4q_u8(src + i * 4);
+            const uint8x16_t tmp = c.val[0];
+            c.val[0] = c.val[2];
+            c.val[2] = tmp;
+            vst4q_u8(dst + i * 4, c);
+        }
+    #endif
+    // NOTE: may be called with src == dst
+    for (; i < num_pixels; i++) {
+        const uint8_t r = src[i * 4 + 0];
+        const uint8_t b = src[i * 4 + 2];
+        dst[i * 4 + 0] = b;
+        dst[i * 4 + 1] = src[i * 4 + 1];
+        dst[i * 4 + 2] = r;
+        dst[i * 4 + 3] = src[i * 4 + 3];
+    }
+}
+
+// expand RGB32F to RGBA32F pixels with alpha set to 1.0
+_SOKOL_PRIVATE void _spc_rgb32f_to_rgba32f(const float* src, float* dst, size_t num_pixels) {
+    for (size_t i = 0; i < num_pixels; i++) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 1.0f;
+    }
+}
+
+// convert unorm8 values to half-floats via lookup table
+_SOKOL_PRIVATE void _spc_unorm8_to_f16(const uint8_t* src, uint16_t* dst, size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        dst[i] = _spc.unorm8_to_f16[src[i]];
+    }
+}
+
+// convert SRGBA8 pixels to linear RGBA8, RGBA16F or RGBA32F pixels via lookup
+// tables, the alpha channel is not sRGB encoded
+_SOKOL_PRIVATE void _spc_srgba8_to_rgba8(const uint8_t* src, uint8_t* dst, size_t num_pixels) {
+    for (size_t i = 0; i < num_pixels * 4; i += 4) {
+        dst[i + 0] = _spc.srgb_to_unorm8[src[i + 0]];
+        dst[i + 1] = _spc.srgb_to_unorm8[src[i + 1]];
+        dst[i + 2] = _spc.srgb_to_unorm8[src[i + 2]];
+        dst[i + 3] = src[i + 3];
+    }
+}
+
+_SOKOL_PRIVATE void _spc_srgba8_to_rgba16f(const uint8_t* src, uint16_t* dst, size_t num_pixels) {
+    for (size_t i = 0; i < num_pixels * 4; i += 4) {
+        dst[i + 0] = _spc.srgb_to_f16[src[i + 0]];
+        dst[i + 1] = _spc.srgb_to_f16[src[i + 1]];
+        dst[i + 2] = _spc.srgb_to_f16[src[i + 2]];
+        dst[i + 3] = _spc.unorm8_to_f16[src[i + 3]];
+    }
+}
+
+_SOKOL_PRIVATE void _spc_srgba8_to_rgba32f(const uint8_t* src, float* dst, size_t num_pixels) {
+    for (size_t i = 0; i < num_pixels * 4; i += 4) {
+        dst[i + 0] = _spc.srgb_to_f32[src[i + 0]];
+        dst[i + 1] = _spc.srgb_to_f32[src[i + 1]];
+        dst[i + 2] = _spc.srgb_to_f32[src[i + 2]];
+        dst[i + 3] = _spc.unorm8_to_f32[src[i + 3]];
+    }
+}
+
+/*=== CONVERSION DISPATCH ====================================================*/
+_SOKOL_PRIVATE int _spc_src_pixel_size(spc_format fmt) {
+    switch (fmt) {
+        case SPC_FORMAT_R8:         return 1;
+        case SPC_FORMAT_RG8:        return 2;
+        case SPC_FORMAT_RGB8:
+        case SPC_FORMAT_SRGB8:      return 3;
+        case SPC_FORMAT_RGBA8:
+        case SPC_FORMAT_BGRA8:
+        case SPC_FORMAT_SRGBA8:
+        case SPC_FORMAT_R32F:       return 4;
+        case SPC_FORMAT_RG32F:      return 8;
+        case SPC_FORMAT_RGB32F:     return 12;
+        case SPC_FORMAT_RGBA32F:    return 16;
+        default:                    return 0;
+    }
+}
+
+_SOKOL_PRIVATE int _spc_dst_pixel_size(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:         return 1;
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_R16F:       return 2;
+        case SG_PIXELFORMAT_RGBA8:
+        case SG_PIXELFORMAT_BGRA8:
+        case SG_PIXELFORMAT_RG16F:
+        case SG_PIXELFORMAT_R32F:       return 4;
+        case SG_PIXELFORMAT_RGBA16F:
+        case SG_PIXELFORMAT_RG32F:      return 8;
+        case SG_PIXELFORMAT_RGBA32F:    return 16;
+        default:                        return 0;
+    }
+}
+
+// the conversion from a 3-channel source format goes through
+// the matching 4-channel format in chunks of _SPC_CHUNK_PIXELS
+_SOKOL_PRIVATE spc_format _spc_expanded_format(spc_format fmt) {
+    switch (fmt) {
+        case SPC_FORMAT_RGB8:   return SPC_FORMAT_RGBA8;
+        case SPC_FORMAT_SRGB8:  return SPC_FORMAT_SRGBA8;
+        case SPC_FORMAT_RGB32F: return SPC_FORMAT_RGBA32F;
+        default:                return fmt;
+    }
+}
+
+_SOKOL_PRIVATE bool _spc_is_copy(spc_format src_fmt, sg_pixel_format dst_fmt) {
+    switch (src_fmt) {
+        case SPC_FORMAT_R8:         return dst_fmt == SG_PIXELFORMAT_R8;
+        case SPC_FORMAT_RG8:        return dst_fmt == SG_PIXELFORMAT_RG8;
+        case SPC_FORMAT_RGBA8:      return dst_fmt == SG_PIXELFORMAT_RGBA8;
+        case SPC_FORMAT_BGRA8:      return dst_fmt == SG_PIXELFORMAT_BGRA8;
+        case SPC_FORMAT_R32F:       return dst_fmt == SG_PIXELFORMAT_R32F;
+        case SPC_FORMAT_RG32F:      return dst_fmt == SG_PIXELFORMAT_RG32F;
+        case SPC_FORMAT_RGBA32F:    return dst_fmt == SG_PIXELFORMAT_RGBA32F;
+        default:                    return false;
+    }
+}
+
+// convert pixels of a 1-, 2- or 4-channel source format
+_SOKOL_PRIVATE bool _spc_convert_direct(spc_format src_fmt, const void* src, sg_pixel_format dst_fmt, void* dst, size_t num_pixels) {
+    const uint8_t* src_u8 = (const uint8_t*) src;
+    const float* src_f32 = (const float*) src;
+    switch (src_fmt) {
+        case SPC_FORMAT_R8:
+        case SPC_FORMAT_RG8:
+        case SPC_FORMAT_RGBA8:
+            {
+                const size_t num = num_pixels * (size_t)_spc_src_pixel_size(src_fmt);
+                switch (dst_fmt) {
+                    case SG_PIXELFORMAT_R16F:
+                    case SG_PIXELFORMAT_RG16F:
+                    case SG_PIXELFORMAT_RGBA16F:
+                        _spc_unorm8_to_f16(src_u8, (uint16_t*)dst, num);
+                        return true;
+                    case SG_PIXELFORMAT_R32F:
+                    case SG_PIXELFORMAT_RG32F:
+                    case SG_PIXELFORMAT_RGBA32F:
+                        _spc_unorm8_to_f32(src_u8, (float*)dst, num);
+                        return true;
+                    case SG_PIXELFORMAT_BGRA8:
+                        _spc_swap_rb8(src_u8, (uint8_t*)dst, num_pixels);
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+        case SPC_FORMAT_BGRA8:
+            _spc_swap_rb8(src_u8, (uint8_t*)dst, num_pixels);
+            return true;
+        case SPC_FORMAT_SRGBA8:
+            switch (dst_fmt) {
+                case SG_PIXELFORMAT_RGBA8:
+                    _spc_srgba8_to_rgba8(src_u8, (uint8_t*)dst, num_pixels);
+                    return true;
+                case SG_PIXELFORMAT_BGRA8:
+                    _spc_srgba8_to_rgba8(src_u8, (uint8_t*)dst, num_pixels);
+                    _spc_swap_rb8((const uint8_t*)dst, (uint8_t*)dst, num_pixels);
+                    return true;
+                case SG_PIXELFORMAT_RGBA16F:
+                    _spc_srgba8_to_rgba16f(src_u8, (uint16_t*)dst, num_pixels);
+                    return true;
+                case SG_PIXELFORMAT_RGBA32F:
+                    _spc_srgba8_to_rgba32f(src_u8, (float*)dst, num_pixels);
+                    return true;
+                default:
+                    return false;
+            }
+        case SPC_FORMAT_R32F:
+        case SPC_FORMAT_RG32F:
+        case SPC_FORMAT_RGBA32F:
+            {
+                const size_t num = num_pixels * (size_t)_spc_src_pixel_size(src_fmt) / sizeof(float);
+                switch (dst_fmt) {
+                    case SG_PIXELFORMAT_R16F:
+                    case SG_PIXELFORMAT_RG16F:
+                    case SG_PIXELFORMAT_RGBA16F:
+                        _spc_f32_to_f16(src_f32, (uint16_t*)dst, num);
+                        return true;
+                    case SG_PIXELFORMAT_RGBA8:
+                        _spc_f32_to_unorm8(src_f32, (uint8_t*)dst, num);
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+        default:
+            return false;
+    }
+}
+
+_SOKOL_PRIVATE bool _spc_convert(spc_format src_fmt, const void* src, sg_pixel_format dst_fmt, void* dst, size_t num_pixels) {
+    if (_spc_is_copy(src_fmt, dst_fmt)) {
+        memcpy(dst, src, num_pixels * (size_t)_spc_src_pixel_size(src_fmt));
+        return true;
+    }
+    const spc_format exp_fmt = _spc_expanded_format(src_fmt);
+    if (exp_fmt == src_fmt) {
+        return _spc_convert_direct(src_fmt, src, dst_fmt, dst, num_pixels);
+    }
+    const size_t src_pixel_size = (size_t)_spc_src_pixel_size(src_fmt);
+    const size_t dst_pixel_size = (size_t)_spc_dst_pixel_size(dst_fmt);
+    if (_spc_is_copy(exp_fmt, dst_fmt)) {
+        // expand directly into the destination
+        if (exp_fmt == SPC_FORMAT_RGBA32F) {
+            _spc_rgb32f_to_rgba32f((const float*)src, (float*)dst, num_pixels);
+        }
+        else {
+            _spc_rgb8_to_rgba8((const uint8_t*)src, (uint8_t*)dst, num_pixels);
+        }
+        return true;
+    }
+    // otherwise expand into a temporary buffer on the stack and convert from there
+    float tmp[_SPC_CHUNK_PIXELS * 4];
+    const uint8_t* src_ptr = (const uint8_t*) src;
+    uint8_t* dst_ptr = (uint8_t*) dst;
+    size_t i = 0;
+    while (i < num_pixels) {
+        const size_t n = ((num_pixels - i) < _SPC_CHUNK_PIXELS) ? (num_pixels - i) : _SPC_CHUNK_PIXELS;
+        if (exp_fmt == SPC_FORMAT_RGBA32F) {
+            _spc_rgb32f_to_rgba32f((const float*)(src_ptr + i * src_pixel_size), tmp, n);
+        }
+        else {
+            _spc_rgb8_to_rgba8(src_ptr + i * src_pixel_size, (uint8_t*)tmp, n);
+        }
+        if (!_spc_convert_direct(exp_fmt, tmp, dst_fmt, dst_ptr + i * dst_pixel_size, n)) {
+            return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE bool _spc_can_convert(spc_format src_fmt, sg_pixel_format dst_fmt) {
+    const spc_format exp_fmt = _spc_expanded_format(src_fmt);
+    switch (exp_fmt) {
+        case SPC_FORMAT_R8:
+            return (dst_fmt == SG_PIXELFORMAT_R8) || (dst_fmt == SG_PIXELFORMAT_R16F) || (dst_fmt == SG_PIXELFORMAT_R32F);
+        case SPC_FORMAT_RG8:
+            return (dst_fmt == SG_PIXELFORMAT_RG8) || (dst_fmt == SG_PIXELFORMAT_RG16F) || (dst_fmt == SG_PIXELFORMAT_RG32F);
+        case SPC_FORMAT_RGBA8:
+        case SPC_FORMAT_SRGBA8:
+            return (dst_fmt == SG_PIXELFORMAT_RGBA8) || (dst_fmt == SG_PIXELFORMAT_BGRA8) ||
+                   (dst_fmt == SG_PIXELFORMAT_RGBA16F) || (dst_fmt == SG_PIXELFORMAT_RGBA32F);
+        case SPC_FORMAT_BGRA8:
+            return (dst_fmt == SG_PIXELFORMAT_RGBA8) || (dst_fmt == SG_PIXELFORMAT_BGRA8);
+        case SPC_FORMAT_R32F:
+            return (dst_fmt == SG_PIXELFORMAT_R16F) || (dst_fmt == SG_PIXELFORMAT_R32F);
+        case SPC_FORMAT_RG32F:
+            return (dst_fmt == SG_PIXELFORMAT_RG16F) || (dst_fmt == SG_PIXELFORMAT_RG32F);
+        case SPC_FORMAT_RGBA32F:
+            return (dst_fmt == SG_PIXELFORMAT_RGBA8) || (dst_fmt == SG_PIXELFORMAT_RGBA16F) || (dst_fmt == SG_PIXELFORMAT_RGBA32F);
+        default:
+            return false;
+    }
+}
+
+_SOKOL_PRIVATE uint8_t* _spc_scratch(size_t size) {
+    if (size > _spc.scratch_size) {
+        if (_spc.scratch) {
+            SOKOL_FREE(_spc.scratch);
+        }
+        _spc.scratch = (uint8_t*) SOKOL_MALLOC(size);
+        SOKOL_ASSERT(_spc.scratch);
+        _spc.scratch_size = size;
+    }
+    return _spc.scratch;
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void spc_setup(const spc_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_spc, 0, sizeof(_spc));
+    _spc.init_cookie = _SPC_INIT_COOKIE;
+    _spc.desc = *desc;
+    _spc_init_tables();
+    if (_spc.desc.scratch_size > 0) {
+        _spc_scratch(_spc.desc.scratch_size);
+    }
+}
+
+SOKOL_API_IMPL void spc_shutdown(void) {
+    SOKOL_ASSERT(_SPC_INIT_COOKIE == _spc.init_cookie);
+    if (_spc.scratch) {
+        SOKOL_FREE(_spc.scratch);
+        _spc.scratch = 0;
+    }
+    _spc.scratch_size = 0;
+    _spc.init_cookie = 0;
+}
+
+SOKOL_API_IMPL bool spc_can_convert(spc_format src_fmt, sg_pixel_format dst_fmt) {
+    return _spc_can_convert(src_fmt, dst_fmt);
+}
+
+SOKOL_API_IMPL size_t spc_src_size(spc_format fmt, size_t num_pixels) {
+    return num_pixels * (size_t)_spc_src_pixel_size(fmt);
+}
+
+SOKOL_API_IMPL size_t spc_dst_size(sg_pixel_format fmt, size_t num_pixels) {
+    return num_pixels * (size_t)_spc_dst_pixel_size(fmt);
+}
+
+SOKOL_API_IMPL bool spc_convert(spc_format src_fmt, const void* src, sg_pixel_format dst_fmt, void* dst, size_t num_pixels) {
+    SOKOL_ASSERT(_SPC_INIT_COOKIE == _spc.init_cookie);
+    SOKOL_ASSERT(src && dst);
+    if (!_spc_can_convert(src_fmt, dst_fmt)) {
+        return false;
+    }
+    return _spc_convert(src_fmt, src, dst_fmt, dst, num_pixels);
+}
+
+SOKOL_API_IMPL bool spc_update_image(sg_image img, spc_format src_fmt, const sg_image_data* data) {
+    SOKOL_ASSERT(_SPC_INIT_COOKIE == _spc.init_cookie);
+    SOKOL_ASSERT(data);
+    const sg_pixel_format dst_fmt = sg_query_image_info(img).pixel_format;
+    if (!_spc_can_convert(src_fmt, dst_fmt)) {
+        return false;
+    }
+    if (_spc_is_copy(src_fmt, dst_fmt)) {
+        sg_update_image(img, data);
+        return true;
+    }
+    const size_t src_pixel_size = (size_t)_spc_src_pixel_size(src_fmt);
+    const size_t dst_pixel_size = (size_t)_spc_dst_pixel_size(dst_fmt);
+    size_t total_size = 0;
+    for (int face = 0; face < SG_CUBEFACE_NUM; face++) {
+        for (int mip = 0; mip < SG_MAX_MIPMAPS; mip++) {
+            const sg_range* src = &data->subimage[face][mip];
+            if (src->ptr) {
+                SOKOL_ASSERT((src->size % src_pixel_size) == 0);
+                total_size += (src->size / src_pixel_size) * dst_pixel_size;
+            }
+        }
+    }
+    uint8_t* dst_ptr = _spc_scratch(total_size);
+    sg_image_data dst_data;
+    memset(&dst_data, 0, sizeof(dst_data));
+    for (int face = 0; face < SG_CUBEFACE_NUM; face++) {
+        for (int mip = 0; mip < SG_MAX_MIPMAPS; mip++) {
+            const sg_range* src = &data->subimage[face][mip];
+            if (src->ptr) {
+                const size_t num_pixels = src->size / src_pixel_size;
+                _spc_convert(src_fmt, src->ptr, dst_fmt, dst_ptr, num_pixels);
+                dst_data.subimage[face][mip].ptr = dst_ptr;
+                dst_data.subimage[face][mip].size = num_pixels * dst_pixel_size;
+                dst_ptr += num_pixels * dst_pixel_size;
+            }
+        }
+    }
+    sg_update_image(img, &dst_data);
+    return true;
+}
+
+#endif // SOKOL_PIXCONV_IMPL
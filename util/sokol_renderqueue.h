@@ -0,0 +1,755 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_RENDERQUEUE_IMPL)
+#define SOKOL_RENDERQUEUE_IMPL
+#endif
+#ifndef SOKOL_RENDERQUEUE_INCLUDED
+/*
+    sokol_renderqueue.h -- sorted draw submission with redundant state
+                           elimination on top of sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_RENDERQUEUE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_renderqueue.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)             - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)             - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)               - your own free function (default: free(p))
+    SOKOL_RENDERQUEUE_API_DECL  - public function declaration prefix (default: extern)
+    SOKOL_API_DECL              - same as SOKOL_RENDERQUEUE_API_DECL
+    SOKOL_API_IMPL              - public function implementation prefix (default: -)
+
+    If sokol_renderqueue.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_RENDERQUEUE_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_renderqueue.h collects draw items (a pipeline, resource bindings,
+    uniform data and draw parameters) together with a 64-bit sort key,
+    sorts the items by key with a radix sort, and then submits them
+    through sg_apply_pipeline(), sg_apply_bindings(), sg_apply_uniforms()
+    and sg_draw(), skipping any calls which would not change state.
+
+    By choosing the sort key layout, draws can be grouped by pipeline
+    and material (to minimize state changes) and ordered by depth
+    (front-to-back for opaque geometry, back-to-front for transparent
+    geometry).
+
+    STEP-BY-STEP
+    ============
+    Call srq_setup() once after sg_setup():
+
+        srq_setup(&(srq_desc_t){
+            .max_items = ...,           // max number of draw items per frame, default: 4096
+            .uniform_buffer_size = ..., // size of uniform data arena in bytes, default: 256 KB
+        });
+
+    For each draw, build a sort key and push a draw item:
+
+        srq_push(&(srq_draw_t){
+            .key = srq_make_key(layer, pip, material, depth),
+            .pipeline = pip,
+            .bindings = bind,
+            .uniforms[0] = {
+                .stage = SG_SHADERSTAGE_VS,
+                .ub_index = 0,
+                .data = SG_RANGE(vs_params),
+            },
+            .num_elements = 36,
+            .num_instances = 1,
+        });
+
+    The uniform data is copied into an internal arena, so the pointed-to
+    data doesn't need to stay alive after srq_push() returns. If the queue
+    or uniform arena is full, srq_push() returns false and the draw item is
+    dropped.
+
+    Inside a render pass, call srq_submit() to sort the queued items and
+    issue the sokol-gfx calls. The queue is empty afterwards:
+
+        sg_begin_default_pass(...);
+        srq_submit();
+        sg_end_pass();
+
+    Sorting and submitting can also be split, srq_sort() only touches
+    data owned by sokol_renderqueue.h and doesn't call into sokol-gfx, so
+    it can run on a worker thread as long as no srq_push() or srq_submit()
+    happens at the same time. srq_submit() won't sort again if nothing was
+    pushed since the last srq_sort().
+
+    The sort itself is single-threaded, splitting one sort across several
+    threads is out of scope for sokol_renderqueue.h (sorting 50k items takes
+    around 1..2 ms, which is small compared to the submission, see
+    bench/srqbench.c). Applications which need more parallelism can fill
+    and sort one queue per thread in their own code.
+
+    To discard all queued items without rendering, call:
+
+        srq_reset();
+
+    At shutdown, call:
+
+        srq_shutdown();
+
+    SORT KEYS
+    =========
+    Items are submitted in ascending key order, items with identical keys
+    keep their push order. You can use any key layout, the helper function
+
+        uint64_t srq_make_key(uint8_t layer, sg_pipeline pip, uint16_t material, float depth)
+
+    builds a key with the following layout (from most to least significant bits):
+
+        - 8 bits layer (for instance opaque before transparent)
+        - 16 bits pipeline (the pipeline's pool slot index)
+        - 16 bits material (a user-provided id for the resource bindings)
+        - 24 bits depth (a value between 0.0 and 1.0, quantized)
+
+    For back-to-front sorting, pass (1.0f - depth) as depth value.
+
+    REDUNDANT STATE ELIMINATION
+    ===========================
+    During srq_submit() the following calls are skipped:
+
+        - sg_apply_pipeline() if the pipeline is the same as in the previous item
+        - sg_apply_bindings() if the pipeline didn't change and the bindings
+          are identical to the previous item
+        - sg_apply_uniforms() if the pipeline didn't change and the uniform
+          data for the same shader stage and uniform block slot is byte-identical
+          to the previously applied data
+
+    To find out how many calls have been issued and skipped, call:
+
+        srq_stats_t stats = srq_stats();
+
+    The stats are accumulated over all srq_submit() calls since the last
+    call to srq_reset_stats().
+
+    AUTO-INSTANCING
+    ===============
+    Draws which only differ in a single uniform block (typically a model
+    matrix) can be merged into instanced draws. This is opt-in per pipeline
+    and requires a second, instanced variant of the pipeline, where the
+    shader reads the per-draw data from per-instance vertex attributes
+    instead of the uniform block.
+
+    First provide the size of a stream vertex buffer for the per-instance
+    data in srq_setup() (the default is 0, which disables auto-instancing).
+    The buffer is created as ring buffer (see sg_buffer_desc.ring), so
+    its size should be large enough for the per-instance data of a few
+    frames:
+
+        srq_setup(&(srq_desc_t){
+            .instance_buffer_size = 1024 * 1024,
+        });
+
+    ...then for each pipeline which should be auto-instanced, register
+    the instanced pipeline variant and the uniform block which becomes
+    instance data:
+
+        srq_add_instancing(&(srq_instancing_desc_t){
+            .pipeline = pip,                // the pipeline used in srq_push()
+            .instanced_pipeline = inst_pip, // the pipeline for instanced draws
+            .stage = SG_SHADERSTAGE_VS,     // the uniform block which...
+            .ub_index = 0,                  // ...becomes per-instance data
+            .buffer_index = 1,              // vertex buffer slot of the instance data
+        });
+
+    The vertex layout of the instanced pipeline must describe the uniform
+    block's memory layout as per-instance vertex attributes in the vertex
+    buffer slot .buffer_index, for instance a mat4 model matrix becomes
+    4 consecutive SG_VERTEXFORMAT_FLOAT4 attributes with
+    .step_func = SG_VERTEXSTEP_PER_INSTANCE. The stride of this buffer
+    slot must be identical to the uniform block size.
+
+    During srq_submit(), consecutive items (after sorting) using the
+    same registered pipeline, identical bindings, identical draw ranges,
+    a single instance and byte-identical data in all other uniform blocks
+    are merged: the per-item uniform data is appended to the instance
+    buffer, and a single sg_draw() is issued with the instanced pipeline.
+    Make sure that those items end up next to each other by giving them
+    identical sort keys (up to the depth bits).
+
+    If the instance buffer is full (it is in the overflow state), the
+    remaining items are rendered without instancing. The number of instanced draws and merged items
+    is available in srq_stats().
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_RENDERQUEUE_INCLUDED
+#include <stddef.h>     // size_t
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_renderqueue.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_RENDERQUEUE_API_DECL)
+#define SOKOL_RENDERQUEUE_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_RENDERQUEUE_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_RENDERQUEUE_IMPL)
+#define SOKOL_RENDERQUEUE_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_RENDERQUEUE_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_RENDERQUEUE_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SRQ_MAX_UNIFORMS = SG_NUM_SHADER_STAGES * SG_MAX_SHADERSTAGE_UBS,
+    SRQ_MAX_INSTANCING = 16,
+};
+
+typedef struct srq_desc_t {
+    int max_items;              // default: 4096
+    int uniform_buffer_size;    // default: 256 KB
+    int instance_buffer_size;   // default: 0 (no auto-instancing)
+} srq_desc_t;
+
+typedef struct srq_instancing_desc_t {
+    sg_pipeline pipeline;           // the pipeline used in srq_push()
+    sg_pipeline instanced_pipeline; // the pipeline used for the instanced draws
+    sg_shader_stage stage;          // shader stage and slot of the uniform block...
+    int ub_index;                   // ...which is turned into per-instance data
+    int buffer_index;               // vertex buffer slot for the per-instance data
+} srq_instancing_desc_t;
+
+typedef struct srq_uniforms_t {
+    sg_shader_stage stage;
+    int ub_index;
+    sg_range data;              // data.ptr == 0 means unused
+} srq_uniforms_t;
+
+typedef struct srq_draw_t {
+    uint64_t key;
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    srq_uniforms_t uniforms[SRQ_MAX_UNIFORMS];
+    int base_element;
+    int num_elements;
+    int num_instances;
+} srq_draw_t;
+
+typedef struct srq_stats_t {
+    uint32_t num_items;
+    uint32_t num_dropped;           // items dropped in srq_push() because the queue was full
+    uint32_t num_apply_pipeline;
+    uint32_t num_apply_bindings;
+    uint32_t num_apply_uniforms;
+    uint32_t num_skipped_pipeline;
+    uint32_t num_skipped_bindings;
+    uint32_t num_skipped_uniforms;
+    uint32_t num_instanced_draws;   // number of draws created by auto-instancing
+    uint32_t num_instanced_items;   // number of items merged into instanced draws
+} srq_stats_t;
+
+SOKOL_RENDERQUEUE_API_DECL void srq_setup(const srq_desc_t* desc);
+SOKOL_RENDERQUEUE_API_DECL void srq_shutdown(void);
+SOKOL_RENDERQUEUE_API_DECL bool srq_add_instancing(const srq_instancing_desc_t* desc);
+SOKOL_RENDERQUEUE_API_DECL bool srq_push(const srq_draw_t* draw);
+SOKOL_RENDERQUEUE_API_DECL void srq_sort(void);
+SOKOL_RENDERQUEUE_API_DECL void srq_submit(void);
+SOKOL_RENDERQUEUE_API_DECL void srq_reset(void);
+SOKOL_RENDERQUEUE_API_DECL srq_stats_t srq_stats(void);
+SOKOL_RENDERQUEUE_API_DECL void srq_reset_stats(void);
+SOKOL_RENDERQUEUE_API_DECL uint64_t srq_make_key(uint8_t layer, sg_pipeline pip, uint16_t material, float depth);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_RENDERQUEUE_INCLUDED
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_RENDERQUEUE_IMPL
+#define SOKOL_RENDERQUEUE_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy, memcmp
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _srq_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SRQ_INIT_COOKIE (0xA5A5F00D)
+#define _SRQ_DEFAULT_MAX_ITEMS (4096)
+#define _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE (256 * 1024)
+#define _SRQ_UNIFORM_ALIGN (16)
+#define _SRQ_RADIX_BITS (8)
+#define _SRQ_RADIX_SIZE (1<<_SRQ_RADIX_BITS)
+#define _SRQ_RADIX_PASSES (64 / _SRQ_RADIX_BITS)
+
+/* a draw item as stored in the queue, uniform data lives in the arena */
+typedef struct {
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int num_uniforms;
+    uint32_t uniform_offset[SRQ_MAX_UNIFORMS];
+    uint32_t uniform_size[SRQ_MAX_UNIFORMS];
+    uint8_t uniform_slot[SRQ_MAX_UNIFORMS];    // stage * SG_MAX_SHADERSTAGE_UBS + ub_index
+} _srq_item_t;
+
+typedef struct {
+    uint64_t key;
+    uint32_t index;
+} _srq_sort_item_t;
+
+typedef struct {
+    sg_pipeline pipeline;
+    sg_pipeline instanced_pipeline;
+    uint8_t uniform_slot;
+    int buffer_index;
+} _srq_instancing_t;
+
+/* the currently applied state during srq_submit() */
+typedef struct {
+    bool pip_valid;
+    sg_pipeline pipeline;
+    const sg_bindings* bindings;    // null if unknown
+    const uint8_t* uniforms[SRQ_MAX_UNIFORMS];
+    uint32_t uniform_size[SRQ_MAX_UNIFORMS];
+} _srq_apply_state_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    srq_desc_t desc;
+    int num_items;
+    bool sorted;
+    _srq_item_t* items;
+    _srq_sort_item_t* sort_items;   // sorted result
+    _srq_sort_item_t* sort_tmp;     // ping-pong buffer for radix sort
+    uint8_t* uniform_buffer;
+    uint32_t uniform_pos;
+    uint32_t hist[_SRQ_RADIX_PASSES][_SRQ_RADIX_SIZE];
+    int num_instancing;
+    _srq_instancing_t instancing[SRQ_MAX_INSTANCING];
+    sg_buffer instance_buffer;
+    uint8_t* instance_staging;
+    srq_stats_t stats;
+} _srq_state_t;
+static _srq_state_t _srq;
+
+_SOKOL_PRIVATE srq_desc_t _srq_desc_defaults(const srq_desc_t* in_desc) {
+    srq_desc_t desc = *in_desc;
+    desc.max_items = _srq_def(desc.max_items, _SRQ_DEFAULT_MAX_ITEMS);
+    desc.uniform_buffer_size = _srq_def(desc.uniform_buffer_size, _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE);
+    SOKOL_ASSERT(desc.max_items > 0);
+    SOKOL_ASSERT(desc.uniform_buffer_size > 0);
+    SOKOL_ASSERT(desc.instance_buffer_size >= 0);
+    return desc;
+}
+
+_SOKOL_PRIVATE uint32_t _srq_roundup(uint32_t val, uint32_t round_to) {
+    return (val + (round_to - 1)) & ~(round_to - 1);
+}
+
+/*
+    Stable LSD radix sort over the 64-bit keys, 8 bits per pass. The
+    histograms for all passes are gathered in a single sweep, passes where
+    all keys have the same digit are skipped (which is common for the
+    layer and pipeline bits).
+*/
+_SOKOL_PRIVATE void _srq_radix_sort(void) {
+    const uint32_t num = (uint32_t) _srq.num_items;
+    uint32_t (*hist)[_SRQ_RADIX_SIZE] = _srq.hist;
+    memset(_srq.hist, 0, sizeof(_srq.hist));
+    _srq_sort_item_t* src = _srq.sort_items;
+    _srq_sort_item_t* dst = _srq.sort_tmp;
+    for (uint32_t i = 0; i < num; i++) {
+        const uint64_t key = src[i].key;
+        for (int pass = 0; pass < _SRQ_RADIX_PASSES; pass++) {
+            hist[pass][(key >> (pass * _SRQ_RADIX_BITS)) & (_SRQ_RADIX_SIZE - 1)]++;
+        }
+    }
+    for (int pass = 0; pass < _SRQ_RADIX_PASSES; pass++) {
+        uint32_t* h = hist[pass];
+        const int shift = pass * _SRQ_RADIX_BITS;
+        if (h[(src[0].key >> shift) & (_SRQ_RADIX_SIZE - 1)] == num) {
+            continue;
+        }
+        /* turn histogram into start offsets */
+        uint32_t sum = 0;
+        for (int i = 0; i < _SRQ_RADIX_SIZE; i++) {
+            const uint32_t count = h[i];
+            h[i] = sum;
+            sum += count;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            const uint32_t digit = (uint32_t)((src[i].key >> shift) & (_SRQ_RADIX_SIZE - 1));
+            dst[h[digit]++] = src[i];
+        }
+        _srq_sort_item_t* tmp = src; src = dst; dst = tmp;
+    }
+    _srq.sort_items = src;
+    _srq.sort_tmp = dst;
+}
+
+_SOKOL_PRIVATE void _srq_apply_pipeline(_srq_apply_state_t* st, sg_pipeline pip) {
+    if (st->pip_valid && (st->pipeline.id == pip.id)) {
+        _srq.stats.num_skipped_pipeline++;
+        return;
+    }
+    sg_apply_pipeline(pip);
+    _srq.stats.num_apply_pipeline++;
+    st->pip_valid = true;
+    st->pipeline = pip;
+    st->bindings = 0;
+    memset(st->uniforms, 0, sizeof(st->uniforms));
+}
+
+/* a null cur_bindings means the bindings are transient and can't be used for skipping */
+_SOKOL_PRIVATE void _srq_apply_bindings(_srq_apply_state_t* st, const sg_bindings* bindings, const sg_bindings* cur_bindings) {
+    if (st->bindings && (0 == memcmp(st->bindings, bindings, sizeof(sg_bindings)))) {
+        _srq.stats.num_skipped_bindings++;
+        return;
+    }
+    sg_apply_bindings(bindings);
+    _srq.stats.num_apply_bindings++;
+    st->bindings = cur_bindings;
+}
+
+/* apply the item's uniform blocks, except the one in skip_slot (-1 for none) */
+_SOKOL_PRIVATE void _srq_apply_uniforms(_srq_apply_state_t* st, const _srq_item_t* item, int skip_slot) {
+    for (int ui = 0; ui < item->num_uniforms; ui++) {
+        const uint8_t slot = item->uniform_slot[ui];
+        if (slot == skip_slot) {
+            continue;
+        }
+        const uint8_t* ptr = _srq.uniform_buffer + item->uniform_offset[ui];
+        const uint32_t size = item->uniform_size[ui];
+        if (st->uniforms[slot] && (st->uniform_size[slot] == size) && (0 == memcmp(st->uniforms[slot], ptr, size))) {
+            _srq.stats.num_skipped_uniforms++;
+            continue;
+        }
+        const sg_range data = { ptr, size };
+        sg_apply_uniforms((sg_shader_stage)(slot / SG_MAX_SHADERSTAGE_UBS), slot % SG_MAX_SHADERSTAGE_UBS, &data);
+        _srq.stats.num_apply_uniforms++;
+        st->uniforms[slot] = ptr;
+        st->uniform_size[slot] = size;
+    }
+}
+
+_SOKOL_PRIVATE const _srq_instancing_t* _srq_find_instancing(sg_pipeline pip) {
+    for (int i = 0; i < _srq.num_instancing; i++) {
+        if (_srq.instancing[i].pipeline.id == pip.id) {
+            return &_srq.instancing[i];
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE int _srq_find_uniform(const _srq_item_t* item, uint8_t slot) {
+    for (int ui = 0; ui < item->num_uniforms; ui++) {
+        if (item->uniform_slot[ui] == slot) {
+            return ui;
+        }
+    }
+    return -1;
+}
+
+/* check if item b can be merged into an instanced draw with item a */
+_SOKOL_PRIVATE bool _srq_can_merge(const _srq_item_t* a, const _srq_item_t* b, uint8_t inst_slot) {
+    if ((a->pipeline.id != b->pipeline.id) ||
+        (a->base_element != b->base_element) ||
+        (a->num_elements != b->num_elements) ||
+        (b->num_instances != 1) ||
+        (a->num_uniforms != b->num_uniforms) ||
+        (0 != memcmp(&a->bindings, &b->bindings, sizeof(sg_bindings))))
+    {
+        return false;
+    }
+    for (int ui = 0; ui < a->num_uniforms; ui++) {
+        if ((a->uniform_slot[ui] != b->uniform_slot[ui]) || (a->uniform_size[ui] != b->uniform_size[ui])) {
+            return false;
+        }
+        if ((a->uniform_slot[ui] != inst_slot) &&
+            (0 != memcmp(_srq.uniform_buffer + a->uniform_offset[ui], _srq.uniform_buffer + b->uniform_offset[ui], a->uniform_size[ui])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* returns the number of consecutive sorted items starting at 'first' which can be merged */
+_SOKOL_PRIVATE int _srq_num_mergeable(const _srq_instancing_t* inst, int first) {
+    const _srq_item_t* item = &_srq.items[_srq.sort_items[first].index];
+    if (item->num_instances != 1) {
+        return 1;
+    }
+    const int ui = _srq_find_uniform(item, inst->uniform_slot);
+    if (ui < 0) {
+        return 1;
+    }
+    const int max_num = _srq.desc.instance_buffer_size / (int)item->uniform_size[ui];
+    int num = 1;
+    while (((first + num) < _srq.num_items) && (num < max_num)) {
+        const _srq_item_t* next = &_srq.items[_srq.sort_items[first + num].index];
+        if (!_srq_can_merge(item, next, inst->uniform_slot)) {
+            break;
+        }
+        num++;
+    }
+    return num;
+}
+
+/* render 'num' merged items as one instanced draw, returns false if the instance buffer is full */
+_SOKOL_PRIVATE bool _srq_draw_instanced(_srq_apply_state_t* st, const _srq_instancing_t* inst, int first, int num) {
+    const _srq_item_t* item = &_srq.items[_srq.sort_items[first].index];
+    const uint32_t size = item->uniform_size[_srq_find_uniform(item, inst->uniform_slot)];
+    uint8_t* dst = _srq.instance_staging;
+    for (int i = 0; i < num; i++) {
+        const _srq_item_t* cur = &_srq.items[_srq.sort_items[first + i].index];
+        const int ui = _srq_find_uniform(cur, inst->uniform_slot);
+        memcpy(dst, _srq.uniform_buffer + cur->uniform_offset[ui], size);
+        dst += size;
+    }
+    const sg_range data = { _srq.instance_staging, (size_t)num * size };
+    const int offset = sg_append_buffer(_srq.instance_buffer, &data);
+    if (sg_query_buffer_overflow(_srq.instance_buffer)) {
+        return false;
+    }
+    _srq_apply_pipeline(st, inst->instanced_pipeline);
+    sg_bindings bindings = item->bindings;
+    bindings.vertex_buffers[inst->buffer_index] = _srq.instance_buffer;
+    bindings.vertex_buffer_offsets[inst->buffer_index] = offset;
+    _srq_apply_bindings(st, &bindings, 0);
+    _srq_apply_uniforms(st, item, inst->uniform_slot);
+    sg_draw(item->base_element, item->num_elements, num);
+    _srq.stats.num_items += (uint32_t)num;
+    _srq.stats.num_instanced_draws++;
+    _srq.stats.num_instanced_items += (uint32_t)num;
+    return true;
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void srq_setup(const srq_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_srq, 0, sizeof(_srq));
+    _srq.init_cookie = _SRQ_INIT_COOKIE;
+    _srq.desc = _srq_desc_defaults(desc);
+    const size_t num = (size_t)_srq.desc.max_items;
+    _srq.items = (_srq_item_t*) SOKOL_MALLOC(num * sizeof(_srq_item_t));
+    _srq.sort_items = (_srq_sort_item_t*) SOKOL_MALLOC(num * sizeof(_srq_sort_item_t));
+    _srq.sort_tmp = (_srq_sort_item_t*) SOKOL_MALLOC(num * sizeof(_srq_sort_item_t));
+    _srq.uniform_buffer = (uint8_t*) SOKOL_MALLOC((size_t)_srq.desc.uniform_buffer_size);
+    SOKOL_ASSERT(_srq.items && _srq.sort_items && _srq.sort_tmp && _srq.uniform_buffer);
+    if (_srq.desc.instance_buffer_size > 0) {
+        sg_buffer_desc buf_desc;
+        memset(&buf_desc, 0, sizeof(buf_desc));
+        buf_desc.size = (size_t)_srq.desc.instance_buffer_size;
+        buf_desc.type = SG_BUFFERTYPE_VERTEXBUFFER;
+        buf_desc.usage = SG_USAGE_STREAM;
+        buf_desc.ring = true;
+        buf_desc.label = "srq-instance-buffer";
+        _srq.instance_buffer = sg_make_buffer(&buf_desc);
+        _srq.instance_staging = (uint8_t*) SOKOL_MALLOC((size_t)_srq.desc.instance_buffer_size);
+        SOKOL_ASSERT(_srq.instance_staging);
+    }
+}
+
+SOKOL_API_IMPL void srq_shutdown(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    if (_srq.instance_staging) {
+        SOKOL_FREE(_srq.instance_staging);
+        sg_destroy_buffer(_srq.instance_buffer);
+    }
+    SOKOL_FREE(_srq.uniform_buffer);
+    SOKOL_FREE(_srq.sort_tmp);
+    SOKOL_FREE(_srq.sort_items);
+    SOKOL_FREE(_srq.items);
+    _srq.init_cookie = 0;
+}
+
+SOKOL_API_IMPL bool srq_add_instancing(const srq_instancing_desc_t* desc) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(_srq.desc.instance_buffer_size > 0);
+    SOKOL_ASSERT((desc->ub_index >= 0) && (desc->ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT((desc->buffer_index >= 0) && (desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+    if (_srq.num_instancing >= SRQ_MAX_INSTANCING) {
+        return false;
+    }
+    _srq_instancing_t* inst = &_srq.instancing[_srq.num_instancing++];
+    inst->pipeline = desc->pipeline;
+    inst->instanced_pipeline = desc->instanced_pipeline;
+    inst->uniform_slot = (uint8_t)(((int)desc->stage * SG_MAX_SHADERSTAGE_UBS) + desc->ub_index);
+    inst->buffer_index = desc->buffer_index;
+    return true;
+}
+
+SOKOL_API_IMPL bool srq_push(const srq_draw_t* draw) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    SOKOL_ASSERT(draw);
+    if (_srq.num_items >= _srq.desc.max_items) {
+        _srq.stats.num_dropped++;
+        return false;
+    }
+    /* first check if all uniform data fits, so that nothing needs to be rolled back */
+    uint32_t pos = _srq.uniform_pos;
+    for (int i = 0; i < SRQ_MAX_UNIFORMS; i++) {
+        const srq_uniforms_t* u = &draw->uniforms[i];
+        if (u->data.ptr) {
+            pos = _srq_roundup(pos, _SRQ_UNIFORM_ALIGN) + (uint32_t)u->data.size;
+        }
+    }
+    if (pos > (uint32_t)_srq.desc.uniform_buffer_size) {
+        _srq.stats.num_dropped++;
+        return false;
+    }
+    const uint32_t index = (uint32_t)_srq.num_items++;
+    _srq_item_t* item = &_srq.items[index];
+    item->pipeline = draw->pipeline;
+    item->bindings = draw->bindings;
+    item->base_element = draw->base_element;
+    item->num_elements = draw->num_elements;
+    item->num_instances = _srq_def(draw->num_instances, 1);
+    item->num_uniforms = 0;
+    for (int i = 0; i < SRQ_MAX_UNIFORMS; i++) {
+        const srq_uniforms_t* u = &draw->uniforms[i];
+        if (u->data.ptr) {
+            SOKOL_ASSERT(u->data.size > 0);
+            SOKOL_ASSERT((u->ub_index >= 0) && (u->ub_index < SG_MAX_SHADERSTAGE_UBS));
+            const int ui = item->num_uniforms++;
+            _srq.uniform_pos = _srq_roundup(_srq.uniform_pos, _SRQ_UNIFORM_ALIGN);
+            item->uniform_offset[ui] = _srq.uniform_pos;
+            item->uniform_size[ui] = (uint32_t)u->data.size;
+            item->uniform_slot[ui] = (uint8_t)(((int)u->stage * SG_MAX_SHADERSTAGE_UBS) + u->ub_index);
+            memcpy(_srq.uniform_buffer + _srq.uniform_pos, u->data.ptr, u->data.size);
+            _srq.uniform_pos += (uint32_t)u->data.size;
+        }
+    }
+    _srq.sort_items[index].key = draw->key;
+    _srq.sort_items[index].index = index;
+    _srq.sorted = false;
+    return true;
+}
+
+SOKOL_API_IMPL void srq_sort(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    if (!_srq.sorted && (_srq.num_items > 1)) {
+        _srq_radix_sort();
+    }
+    _srq.sorted = true;
+}
+
+SOKOL_API_IMPL void srq_submit(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    srq_sort();
+    _srq_apply_state_t st;
+    memset(&st, 0, sizeof(st));
+    int i = 0;
+    while (i < _srq.num_items) {
+        const _srq_item_t* item = &_srq.items[_srq.sort_items[i].index];
+        const _srq_instancing_t* inst = _srq_find_instancing(item->pipeline);
+        /* once the instance buffer has overflowed, all further appends this frame
+           would fail too, so don't bother looking for mergeable items anymore
+        */
+        if (inst && !sg_query_buffer_overflow(_srq.instance_buffer)) {
+            const int num = _srq_num_mergeable(inst, i);
+            if ((num > 1) && _srq_draw_instanced(&st, inst, i, num)) {
+                i += num;
+                continue;
+            }
+        }
+        _srq_apply_pipeline(&st, item->pipeline);
+        _srq_apply_bindings(&st, &item->bindings, &item->bindings);
+        _srq_apply_uniforms(&st, item, -1);
+        sg_draw(item->base_element, item->num_elements, item->num_instances);
+        _srq.stats.num_items++;
+        i++;
+    }
+    srq_reset();
+}
+
+SOKOL_API_IMPL void srq_reset(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    _srq.num_items = 0;
+    _srq.uniform_pos = 0;
+    _srq.sorted = false;
+}
+
+SOKOL_API_IMPL srq_stats_t srq_stats(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    return _srq.stats;
+}
+
+SOKOL_API_IMPL void srq_reset_stats(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    memset(&_srq.stats, 0, sizeof(_srq.stats));
+}
+
+SOKOL_API_IMPL uint64_t srq_make_key(uint8_t layer, sg_pipeline pip, uint16_t material, float depth) {
+    if (depth < 0.0f) {
+        depth = 0.0f;
+    }
+    else if (depth > 1.0f) {
+        depth = 1.0f;
+    }
+    const uint64_t depth_bits = (uint64_t)(depth * (float)0xFFFFFF);
+    const uint64_t pip_bits = (uint64_t)(pip.id & 0xFFFF);
+    return ((uint64_t)layer << 56) | (pip_bits << 40) | ((uint64_t)material << 24) | depth_bits;
+}
+
+#endif // SOKOL_RENDERQUEUE_IMPL
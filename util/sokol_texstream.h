@@ -0,0 +1,1153 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_TEXSTREAM_IMPL)
+#define SOKOL_TEXSTREAM_IMPL
+#endif
+#ifndef SOKOL_TEXSTREAM_INCLUDED
+/*
+    sokol_texstream.h -- load KTX2 and DDS texture files chunk by chunk
+                         into sokol_gfx.h images
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_TEXSTREAM_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_texstream.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)             - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)             - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)               - your own free function (default: free(p))
+    SOKOL_LOG(msg)              - your own logging function (default: puts(msg))
+    SOKOL_TEXSTREAM_API_DECL    - public function declaration prefix (default: extern)
+    SOKOL_API_DECL              - same as SOKOL_TEXSTREAM_API_DECL
+    SOKOL_API_IMPL              - public function implementation prefix (default: -)
+
+    If sokol_texstream.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_TEXSTREAM_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_texstream.h parses KTX2 and DDS texture files from a sequence of
+    data chunks (for instance the chunks loaded by sokol_fetch.h in
+    streaming mode), and creates a sokol-gfx image from the pixel data
+    as it arrives, without first loading the whole file into memory.
+
+    Supported are 2D textures, cubemaps and (KTX2 only) array textures in
+    all uncompressed pixel formats of sg_pixel_format that have a
+    matching file format, and the block-compressed formats (BC1..BC7,
+    ETC2, EAC RG11 and PVRTC1). sokol_gfx.h has no sRGB pixel formats,
+    sRGB texture formats are loaded as their linear counterparts.
+
+    Not supported are 3D textures, DDS array textures, cubemap arrays,
+    KTX2 supercompression (Basis Universal, zstd) and legacy KTX1 files.
+
+    PROGRESSIVE MIP STREAMING
+    =========================
+    KTX2 files store mip levels from smallest to largest. If the backend
+    supports streaming images (sg_query_features().mip_streaming), the
+    image is created as soon as the smallest mip has arrived, and the
+    higher resolution mips are added one by one with sg_update_image_mip().
+    This means a texture is visible after the first few KB of a file have
+    been loaded, and the memory overhead is at most one mip level (a mip
+    level which is completely contained in a data chunk is uploaded
+    directly from the chunk without copying).
+
+    DDS files store the largest mip first, and in that case (and if
+    progressive streaming is not supported or disabled) the pixel data is
+    gathered in a single buffer and the image is created when the last
+    byte has arrived.
+
+    STEP-BY-STEP
+    ============
+    Call stx_setup() once after sg_setup():
+
+        stx_setup(&(stx_desc_t){
+            .max_loaders = ...,         // max number of concurrent loaders, default: 16
+            .max_image_size = ...,      // max width and height of a texture, default: 16384
+            .max_staging_size = ...,    // max size of a loader's staging buffer, default: 256 MB
+        });
+
+    Files which exceed those limits are rejected (the limits protect
+    against damaged or malicious files which would otherwise cause huge
+    allocations).
+
+    For each texture file, create a loader. The loader allocates an image
+    handle right away, so it can be put into sg_bindings before any data
+    has been loaded (draw calls using an image which isn't valid yet are
+    silently skipped):
+
+        stx_loader ld = stx_make_loader(&(stx_loader_desc_t){
+            .min_filter = SG_FILTER_LINEAR_MIPMAP_LINEAR,
+            .mag_filter = SG_FILTER_LINEAR,
+        });
+        bind.fs_images[0] = stx_image(ld);
+
+    ...then feed the file data to the loader in the right order, for
+    instance from a sokol_fetch.h response callback in streaming mode
+    (with the loader handle passed in the request's user data):
+
+        static void fetch_callback(const sfetch_response_t* response) {
+            stx_loader ld = *(stx_loader*)response->user_data;
+            if (response->fetched) {
+                stx_feed(ld, response->buffer_ptr, response->fetched_size);
+            }
+            if (response->finished) {
+                stx_destroy_loader(ld);
+            }
+        }
+
+    stx_feed() returns false when the data couldn't be parsed or the
+    image couldn't be created, in that case the image is put into the
+    FAILED resource state.
+
+    If the total file size is known up front (for instance from an HTTP
+    Content-Length header), provide it in stx_loader_desc_t.file_size,
+    this rejects files whose header describes pixel data beyond the end
+    of the file before any pixel data has been received.
+
+    You can query the loading state with:
+
+        stx_state_t stx_loader_state(stx_loader ld)
+
+    which returns one of:
+
+        STX_STATE_LOADING   - waiting for more data
+        STX_STATE_VALID     - all data has arrived and the image is complete
+        STX_STATE_FAILED    - the file couldn't be loaded
+        STX_STATE_INVALID   - the loader handle is invalid
+
+    Destroying a loader doesn't destroy the image, the image belongs to the
+    caller and must be destroyed with sg_destroy_image().
+
+    At shutdown, call:
+
+        stx_shutdown();
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_TEXSTREAM_INCLUDED
+#include <stddef.h>     // size_t
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_texstream.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_TEXSTREAM_API_DECL)
+#define SOKOL_TEXSTREAM_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_TEXSTREAM_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_TEXSTREAM_IMPL)
+#define SOKOL_TEXSTREAM_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_TEXSTREAM_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_TEXSTREAM_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct stx_loader { uint32_t id; } stx_loader;
+
+typedef enum stx_state_t {
+    STX_STATE_INVALID,
+    STX_STATE_LOADING,
+    STX_STATE_VALID,
+    STX_STATE_FAILED,
+} stx_state_t;
+
+typedef struct stx_desc_t {
+    int max_loaders;            // default: 16
+    int max_image_size;         // max texture width and height, default: 16384
+    size_t max_staging_size;    // max size of the pixel data staging buffer, default: 256 MB
+} stx_desc_t;
+
+typedef struct stx_loader_desc_t {
+    sg_filter min_filter;
+    sg_filter mag_filter;
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    uint32_t max_anisotropy;
+    bool no_streaming;          // don't create a streaming image, even if supported
+    uint64_t file_size;         // optional total file size, 0 if unknown
+    const char* label;
+} stx_loader_desc_t;
+
+SOKOL_TEXSTREAM_API_DECL void stx_setup(const stx_desc_t* desc);
+SOKOL_TEXSTREAM_API_DECL void stx_shutdown(void);
+SOKOL_TEXSTREAM_API_DECL stx_loader stx_make_loader(const stx_loader_desc_t* desc);
+SOKOL_TEXSTREAM_API_DECL void stx_destroy_loader(stx_loader ld);
+SOKOL_TEXSTREAM_API_DECL bool stx_feed(stx_loader ld, const void* ptr, size_t size);
+SOKOL_TEXSTREAM_API_DECL stx_state_t stx_loader_state(stx_loader ld);
+SOKOL_TEXSTREAM_API_DECL sg_image stx_image(stx_loader ld);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_TEXSTREAM_INCLUDED
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_TEXSTREAM_IMPL
+#define SOKOL_TEXSTREAM_IMPL_INCLUDED (1)
+
+#include <string.h> // memset, memcpy, memcmp
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #include <stdio.h>
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _stx_def(val, def) (((val) == 0) ? (def) : (val))
+#define _STX_INIT_COOKIE (0x57A5F00D)
+#define _STX_DEFAULT_MAX_LOADERS (16)
+#define _STX_DEFAULT_MAX_IMAGE_SIZE (16 * 1024)
+#define _STX_DEFAULT_MAX_STAGING_SIZE (256 * 1024 * 1024)
+#define _STX_SLOT_SHIFT (16)
+#define _STX_SLOT_MASK ((1<<_STX_SLOT_SHIFT)-1)
+#define _STX_FOURCC(a,b,c,d) ((uint32_t)(a) | ((uint32_t)(b)<<8) | ((uint32_t)(c)<<16) | ((uint32_t)(d)<<24))
+#define _STX_DDS_HEADER_SIZE (4 + 124)
+#define _STX_DDS_DX10_HEADER_SIZE (_STX_DDS_HEADER_SIZE + 20)
+#define _STX_KTX2_HEADER_SIZE (80)
+#define _STX_KTX2_LEVEL_SIZE (24)
+#define _STX_MAX_HEADER_SIZE (_STX_KTX2_HEADER_SIZE + _STX_KTX2_LEVEL_SIZE * SG_MAX_MIPMAPS)
+
+typedef enum {
+    _STX_CONTAINER_UNKNOWN,
+    _STX_CONTAINER_DDS,
+    _STX_CONTAINER_KTX2,
+} _stx_container_t;
+
+typedef struct {
+    uint32_t id;                // 0 if the slot is free
+    stx_state_t state;
+    stx_loader_desc_t desc;
+    sg_image image;
+    /* header parsing */
+    _stx_container_t container;
+    uint8_t header[_STX_MAX_HEADER_SIZE];
+    uint32_t header_size;       // number of header bytes needed
+    uint32_t header_fill;       // number of header bytes received
+    bool header_done;
+    uint64_t pos;               // file offset of the next received byte
+    /* image layout from the header */
+    sg_image_type type;
+    sg_pixel_format fmt;
+    int width;
+    int height;
+    int num_slices;
+    int num_faces;
+    int num_mips;
+    uint64_t sub_offset[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];   // file offset of each subimage
+    uint64_t sub_size[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+    /* pixel data gathering */
+    bool progressive;
+    int cur_mip;                // progressive: the next mip to receive
+    uint64_t data_begin;        // file range of the gathered data
+    uint64_t data_end;
+    uint8_t* staging;
+    size_t fill;
+} _stx_loader_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    stx_desc_t desc;
+    uint32_t gen;
+    _stx_loader_t* loaders;
+} _stx_state_t;
+static _stx_state_t _stx;
+
+_SOKOL_PRIVATE stx_desc_t _stx_desc_defaults(const stx_desc_t* in_desc) {
+    stx_desc_t desc = *in_desc;
+    desc.max_loaders = _stx_def(desc.max_loaders, _STX_DEFAULT_MAX_LOADERS);
+    desc.max_image_size = _stx_def(desc.max_image_size, _STX_DEFAULT_MAX_IMAGE_SIZE);
+    desc.max_staging_size = _stx_def(desc.max_staging_size, _STX_DEFAULT_MAX_STAGING_SIZE);
+    SOKOL_ASSERT((desc.max_loaders > 0) && (desc.max_loaders < _STX_SLOT_MASK));
+    SOKOL_ASSERT(desc.max_image_size > 0);
+    return desc;
+}
+
+_SOKOL_PRIVATE _stx_loader_t* _stx_lookup(uint32_t id) {
+    if (0 == id) {
+        return 0;
+    }
+    const int slot_index = (int)(id & _STX_SLOT_MASK);
+    if (slot_index >= _stx.desc.max_loaders) {
+        return 0;
+    }
+    _stx_loader_t* ld = &_stx.loaders[slot_index];
+    return (ld->id == id) ? ld : 0;
+}
+
+_SOKOL_PRIVATE uint32_t _stx_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+_SOKOL_PRIVATE uint64_t _stx_u64(const uint8_t* p) {
+    return (uint64_t)_stx_u32(p) | ((uint64_t)_stx_u32(p + 4) << 32);
+}
+
+_SOKOL_PRIVATE int _stx_max(int a, int b) {
+    return (a > b) ? a : b;
+}
+
+/* byte size of one surface, this must match the size expected by sokol_gfx.h */
+_SOKOL_PRIVATE uint64_t _stx_surface_size(sg_pixel_format fmt, int width, int height) {
+    const uint64_t bw = (uint64_t)((width + 3) / 4);
+    const uint64_t bh = (uint64_t)((height + 3) / 4);
+    switch (fmt) {
+        case SG_PIXELFORMAT_BC1_RGBA:
+        case SG_PIXELFORMAT_BC4_R:
+        case SG_PIXELFORMAT_BC4_RSN:
+        case SG_PIXELFORMAT_ETC2_RGB8:
+        case SG_PIXELFORMAT_ETC2_RGB8A1:
+            return bw * bh * 8;
+        case SG_PIXELFORMAT_BC2_RGBA:
+        case SG_PIXELFORMAT_BC3_RGBA:
+        case SG_PIXELFORMAT_BC5_RG:
+        case SG_PIXELFORMAT_BC5_RGSN:
+        case SG_PIXELFORMAT_BC6H_RGBF:
+        case SG_PIXELFORMAT_BC6H_RGBUF:
+        case SG_PIXELFORMAT_BC7_RGBA:
+        case SG_PIXELFORMAT_ETC2_RGBA8:
+        case SG_PIXELFORMAT_ETC2_RG11:
+        case SG_PIXELFORMAT_ETC2_RG11SN:
+            return bw * bh * 16;
+        case SG_PIXELFORMAT_PVRTC_RGB_4BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_4BPP:
+            return (uint64_t)((_stx_max(width, 8) * 4 + 7) / 8) * (uint64_t)(((_stx_max(height, 8) + 7) / 8) * 8);
+        case SG_PIXELFORMAT_PVRTC_RGB_2BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_2BPP:
+            return (uint64_t)((_stx_max(width, 16) * 2 + 7) / 8) * (uint64_t)(((_stx_max(height, 8) + 7) / 8) * 8);
+        case SG_PIXELFORMAT_R8:
+        case SG_PIXELFORMAT_R8SN:
+        case SG_PIXELFORMAT_R8UI:
+        case SG_PIXELFORMAT_R8SI:
+            return (uint64_t)width * (uint64_t)height;
+        case SG_PIXELFORMAT_R16:
+        case SG_PIXELFORMAT_R16SN:
+        case SG_PIXELFORMAT_R16UI:
+        case SG_PIXELFORMAT_R16SI:
+        case SG_PIXELFORMAT_R16F:
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_RG8SN:
+        case SG_PIXELFORMAT_RG8UI:
+        case SG_PIXELFORMAT_RG8SI:
+            return (uint64_t)width * (uint64_t)height * 2;
+        case SG_PIXELFORMAT_RG32UI:
+        case SG_PIXELFORMAT_RG32SI:
+        case SG_PIXELFORMAT_RG32F:
+        case SG_PIXELFORMAT_RGBA16:
+        case SG_PIXELFORMAT_RGBA16SN:
+        case SG_PIXELFORMAT_RGBA16UI:
+        case SG_PIXELFORMAT_RGBA16SI:
+        case SG_PIXELFORMAT_RGBA16F:
+            return (uint64_t)width * (uint64_t)height * 8;
+        case SG_PIXELFORMAT_RGBA32UI:
+        case SG_PIXELFORMAT_RGBA32SI:
+        case SG_PIXELFORMAT_RGBA32F:
+            return (uint64_t)width * (uint64_t)height * 16;
+        default:
+            /* all remaining formats are 32 bits per pixel */
+            return (uint64_t)width * (uint64_t)height * 4;
+    }
+}
+
+/* map a KTX2 VkFormat to a sokol-gfx pixel format */
+_SOKOL_PRIVATE sg_pixel_format _stx_ktx2_pixel_format(uint32_t vk_format) {
+    switch (vk_format) {
+        case 9:     return SG_PIXELFORMAT_R8;           // VK_FORMAT_R8_UNORM
+        case 10:    return SG_PIXELFORMAT_R8SN;
+        case 13:    return SG_PIXELFORMAT_R8UI;
+        case 14:    return SG_PIXELFORMAT_R8SI;
+        case 16:    return SG_PIXELFORMAT_RG8;          // VK_FORMAT_R8G8_UNORM
+        case 17:    return SG_PIXELFORMAT_RG8SN;
+        case 20:    return SG_PIXELFORMAT_RG8UI;
+        case 21:    return SG_PIXELFORMAT_RG8SI;
+        case 37:    return SG_PIXELFORMAT_RGBA8;        // VK_FORMAT_R8G8B8A8_UNORM
+        case 38:    return SG_PIXELFORMAT_RGBA8SN;
+        case 41:    return SG_PIXELFORMAT_RGBA8UI;
+        case 42:    return SG_PIXELFORMAT_RGBA8SI;
+        case 43:    return SG_PIXELFORMAT_RGBA8;        // VK_FORMAT_R8G8B8A8_SRGB
+        case 44:    return SG_PIXELFORMAT_BGRA8;        // VK_FORMAT_B8G8R8A8_UNORM
+        case 50:    return SG_PIXELFORMAT_BGRA8;        // VK_FORMAT_B8G8R8A8_SRGB
+        case 64:    return SG_PIXELFORMAT_RGB10A2;      // VK_FORMAT_A2B10G10R10_UNORM_PACK32
+        case 70:    return SG_PIXELFORMAT_R16;          // VK_FORMAT_R16_UNORM
+        case 71:    return SG_PIXELFORMAT_R16SN;
+        case 74:    return SG_PIXELFORMAT_R16UI;
+        case 75:    return SG_PIXELFORMAT_R16SI;
+        case 76:    return SG_PIXELFORMAT_R16F;
+        case 77:    return SG_PIXELFORMAT_RG16;         // VK_FORMAT_R16G16_UNORM
+        case 78:    return SG_PIXELFORMAT_RG16SN;
+        case 81:    return SG_PIXELFORMAT_RG16UI;
+        case 82:    return SG_PIXELFORMAT_RG16SI;
+        case 83:    return SG_PIXELFORMAT_RG16F;
+        case 91:    return SG_PIXELFORMAT_RGBA16;       // VK_FORMAT_R16G16B16A16_UNORM
+        case 92:    return SG_PIXELFORMAT_RGBA16SN;
+        case 95:    return SG_PIXELFORMAT_RGBA16UI;
+        case 96:    return SG_PIXELFORMAT_RGBA16SI;
+        case 97:    return SG_PIXELFORMAT_RGBA16F;
+        case 98:    return SG_PIXELFORMAT_R32UI;        // VK_FORMAT_R32_UINT
+        case 99:    return SG_PIXELFORMAT_R32SI;
+        case 100:   return SG_PIXELFORMAT_R32F;
+        case 101:   return SG_PIXELFORMAT_RG32UI;       // VK_FORMAT_R32G32_UINT
+        case 102:   return SG_PIXELFORMAT_RG32SI;
+        case 103:   return SG_PIXELFORMAT_RG32F;
+        case 107:   return SG_PIXELFORMAT_RGBA32UI;     // VK_FORMAT_R32G32B32A32_UINT
+        case 108:   return SG_PIXELFORMAT_RGBA32SI;
+        case 109:   return SG_PIXELFORMAT_RGBA32F;
+        case 122:   return SG_PIXELFORMAT_RG11B10F;     // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+        case 131:                                       // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132:
+        case 133:
+        case 134:   return SG_PIXELFORMAT_BC1_RGBA;
+        case 135:
+        case 136:   return SG_PIXELFORMAT_BC2_RGBA;
+        case 137:
+        case 138:   return SG_PIXELFORMAT_BC3_RGBA;
+        case 139:   return SG_PIXELFORMAT_BC4_R;
+        case 140:   return SG_PIXELFORMAT_BC4_RSN;
+        case 141:   return SG_PIXELFORMAT_BC5_RG;
+        case 142:   return SG_PIXELFORMAT_BC5_RGSN;
+        case 143:   return SG_PIXELFORMAT_BC6H_RGBUF;   // VK_FORMAT_BC6H_UFLOAT_BLOCK
+        case 144:   return SG_PIXELFORMAT_BC6H_RGBF;
+        case 145:
+        case 146:   return SG_PIXELFORMAT_BC7_RGBA;
+        case 147:                                       // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148:   return SG_PIXELFORMAT_ETC2_RGB8;
+        case 149:
+        case 150:   return SG_PIXELFORMAT_ETC2_RGB8A1;
+        case 151:
+        case 152:   return SG_PIXELFORMAT_ETC2_RGBA8;
+        case 155:   return SG_PIXELFORMAT_ETC2_RG11;    // VK_FORMAT_EAC_R11G11_UNORM_BLOCK
+        case 156:   return SG_PIXELFORMAT_ETC2_RG11SN;
+        case 1000054000:                                // VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG
+        case 1000054004:
+            return SG_PIXELFORMAT_PVRTC_RGBA_2BPP;
+        case 1000054001:                                // VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG
+        case 1000054005:
+            return SG_PIXELFORMAT_PVRTC_RGBA_4BPP;
+        default:    return SG_PIXELFORMAT_NONE;
+    }
+}
+
+/* map a DXGI_FORMAT from the DDS DX10 header to a sokol-gfx pixel format */
+_SOKOL_PRIVATE sg_pixel_format _stx_dxgi_pixel_format(uint32_t dxgi_format) {
+    switch (dxgi_format) {
+        case 2:     return SG_PIXELFORMAT_RGBA32F;      // DXGI_FORMAT_R32G32B32A32_FLOAT
+        case 3:     return SG_PIXELFORMAT_RGBA32UI;
+        case 4:     return SG_PIXELFORMAT_RGBA32SI;
+        case 10:    return SG_PIXELFORMAT_RGBA16F;      // DXGI_FORMAT_R16G16B16A16_FLOAT
+        case 11:    return SG_PIXELFORMAT_RGBA16;
+        case 12:    return SG_PIXELFORMAT_RGBA16UI;
+        case 13:    return SG_PIXELFORMAT_RGBA16SN;
+        case 14:    return SG_PIXELFORMAT_RGBA16SI;
+        case 16:    return SG_PIXELFORMAT_RG32F;        // DXGI_FORMAT_R32G32_FLOAT
+        case 17:    return SG_PIXELFORMAT_RG32UI;
+        case 18:    return SG_PIXELFORMAT_RG32SI;
+        case 24:    return SG_PIXELFORMAT_RGB10A2;      // DXGI_FORMAT_R10G10B10A2_UNORM
+        case 26:    return SG_PIXELFORMAT_RG11B10F;     // DXGI_FORMAT_R11G11B10_FLOAT
+        case 28:                                        // DXGI_FORMAT_R8G8B8A8_UNORM
+        case 29:    return SG_PIXELFORMAT_RGBA8;
+        case 30:    return SG_PIXELFORMAT_RGBA8UI;
+        case 31:    return SG_PIXELFORMAT_RGBA8SN;
+        case 32:    return SG_PIXELFORMAT_RGBA8SI;
+        case 34:    return SG_PIXELFORMAT_RG16F;        // DXGI_FORMAT_R16G16_FLOAT
+        case 35:    return SG_PIXELFORMAT_RG16;
+        case 36:    return SG_PIXELFORMAT_RG16UI;
+        case 37:    return SG_PIXELFORMAT_RG16SN;
+        case 38:    return SG_PIXELFORMAT_RG16SI;
+        case 41:    return SG_PIXELFORMAT_R32F;         // DXGI_FORMAT_R32_FLOAT
+        case 42:    return SG_PIXELFORMAT_R32UI;
+        case 43:    return SG_PIXELFORMAT_R32SI;
+        case 49:    return SG_PIXELFORMAT_RG8;          // DXGI_FORMAT_R8G8_UNORM
+        case 50:    return SG_PIXELFORMAT_RG8UI;
+        case 51:    return SG_PIXELFORMAT_RG8SN;
+        case 52:    return SG_PIXELFORMAT_RG8SI;
+        case 54:    return SG_PIXELFORMAT_R16F;         // DXGI_FORMAT_R16_FLOAT
+        case 56:    return SG_PIXELFORMAT_R16;
+        case 57:    return SG_PIXELFORMAT_R16UI;
+        case 58:    return SG_PIXELFORMAT_R16SN;
+        case 59:    return SG_PIXELFORMAT_R16SI;
+        case 61:    return SG_PIXELFORMAT_R8;           // DXGI_FORMAT_R8_UNORM
+        case 62:    return SG_PIXELFORMAT_R8UI;
+        case 63:    return SG_PIXELFORMAT_R8SN;
+        case 64:    return SG_PIXELFORMAT_R8SI;
+        case 71:                                        // DXGI_FORMAT_BC1_UNORM
+        case 72:    return SG_PIXELFORMAT_BC1_RGBA;
+        case 74:
+        case 75:    return SG_PIXELFORMAT_BC2_RGBA;
+        case 77:
+        case 78:    return SG_PIXELFORMAT_BC3_RGBA;
+        case 80:    return SG_PIXELFORMAT_BC4_R;
+        case 81:    return SG_PIXELFORMAT_BC4_RSN;
+        case 83:    return SG_PIXELFORMAT_BC5_RG;
+        case 84:    return SG_PIXELFORMAT_BC5_RGSN;
+        case 87:                                        // DXGI_FORMAT_B8G8R8A8_UNORM
+        case 91:    return SG_PIXELFORMAT_BGRA8;
+        case 95:    return SG_PIXELFORMAT_BC6H_RGBUF;   // DXGI_FORMAT_BC6H_UF16
+        case 96:    return SG_PIXELFORMAT_BC6H_RGBF;
+        case 98:
+        case 99:    return SG_PIXELFORMAT_BC7_RGBA;
+        default:    return SG_PIXELFORMAT_NONE;
+    }
+}
+
+/* map a legacy DDS pixel format (FourCC or RGB bit masks) to a sokol-gfx pixel format */
+_SOKOL_PRIVATE sg_pixel_format _stx_dds_pixel_format(const uint8_t* pf) {
+    const uint32_t flags = _stx_u32(pf + 4);
+    const uint32_t fourcc = _stx_u32(pf + 8);
+    if (flags & 0x4) {  // DDPF_FOURCC
+        switch (fourcc) {
+            case _STX_FOURCC('D','X','T','1'):  return SG_PIXELFORMAT_BC1_RGBA;
+            case _STX_FOURCC('D','X','T','2'):
+            case _STX_FOURCC('D','X','T','3'):  return SG_PIXELFORMAT_BC2_RGBA;
+            case _STX_FOURCC('D','X','T','4'):
+            case _STX_FOURCC('D','X','T','5'):  return SG_PIXELFORMAT_BC3_RGBA;
+            case _STX_FOURCC('A','T','I','1'):
+            case _STX_FOURCC('B','C','4','U'):  return SG_PIXELFORMAT_BC4_R;
+            case _STX_FOURCC('B','C','4','S'):  return SG_PIXELFORMAT_BC4_RSN;
+            case _STX_FOURCC('A','T','I','2'):
+            case _STX_FOURCC('B','C','5','U'):  return SG_PIXELFORMAT_BC5_RG;
+            case _STX_FOURCC('B','C','5','S'):  return SG_PIXELFORMAT_BC5_RGSN;
+            case 36:    return SG_PIXELFORMAT_RGBA16;   // D3DFMT_A16B16G16R16
+            case 110:   return SG_PIXELFORMAT_RGBA16SN; // D3DFMT_Q16W16V16U16
+            case 111:   return SG_PIXELFORMAT_R16F;     // D3DFMT_R16F
+            case 112:   return SG_PIXELFORMAT_RG16F;    // D3DFMT_G16R16F
+            case 113:   return SG_PIXELFORMAT_RGBA16F;  // D3DFMT_A16B16G16R16F
+            case 114:   return SG_PIXELFORMAT_R32F;     // D3DFMT_R32F
+            case 115:   return SG_PIXELFORMAT_RG32F;    // D3DFMT_G32R32F
+            case 116:   return SG_PIXELFORMAT_RGBA32F;  // D3DFMT_A32B32G32R32F
+            default:    return SG_PIXELFORMAT_NONE;
+        }
+    }
+    const uint32_t bit_count = _stx_u32(pf + 12);
+    const uint32_t r_mask = _stx_u32(pf + 16);
+    const uint32_t g_mask = _stx_u32(pf + 20);
+    const uint32_t b_mask = _stx_u32(pf + 24);
+    const uint32_t a_mask = _stx_u32(pf + 28);
+    if (bit_count == 32) {
+        if ((r_mask == 0x000000FF) && (g_mask == 0x0000FF00) && (b_mask == 0x00FF0000) && (a_mask == 0xFF000000)) {
+            return SG_PIXELFORMAT_RGBA8;
+        }
+        if ((r_mask == 0x00FF0000) && (g_mask == 0x0000FF00) && (b_mask == 0x000000FF) && (a_mask == 0xFF000000)) {
+            return SG_PIXELFORMAT_BGRA8;
+        }
+        if ((r_mask == 0x3FF00000) && (g_mask == 0x000FFC00) && (b_mask == 0x000003FF) && (a_mask == 0xC0000000)) {
+            /* the famous D3DX10 bit mask mixup, this is actually RGB10A2 */
+            return SG_PIXELFORMAT_RGB10A2;
+        }
+        if ((r_mask == 0x000003FF) && (g_mask == 0x000FFC00) && (b_mask == 0x3FF00000) && (a_mask == 0xC0000000)) {
+            return SG_PIXELFORMAT_RGB10A2;
+        }
+        if ((r_mask == 0x0000FFFF) && (g_mask == 0xFFFF0000) && (b_mask == 0) && (a_mask == 0)) {
+            return SG_PIXELFORMAT_RG16;
+        }
+        if ((r_mask == 0xFFFFFFFF) && (g_mask == 0) && (b_mask == 0) && (a_mask == 0)) {
+            return SG_PIXELFORMAT_R32F;
+        }
+    }
+    else if (bit_count == 16) {
+        if ((r_mask == 0xFFFF) && (g_mask == 0) && (b_mask == 0) && (a_mask == 0)) {
+            return SG_PIXELFORMAT_R16;
+        }
+        if ((r_mask == 0x00FF) && (g_mask == 0xFF00) && (b_mask == 0) && (a_mask == 0)) {
+            return SG_PIXELFORMAT_RG8;
+        }
+    }
+    else if (bit_count == 8) {
+        if ((r_mask == 0xFF) && (g_mask == 0) && (b_mask == 0)) {
+            return SG_PIXELFORMAT_R8;
+        }
+    }
+    return SG_PIXELFORMAT_NONE;
+}
+
+_SOKOL_PRIVATE bool _stx_valid_image_size(uint32_t width, uint32_t height) {
+    const uint32_t max_size = (uint32_t)_stx.desc.max_image_size;
+    if ((width == 0) || (height == 0) || (width > max_size) || (height > max_size)) {
+        SOKOL_LOG("sokol_texstream.h: invalid image size or image too big (see stx_desc_t.max_image_size)");
+        return false;
+    }
+    return true;
+}
+
+/* returns 0 on error, otherwise the number of header bytes needed (which is
+   identical with header_fill when the header is complete)
+*/
+_SOKOL_PRIVATE uint32_t _stx_parse_dds_header(_stx_loader_t* ld) {
+    if (ld->header_fill < _STX_DDS_HEADER_SIZE) {
+        return _STX_DDS_HEADER_SIZE;
+    }
+    const uint8_t* h = ld->header + 4;
+    const uint8_t* pf = h + 72;
+    const bool dx10 = (_stx_u32(pf + 4) & 0x4) && (_stx_u32(pf + 8) == _STX_FOURCC('D','X','1','0'));
+    if (dx10 && (ld->header_fill < _STX_DDS_DX10_HEADER_SIZE)) {
+        return _STX_DDS_DX10_HEADER_SIZE;
+    }
+    const uint32_t flags = _stx_u32(h + 4);
+    const uint32_t caps2 = _stx_u32(h + 108);
+    if (!_stx_valid_image_size(_stx_u32(h + 12), _stx_u32(h + 8))) {
+        return 0;
+    }
+    ld->height = (int)_stx_u32(h + 8);
+    ld->width = (int)_stx_u32(h + 12);
+    ld->num_mips = (flags & 0x20000) ? (int)_stx_u32(h + 24) : 1;    // DDSD_MIPMAPCOUNT
+    ld->num_mips = _stx_max(ld->num_mips, 1);
+    ld->num_slices = 1;
+    bool cube = false;
+    if (dx10) {
+        const uint8_t* h10 = ld->header + _STX_DDS_HEADER_SIZE;
+        ld->fmt = _stx_dxgi_pixel_format(_stx_u32(h10));
+        const uint32_t dim = _stx_u32(h10 + 4);
+        const uint32_t misc = _stx_u32(h10 + 8);
+        const uint32_t array_size = _stx_u32(h10 + 12);
+        if (dim != 3) {     // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+            SOKOL_LOG("sokol_texstream.h: only 2D and cube DDS textures are supported");
+            return 0;
+        }
+        if (array_size > 1) {
+            SOKOL_LOG("sokol_texstream.h: DDS array textures are not supported");
+            return 0;
+        }
+        cube = 0 != (misc & 0x4);   // D3D10_RESOURCE_MISC_TEXTURECUBE
+    }
+    else {
+        ld->fmt = _stx_dds_pixel_format(pf);
+        if (caps2 & 0x200000) {     // DDSCAPS2_VOLUME
+            SOKOL_LOG("sokol_texstream.h: DDS volume textures are not supported");
+            return 0;
+        }
+        if (caps2 & 0x200) {        // DDSCAPS2_CUBEMAP
+            if ((caps2 & 0xFC00) != 0xFC00) {
+                SOKOL_LOG("sokol_texstream.h: DDS cubemaps must have all 6 faces");
+                return 0;
+            }
+            cube = true;
+        }
+    }
+    ld->type = cube ? SG_IMAGETYPE_CUBE : SG_IMAGETYPE_2D;
+    ld->num_faces = cube ? 6 : 1;
+    if ((ld->num_mips > SG_MAX_MIPMAPS) || (ld->fmt == SG_PIXELFORMAT_NONE)) {
+        SOKOL_LOG("sokol_texstream.h: unsupported DDS pixel format or too many mipmaps");
+        return 0;
+    }
+    /* DDS stores all mips of a face after each other, largest mip first */
+    uint64_t offset = dx10 ? _STX_DDS_DX10_HEADER_SIZE : _STX_DDS_HEADER_SIZE;
+    for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < ld->num_mips; mip_index++) {
+            const uint64_t size = _stx_surface_size(ld->fmt, _stx_max(ld->width >> mip_index, 1), _stx_max(ld->height >> mip_index, 1));
+            ld->sub_offset[face_index][mip_index] = offset;
+            ld->sub_size[face_index][mip_index] = size;
+            offset += size;
+        }
+    }
+    return ld->header_fill;
+}
+
+_SOKOL_PRIVATE uint32_t _stx_parse_ktx2_header(_stx_loader_t* ld) {
+    if (ld->header_fill < _STX_KTX2_HEADER_SIZE) {
+        return _STX_KTX2_HEADER_SIZE;
+    }
+    const uint8_t* h = ld->header;
+    const uint32_t level_count = _stx_u32(h + 40);
+    ld->num_mips = (level_count == 0) ? 1 : (int)level_count;
+    if (ld->num_mips > SG_MAX_MIPMAPS) {
+        SOKOL_LOG("sokol_texstream.h: KTX2 file has too many mipmaps");
+        return 0;
+    }
+    const uint32_t header_size = _STX_KTX2_HEADER_SIZE + _STX_KTX2_LEVEL_SIZE * (uint32_t)ld->num_mips;
+    if (ld->header_fill < header_size) {
+        return header_size;
+    }
+    const uint32_t vk_format = _stx_u32(h + 12);
+    const uint32_t depth = _stx_u32(h + 28);
+    const uint32_t layer_count = _stx_u32(h + 32);
+    const uint32_t face_count = _stx_u32(h + 36);
+    const uint32_t supercompression = _stx_u32(h + 44);
+    if (!_stx_valid_image_size(_stx_u32(h + 20), _stx_u32(h + 24))) {
+        return 0;
+    }
+    ld->width = (int)_stx_u32(h + 20);
+    ld->height = (int)_stx_u32(h + 24);
+    ld->fmt = _stx_ktx2_pixel_format(vk_format);
+    if (supercompression != 0) {
+        SOKOL_LOG("sokol_texstream.h: KTX2 supercompression is not supported");
+        return 0;
+    }
+    if (ld->fmt == SG_PIXELFORMAT_NONE) {
+        SOKOL_LOG("sokol_texstream.h: unsupported KTX2 pixel format");
+        return 0;
+    }
+    if ((depth > 0) || ((face_count != 1) && (face_count != 6)) || ((face_count == 6) && (layer_count > 0))) {
+        SOKOL_LOG("sokol_texstream.h: only 2D, cube and array KTX2 textures are supported");
+        return 0;
+    }
+    ld->num_faces = (int)face_count;
+    ld->num_slices = _stx_max((int)layer_count, 1);
+    if (face_count == 6) {
+        ld->type = SG_IMAGETYPE_CUBE;
+    }
+    else if (layer_count > 0) {
+        ld->type = SG_IMAGETYPE_ARRAY;
+    }
+    else {
+        ld->type = SG_IMAGETYPE_2D;
+    }
+    /* each level contains all array layers and faces, the levels are usually stored smallest first */
+    for (int mip_index = 0; mip_index < ld->num_mips; mip_index++) {
+        const uint8_t* level = h + _STX_KTX2_HEADER_SIZE + _STX_KTX2_LEVEL_SIZE * mip_index;
+        const uint64_t offset = _stx_u64(level);
+        const uint64_t length = _stx_u64(level + 8);
+        const uint64_t face_size = _stx_surface_size(ld->fmt, _stx_max(ld->width >> mip_index, 1), _stx_max(ld->height >> mip_index, 1)) * (uint64_t)ld->num_slices;
+        if (length != (face_size * (uint64_t)ld->num_faces)) {
+            SOKOL_LOG("sokol_texstream.h: unexpected KTX2 mip level size");
+            return 0;
+        }
+        for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+            ld->sub_offset[face_index][mip_index] = offset + face_size * (uint64_t)face_index;
+            ld->sub_size[face_index][mip_index] = face_size;
+        }
+    }
+    return header_size;
+}
+
+/* returns 0 on error, otherwise the number of header bytes needed */
+_SOKOL_PRIVATE uint32_t _stx_parse_header(_stx_loader_t* ld) {
+    static const uint8_t ktx2_id[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    if (ld->container == _STX_CONTAINER_UNKNOWN) {
+        if ((ld->header_fill >= 4) && (0 == memcmp(ld->header, "DDS ", 4))) {
+            ld->container = _STX_CONTAINER_DDS;
+        }
+        else if (ld->header_fill < sizeof(ktx2_id)) {
+            return sizeof(ktx2_id);
+        }
+        else if (0 == memcmp(ld->header, ktx2_id, sizeof(ktx2_id))) {
+            ld->container = _STX_CONTAINER_KTX2;
+        }
+        else {
+            SOKOL_LOG("sokol_texstream.h: not a DDS or KTX2 file");
+            return 0;
+        }
+    }
+    if (ld->container == _STX_CONTAINER_DDS) {
+        return _stx_parse_dds_header(ld);
+    }
+    else {
+        return _stx_parse_ktx2_header(ld);
+    }
+}
+
+/* file range of all faces of a mip level, returns false if the faces are not contiguous */
+_SOKOL_PRIVATE bool _stx_level_range(const _stx_loader_t* ld, int mip_index, uint64_t* out_begin, uint64_t* out_end) {
+    *out_begin = ld->sub_offset[0][mip_index];
+    *out_end = *out_begin;
+    for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+        if (ld->sub_offset[face_index][mip_index] != *out_end) {
+            return false;
+        }
+        *out_end += ld->sub_size[face_index][mip_index];
+    }
+    return true;
+}
+
+/* check that all subimages are located after the header, inside the file,
+   and don't overlap each other, everything below relies on this
+*/
+_SOKOL_PRIVATE bool _stx_validate_layout(const _stx_loader_t* ld) {
+    const uint64_t file_size = ld->desc.file_size;
+    for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < ld->num_mips; mip_index++) {
+            const uint64_t begin = ld->sub_offset[face_index][mip_index];
+            const uint64_t size = ld->sub_size[face_index][mip_index];
+            if ((begin < ld->header_fill) || (size == 0) || (size > (UINT64_MAX - begin))) {
+                return false;
+            }
+            const uint64_t end = begin + size;
+            if ((file_size > 0) && (end > file_size)) {
+                return false;
+            }
+            for (int other_face = 0; other_face < ld->num_faces; other_face++) {
+                for (int other_mip = 0; other_mip < ld->num_mips; other_mip++) {
+                    if ((other_face == face_index) && (other_mip == mip_index)) {
+                        continue;
+                    }
+                    const uint64_t other_begin = ld->sub_offset[other_face][other_mip];
+                    const uint64_t other_end = other_begin + ld->sub_size[other_face][other_mip];
+                    if ((begin < other_end) && (other_begin < end)) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* decide how the pixel data is gathered once the header is complete */
+_SOKOL_PRIVATE bool _stx_begin_data(_stx_loader_t* ld) {
+    if (!sg_query_pixelformat(ld->fmt).sample) {
+        SOKOL_LOG("sokol_texstream.h: pixel format not supported by backend");
+        return false;
+    }
+    if (!_stx_validate_layout(ld)) {
+        SOKOL_LOG("sokol_texstream.h: invalid or overlapping pixel data ranges in file header");
+        return false;
+    }
+    /* progressive streaming needs contiguous mip levels stored smallest first */
+    ld->progressive = !ld->desc.no_streaming && (ld->num_mips > 1) && sg_query_features().mip_streaming;
+    uint64_t begin, end, prev_begin = 0;
+    for (int mip_index = ld->num_mips - 1; mip_index >= 0; mip_index--) {
+        if (!_stx_level_range(ld, mip_index, &begin, &end)) {
+            ld->progressive = false;
+        }
+        else if ((mip_index < (ld->num_mips - 1)) && (begin < prev_begin)) {
+            ld->progressive = false;
+        }
+        prev_begin = end;
+    }
+    uint64_t staging_size = 0;
+    if (ld->progressive) {
+        /* only needs to hold the largest mip level, for levels which span several chunks */
+        ld->cur_mip = ld->num_mips - 1;
+        _stx_level_range(ld, 0, &begin, &end);
+        staging_size = end - begin;
+    }
+    else {
+        /* gather all pixel data */
+        ld->data_begin = ld->sub_offset[0][0];
+        ld->data_end = ld->data_begin;
+        for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+            for (int mip_index = 0; mip_index < ld->num_mips; mip_index++) {
+                const uint64_t sub_begin = ld->sub_offset[face_index][mip_index];
+                const uint64_t sub_end = sub_begin + ld->sub_size[face_index][mip_index];
+                ld->data_begin = (sub_begin < ld->data_begin) ? sub_begin : ld->data_begin;
+                ld->data_end = (sub_end > ld->data_end) ? sub_end : ld->data_end;
+            }
+        }
+        staging_size = ld->data_end - ld->data_begin;
+    }
+    if (staging_size > (uint64_t)_stx.desc.max_staging_size) {
+        SOKOL_LOG("sokol_texstream.h: pixel data too big (see stx_desc_t.max_staging_size)");
+        return false;
+    }
+    ld->staging = (uint8_t*) SOKOL_MALLOC((size_t)staging_size);
+    if (0 == ld->staging) {
+        SOKOL_LOG("sokol_texstream.h: failed to allocate staging buffer");
+        return false;
+    }
+    ld->fill = 0;
+    return true;
+}
+
+_SOKOL_PRIVATE sg_image_desc _stx_image_desc(const _stx_loader_t* ld) {
+    sg_image_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.type = ld->type;
+    desc.width = ld->width;
+    desc.height = ld->height;
+    desc.num_slices = ld->num_slices;
+    desc.num_mipmaps = ld->num_mips;
+    desc.pixel_format = ld->fmt;
+    desc.min_filter = ld->desc.min_filter;
+    desc.mag_filter = ld->desc.mag_filter;
+    desc.wrap_u = ld->desc.wrap_u;
+    desc.wrap_v = ld->desc.wrap_v;
+    desc.max_anisotropy = ld->desc.max_anisotropy;
+    desc.label = ld->desc.label;
+    return desc;
+}
+
+/* create the image or add a mip level, ptr points to the level's data at file offset 'base' */
+_SOKOL_PRIVATE bool _stx_submit_level(_stx_loader_t* ld, int mip_index, const uint8_t* ptr, uint64_t base) {
+    sg_image_data data;
+    memset(&data, 0, sizeof(data));
+    for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+        data.subimage[face_index][mip_index].ptr = ptr + (ld->sub_offset[face_index][mip_index] - base);
+        data.subimage[face_index][mip_index].size = (size_t)ld->sub_size[face_index][mip_index];
+    }
+    if (mip_index == (ld->num_mips - 1)) {
+        sg_image_desc desc = _stx_image_desc(ld);
+        desc.streaming = true;
+        desc.data = data;
+        sg_init_image(ld->image, &desc);
+        return sg_query_image_state(ld->image) == SG_RESOURCESTATE_VALID;
+    }
+    else {
+        sg_update_image_mip(ld->image, mip_index, &data);
+        return sg_query_image_info(ld->image).resident_mip == mip_index;
+    }
+}
+
+/* create the image from the gathered pixel data */
+_SOKOL_PRIVATE bool _stx_submit_all(_stx_loader_t* ld) {
+    sg_image_desc desc = _stx_image_desc(ld);
+    for (int face_index = 0; face_index < ld->num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < ld->num_mips; mip_index++) {
+            desc.data.subimage[face_index][mip_index].ptr = ld->staging + (ld->sub_offset[face_index][mip_index] - ld->data_begin);
+            desc.data.subimage[face_index][mip_index].size = (size_t)ld->sub_size[face_index][mip_index];
+        }
+    }
+    sg_init_image(ld->image, &desc);
+    return sg_query_image_state(ld->image) == SG_RESOURCESTATE_VALID;
+}
+
+/* consume pixel data, returns the number of bytes consumed, or 0 on error */
+_SOKOL_PRIVATE size_t _stx_feed_data(_stx_loader_t* ld, const uint8_t* src, size_t size) {
+    if (ld->progressive) {
+        uint64_t begin, end;
+        _stx_level_range(ld, ld->cur_mip, &begin, &end);
+        if (ld->pos < begin) {
+            /* skip padding and metadata between levels */
+            const uint64_t skip = begin - ld->pos;
+            return (skip < size) ? (size_t)skip : size;
+        }
+        if (ld->pos != (begin + ld->fill)) {
+            return 0;
+        }
+        const size_t level_size = (size_t)(end - begin);
+        size_t num_bytes;
+        bool ok;
+        if ((ld->fill == 0) && (size >= level_size)) {
+            /* level is complete in this chunk, no need to copy */
+            num_bytes = level_size;
+            ok = _stx_submit_level(ld, ld->cur_mip, src, begin);
+        }
+        else {
+            num_bytes = level_size - ld->fill;
+            num_bytes = (num_bytes < size) ? num_bytes : size;
+            memcpy(ld->staging + ld->fill, src, num_bytes);
+            ld->fill += num_bytes;
+            if (ld->fill < level_size) {
+                return num_bytes;
+            }
+            ok = _stx_submit_level(ld, ld->cur_mip, ld->staging, begin);
+        }
+        if (!ok) {
+            return 0;
+        }
+        ld->fill = 0;
+        if (--ld->cur_mip < 0) {
+            ld->state = STX_STATE_VALID;
+        }
+        return num_bytes;
+    }
+    else {
+        if (ld->pos < ld->data_begin) {
+            const uint64_t skip = ld->data_begin - ld->pos;
+            return (skip < size) ? (size_t)skip : size;
+        }
+        if (ld->pos >= ld->data_end) {
+            return 0;
+        }
+        size_t num_bytes = (size_t)(ld->data_end - ld->pos);
+        num_bytes = (num_bytes < size) ? num_bytes : size;
+        memcpy(ld->staging + (ld->pos - ld->data_begin), src, num_bytes);
+        if ((ld->pos + num_bytes) == ld->data_end) {
+            if (!_stx_submit_all(ld)) {
+                return 0;
+            }
+            ld->state = STX_STATE_VALID;
+        }
+        return num_bytes;
+    }
+}
+
+_SOKOL_PRIVATE void _stx_free_staging(_stx_loader_t* ld) {
+    if (ld->staging) {
+        SOKOL_FREE(ld->staging);
+        ld->staging = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _stx_fail(_stx_loader_t* ld) {
+    ld->state = STX_STATE_FAILED;
+    if (sg_query_image_state(ld->image) == SG_RESOURCESTATE_ALLOC) {
+        sg_fail_image(ld->image);
+    }
+    _stx_free_staging(ld);
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void stx_setup(const stx_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_stx, 0, sizeof(_stx));
+    _stx.init_cookie = _STX_INIT_COOKIE;
+    _stx.desc = _stx_desc_defaults(desc);
+    const size_t loaders_size = (size_t)_stx.desc.max_loaders * sizeof(_stx_loader_t);
+    _stx.loaders = (_stx_loader_t*) SOKOL_MALLOC(loaders_size);
+    SOKOL_ASSERT(_stx.loaders);
+    memset(_stx.loaders, 0, loaders_size);
+}
+
+SOKOL_API_IMPL void stx_shutdown(void) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    for (int i = 0; i < _stx.desc.max_loaders; i++) {
+        _stx_free_staging(&_stx.loaders[i]);
+    }
+    SOKOL_FREE(_stx.loaders);
+    _stx.loaders = 0;
+    _stx.init_cookie = 0;
+}
+
+SOKOL_API_IMPL stx_loader stx_make_loader(const stx_loader_desc_t* desc) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    SOKOL_ASSERT(desc);
+    stx_loader res = { 0 };
+    for (int i = 0; i < _stx.desc.max_loaders; i++) {
+        _stx_loader_t* ld = &_stx.loaders[i];
+        if (0 == ld->id) {
+            memset(ld, 0, sizeof(_stx_loader_t));
+            if (++_stx.gen > (0xFFFFFFFF >> _STX_SLOT_SHIFT)) {
+                _stx.gen = 1;
+            }
+            ld->id = (_stx.gen << _STX_SLOT_SHIFT) | (uint32_t)i;
+            ld->state = STX_STATE_LOADING;
+            ld->desc = *desc;
+            ld->image = sg_alloc_image();
+            ld->header_size = 4;
+            res.id = ld->id;
+            break;
+        }
+    }
+    return res;
+}
+
+SOKOL_API_IMPL void stx_destroy_loader(stx_loader ld_id) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    _stx_loader_t* ld = _stx_lookup(ld_id.id);
+    if (ld) {
+        /* the image is owned by the caller, but must not stay in the alloc state */
+        if (ld->state == STX_STATE_LOADING) {
+            _stx_fail(ld);
+        }
+        _stx_free_staging(ld);
+        ld->id = 0;
+    }
+}
+
+SOKOL_API_IMPL bool stx_feed(stx_loader ld_id, const void* ptr, size_t size) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    SOKOL_ASSERT(ptr || (size == 0));
+    _stx_loader_t* ld = _stx_lookup(ld_id.id);
+    if (!ld || (ld->state == STX_STATE_FAILED)) {
+        return false;
+    }
+    const uint8_t* src = (const uint8_t*) ptr;
+    while ((size > 0) && (ld->state == STX_STATE_LOADING)) {
+        size_t num_bytes;
+        if (!ld->header_done) {
+            num_bytes = ld->header_size - ld->header_fill;
+            num_bytes = (num_bytes < size) ? num_bytes : size;
+            memcpy(ld->header + ld->header_fill, src, num_bytes);
+            ld->header_fill += (uint32_t)num_bytes;
+            if (ld->header_fill == ld->header_size) {
+                ld->header_size = _stx_parse_header(ld);
+                if (0 == ld->header_size) {
+                    _stx_fail(ld);
+                    return false;
+                }
+                SOKOL_ASSERT(ld->header_size <= _STX_MAX_HEADER_SIZE);
+                if (ld->header_size == ld->header_fill) {
+                    ld->header_done = true;
+                    if (!_stx_begin_data(ld)) {
+                        _stx_fail(ld);
+                        return false;
+                    }
+                }
+            }
+        }
+        else {
+            num_bytes = _stx_feed_data(ld, src, size);
+            if (0 == num_bytes) {
+                _stx_fail(ld);
+                return false;
+            }
+        }
+        src += num_bytes;
+        size -= num_bytes;
+        ld->pos += num_bytes;
+    }
+    if (ld->state == STX_STATE_VALID) {
+        _stx_free_staging(ld);
+    }
+    return true;
+}
+
+SOKOL_API_IMPL stx_state_t stx_loader_state(stx_loader ld_id) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    const _stx_loader_t* ld = _stx_lookup(ld_id.id);
+    return ld ? ld->state : STX_STATE_INVALID;
+}
+
+SOKOL_API_IMPL sg_image stx_image(stx_loader ld_id) {
+    SOKOL_ASSERT(_STX_INIT_COOKIE == _stx.init_cookie);
+    const _stx_loader_t* ld = _stx_lookup(ld_id.id);
+    sg_image img = { SG_INVALID_ID };
+    if (ld) {
+        img = ld->image;
+    }
+    return img;
+}
+
+#endif // SOKOL_TEXSTREAM_IMPL